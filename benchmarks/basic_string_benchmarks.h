@@ -0,0 +1,70 @@
+#pragma once
+
+#include "bench.h"
+
+class BasicStringBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// A short path built and dropped: inline, so no allocator call at all
+		auto buildShort = [](USIZE iterations)
+		{
+			auto directory = L"C:\\Temp"_embed;
+			auto name = L"\\log.txt"_embed;
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				WideString path;
+				path.Append((const WCHAR *)directory, 7);
+				path.Append((const WCHAR *)name, 8);
+				DoNotOptimize(path.GetData());
+			}
+		};
+		bench.Run(L"basic_string.build_short_15"_embed, buildShort, 15 * sizeof(WCHAR));
+
+		// The same through the formatter
+		auto formatShort = [](USIZE iterations)
+		{
+			auto format = L"C:\\Temp\\log_%03u.txt"_embed;
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				WideString path;
+				path.Format((const WCHAR *)format, (UINT32)(i & 0xFF));
+				DoNotOptimize(path.GetData());
+			}
+		};
+		bench.Run(L"basic_string.format_short"_embed, formatShort, 19 * sizeof(WCHAR));
+
+		// Unit-at-a-time appends from empty: amortized doubling
+		auto appendUnits = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				NarrowString text;
+				for (UINT32 j = 0; j < LargeCount; j++)
+					text.Append((CHAR)('a' + (j & 15)));
+				DoNotOptimize(text.GetData());
+			}
+		};
+		bench.Run(L"basic_string.append_units_1m"_embed, appendUnits, LargeCount);
+
+		// 64-unit pieces, as when joining lines
+		auto appendPieces = [](USIZE iterations)
+		{
+			CHAR piece[64];
+			for (UINT32 j = 0; j < 64; j++)
+				piece[j] = (CHAR)('a' + (j & 15));
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				NarrowString text;
+				for (UINT32 j = 0; j < LargeCount / 64; j++)
+					text.Append(piece, 64);
+				DoNotOptimize(text.GetData());
+			}
+		};
+		bench.Run(L"basic_string.append_pieces_1m"_embed, appendPieces, LargeCount);
+	}
+
+private:
+	static constexpr UINT32 LargeCount = 1024 * 1024;
+};
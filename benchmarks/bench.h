@@ -0,0 +1,205 @@
+/**
+ * bench.h - In-Blob Microbenchmark Framework
+ *
+ * Benchmarks run inside the PIC blob itself, so they measure the code
+ * exactly as it is laid out, relocated and optimized in the shipped build.
+ *
+ * MEASUREMENT:
+ *   1. Scaling  - The iteration count doubles until one batch takes at
+ *                 least the sample time, so timer overhead stays negligible
+ *   2. Warmup   - Batches run untimed for the warmup time (caches, branch
+ *                 predictors, lazily resolved APIs, page faults)
+ *   3. Sampling - SampleCount timed batches; each yields a per-iteration time
+ *
+ * OUTPUT:
+ *   One JSON object per benchmark and line, written through Console:
+ *   {"name":"queue.spsc","iterations":4096,"samples":100,"min_ns":3.125,
+ *    "median_ns":3.201,"p99_ns":4.870,"mean_ns":3.260,"mb_per_s":0}
+ *   mb_per_s is set for benchmarks that declare bytes per iteration.
+ *
+ * REGISTRATION:
+ *   Benchmarks are lambdas or functors taking the iteration count; they are
+ *   called directly, so there is no function pointer to relocate:
+ *
+ *     auto copy = [&](USIZE iterations)
+ *     {
+ *         for (USIZE i = 0; i < iterations; i++)
+ *             Memory::Copy(target, source, 4096);
+ *         DoNotOptimize(target);
+ *     };
+ *     BENCH_RUN_BYTES(bench, L"memory.copy_4k", 4096, copy);
+ */
+
+#pragma once
+
+#include "runtime.h"
+
+// Upper bound of timed batches per benchmark
+#define BENCH_MAX_SAMPLES 128
+// Largest batch the scaling phase will try
+#define BENCH_MAX_ITERATIONS ((USIZE)1 << 30)
+
+// Run a benchmark; name must be a wide string literal
+#define BENCH_RUN(bench, name, routine) (bench).Run(name##_embed, routine)
+// Run a benchmark that moves bytes bytes per iteration; reports throughput as well
+#define BENCH_RUN_BYTES(bench, name, bytes, routine) (bench).Run(name##_embed, routine, bytes)
+
+/**
+ * DoNotOptimize - Force value to be computed and treated as used
+ *
+ * The empty asm claims to read value, so the compiler can neither drop
+ * the computation that produced it nor hoist it out of the loop.
+ */
+template <typename T>
+FORCE_INLINE VOID DoNotOptimize(T const &value)
+{
+	__asm__ __volatile__("" : : "r,m"(value) : "memory");
+}
+
+// Make all pending memory writes observable, e.g. after filling a buffer
+FORCE_INLINE VOID ClobberMemory()
+{
+	__asm__ __volatile__("" : : : "memory");
+}
+
+/**
+ * StartBenchPool - Start pool with exactly participants threads, the caller included
+ *
+ * One participant leaves the pool unstarted, so every spawn runs inline on
+ * the caller: the single-thread baseline of a thread-count sweep.
+ *
+ * @return FALSE if not every requested worker started (the pool is left stopped)
+ */
+inline BOOL StartBenchPool(ThreadPool &pool, UINT32 participants)
+{
+	if (participants <= 1)
+		return TRUE;
+	if (!pool.Start(participants - 1))
+		return FALSE;
+	if (pool.GetParticipantCount() == participants)
+		return TRUE;
+	pool.Stop();
+	return FALSE;
+}
+
+typedef struct _BENCH_RESULT
+{
+	USIZE Iterations;  // Iterations per sample
+	UINT32 Samples;
+	UINT64 MinimumPs;  // Per-iteration times in picoseconds
+	UINT64 MedianPs;
+	UINT64 P99Ps;
+	UINT64 MeanPs;
+} BENCH_RESULT, *PBENCH_RESULT;
+
+class Bench
+{
+private:
+	UINT64 sampleNs;
+	UINT64 warmupNs;
+	UINT32 sampleCount;
+	UINT32 failures;
+
+	// Nanoseconds taken by one batch
+	template <typename Routine>
+	static UINT64 TimeBatch(Routine &routine, USIZE iterations)
+	{
+		UINT64 start = Timer::ReadCyclesOrdered();
+		routine(iterations);
+		UINT64 end = Timer::ReadCyclesOrdered();
+		return Timer::CyclesToNanoseconds(end - start);
+	}
+
+	// Sort samples and reduce them to per-iteration statistics
+	static VOID Summarize(PUINT64 samples, UINT32 count, USIZE iterations, BENCH_RESULT &result)
+	{
+		for (UINT32 i = 1; i < count; i++)
+		{
+			UINT64 value = samples[i];
+			UINT32 j = i;
+			for (; j > 0 && samples[j - 1] > value; j--)
+				samples[j] = samples[j - 1];
+			samples[j] = value;
+		}
+
+		UINT64 total;
+		for (UINT32 i = 0; i < count; i++)
+			total += samples[i];
+
+		UINT64 divisor = (UINT64)iterations;
+		UINT32 p99 = (count * 99 + 99) / 100;
+		result.Iterations = iterations;
+		result.Samples = count;
+		result.MinimumPs = samples[0] * 1000U / divisor;
+		result.MedianPs = samples[count / 2] * 1000U / divisor;
+		result.P99Ps = samples[(p99 > 0 ? p99 : 1) - 1] * 1000U / divisor;
+		result.MeanPs = total * 1000U / (divisor * count);
+	}
+
+	// Picoseconds as nanoseconds with three decimals
+	static VOID SplitNanoseconds(UINT64 picoseconds, unsigned long long &whole, UINT32 &fraction)
+	{
+		whole = (unsigned long long)(picoseconds / 1000U);
+		fraction = (picoseconds % 1000U).Low();
+	}
+
+public:
+	Bench() : sampleNs(UINT64(500000U)), warmupNs(UINT64(20000000U)), sampleCount(100), failures(0) {}
+
+	// Target duration of one timed batch
+	VOID SetSampleTime(UINT64 nanoseconds) { sampleNs = nanoseconds; }
+	VOID SetWarmupTime(UINT64 nanoseconds) { warmupNs = nanoseconds; }
+	VOID SetSampleCount(UINT32 count) { sampleCount = count == 0 ? 1 : (count > BENCH_MAX_SAMPLES ? BENCH_MAX_SAMPLES : count); }
+
+	// Benchmarks that could not set up their inputs
+	UINT32 GetFailureCount() const { return failures; }
+
+	// Report a benchmark that could not run, keeping the output complete
+	VOID Skip(const WCHAR *name)
+	{
+		failures++;
+		Console::WriteFormatted<WCHAR>(L"{\"name\":\"%ls\",\"error\":\"setup failed\"}\n"_embed, name);
+	}
+
+	template <typename Routine>
+	BENCH_RESULT Run(const WCHAR *name, Routine &routine, USIZE bytesPerIteration = 0)
+	{
+		// Scale the batch up until it fills a sample
+		USIZE iterations = 1;
+		while (iterations < BENCH_MAX_ITERATIONS && TimeBatch(routine, iterations) < sampleNs)
+			iterations <<= 1;
+
+		UINT64 warmupStart = Timer::GetNanoseconds();
+		while (Timer::GetNanoseconds() - warmupStart < warmupNs)
+			routine(iterations);
+
+		UINT64 samples[BENCH_MAX_SAMPLES];
+		for (UINT32 i = 0; i < sampleCount; i++)
+			samples[i] = TimeBatch(routine, iterations);
+
+		BENCH_RESULT result;
+		Summarize(samples, sampleCount, iterations, result);
+		Report(name, result, bytesPerIteration);
+		return result;
+	}
+
+	static VOID Report(const WCHAR *name, const BENCH_RESULT &result, USIZE bytesPerIteration)
+	{
+		unsigned long long minimum, median, p99, mean;
+		UINT32 minimumFraction, medianFraction, p99Fraction, meanFraction;
+		SplitNanoseconds(result.MinimumPs, minimum, minimumFraction);
+		SplitNanoseconds(result.MedianPs, median, medianFraction);
+		SplitNanoseconds(result.P99Ps, p99, p99Fraction);
+		SplitNanoseconds(result.MeanPs, mean, meanFraction);
+
+		// bytes / median: bytes * 10^12 / ps is bytes per second, / 10^6 for MB
+		unsigned long long throughput = 0;
+		if (bytesPerIteration != 0 && result.MedianPs != 0)
+			throughput = (unsigned long long)(UINT64((UINT64)bytesPerIteration) * 1000000U / result.MedianPs);
+
+		Console::WriteFormatted<WCHAR>(
+			L"{\"name\":\"%ls\",\"iterations\":%llu,\"samples\":%u,\"min_ns\":%llu.%03u,\"median_ns\":%llu.%03u,\"p99_ns\":%llu.%03u,\"mean_ns\":%llu.%03u,\"mb_per_s\":%llu}\n"_embed,
+			name, (unsigned long long)result.Iterations, result.Samples,
+			minimum, minimumFraction, median, medianFraction, p99, p99Fraction, mean, meanFraction, throughput);
+	}
+};
@@ -0,0 +1,75 @@
+/**
+ * benchmarks.h - Unified Benchmark Suite Header
+ *
+ * Entry point of the BENCH build: start.cc calls Benchmarks::RunAll
+ * instead of the test suites, so the numbers come from the same blob,
+ * layout and relocation path that ships.
+ *
+ * BENCHMARK SUITES:
+ *   TimerBenchmarks       - Timestamp and histogram recording costs
+ *   SyncBenchmarks        - Atomic, SpinLock and Mutex, uncontended and at 1 to 64 threads
+ *   ThreadPoolBenchmarks  - ParallelFor grains and fork/join on 0, 1, 2, 4 ... N workers
+ *   QueueBenchmarks       - SPSC/MPMC push/pop, batches and 1x1 to 4x4 producer/consumer transfer
+ *   CoroutineBenchmarks   - Child task await and executor yield round trips
+ *   IoBenchmarks          - Sync vs async reads (64 KB, 64 MB sequential, random 4 KB), writes, mapped scan
+ *   Lz4Benchmarks         - LZ4 block compression and decompression throughput
+ *   EncodingBenchmarks    - Base64 and hex encode/decode throughput, CHAR and WCHAR
+ *   ChecksumBenchmarks    - CRC32C and XXH64 throughput at 4 KB, 1 MB and 1 GB
+ *   ShaBenchmarks         - SHA-256 (instructions and portable) and SHA-1 cycles per byte
+ *   VectorBenchmarks      - Vector push throughput: growth, reserved, arena, inline
+ *   HashMapBenchmarks     - HashMap insert, hit and miss lookup rates
+ *   BasicStringBenchmarks - BasicString short builds, formatting and appends
+ *   StringBenchmarks      - IndexOf, Compare, EqualsIgnoreCase and UTF-8/UTF-16 transcoding over 4 MB of text
+ *   SortBenchmarks        - Sort, RadixSort and LowerBound on 1M elements
+ *
+ * OUTPUT:
+ *   One JSON object per line (see bench.h); lines that do not start with
+ *   '{' are progress messages and can be filtered out.
+ */
+
+#pragma once
+
+#include "bench.h"
+#include "timer_benchmarks.h"
+#include "sync_benchmarks.h"
+#include "thread_pool_benchmarks.h"
+#include "queue_benchmarks.h"
+#include "coroutine_benchmarks.h"
+#include "io_benchmarks.h"
+#include "lz4_benchmarks.h"
+#include "encoding_benchmarks.h"
+#include "checksum_benchmarks.h"
+#include "sha_benchmarks.h"
+#include "vector_benchmarks.h"
+#include "hash_map_benchmarks.h"
+#include "basic_string_benchmarks.h"
+#include "string_benchmarks.h"
+#include "sort_benchmarks.h"
+
+class Benchmarks
+{
+public:
+	// FALSE if any benchmark could not set up its inputs
+	static BOOL RunAll()
+	{
+		Bench bench;
+
+		TimerBenchmarks::RunAll(bench);
+		QueueBenchmarks::RunAll(bench);
+		CoroutineBenchmarks::RunAll(bench);
+		IoBenchmarks::RunAll(bench);
+		Lz4Benchmarks::RunAll(bench);
+		EncodingBenchmarks::RunAll(bench);
+		ChecksumBenchmarks::RunAll(bench);
+		ShaBenchmarks::RunAll(bench);
+		VectorBenchmarks::RunAll(bench);
+		HashMapBenchmarks::RunAll(bench);
+		BasicStringBenchmarks::RunAll(bench);
+		StringBenchmarks::RunAll(bench);
+		SortBenchmarks::RunAll(bench);
+		SyncBenchmarks::RunAll(bench);
+		ThreadPoolBenchmarks::RunAll(bench);
+
+		return bench.GetFailureCount() == 0;
+	}
+};
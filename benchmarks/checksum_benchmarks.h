@@ -0,0 +1,77 @@
+#pragma once
+
+#include "bench.h"
+
+class ChecksumBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// 4 KB stays in L1, 1 MB in L2/L3; both run the same buffer again every iteration
+		PUINT8 buffer = new UINT8[MediumSize];
+		if (buffer != NULL)
+		{
+			Fill(buffer, MediumSize);
+			RunSize(bench, buffer, SmallSize, L"checksum.crc32c_4k"_embed, L"checksum.xxh64_4k"_embed);
+			RunSize(bench, buffer, MediumSize, L"checksum.crc32c_1m"_embed, L"checksum.xxh64_1m"_embed);
+			delete[] buffer;
+		}
+		else
+		{
+			bench.Skip(L"checksum.crc32c_4k"_embed);
+			bench.Skip(L"checksum.xxh64_4k"_embed);
+			bench.Skip(L"checksum.crc32c_1m"_embed);
+			bench.Skip(L"checksum.xxh64_1m"_embed);
+		}
+
+		// 1 GB streams from memory; one iteration takes long enough that a few samples do
+		PUINT8 large = new UINT8[LargeSize];
+		if (large != NULL)
+		{
+			Fill(large, LargeSize);
+			bench.SetSampleCount(LargeSamples);
+			RunSize(bench, large, LargeSize, L"checksum.crc32c_1g"_embed, L"checksum.xxh64_1g"_embed);
+			bench.SetSampleCount(DefaultSamples);
+			delete[] large;
+		}
+		else
+		{
+			bench.Skip(L"checksum.crc32c_1g"_embed);
+			bench.Skip(L"checksum.xxh64_1g"_embed);
+		}
+	}
+
+private:
+	static constexpr USIZE SmallSize = 4 * 1024;
+	static constexpr USIZE MediumSize = 1024 * 1024;
+	static constexpr USIZE LargeSize = 1024 * 1024 * 1024;
+	static constexpr UINT32 LargeSamples = 5;
+	static constexpr UINT32 DefaultSamples = 100;
+
+	static VOID Fill(PUINT8 data, USIZE size)
+	{
+		UINT32 state = 0x85EBCA6B;
+		for (USIZE i = 0; i < size; i++)
+		{
+			state = state * 1664525 + 1013904223;
+			data[i] = (UINT8)(state >> 24);
+		}
+	}
+
+	static VOID RunSize(Bench &bench, const UINT8 *data, USIZE size, const WCHAR *crcName, const WCHAR *hashName)
+	{
+		auto crc32c = [data, size](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(Crc32c::Compute(data, size));
+		};
+		bench.Run(crcName, crc32c, size);
+
+		auto xxh64 = [data, size](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(XxHash64::Compute(data, size));
+		};
+		bench.Run(hashName, xxh64, size);
+	}
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "bench.h"
+
+class CoroutineBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// Each iteration creates, awaits and destroys one child task
+		auto awaitChild = [](USIZE iterations)
+		{
+			Executor executor;
+			Task<USIZE> task = AwaitLoop(iterations);
+			executor.Spawn(task);
+			executor.Run();
+			DoNotOptimize(task.GetResult());
+		};
+		BENCH_RUN(bench, L"coroutine.await", awaitChild);
+
+		// Each iteration suspends to the executor's ready queue and is resumed
+		auto yieldResume = [](USIZE iterations)
+		{
+			Executor executor;
+			Task<USIZE> task = YieldLoop(iterations);
+			executor.Spawn(task);
+			executor.Run();
+			DoNotOptimize(task.GetResult());
+		};
+		BENCH_RUN(bench, L"coroutine.yield", yieldResume);
+	}
+
+private:
+	static Task<USIZE> Constant(USIZE value)
+	{
+		co_return value;
+	}
+
+	static Task<USIZE> AwaitLoop(USIZE count)
+	{
+		USIZE total = 0;
+		for (USIZE i = 0; i < count; i++)
+			total += co_await Constant(i);
+		co_return total;
+	}
+
+	static Task<USIZE> YieldLoop(USIZE count)
+	{
+		for (USIZE i = 0; i < count; i++)
+			co_await Executor::Yield();
+		co_return count;
+	}
+};
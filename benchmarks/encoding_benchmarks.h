@@ -0,0 +1,86 @@
+#pragma once
+
+#include "bench.h"
+
+class EncodingBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		PUINT8 source = new UINT8[DataSize];
+		PUINT8 decoded = new UINT8[DataSize];
+		PCHAR text = new CHAR[TextCapacity];
+		PWCHAR wide = new WCHAR[TextCapacity];
+
+		UINT32 state = 0x6C078965;
+		for (USIZE i = 0; i < DataSize; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			source[i] = (UINT8)(state >> 24);
+		}
+
+		// Throughput is counted in bytes on the binary side for both directions
+		auto base64Encode = [source, text](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Base64::Encode(source, DataSize, text, TextCapacity);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.base64_encode_64k", DataSize, base64Encode);
+
+		SSIZE length = Base64::Encode(source, DataSize, text, TextCapacity);
+		auto base64Decode = [text, length, decoded](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Base64::Decode(text, (USIZE)length, decoded, DataSize);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.base64_decode_64k", DataSize, base64Decode);
+
+		auto base64EncodeWide = [source, wide](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Base64::Encode(source, DataSize, wide, TextCapacity);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.base64_encode_wide_64k", DataSize, base64EncodeWide);
+
+		length = Base64::Encode(source, DataSize, wide, TextCapacity);
+		auto base64DecodeWide = [wide, length, decoded](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Base64::Decode(wide, (USIZE)length, decoded, DataSize);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.base64_decode_wide_64k", DataSize, base64DecodeWide);
+
+		auto hexEncode = [source, text](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Hex::Encode(source, DataSize, text, TextCapacity);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.hex_encode_64k", DataSize, hexEncode);
+
+		length = Hex::Encode(source, DataSize, text, TextCapacity);
+		auto hexDecode = [text, length, decoded](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Hex::Decode(text, (USIZE)length, decoded, DataSize);
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"encoding.hex_decode_64k", DataSize, hexDecode);
+
+		delete[] wide;
+		delete[] text;
+		delete[] decoded;
+		delete[] source;
+	}
+
+private:
+	static constexpr USIZE DataSize = 64 * 1024;
+	// Hex is the longer encoding, plus the terminator
+	static constexpr USIZE TextCapacity = DataSize * 2 + 1;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "bench.h"
+
+class HashMapBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// Growing from empty: every doubling moves the entries by their stored hash
+		auto insert = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				HashMap<UINT32, UINT32> map;
+				for (UINT32 j = 0; j < LargeCount; j++)
+					map.Insert(j * KeyStride, j);
+				DoNotOptimize(map.GetSize());
+			}
+		};
+		bench.Run(L"hash_map.insert_1m"_embed, insert, LargeCount * sizeof(UINT32));
+
+		auto insertReserved = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				HashMap<UINT32, UINT32> map;
+				map.Reserve(LargeCount);
+				for (UINT32 j = 0; j < LargeCount; j++)
+					map.Insert(j * KeyStride, j);
+				DoNotOptimize(map.GetSize());
+			}
+		};
+		bench.Run(L"hash_map.insert_reserved_1m"_embed, insertReserved, LargeCount * sizeof(UINT32));
+
+		HashMap<UINT32, UINT32> map;
+		for (UINT32 j = 0; j < LargeCount; j++)
+			map.Insert(j * KeyStride, j);
+
+		// Present keys: usually one control-byte match in the home group
+		auto findHit = [&map](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				UINT32 sum = 0;
+				for (UINT32 j = 0; j < LargeCount; j++)
+					sum += *map.Find(j * KeyStride);
+				DoNotOptimize(sum);
+			}
+		};
+		bench.Run(L"hash_map.find_hit_1m"_embed, findHit, LargeCount * sizeof(UINT32));
+
+		// Absent keys: settled by the control bytes, rarely touching a key
+		auto findMiss = [&map](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				UINT32 found = 0;
+				for (UINT32 j = 0; j < LargeCount; j++)
+					found += map.Contains(j * KeyStride + 1) ? 1 : 0;
+				DoNotOptimize(found);
+			}
+		};
+		bench.Run(L"hash_map.find_miss_1m"_embed, findMiss, LargeCount * sizeof(UINT32));
+
+		// The API cache shape: a few dozen entries keyed by precomputed name hashes
+		HashMap<USIZE, USIZE> small;
+		for (UINT32 j = 0; j < SmallCount; j++)
+			small.Insert(Mix(j), j, Mix(j));
+		auto findSmall = [&small](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				USIZE sum = 0;
+				for (UINT32 j = 0; j < SmallCount; j++)
+				{
+					USIZE hash = Mix(j);
+					sum += *small.Find(hash, hash);
+				}
+				DoNotOptimize(sum);
+			}
+		};
+		bench.Run(L"hash_map.find_small_32"_embed, findSmall, SmallCount * sizeof(USIZE));
+	}
+
+private:
+	static constexpr UINT32 LargeCount = 1024 * 1024;
+	static constexpr UINT32 SmallCount = 32;
+	static constexpr UINT32 KeyStride = 2;
+
+	// Stand-in for a Djb2 name hash
+	static USIZE Mix(UINT32 value) { return (USIZE)value * 0x01000193U ^ 0x811C9DC5U; }
+};
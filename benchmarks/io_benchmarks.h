@@ -0,0 +1,327 @@
+#pragma once
+
+#include "bench.h"
+
+class IoBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		if (!WriteScratchFile(L"bench_io.tmp"_embed, FileSize))
+		{
+			bench.Skip(L"io"_embed);
+			return;
+		}
+
+		PUINT8 buffer = new UINT8[LargeWindow * LargeChunkSize];
+		ASYNC_REQUEST *requests = new ASYNC_REQUEST[RandomCount];
+		PUINT32 offsets = new UINT32[RandomCount];
+		if (buffer == NULL || requests == NULL || offsets == NULL)
+		{
+			bench.Skip(L"io"_embed);
+			delete[] offsets;
+			delete[] requests;
+			delete[] buffer;
+			DeleteScratchFile(L"bench_io.tmp"_embed);
+			return;
+		}
+
+		// Synchronous reads: one system call per chunk, issued back to back
+		File file;
+		if (file.Open(L"bench_io.tmp"_embed, FILE_MODE_READ | FILE_MODE_SEQUENTIAL))
+		{
+			auto syncRead = [&file, buffer](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					file.Seek(UINT64());
+					for (USIZE offset = 0; offset < FileSize; offset += ChunkSize)
+						file.Read(buffer + offset, ChunkSize);
+				}
+				DoNotOptimize(buffer[0]);
+			};
+			BENCH_RUN_BYTES(bench, L"io.file.read_64k", FileSize, syncRead);
+			file.Close();
+		}
+		else
+		{
+			bench.Skip(L"io.file.read_64k"_embed);
+		}
+
+		// The same chunks queued together and submitted as one batch
+		AsyncIo io;
+		PVOID asyncFile = io.Create() ? io.OpenFile(L"bench_io.tmp"_embed, ASYNC_FILE_READ) : NULL;
+		if (asyncFile != NULL)
+		{
+			auto asyncRead = [&io, asyncFile, requests, buffer](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					for (USIZE chunk = 0; chunk < ChunkCount; chunk++)
+					{
+						AsyncIo::PrepareRead(requests[chunk], asyncFile, buffer + chunk * ChunkSize, ChunkSize, UINT64((UINT32)(chunk * ChunkSize)), NULL);
+						io.Queue(&requests[chunk]);
+					}
+					io.Submit();
+					Drain(io, ChunkCount);
+				}
+				DoNotOptimize(buffer[0]);
+			};
+			BENCH_RUN_BYTES(bench, L"io.async.read_64k", FileSize, asyncRead);
+			AsyncIo::CloseFile(asyncFile);
+		}
+		else
+		{
+			bench.Skip(L"io.async.read_64k"_embed);
+		}
+
+		// Writes of the same chunks: a synchronous loop against one batched submission
+		if (file.Open(L"bench_io_write.tmp"_embed, FILE_MODE_WRITE | FILE_MODE_CREATE))
+		{
+			auto syncWrite = [&file, buffer](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					file.Seek(UINT64());
+					for (USIZE offset = 0; offset < FileSize; offset += ChunkSize)
+						file.Write(buffer + offset, ChunkSize);
+				}
+			};
+			BENCH_RUN_BYTES(bench, L"io.file.write_64k", FileSize, syncWrite);
+			file.Close();
+		}
+		else
+		{
+			bench.Skip(L"io.file.write_64k"_embed);
+		}
+
+		asyncFile = io.IsCreated() ? io.OpenFile(L"bench_io_write.tmp"_embed, ASYNC_FILE_WRITE | ASYNC_FILE_CREATE) : NULL;
+		if (asyncFile != NULL)
+		{
+			auto asyncWrite = [&io, asyncFile, requests, buffer](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					for (USIZE chunk = 0; chunk < ChunkCount; chunk++)
+					{
+						AsyncIo::PrepareWrite(requests[chunk], asyncFile, buffer + chunk * ChunkSize, ChunkSize, UINT64((UINT32)(chunk * ChunkSize)), NULL);
+						io.Queue(&requests[chunk]);
+					}
+					io.Submit();
+					Drain(io, ChunkCount);
+				}
+			};
+			BENCH_RUN_BYTES(bench, L"io.async.write_64k", FileSize, asyncWrite);
+			AsyncIo::CloseFile(asyncFile);
+		}
+		else
+		{
+			bench.Skip(L"io.async.write_64k"_embed);
+		}
+		DeleteScratchFile(L"bench_io_write.tmp"_embed);
+
+		// A mapped view skips the copy into a user buffer entirely
+		MappedFile mapped;
+		if (mapped.Open(L"bench_io.tmp"_embed, MappedView::ReadOnly, MappedAccess::Sequential))
+		{
+			auto mappedScan = [&mapped](USIZE iterations)
+			{
+				const USIZE *words = (const USIZE *)mapped.GetData();
+				USIZE sum = 0;
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					for (USIZE w = 0; w < FileSize / sizeof(USIZE); w++)
+						sum += words[w];
+				}
+				DoNotOptimize(sum);
+			};
+			BENCH_RUN_BYTES(bench, L"io.mapped.scan", FileSize, mappedScan);
+			mapped.Close();
+		}
+		else
+		{
+			bench.Skip(L"io.mapped.scan"_embed);
+		}
+		DeleteScratchFile(L"bench_io.tmp"_embed);
+
+		if (WriteScratchFile(L"bench_io_large.tmp"_embed, LargeFileSize))
+		{
+			RunLarge(bench, io, buffer, requests, offsets);
+		}
+		else
+		{
+			bench.Skip(L"io.large"_embed);
+		}
+		DeleteScratchFile(L"bench_io_large.tmp"_embed);
+
+		delete[] offsets;
+		delete[] requests;
+		delete[] buffer;
+	}
+
+private:
+	static constexpr USIZE FileSize = 1024 * 1024;
+	static constexpr UINT32 ChunkSize = 64 * 1024;
+	static constexpr USIZE ChunkCount = FileSize / ChunkSize;
+	static_assert(ChunkCount <= ASYNC_IO_QUEUE_DEPTH, "All chunks must fit one submission");
+
+	// Large sequential workload: 1 MB chunks, at most LargeWindow of them in flight
+	static constexpr USIZE LargeFileSize = 64 * 1024 * 1024;
+	static constexpr UINT32 LargeChunkSize = 1024 * 1024;
+	static constexpr USIZE LargeChunkCount = LargeFileSize / LargeChunkSize;
+	static constexpr USIZE LargeWindow = 16;
+	static_assert(LargeWindow <= ASYNC_IO_QUEUE_DEPTH, "The window must fit one submission");
+	static_assert(LargeWindow * LargeChunkSize >= FileSize, "The buffer also holds the small file");
+
+	// Random workload: page-sized reads at RandomCount fixed random offsets of the large file
+	static constexpr UINT32 RandomReadSize = 4096;
+	static constexpr USIZE RandomCount = 256;
+	static_assert(RandomCount >= ChunkCount, "The request array also serves the small file");
+
+	static VOID RunLarge(Bench &bench, AsyncIo &io, PUINT8 buffer, ASYNC_REQUEST *requests, PUINT32 offsets)
+	{
+		UINT32 state = 0x6C8E9CF5;
+		for (USIZE i = 0; i < RandomCount; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			offsets[i] = (state % (LargeFileSize / RandomReadSize)) * RandomReadSize;
+		}
+
+		File file;
+		if (file.Open(L"bench_io_large.tmp"_embed, FILE_MODE_READ))
+		{
+			auto syncLarge = [&file, buffer](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					file.Seek(UINT64());
+					for (USIZE chunk = 0; chunk < LargeChunkCount; chunk++)
+						file.Read(buffer + (chunk % LargeWindow) * LargeChunkSize, LargeChunkSize);
+				}
+				DoNotOptimize(buffer[0]);
+			};
+			BENCH_RUN_BYTES(bench, L"io.file.read_large_1m", LargeFileSize, syncLarge);
+
+			auto syncRandom = [&file, buffer, offsets](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					for (USIZE read = 0; read < RandomCount; read++)
+					{
+						file.Seek(UINT64(offsets[read]));
+						file.Read(buffer + read * RandomReadSize, RandomReadSize);
+					}
+				}
+				DoNotOptimize(buffer[0]);
+			};
+			BENCH_RUN_BYTES(bench, L"io.file.read_random_4k", RandomCount * RandomReadSize, syncRandom);
+			file.Close();
+		}
+		else
+		{
+			bench.Skip(L"io.file.read_large_1m"_embed);
+			bench.Skip(L"io.file.read_random_4k"_embed);
+		}
+
+		PVOID asyncFile = io.IsCreated() ? io.OpenFile(L"bench_io_large.tmp"_embed, ASYNC_FILE_READ) : NULL;
+		if (asyncFile == NULL)
+		{
+			bench.Skip(L"io.async.read_large_1m"_embed);
+			bench.Skip(L"io.async.read_random_4k"_embed);
+			return;
+		}
+
+		// A finished chunk's request slot and buffer are refilled with the next chunk right away
+		auto asyncLarge = [&io, asyncFile, requests, buffer](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				USIZE issued = 0;
+				for (; issued < LargeWindow; issued++)
+					QueueLargeChunk(io, asyncFile, requests, buffer, issued, issued);
+				io.Submit();
+
+				PASYNC_REQUEST completed[ASYNC_IO_REAP_BATCH];
+				for (USIZE done = 0; done < LargeChunkCount;)
+				{
+					USIZE reaped = io.Poll(completed, ASYNC_IO_REAP_BATCH, TRUE);
+					if (reaped == 0)
+						return;
+					done += reaped;
+					for (USIZE r = 0; r < reaped && issued < LargeChunkCount; r++, issued++)
+						QueueLargeChunk(io, asyncFile, requests, buffer, (USIZE)(completed[r] - requests), issued);
+					io.Submit();
+				}
+			}
+			DoNotOptimize(buffer[0]);
+		};
+		BENCH_RUN_BYTES(bench, L"io.async.read_large_1m", LargeFileSize, asyncLarge);
+
+		// Every random read is queued; a full submission queue is submitted and refilled
+		auto asyncRandom = [&io, asyncFile, requests, buffer, offsets](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				for (USIZE read = 0; read < RandomCount; read++)
+				{
+					AsyncIo::PrepareRead(requests[read], asyncFile, buffer + read * RandomReadSize, RandomReadSize, UINT64(offsets[read]), NULL);
+					if (!io.Queue(&requests[read]))
+					{
+						io.Submit();
+						io.Queue(&requests[read]);
+					}
+				}
+				io.Submit();
+				Drain(io, RandomCount);
+			}
+			DoNotOptimize(buffer[0]);
+		};
+		BENCH_RUN_BYTES(bench, L"io.async.read_random_4k", RandomCount * RandomReadSize, asyncRandom);
+		AsyncIo::CloseFile(asyncFile);
+	}
+
+	static VOID QueueLargeChunk(AsyncIo &io, PVOID file, ASYNC_REQUEST *requests, PUINT8 buffer, USIZE slot, USIZE chunk)
+	{
+		AsyncIo::PrepareRead(requests[slot], file, buffer + slot * LargeChunkSize, LargeChunkSize, UINT64((UINT32)(chunk * LargeChunkSize)), NULL);
+		io.Queue(&requests[slot]);
+	}
+
+	static BOOL WriteScratchFile(const WCHAR *path, USIZE size)
+	{
+		File file;
+		if (!file.Open(path, FILE_MODE_WRITE | FILE_MODE_CREATE))
+			return FALSE;
+
+		BufferedWriter writer(file);
+		if (!writer.IsValid())
+			return FALSE;
+		for (USIZE i = 0; i < size / sizeof(USIZE); i++)
+		{
+			USIZE value = i * 2654435761U;
+			if (!writer.Write(&value, sizeof(value)))
+				return FALSE;
+		}
+		return writer.Flush();
+	}
+
+	// Opening with FILE_MODE_TEMPORARY deletes the file once the handle closes
+	static VOID DeleteScratchFile(const WCHAR *path)
+	{
+		File file;
+		file.Open(path, FILE_MODE_READ | FILE_MODE_TEMPORARY);
+	}
+
+	static VOID Drain(AsyncIo &io, USIZE count)
+	{
+		PASYNC_REQUEST completed[ASYNC_IO_REAP_BATCH];
+		while (count > 0)
+		{
+			USIZE reaped = io.Poll(completed, ASYNC_IO_REAP_BATCH, TRUE);
+			if (reaped == 0)
+				return;
+			count -= reaped;
+		}
+	}
+};
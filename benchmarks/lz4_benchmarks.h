@@ -0,0 +1,89 @@
+#pragma once
+
+#include "bench.h"
+
+class Lz4Benchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		PUINT8 source = new UINT8[DataSize];
+		PUINT8 packed = new UINT8[Lz4::GetCompressBound(DataSize)];
+		PUINT8 unpacked = new UINT8[DataSize];
+		FillMixed(source);
+
+		// Hash table from the thread's scratch arena
+		auto compress = [source, packed](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Lz4::Compress(source, DataSize, packed, Lz4::GetCompressBound(DataSize));
+			ClobberMemory();
+		};
+		BENCH_RUN_BYTES(bench, L"lz4.compress_64k", DataSize, compress);
+
+		SSIZE packedSize = Lz4::Compress(source, DataSize, packed, Lz4::GetCompressBound(DataSize));
+		if (packedSize > 0 && Lz4::Decompress(packed, (USIZE)packedSize, unpacked, DataSize) == (SSIZE)DataSize)
+		{
+			auto decompress = [packed, packedSize, unpacked](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+					Lz4::Decompress(packed, (USIZE)packedSize, unpacked, DataSize);
+				ClobberMemory();
+			};
+			BENCH_RUN_BYTES(bench, L"lz4.decompress_64k", DataSize, decompress);
+		}
+		else
+		{
+			bench.Skip(L"lz4.decompress_64k"_embed);
+		}
+
+		// Short-period runs take the overlapping match path
+		for (USIZE i = 0; i < DataSize; i++)
+			source[i] = (UINT8)('a' + i % 3);
+		packedSize = Lz4::Compress(source, DataSize, packed, Lz4::GetCompressBound(DataSize));
+		if (packedSize > 0)
+		{
+			auto decompressRun = [packed, packedSize, unpacked](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+					Lz4::Decompress(packed, (USIZE)packedSize, unpacked, DataSize);
+				ClobberMemory();
+			};
+			BENCH_RUN_BYTES(bench, L"lz4.decompress_run_64k", DataSize, decompressRun);
+		}
+		else
+		{
+			bench.Skip(L"lz4.decompress_run_64k"_embed);
+		}
+
+		delete[] unpacked;
+		delete[] packed;
+		delete[] source;
+	}
+
+private:
+	static constexpr USIZE DataSize = 64 * 1024;
+
+	// Random letters mixed with repeats of earlier spans; packs to roughly half
+	static VOID FillMixed(PUINT8 data)
+	{
+		UINT32 state = 0x9E3779B9;
+		USIZE i = 0;
+		while (i < DataSize)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			if (i >= 64 && (state & 3) == 0)
+			{
+				USIZE from = (state >> 8) % (i - 32);
+				for (USIZE length = 8 + (state >> 2) % 32; length > 0 && i < DataSize; length--)
+					data[i++] = data[from++];
+			}
+			else
+			{
+				data[i++] = (UINT8)('a' + (state >> 24) % 26);
+			}
+		}
+	}
+};
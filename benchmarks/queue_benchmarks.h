@@ -0,0 +1,183 @@
+#pragma once
+
+#include "bench.h"
+
+class QueueBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		SpscQueue<USIZE, QueueCapacity> *spsc = new SpscQueue<USIZE, QueueCapacity>();
+		MpmcQueue<USIZE, QueueCapacity> *mpmc = new MpmcQueue<USIZE, QueueCapacity>();
+		if (spsc == NULL || mpmc == NULL)
+		{
+			bench.Skip(L"queue"_embed);
+			delete spsc;
+			delete mpmc;
+			return;
+		}
+
+		// Single-thread push/pop pairs: the uncontended cost of one item
+		RunPushPop(bench, *spsc, L"queue.spsc.push_pop"_embed);
+		RunPushPop(bench, *mpmc, L"queue.mpmc.push_pop"_embed);
+		RunBatch(bench, *spsc, L"queue.spsc.batch_32"_embed);
+		RunBatch(bench, *mpmc, L"queue.mpmc.batch_32"_embed);
+
+		// Cross-thread throughput: producers x consumers, all started before timing
+		RunTransfer(bench, *spsc, 1, 1, L"queue.spsc.transfer_1x1"_embed);
+		RunTransfer(bench, *mpmc, 1, 1, L"queue.mpmc.transfer_1x1"_embed);
+		RunTransfer(bench, *mpmc, 2, 2, L"queue.mpmc.transfer_2x2"_embed);
+		RunTransfer(bench, *mpmc, 4, 4, L"queue.mpmc.transfer_4x4"_embed);
+
+		delete spsc;
+		delete mpmc;
+	}
+
+private:
+	static constexpr USIZE QueueCapacity = 1024;
+	static constexpr USIZE BatchSize = 32;
+	// Items per transfer iteration
+	static constexpr USIZE TransferBlock = 4096;
+	// Items a producer claims, and a consumer counts, per shared counter update
+	static constexpr USIZE TransferChunk = 64;
+	static constexpr USIZE MaxTransferThreads = 8;
+
+	// Shared by the transfer threads, which outlive every timed batch
+	template <typename TQueue>
+	struct TRANSFER
+	{
+		TQueue *Queue;
+		Atomic<USIZE> Remaining; // Items of the current batch not yet claimed by a producer
+		Atomic<USIZE> Consumed;  // Items of the current batch popped so far
+		Atomic<BOOL> Stopping;
+	};
+
+	template <typename TQueue>
+	static INT32 Producer(PVOID parameter)
+	{
+		TRANSFER<TQueue> *transfer = (TRANSFER<TQueue> *)parameter;
+		while (!transfer->Stopping.Load(MemoryOrder::Acquire))
+		{
+			USIZE remaining = transfer->Remaining.Load(MemoryOrder::Acquire);
+			if (remaining == 0)
+			{
+				Thread::Yield();
+				continue;
+			}
+			USIZE take = remaining < TransferChunk ? remaining : TransferChunk;
+			if (!transfer->Remaining.CompareExchangeWeak(remaining, remaining - take))
+				continue;
+			for (USIZE i = 0; i < take; i++)
+			{
+				while (!transfer->Queue->TryPush(i))
+					Thread::Yield();
+			}
+		}
+		return 0;
+	}
+
+	template <typename TQueue>
+	static INT32 Consumer(PVOID parameter)
+	{
+		TRANSFER<TQueue> *transfer = (TRANSFER<TQueue> *)parameter;
+		USIZE item = 0;
+		USIZE counted = 0;
+		while (!transfer->Stopping.Load(MemoryOrder::Acquire))
+		{
+			if (transfer->Queue->TryPop(item))
+			{
+				if (++counted == TransferChunk)
+				{
+					transfer->Consumed.FetchAdd(counted, MemoryOrder::Release);
+					counted = 0;
+				}
+				continue;
+			}
+			// Empty: publish what was popped so the batch can finish
+			if (counted != 0)
+			{
+				transfer->Consumed.FetchAdd(counted, MemoryOrder::Release);
+				counted = 0;
+			}
+			Thread::Yield();
+		}
+		DoNotOptimize(item);
+		return 0;
+	}
+
+	template <typename TQueue>
+	static VOID RunPushPop(Bench &bench, TQueue &queue, const WCHAR *name)
+	{
+		auto pushPop = [&queue](USIZE iterations)
+		{
+			USIZE item = 0;
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				queue.TryPush(i);
+				queue.TryPop(item);
+			}
+			DoNotOptimize(item);
+		};
+		bench.Run(name, pushPop);
+	}
+
+	// One iteration moves BatchSize items in and out with a single index update each way
+	template <typename TQueue>
+	static VOID RunBatch(Bench &bench, TQueue &queue, const WCHAR *name)
+	{
+		USIZE items[BatchSize];
+		for (USIZE i = 0; i < BatchSize; i++)
+			items[i] = i;
+
+		auto batch = [&queue, &items](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				queue.TryPushBatch(items, BatchSize);
+				queue.TryPopBatch(items, BatchSize);
+			}
+			DoNotOptimize(items);
+		};
+		bench.Run(name, batch, BatchSize * sizeof(USIZE));
+	}
+
+	template <typename TQueue>
+	static VOID RunTransfer(Bench &bench, TQueue &queue, USIZE producers, USIZE consumers, const WCHAR *name)
+	{
+		TRANSFER<TQueue> shared;
+		shared.Queue = &queue;
+		shared.Remaining.Store(0);
+		shared.Consumed.Store(0);
+		shared.Stopping.Store(FALSE);
+
+		Thread threads[MaxTransferThreads];
+		BOOL started = TRUE;
+		for (USIZE i = 0; i < producers + consumers && started; i++)
+			started = threads[i].Create(i < producers ? Producer<TQueue> : Consumer<TQueue>, &shared);
+
+		if (started)
+		{
+			// The benchmark thread only hands out each batch and waits for its last item
+			auto transfer = [&shared](USIZE iterations)
+			{
+				USIZE count = iterations * TransferBlock;
+				shared.Consumed.Store(0, MemoryOrder::Relaxed);
+				shared.Remaining.Store(count, MemoryOrder::Release);
+				while (shared.Consumed.Load(MemoryOrder::Acquire) < count)
+					Thread::Yield();
+			};
+			bench.Run(name, transfer, TransferBlock * sizeof(USIZE));
+		}
+		else
+		{
+			bench.Skip(name);
+		}
+
+		shared.Stopping.Store(TRUE, MemoryOrder::Release);
+		for (USIZE i = 0; i < producers + consumers; i++)
+		{
+			if (threads[i].IsJoinable())
+				threads[i].Join();
+		}
+	}
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "bench.h"
+
+class ShaBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		PUINT8 buffer = new UINT8[LargeSize];
+		for (USIZE i = 0; i < LargeSize; i++)
+			buffer[i] = (UINT8)(i * 131 + (i >> 8));
+
+		// Default path: the SHA instructions where the CPU has them
+		RunSha256(bench, buffer, SmallSize, FALSE, L"sha.sha256_4k"_embed);
+		RunSha256(bench, buffer, LargeSize, FALSE, L"sha.sha256_1m"_embed);
+		RunSha256(bench, buffer, SmallSize, TRUE, L"sha.sha256_portable_4k"_embed);
+		RunSha256(bench, buffer, LargeSize, TRUE, L"sha.sha256_portable_1m"_embed);
+
+		auto sha1 = [buffer](USIZE iterations)
+		{
+			UINT8 digest[SHA1_DIGEST_SIZE];
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Sha1::Compute(buffer, LargeSize, digest);
+				DoNotOptimize(digest);
+			}
+		};
+		ReportCyclesPerByte(L"sha.sha1_1m"_embed, bench.Run(L"sha.sha1_1m"_embed, sha1, LargeSize), LargeSize);
+
+		delete[] buffer;
+	}
+
+private:
+	static constexpr USIZE SmallSize = 4 * 1024;
+	static constexpr USIZE LargeSize = 1024 * 1024;
+
+	static VOID RunSha256(Bench &bench, const UINT8 *data, USIZE size, BOOL portable, const WCHAR *name)
+	{
+		auto sha256 = [data, size, portable](USIZE iterations)
+		{
+			UINT8 digest[SHA256_DIGEST_SIZE];
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Sha256 sha;
+				if (portable)
+					sha.UsePortable();
+				sha.Update(data, size);
+				sha.Final(digest);
+				DoNotOptimize(digest);
+			}
+		};
+		ReportCyclesPerByte(name, bench.Run(name, sha256, size), size);
+	}
+
+	// Extra line with the median in Timer::ReadCycles ticks per byte (the TSC or generic timer,
+	// which need not tick at the core clock)
+	static VOID ReportCyclesPerByte(const WCHAR *name, const BENCH_RESULT &result, USIZE bytesPerIteration)
+	{
+		// ps * MHz / 10^6 is cycles; a further * 1000 / bytes gives thousandths of a cycle per byte
+		UINT32 megahertz = (Timer::GetCycleFrequency() / 1000000U).Low();
+		UINT64 milli = result.MedianPs * megahertz / (UINT64((UINT64)bytesPerIteration) * 1000U);
+		Console::WriteFormatted<WCHAR>(L"{\"name\":\"%ls\",\"cycles_per_byte\":%llu.%03u}\n"_embed,
+									   name, (unsigned long long)(milli / 1000U), (milli % 1000U).Low());
+	}
+};
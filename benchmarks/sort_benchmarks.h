@@ -0,0 +1,136 @@
+#pragma once
+
+#include "bench.h"
+
+class SortBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// Each iteration sorts a fresh copy of the input; the 4 MB copy is a small part of the time
+		PUINT32 random = new UINT32[Count];
+		PUINT32 fewUnique = new UINT32[Count];
+		PUINT32 work = new UINT32[Count];
+		PUINT32 scratch = new UINT32[Count];
+		UINT32 state = 0x3C6EF372;
+		for (UINT32 i = 0; i < Count; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			random[i] = state;
+			fewUnique[i] = state % 16;
+		}
+
+		auto sortRandom = [random, work](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(work, random, Count * sizeof(UINT32));
+				Sort(work, Count);
+				DoNotOptimize(work[0]);
+			}
+		};
+		bench.Run(L"sort.introsort_random_1m"_embed, sortRandom, Count * sizeof(UINT32));
+
+		// Already sorted: the median of three splits evenly every time
+		auto sortSorted = [work](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Sort(work, Count);
+				DoNotOptimize(work[0]);
+			}
+		};
+		bench.Run(L"sort.introsort_sorted_1m"_embed, sortSorted, Count * sizeof(UINT32));
+
+		auto sortFewUnique = [fewUnique, work](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(work, fewUnique, Count * sizeof(UINT32));
+				Sort(work, Count);
+				DoNotOptimize(work[0]);
+			}
+		};
+		bench.Run(L"sort.introsort_16_values_1m"_embed, sortFewUnique, Count * sizeof(UINT32));
+
+		// The depth-limit fallback on its own
+		auto heapSort = [random, work](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(work, random, Count * sizeof(UINT32));
+				HeapSort(work, Count);
+				DoNotOptimize(work[0]);
+			}
+		};
+		bench.Run(L"sort.heapsort_random_1m"_embed, heapSort, Count * sizeof(UINT32));
+
+		auto radixSort = [random, work, scratch](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(work, random, Count * sizeof(UINT32));
+				RadixSort(work, scratch, Count);
+				DoNotOptimize(work[0]);
+			}
+		};
+		bench.Run(L"sort.radix_u32_1m"_embed, radixSort, Count * sizeof(UINT32));
+
+		// Software UINT64 keys: digits from Low() and High(), no 64-bit shifts
+		UINT64 *wideRandom = new UINT64[Count];
+		UINT64 *wideWork = new UINT64[Count];
+		UINT64 *wideScratch = new UINT64[Count];
+		for (UINT32 i = 0; i < Count; i++)
+			wideRandom[i] = UINT64(random[i], random[Count - 1 - i]);
+		auto radixSort64 = [wideRandom, wideWork, wideScratch](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(wideWork, wideRandom, Count * sizeof(UINT64));
+				RadixSort(wideWork, wideScratch, Count);
+				DoNotOptimize(wideWork[0]);
+			}
+		};
+		bench.Run(L"sort.radix_uint64_1m"_embed, radixSort64, Count * sizeof(UINT64));
+
+		auto introSort64 = [wideRandom, wideWork](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Memory::Copy(wideWork, wideRandom, Count * sizeof(UINT64));
+				Sort(wideWork, Count);
+				DoNotOptimize(wideWork[0]);
+			}
+		};
+		bench.Run(L"sort.introsort_uint64_1m"_embed, introSort64, Count * sizeof(UINT64));
+
+		// 1024 lookups of present and absent keys per iteration in a sorted 1M array
+		Memory::Copy(work, random, Count * sizeof(UINT32));
+		RadixSort(work, scratch, Count);
+		auto lowerBound = [random, work](USIZE iterations)
+		{
+			USIZE found = 0;
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				for (UINT32 j = 0; j < Lookups; j++)
+					found += LowerBound((const UINT32 *)work, Count, random[j] + (j & 1));
+			}
+			DoNotOptimize(found);
+		};
+		bench.Run(L"sort.lower_bound_1024_of_1m"_embed, lowerBound, Lookups * sizeof(UINT32));
+
+		delete[] wideScratch;
+		delete[] wideWork;
+		delete[] wideRandom;
+		delete[] scratch;
+		delete[] work;
+		delete[] fewUnique;
+		delete[] random;
+	}
+
+private:
+	static constexpr UINT32 Count = 1024 * 1024;
+	static constexpr UINT32 Lookups = 1024;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "bench.h"
+
+class StringBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// Lower-case words with the marker only at the very end, so every search scans the whole haystack
+		PCHAR text = new CHAR[TextSize];
+		PCHAR upper = new CHAR[TextSize];
+		PWCHAR wide = new WCHAR[TextSize];
+		UINT32 state = 0x6C078965;
+		for (USIZE i = 0; i < TextSize; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			UINT32 symbol = (state >> 24) % 27;
+			text[i] = symbol == 26 ? ' ' : (CHAR)('a' + symbol);
+			upper[i] = symbol == 26 ? ' ' : (CHAR)('A' + symbol);
+		}
+		auto marker = "[section:relocations]"_embed;
+		const CHAR *pattern = (const CHAR *)marker;
+		for (USIZE i = 0; i < LongPattern; i++)
+			text[TextSize - LongPattern + i] = pattern[i];
+		for (USIZE i = 0; i < TextSize; i++)
+			wide[i] = (WCHAR)text[i];
+
+		auto indexOfUnit = [text](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::IndexOf((const CHAR *)text, TextSize, ']'));
+		};
+		BENCH_RUN_BYTES(bench, L"string.index_of_unit_4m", TextSize, indexOfUnit);
+
+		// Baseline for the short-pattern filter: compare at every position
+		auto indexOfNaive = [text](USIZE iterations)
+		{
+			const CHAR *needle = text + TextSize - LongPattern;
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				SSIZE found = -1;
+				for (USIZE start = 0; start + ShortPattern <= TextSize && found < 0; start++)
+				{
+					USIZE j = 0;
+					while (j < ShortPattern && text[start + j] == needle[j])
+						j++;
+					if (j == ShortPattern)
+						found = (SSIZE)start;
+				}
+				DoNotOptimize(found);
+			}
+		};
+		BENCH_RUN_BYTES(bench, L"string.index_of_naive_8_4m", TextSize, indexOfNaive);
+
+		auto indexOfShort = [text](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::IndexOf((const CHAR *)text, TextSize, text + TextSize - LongPattern, ShortPattern));
+		};
+		BENCH_RUN_BYTES(bench, L"string.index_of_8_4m", TextSize, indexOfShort);
+
+		auto indexOfLong = [text](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::IndexOf((const CHAR *)text, TextSize, text + TextSize - LongPattern, LongPattern));
+		};
+		BENCH_RUN_BYTES(bench, L"string.index_of_21_4m", TextSize, indexOfLong);
+
+		auto indexOfWide = [wide](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::IndexOf((const WCHAR *)wide, TextSize, wide + TextSize - LongPattern, ShortPattern));
+		};
+		BENCH_RUN_BYTES(bench, L"string.index_of_wide_8_4m", TextSize * sizeof(WCHAR), indexOfWide);
+
+		// Equal inputs: the whole length is compared
+		PCHAR copy = new CHAR[TextSize];
+		Memory::Copy(copy, text, TextSize);
+		auto compare = [text, copy](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::Compare((const CHAR *)text, TextSize, (const CHAR *)copy, TextSize));
+		};
+		BENCH_RUN_BYTES(bench, L"string.compare_4m", TextSize, compare);
+
+		// Every word differs in case, so every word is folded
+		for (USIZE i = TextSize - LongPattern; i < TextSize; i++)
+			upper[i] = text[i];
+		auto equalsIgnoreCase = [text, upper](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::EqualsIgnoreCase((const CHAR *)text, TextSize, (const CHAR *)upper, TextSize));
+		};
+		BENCH_RUN_BYTES(bench, L"string.equals_ignore_case_4m", TextSize, equalsIgnoreCase);
+
+		// ASCII text in both directions: the 8-unit block path end to end
+		PCHAR utf8 = new CHAR[TextSize * 3];
+		PWCHAR decoded = new WCHAR[TextSize];
+		auto wideToUtf8 = [wide, utf8](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::WideToUtf8((const WCHAR *)wide, TextSize, utf8, TextSize * 3));
+		};
+		BENCH_RUN_BYTES(bench, L"string.wide_to_utf8_ascii_4m", TextSize * sizeof(WCHAR), wideToUtf8);
+
+		String::WideToUtf8((const WCHAR *)wide, TextSize, utf8, TextSize * 3);
+		auto utf8ToWide = [utf8, decoded](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::Utf8ToWide((const CHAR *)utf8, TextSize, decoded, TextSize));
+		};
+		BENCH_RUN_BYTES(bench, L"string.utf8_to_wide_ascii_4m", TextSize, utf8ToWide);
+
+		// Mostly ASCII with an accented letter or a euro sign in every 32 units, as in European prose
+		for (USIZE i = 31; i < TextSize; i += 32)
+			wide[i] = (i & 32) ? (WCHAR)0x00E9 : (WCHAR)0x20AC;
+		auto wideToUtf8Mixed = [wide, utf8](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::WideToUtf8((const WCHAR *)wide, TextSize, utf8, TextSize * 3));
+		};
+		BENCH_RUN_BYTES(bench, L"string.wide_to_utf8_mixed_4m", TextSize * sizeof(WCHAR), wideToUtf8Mixed);
+
+		USIZE mixedLength = (USIZE)String::WideToUtf8((const WCHAR *)wide, TextSize, utf8, TextSize * 3);
+		auto utf8ToWideMixed = [utf8, decoded, mixedLength](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(String::Utf8ToWide((const CHAR *)utf8, mixedLength, decoded, TextSize));
+		};
+		BENCH_RUN_BYTES(bench, L"string.utf8_to_wide_mixed_4m", mixedLength, utf8ToWideMixed);
+
+		delete[] decoded;
+		delete[] utf8;
+		delete[] copy;
+		delete[] wide;
+		delete[] upper;
+		delete[] text;
+	}
+
+private:
+	static constexpr USIZE TextSize = 4 * 1024 * 1024;
+	static constexpr USIZE ShortPattern = 8;
+	static constexpr USIZE LongPattern = 21;
+};
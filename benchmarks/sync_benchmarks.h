@@ -0,0 +1,81 @@
+#pragma once
+
+#include "bench.h"
+
+class SyncBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		Atomic<USIZE> counter(0);
+		auto fetchAdd = [&counter](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				counter.FetchAdd(1, MemoryOrder::Relaxed);
+		};
+		BENCH_RUN(bench, L"sync.atomic.fetch_add", fetchAdd);
+
+		RunUncontended<SpinLock>(bench, L"sync.spinlock.uncontended"_embed);
+		RunUncontended<Mutex>(bench, L"sync.mutex.uncontended"_embed);
+
+		// 1, 2, 4 ... 64 threads hammer the same lock, to show where contention starts to cost
+		for (UINT32 threads = 1; threads <= ThreadPool::MaxParticipants; threads *= 2)
+		{
+			ThreadPool pool;
+			BOOL started = StartBenchPool(pool, threads);
+			RunContended<SpinLock>(bench, pool, started, L"sync.spinlock.threads_%u"_embed, threads);
+			RunContended<Mutex>(bench, pool, started, L"sync.mutex.threads_%u"_embed, threads);
+		}
+	}
+
+private:
+	// Indices per ParallelFor piece; small enough that all participants join in
+	static constexpr USIZE ContendedGrain = 64;
+
+	template <typename TLock>
+	static VOID RunUncontended(Bench &bench, const WCHAR *name)
+	{
+		TLock lock;
+		USIZE value = 0;
+		auto lockUnlock = [&lock, &value](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				LockGuard<TLock> guard(lock);
+				value++;
+			}
+			DoNotOptimize(value);
+		};
+		bench.Run(name, lockUnlock);
+	}
+
+	template <typename TLock>
+	static VOID RunContended(Bench &bench, ThreadPool &pool, BOOL started, const WCHAR *format, UINT32 threads)
+	{
+		WideString name;
+		if (!name.Format(format, threads))
+		{
+			bench.Skip(format);
+			return;
+		}
+		if (!started)
+		{
+			bench.Skip(name.GetData());
+			return;
+		}
+
+		TLock lock;
+		USIZE value = 0;
+		auto increment = [&lock, &value](USIZE)
+		{
+			LockGuard<TLock> guard(lock);
+			value++;
+		};
+		auto contended = [&pool, &increment, &value](USIZE iterations)
+		{
+			pool.ParallelFor(0, iterations, ContendedGrain, increment);
+			DoNotOptimize(value);
+		};
+		bench.Run(name.GetData(), contended);
+	}
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "bench.h"
+
+class ThreadPoolBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// 0 workers is the serial baseline: every spawn runs inline on the caller.
+		// Then 1, 2, 4 ... workers, ending with one per processor besides the caller.
+		UINT32 processors = Thread::GetProcessorCount();
+		UINT32 maximum = processors > 1 ? processors - 1 : 1;
+		if (maximum > ThreadPool::MaxParticipants - 1)
+			maximum = ThreadPool::MaxParticipants - 1;
+		for (UINT32 workers = 0;; workers = workers == 0 ? 1 : workers * 2)
+		{
+			if (workers > maximum)
+				workers = maximum;
+			ThreadPool pool;
+			if (StartBenchPool(pool, workers + 1))
+				RunPool(bench, pool, workers);
+			else
+				bench.Skip(L"pool"_embed);
+			if (workers == maximum)
+				break;
+		}
+	}
+
+private:
+	// Run one benchmark under name.workers_<n>
+	template <typename Routine>
+	static VOID RunNamed(Bench &bench, const WCHAR *name, UINT32 workers, Routine &routine)
+	{
+		WideString fullName;
+		if (!fullName.Format(L"%ls.workers_%u"_embed, name, workers))
+		{
+			bench.Skip(name);
+			return;
+		}
+		bench.Run(fullName.GetData(), routine);
+	}
+
+	static VOID RunPool(Bench &bench, ThreadPool &pool, UINT32 workers)
+	{
+		// Per-index overhead of splitting and stealing at different grains
+		Atomic<USIZE> sum(0);
+		auto touch = [&sum](USIZE i)
+		{ sum.FetchAdd(i, MemoryOrder::Relaxed); };
+
+		auto grain1 = [&pool, &touch](USIZE iterations)
+		{ pool.ParallelFor(0, iterations, 1, touch); };
+		RunNamed(bench, L"pool.parallel_for.grain_1"_embed, workers, grain1);
+
+		auto grain64 = [&pool, &touch](USIZE iterations)
+		{ pool.ParallelFor(0, iterations, 64, touch); };
+		RunNamed(bench, L"pool.parallel_for.grain_64"_embed, workers, grain64);
+
+		auto grain4096 = [&pool, &touch](USIZE iterations)
+		{ pool.ParallelFor(0, iterations, 4096, touch); };
+		RunNamed(bench, L"pool.parallel_for.grain_4096"_embed, workers, grain4096);
+
+		// One forked job joined right away: the cost of a fork/join pair
+		auto spawnWait = [&pool](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				USIZE result = 0;
+				auto job = MakeJob([&result, i]()
+								   { result = i; });
+				TaskGroup group;
+				group.Run(pool, job);
+				group.Wait(pool);
+				DoNotOptimize(result);
+			}
+		};
+		RunNamed(bench, L"pool.spawn_wait"_embed, workers, spawnWait);
+
+		// Recursive fork/join with a CPU-bound leaf; scales with the participant count
+		auto fibonacci = [&pool](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(Fibonacci(pool, 24));
+		};
+		RunNamed(bench, L"pool.fibonacci_24"_embed, workers, fibonacci);
+	}
+
+	static USIZE Fibonacci(ThreadPool &pool, USIZE n)
+	{
+		if (n < 2)
+			return n;
+		if (n < 12)
+			return Fibonacci(pool, n - 1) + Fibonacci(pool, n - 2);
+
+		USIZE left = 0;
+		auto job = MakeJob([&pool, &left, n]()
+						   { left = Fibonacci(pool, n - 1); });
+		TaskGroup group;
+		group.Run(pool, job);
+		USIZE right = Fibonacci(pool, n - 2);
+		group.Wait(pool);
+		return left + right;
+	}
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "bench.h"
+
+class TimerBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// What a single timestamp costs, i.e. the floor under every Stopwatch
+		auto readCycles = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(Timer::ReadCycles());
+		};
+		BENCH_RUN(bench, L"timer.read_cycles", readCycles);
+
+		auto readCyclesOrdered = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(Timer::ReadCyclesOrdered());
+		};
+		BENCH_RUN(bench, L"timer.read_cycles_ordered", readCyclesOrdered);
+
+		auto getNanoseconds = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				DoNotOptimize(Timer::GetNanoseconds());
+		};
+		BENCH_RUN(bench, L"timer.get_nanoseconds", getNanoseconds);
+
+		Histogram *histogram = new Histogram();
+		auto record = [histogram](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				histogram->Record(UINT64((UINT32)(i * 2654435761U)));
+		};
+		BENCH_RUN(bench, L"timer.histogram_record", record);
+		delete histogram;
+	}
+};
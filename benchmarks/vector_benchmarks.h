@@ -0,0 +1,100 @@
+#pragma once
+
+#include "bench.h"
+
+class VectorBenchmarks
+{
+public:
+	static VOID RunAll(Bench &bench)
+	{
+		// Upper bound: stores into an array that is already big enough
+		PUINT32 raw = new UINT32[LargeCount];
+		auto rawStores = [raw](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				for (UINT32 j = 0; j < LargeCount; j++)
+					raw[j] = j;
+				DoNotOptimize(raw[LargeCount - 1]);
+			}
+		};
+		bench.Run(L"vector.raw_stores_1m"_embed, rawStores, LargeCount * sizeof(UINT32));
+		delete[] raw;
+
+		// Doubling from empty: about 2 moves per element in total
+		auto push = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Vector<UINT32> values;
+				for (UINT32 j = 0; j < LargeCount; j++)
+					values.Push(j);
+				DoNotOptimize(values.GetData());
+			}
+		};
+		bench.Run(L"vector.push_1m"_embed, push, LargeCount * sizeof(UINT32));
+
+		auto pushReserved = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Vector<UINT32> values;
+				values.Reserve(LargeCount);
+				for (UINT32 j = 0; j < LargeCount; j++)
+					values.Push(j);
+				DoNotOptimize(values.GetData());
+			}
+		};
+		bench.Run(L"vector.push_reserved_1m"_embed, pushReserved, LargeCount * sizeof(UINT32));
+
+		// The only block in the arena grows in place, so nothing is ever copied
+		Arena arena;
+		if (arena.InitializeHeap(LargeCount * sizeof(UINT32) * 2))
+		{
+			auto pushArena = [&arena](USIZE iterations)
+			{
+				for (USIZE i = 0; i < iterations; i++)
+				{
+					Vector<UINT32, ArenaAllocator> values{ArenaAllocator(arena)};
+					for (UINT32 j = 0; j < LargeCount; j++)
+						values.Push(j);
+					DoNotOptimize(values.GetData());
+				}
+			};
+			bench.Run(L"vector.push_arena_1m"_embed, pushArena, LargeCount * sizeof(UINT32));
+		}
+		else
+		{
+			bench.Skip(L"vector.push_arena_1m"_embed);
+		}
+
+		// Short-lived small vectors: inline storage against heap blocks from the size-class caches
+		auto pushInline = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				SmallVector<UINT32, SmallCount> values;
+				for (UINT32 j = 0; j < SmallCount; j++)
+					values.Push(j);
+				DoNotOptimize(values.GetData());
+			}
+		};
+		bench.Run(L"vector.push_inline_16"_embed, pushInline, SmallCount * sizeof(UINT32));
+
+		auto pushHeap = [](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+			{
+				Vector<UINT32> values;
+				for (UINT32 j = 0; j < SmallCount; j++)
+					values.Push(j);
+				DoNotOptimize(values.GetData());
+			}
+		};
+		bench.Run(L"vector.push_heap_16"_embed, pushHeap, SmallCount * sizeof(UINT32));
+	}
+
+private:
+	static constexpr UINT32 LargeCount = 1024 * 1024;
+	static constexpr UINT32 SmallCount = 16;
+};
@@ -0,0 +1,77 @@
+/**
+ * allocator_policy.h - Allocation Policies for Containers
+ *
+ * Containers take a policy as a template parameter and keep one instance
+ * of it, so a policy may carry state such as the arena it carves from.
+ * Every policy provides:
+ *   PVOID Allocate(USIZE size, USIZE alignment) - NULL when out of memory; alignment is a power of two
+ *   VOID Release(PVOID block, USIZE size, USIZE alignment)
+ *                                               - size and alignment as allocated
+ *   BOOL Resize(PVOID block, USIZE size, USIZE newSize)
+ *                                               - grow or shrink in place, FALSE if not possible
+ *
+ * POLICIES:
+ *   HeapAllocator  - Allocator::AllocateMemory, which aligns to
+ *                    HEAP_ALLOCATOR_ALIGNMENT. Release passes the exact size,
+ *                    so blocks of up to ALLOCATOR_CACHE_MAX_SIZE bytes go back
+ *                    to the thread's size-class free lists and are reused
+ *                    slab-style. Stricter alignments over-allocate by the
+ *                    alignment and keep the heap's pointer just below the block.
+ *   ArenaAllocator - Carves from an Arena. The most recent block grows in
+ *                    place and is handed back on Release; older blocks stay
+ *                    until the arena is rewound.
+ *
+ * USAGE:
+ *   Vector<UINT32> heap;                              // HeapAllocator
+ *   Vector<UINT32, ArenaAllocator> scratch(ArenaAllocator(arena));
+ */
+
+#pragma once
+
+#include "arena.h"
+
+// What RtlAllocateHeap guarantees: two pointers
+#define HEAP_ALLOCATOR_ALIGNMENT (2 * sizeof(PVOID))
+
+class HeapAllocator
+{
+public:
+    PVOID Allocate(USIZE size, USIZE alignment)
+    {
+        if (alignment <= HEAP_ALLOCATOR_ALIGNMENT)
+            return Allocator::AllocateMemory(size);
+        if (size > (USIZE)-1 - alignment)
+            return NULL;
+
+        // Rounding up from past the start leaves at least a pointer's room below the block
+        PUINT8 base = (PUINT8)Allocator::AllocateMemory(size + alignment);
+        if (base == NULL)
+            return NULL;
+        PUINT8 block = (PUINT8)(((USIZE)base + alignment) & ~(alignment - 1));
+        ((PUINT8 *)block)[-1] = base;
+        return block;
+    }
+
+    VOID Release(PVOID block, USIZE size, USIZE alignment)
+    {
+        if (alignment <= HEAP_ALLOCATOR_ALIGNMENT)
+            Allocator::ReleaseMemory(block, size);
+        else if (block != NULL)
+            Allocator::ReleaseMemory(((PUINT8 *)block)[-1], size + alignment);
+    }
+
+    BOOL Resize(PVOID, USIZE, USIZE) { return FALSE; }
+};
+
+class ArenaAllocator
+{
+private:
+    Arena *arena;
+
+public:
+    explicit ArenaAllocator(Arena &source) : arena(&source) {}
+
+    PVOID Allocate(USIZE size, USIZE alignment) { return arena->Allocate(size, alignment); }
+    VOID Release(PVOID block, USIZE size, USIZE) { arena->Resize(block, size, 0); }
+    BOOL Resize(PVOID block, USIZE size, USIZE newSize) { return arena->Resize(block, size, newSize); }
+};
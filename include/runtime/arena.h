@@ -0,0 +1,132 @@
+/**
+ * arena.h - Bump-Pointer Arena Allocator
+ *
+ * Hands out memory from one contiguous block by advancing an offset.
+ * Individual allocations are never freed; callers take a Mark() before a
+ * batch of temporary work and Rewind() to it afterwards, or Reset() the
+ * whole arena. This makes scratch allocations a few instructions each and
+ * keeps them out of the process heap entirely.
+ *
+ * BACKING STORAGE:
+ *   InitializeHeap(capacity)          - Heap block owned by the arena
+ *   InitializeBuffer(buffer, capacity) - Caller-provided buffer (stack, mapped file)
+ *
+ * USAGE:
+ *   Arena arena;
+ *   arena.InitializeHeap(64 * 1024);
+ *   USIZE mark = arena.Mark();
+ *   PCHAR text = (PCHAR)arena.Allocate(256);
+ *   // ... use text ...
+ *   arena.Rewind(mark);
+ *   arena.Release();
+ */
+
+#pragma once
+
+#include "allocator.h"
+
+class Arena
+{
+private:
+    PUINT8 base;
+    USIZE capacity;
+    USIZE offset;
+    BOOL ownsMemory;
+
+public:
+    Arena() : base(NULL), capacity(0), offset(0), ownsMemory(FALSE) {}
+    ~Arena() { Release(); }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Back the arena with a new heap block
+    BOOL InitializeHeap(USIZE size)
+    {
+        Release();
+        base = (PUINT8)Allocator::AllocateMemory(size);
+        if (base == NULL)
+            return FALSE;
+        capacity = size;
+        offset = 0;
+        ownsMemory = TRUE;
+        return TRUE;
+    }
+
+    // Back the arena with caller-owned memory
+    VOID InitializeBuffer(PVOID buffer, USIZE size)
+    {
+        Release();
+        base = (PUINT8)buffer;
+        capacity = size;
+        offset = 0;
+        ownsMemory = FALSE;
+    }
+
+    // Free the backing block if the arena owns it
+    VOID Release()
+    {
+        if (ownsMemory && base != NULL)
+            Allocator::ReleaseMemory(base, capacity);
+        base = NULL;
+        capacity = 0;
+        offset = 0;
+        ownsMemory = FALSE;
+    }
+
+    /**
+     * Allocate - Carve size bytes aligned to alignment (a power of two)
+     *
+     * @return Pointer into the arena, or NULL when it is exhausted
+     */
+    PVOID Allocate(USIZE size, USIZE alignment = sizeof(USIZE))
+    {
+        USIZE address = (USIZE)base + offset;
+        USIZE aligned = (address + alignment - 1) & ~(alignment - 1);
+        USIZE newOffset = aligned - (USIZE)base + size;
+        if (base == NULL || newOffset > capacity || newOffset < offset)
+            return NULL;
+        offset = newOffset;
+        return (PVOID)aligned;
+    }
+
+    /**
+     * Resize - Grow or shrink the most recent allocation in place
+     *
+     * @return FALSE if block is not the last allocation or newSize does not fit
+     */
+    BOOL Resize(PVOID block, USIZE size, USIZE newSize)
+    {
+        USIZE start = (USIZE)block - (USIZE)base;
+        if (base == NULL || !Contains(block) || start + size != offset || newSize > capacity - start)
+            return FALSE;
+        offset = start + newSize;
+        return TRUE;
+    }
+
+    USIZE Mark() const { return offset; }
+    VOID Rewind(USIZE mark) { offset = mark <= offset ? mark : offset; }
+    VOID Reset() { offset = 0; }
+
+    BOOL IsInitialized() const { return base != NULL; }
+    BOOL Contains(PCVOID p) const { return (PUINT8)p >= base && (PUINT8)p < base + capacity; }
+    USIZE GetUsed() const { return offset; }
+    USIZE GetCapacity() const { return capacity; }
+};
+
+/**
+ * ArenaScope - Rewinds an arena to its current mark at end of scope
+ */
+class ArenaScope
+{
+private:
+    Arena &arena;
+    USIZE mark;
+
+public:
+    explicit ArenaScope(Arena &a) : arena(a), mark(a.Mark()) {}
+    ~ArenaScope() { arena.Rewind(mark); }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+};
@@ -0,0 +1,251 @@
+/**
+ * basic_string.h - Owned String with Small-String Optimization
+ *
+ * BasicString<TChar> owns a null-terminated run of CHAR or WCHAR units and
+ * tracks its length explicitly, so appending never rescans the text. Up to
+ * BASIC_STRING_INLINE_CAPACITY units live inside the object; longer text
+ * moves to a heap block whose capacity doubles as it grows, so n appended
+ * units cost O(n) copies in total.
+ *
+ * DESIGN:
+ *   - No exceptions: operations that may allocate return FALSE when out of
+ *     memory and leave the string unchanged
+ *   - GetData is always null-terminated, so the text can be passed straight
+ *     to Console::Write or a Windows API
+ *   - Format/FormatV append through StringFormatter, with the same
+ *     specifiers as Console::WriteFormatted
+ *   - Not copyable (a copy could fail): Assign copies explicitly, moves take
+ *     the heap block over
+ *   - No pointer into itself, so containers relocate strings as plain bytes
+ *
+ * USAGE:
+ *   WideString path;
+ *   if (!path.Append(directory, directoryLength) || !path.Format(L"\\%ls.log"_embed, name))
+ *       return FALSE; // out of memory
+ *   file.Open(path.GetData(), FILE_MODE_WRITE | FILE_MODE_CREATE);
+ */
+
+#pragma once
+
+#include "utility.h"
+#include "memory.h"
+#include "string.h"
+#include "string_formatter.h"
+#include "allocator.h"
+
+// Units stored inside the object (plus the terminator): 24 bytes of CHAR, 48 of WCHAR
+#define BASIC_STRING_INLINE_CAPACITY 23
+
+template <TCHAR TChar>
+class BasicString
+{
+private:
+    USIZE length;
+    USIZE capacity; // Units before the terminator; BASIC_STRING_INLINE_CAPACITY while inline
+    union
+    {
+        TChar *heap;
+        TChar units[BASIC_STRING_INLINE_CAPACITY + 1];
+    };
+
+    BOOL IsInlineStorage() const { return capacity == BASIC_STRING_INLINE_CAPACITY; }
+    TChar *GetStorage() { return IsInlineStorage() ? units : heap; }
+    const TChar *GetStorage() const { return IsInlineStorage() ? units : heap; }
+
+    VOID ReleaseBlock()
+    {
+        if (!IsInlineStorage())
+            Allocator::ReleaseMemory(heap, (capacity + 1) * sizeof(TChar));
+    }
+
+    // Move the text to a block of newCapacity units
+    BOOL Reallocate(USIZE newCapacity)
+    {
+        if (newCapacity >= (USIZE)-1 / sizeof(TChar))
+            return FALSE;
+        TChar *block = (TChar *)Allocator::AllocateMemory((newCapacity + 1) * sizeof(TChar));
+        if (block == NULL)
+            return FALSE;
+        Memory::Copy(block, GetStorage(), (length + 1) * sizeof(TChar));
+        ReleaseBlock();
+        heap = block;
+        capacity = newCapacity;
+        return TRUE;
+    }
+
+    // Room for needed units when full: double the current capacity
+    NOINLINE BOOL Grow(USIZE needed)
+    {
+        USIZE grown = capacity * 2;
+        return Reallocate(grown < needed ? needed : grown);
+    }
+
+    // StringFormatter context: the formatter carries on after a failed write, so the failure is remembered
+    struct FormatTarget
+    {
+        BasicString *Text;
+        BOOL Failed;
+    };
+
+    static BOOL AppendUnit(PVOID context, TChar unit)
+    {
+        FormatTarget *target = (FormatTarget *)context;
+        if (target->Text->Append(unit))
+            return TRUE;
+        target->Failed = TRUE;
+        return FALSE;
+    }
+
+    // Take over other's text; this string must be inline and empty
+    VOID TakeFrom(BasicString &other)
+    {
+        if (other.IsInlineStorage())
+        {
+            Memory::Copy(units, other.units, (other.length + 1) * sizeof(TChar));
+        }
+        else
+        {
+            heap = other.heap;
+            capacity = other.capacity;
+            other.capacity = BASIC_STRING_INLINE_CAPACITY;
+        }
+        length = other.length;
+        other.length = 0;
+        other.units[0] = (TChar)0;
+    }
+
+public:
+    BasicString() : length(0), capacity(BASIC_STRING_INLINE_CAPACITY) { units[0] = (TChar)0; }
+    ~BasicString() { ReleaseBlock(); }
+
+    BasicString(const BasicString &) = delete;
+    BasicString &operator=(const BasicString &) = delete;
+
+    BasicString(BasicString &&other) : length(0), capacity(BASIC_STRING_INLINE_CAPACITY) { TakeFrom(other); }
+
+    BasicString &operator=(BasicString &&other)
+    {
+        if (this != &other)
+        {
+            ReleaseBlock();
+            capacity = BASIC_STRING_INLINE_CAPACITY;
+            TakeFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * Reserve - Make room for at least newCapacity units (the terminator is extra)
+     *
+     * @return FALSE if the allocation failed (the string is unchanged)
+     */
+    BOOL Reserve(USIZE newCapacity)
+    {
+        return newCapacity <= capacity || Reallocate(newCapacity);
+    }
+
+    // Append count units of text (which must not point into this string)
+    BOOL Append(const TChar *text, USIZE count)
+    {
+        if (count > capacity - length && !Grow(length + count))
+            return FALSE;
+        TChar *storage = GetStorage();
+        Memory::Copy(storage + length, text, count * sizeof(TChar));
+        length += count;
+        storage[length] = (TChar)0;
+        return TRUE;
+    }
+
+    BOOL Append(const TChar *text) { return Append(text, String::Length(text)); }
+    BOOL Append(const BasicString &other) { return Append(other.GetData(), other.length); }
+
+    FORCE_INLINE BOOL Append(TChar unit)
+    {
+        if (length == capacity && !Grow(length + 1))
+            return FALSE;
+        TChar *storage = GetStorage();
+        storage[length++] = unit;
+        storage[length] = (TChar)0;
+        return TRUE;
+    }
+
+    // Replace the text with count units of text
+    BOOL Assign(const TChar *text, USIZE count)
+    {
+        Clear();
+        return Append(text, count);
+    }
+
+    BOOL Assign(const TChar *text) { return Assign(text, String::Length(text)); }
+
+    /**
+     * Format - Append printf-style output (see Console::WriteFormatted)
+     *
+     * @return FALSE if out of memory; the string keeps its previous text
+     */
+    BOOL FormatV(const TChar *format, VA_LIST args)
+    {
+        USIZE start = length;
+        FormatTarget target = {this, FALSE};
+        auto writer = (BOOL (*)(PVOID, TChar))PerformRelocation((PVOID)AppendUnit);
+        StringFormatter::FormatV(writer, &target, format, args);
+        if (!target.Failed)
+            return TRUE;
+        Truncate(start);
+        return FALSE;
+    }
+
+    BOOL Format(const TChar *format, ...)
+    {
+        VA_LIST args;
+        VA_START(args, format);
+        BOOL result = FormatV(format, args);
+        VA_END(args);
+        return result;
+    }
+
+    // Shorten to newLength units (no effect if already shorter); the capacity is kept
+    VOID Truncate(USIZE newLength)
+    {
+        if (newLength < length)
+        {
+            length = newLength;
+            GetStorage()[length] = (TChar)0;
+        }
+    }
+
+    VOID Clear() { Truncate(0); }
+
+    BOOL Equals(const TChar *text, USIZE count) const
+    {
+        return count == length && Memory::Compare(GetData(), text, count * sizeof(TChar)) == 0;
+    }
+
+    BOOL Equals(const BasicString &other) const { return Equals(other.GetData(), other.length); }
+
+    TChar &operator[](USIZE index) { return GetStorage()[index]; }
+    const TChar &operator[](USIZE index) const { return GetStorage()[index]; }
+
+    // Null-terminated text, valid until the string is next modified
+    const TChar *GetData() const { return GetStorage(); }
+    USIZE GetLength() const { return length; }
+    USIZE GetCapacity() const { return capacity; }
+    BOOL IsEmpty() const { return length == 0; }
+    BOOL IsInline() const { return IsInlineStorage(); }
+
+    // Range-based for support
+    TChar *begin() { return GetStorage(); }
+    TChar *end() { return GetStorage() + length; }
+    const TChar *begin() const { return GetStorage(); }
+    const TChar *end() const { return GetStorage() + length; }
+};
+
+typedef BasicString<CHAR> NarrowString;
+typedef BasicString<WCHAR> WideString;
+
+// The inline units are reached through this, never through a stored pointer
+template <TCHAR TChar>
+struct IsTriviallyRelocatable<BasicString<TChar>>
+{
+    static constexpr BOOL Value = TRUE;
+};
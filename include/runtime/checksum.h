@@ -0,0 +1,98 @@
+/**
+ * checksum.h - CRC32C and 64-bit Checksums
+ *
+ * Two checksums for detecting corruption in large buffers (neither resists
+ * deliberate tampering):
+ *   Crc32c   - CRC-32C (Castagnoli), as used by iSCSI, ext4 and SSE4.2
+ *   XxHash64 - XXH64, a multiply-rotate hash that is several times faster
+ *              than a software CRC and matches the reference xxHash output
+ *
+ * CRC32C IMPLEMENTATIONS:
+ *   x86_64/i386: SSE4.2 crc32 instruction, when cpuid reports it
+ *   aarch64:     ARMv8 crc32c instructions, when Windows reports them
+ *   Otherwise:   Slicing-by-8 lookup, 8 bytes per step
+ *   The instruction paths run three independent CRCs over adjacent blocks,
+ *   hiding the instruction's latency, and merge them by multiplying the
+ *   first two (carry-less, in software) by x^n mod P constants that are
+ *   computed at compile time.
+ *
+ * LOOKUP TABLE:
+ *   Slicing-by-8 needs 8 KB of tables, which cannot be a static const in a
+ *   blob without .rdata. They are generated on first use into the thread's
+ *   table arena and kept until the thread detaches; a thread without a
+ *   context falls back to computing the CRC a bit at a time.
+ *
+ * USAGE:
+ *   UINT32 crc = Crc32c::Compute(header, sizeof(header));
+ *   crc = Crc32c::Compute(payload, payloadSize, crc); // continues the same CRC
+ *   BOOL hardware = Crc32c::IsHardwareAvailable();      // once, outside the loop
+ *   for (USIZE i = 0; i < count; i++)
+ *       crcs[i] = Crc32c::Compute(blocks[i], blockSize, 0, hardware);
+ *   UINT64 hash = XxHash64::Compute(payload, payloadSize);
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+#include "arena.h"
+
+// Reflected CRC-32C polynomial
+#define CRC32C_POLYNOMIAL 0x82F63B78
+// Slicing-by-8 tables: 8 x 256 entries of 4 bytes
+#define CRC32C_TABLE_ENTRIES (8 * 256)
+
+class Crc32c
+{
+private:
+    // Platform-specific instruction support (implemented in platform-specific .cc files)
+    static BOOL DetectHardware();
+    // Support as reported by the OS: a memory read, no cpuid; older systems may not report it
+    static BOOL ReadPublishedHardware();
+
+public:
+    // TRUE if Compute uses the CPU's CRC32C instructions; detected once per thread,
+    // read from the OS's published processor features on a thread without a context
+    static BOOL IsHardwareAvailable();
+
+    /**
+     * BuildTable - Generate the slicing-by-8 tables into arena
+     *
+     * @return CRC32C_TABLE_ENTRIES entries, or NULL if the arena is full
+     */
+    static const UINT32 *BuildTable(Arena &arena);
+
+    /**
+     * Compute - CRC-32C of size bytes
+     *
+     * @param data - Bytes to checksum
+     * @param size - Number of bytes
+     * @param crc  - Result for the preceding bytes, to checksum a buffer in pieces (0 to start)
+     * @return CRC-32C of all bytes so far
+     */
+    static UINT32 Compute(PCVOID data, USIZE size, UINT32 crc = 0);
+
+    /**
+     * Compute - CRC-32C of size bytes with the instruction choice made by the caller
+     *
+     * For loops over many buffers: IsHardwareAvailable is queried once and
+     * its result passed in, so no buffer pays for detection.
+     *
+     * @param hardware - IsHardwareAvailable(), or FALSE for the software path
+     */
+    static UINT32 Compute(PCVOID data, USIZE size, UINT32 crc, BOOL hardware);
+};
+
+class XxHash64
+{
+public:
+    /**
+     * Compute - XXH64 of size bytes
+     *
+     * @param data - Bytes to hash
+     * @param size - Number of bytes
+     * @param seed - Hash seed (0 gives the reference default)
+     * @return 64-bit hash
+     */
+    static UINT64 Compute(PCVOID data, USIZE size, UINT64 seed = UINT64());
+};
@@ -29,6 +29,7 @@
 
 #include "string_formatter.h"  // Printf-style formatting engine
 #include "string.h"             // String utilities (length, copy, etc.)
+#include "thread_context.h"     // Per-thread log buffer
 
 /**
  * Console - Static class providing console I/O operations
@@ -48,7 +49,7 @@ private:
 	 * Used by StringFormatter to emit formatted characters one at a time.
 	 * This callback is invoked for each character in the formatted output.
 	 *
-	 * @param context - User context (unused, reserved for future use)
+	 * @param context - Calling thread's context (buffers output), or NULL
 	 * @param ch      - Character to write to console
 	 * @return TRUE on success, FALSE on error
 	 *
@@ -62,12 +63,17 @@ private:
 	template <TCHAR TChar>
 	static BOOL FormatterCallback(PVOID context, TChar ch);
 
+	// Write and empty the characters buffered in context's log buffer
+	template <TCHAR TChar>
+	static VOID FlushLogBuffer(PTHREAD_CONTEXT context);
+
 public:
 	/**
 	 * Write - Output narrow (ANSI) string to console
 	 *
 	 * Platform Behavior:
-	 *   Windows: Converts to UTF-16 and calls WriteConsoleW
+	 *   Windows: WriteConsoleA, which reads text in the console's code page;
+	 *            redirected output (file or pipe) gets the bytes unchanged
 	 *   Linux:   Writes directly via write(STDOUT_FILENO, text, length)
 	 *
 	 * @param text   - Pointer to narrow character string
@@ -84,7 +90,8 @@ public:
 	 * Write - Output wide (Unicode) string to console
 	 *
 	 * Platform Behavior:
-	 *   Windows: Calls WriteConsoleW directly (native Unicode support)
+	 *   Windows: Calls WriteConsoleW directly (native Unicode support);
+	 *            redirected output (file or pipe) is converted to UTF-8
 	 *   Linux:   Converts UTF-16 → UTF-8, then write() syscall
 	 *
 	 * @param text   - Pointer to wide character string
@@ -212,23 +219,35 @@ UINT32 Console::Write(const TChar *text)
  * FormatterCallback<TChar> - Character emission callback (inline implementation)
  *
  * StringFormatter calls this function for each formatted character.
- * We simply write each character directly to the console.
  *
  * DESIGN RATIONALE:
- *   Why not buffer the output?
- *   - Buffering requires allocating memory (heap or large stack)
- *   - Character-by-character is simpler and more position-independent
- *   - Kernel handles buffering internally anyway
- *   - For small outputs, overhead is negligible
+ *   Every console write is a round trip into the console host, so one write
+ *   per character dominates logging cost. When the thread has a context the
+ *   characters collect in its log buffer (no heap, no large stack frame) and
+ *   go out in one write per buffer. Without a context each character is
+ *   written directly, as before.
  */
 template <TCHAR TChar>
 BOOL Console::FormatterCallback(PVOID context, TChar ch)
 {
-	(VOID)context;  // Unused - reserved for future use (e.g., buffer pointer)
+	PTHREAD_CONTEXT threadContext = (PTHREAD_CONTEXT)context;
+	if (threadContext == NULL)
+		return Write(&ch, 1);
+
+	if (threadContext->LogLength + sizeof(TChar) > THREAD_LOG_BUFFER_SIZE)
+		FlushLogBuffer<TChar>(threadContext);
 
-	// Write single character to console
-	// Return value: TRUE = success, FALSE = error
-	return Write(&ch, 1);
+	*(TChar *)(threadContext->LogBuffer + threadContext->LogLength) = ch;
+	threadContext->LogLength += sizeof(TChar);
+	return TRUE;
+}
+
+template <TCHAR TChar>
+VOID Console::FlushLogBuffer(PTHREAD_CONTEXT context)
+{
+	if (context->LogLength != 0)
+		Write((const TChar *)context->LogBuffer, context->LogLength / sizeof(TChar));
+	context->LogLength = 0;
 }
 
 /**
@@ -259,13 +278,22 @@ UINT32 Console::WriteFormattedV(const TChar *format, VA_LIST args)
 	// Without this, the callback address would be incorrect in PIC environments
 	auto fixed = (BOOL (*)(PVOID, TChar))PerformRelocation((PVOID)FormatterCallback<TChar>);
 
+	// Buffer through the thread's log buffer unless it is already in use
+	PTHREAD_CONTEXT context = ThreadContext::Get();
+	if (context != NULL && context->LogLength != 0)
+		context = NULL;
+
 	// Delegate to StringFormatter which handles all format specifier parsing
 	// Parameters:
-	//   fixed  - Relocated callback function
-	//   NULL   - Context (unused, could be used for buffering)
-	//   format - Format string (embedded, not in .rdata)
-	//   args   - Variable arguments list
-	return StringFormatter::FormatV(fixed, NULL, format, args);
+	//   fixed   - Relocated callback function
+	//   context - Thread context holding the log buffer (NULL = unbuffered)
+	//   format  - Format string (embedded, not in .rdata)
+	//   args    - Variable arguments list
+	UINT32 written = StringFormatter::FormatV(fixed, context, format, args);
+
+	if (context != NULL)
+		FlushLogBuffer<TChar>(context);
+	return written;
 }
 
 /**
@@ -0,0 +1,398 @@
+/**
+ * coroutine.h - Stackless Coroutines and Single-Threaded Executor
+ *
+ * Lets one thread overlap many waits (I/O completions, events) without a
+ * thread per operation. A coroutine returning Task<T> suspends at co_await
+ * and is resumed later by the Executor's run loop.
+ *
+ * DESIGN:
+ *   - Tasks are lazy: nothing runs until the task is awaited or spawned.
+ *   - Awaiting a task hands control to it directly (symmetric transfer) and
+ *     the finished task hands control back, so deep await chains and long
+ *     await loops run in constant native stack.
+ *   - Frames come from the FramePool of the executor installed on the
+ *     calling thread: a bump arena with per-size free lists, so frame
+ *     allocation in steady state is a pointer pop. Without an executor
+ *     frames fall back to the heap.
+ *   - The executor does not know about I/O. A backend registers a poll
+ *     routine that waits for completions (completion-based, e.g. I/O
+ *     completion ports) or readiness (readiness-based) and schedules the
+ *     coroutines waiting on them. The run loop calls it whenever nothing
+ *     else is runnable.
+ *
+ * THREADING:
+ *   An executor, its tasks and its events belong to the thread that created
+ *   the executor. Tasks must not outlive their executor.
+ *
+ * USAGE:
+ *   Task<INT32> Child(AsyncEvent &ready)
+ *   {
+ *       co_await ready;
+ *       co_return 42;
+ *   }
+ *
+ *   Task<VOID> Parent(AsyncEvent &ready, INT32 &out)
+ *   {
+ *       out = co_await Child(ready);
+ *   }
+ *
+ *   Executor executor;
+ *   executor.Spawn(Parent(ready, out)); // detached, frame freed when done
+ *   executor.Run();                     // until every spawned task finished
+ */
+
+#pragma once
+
+#include "coroutine_support.h"
+#include "platform.h"
+#include "arena.h"
+#include "thread_context.h"
+
+class Executor;
+
+// Frames up to COROUTINE_FRAME_GRANULE * COROUTINE_FRAME_CLASSES bytes are pooled
+#define COROUTINE_FRAME_GRANULE 64
+#define COROUTINE_FRAME_CLASSES 16
+// Arena reserved by each executor for frames, allocated on first use
+#define COROUTINE_FRAME_ARENA_SIZE (64 * 1024)
+
+/**
+ * FramePool - Coroutine frame allocator owned by an executor
+ *
+ * Frames are rounded up to a granule class and carved from an arena;
+ * released frames go to a per-class free list and are reused by the next
+ * coroutine of that size. Frames larger than the largest class, or allocated
+ * once the arena is exhausted, come from the heap.
+ */
+class FramePool
+{
+private:
+    Arena arena;
+    PVOID freeLists[COROUTINE_FRAME_CLASSES];
+
+public:
+    FramePool();
+    ~FramePool();
+
+    FramePool(const FramePool &) = delete;
+    FramePool &operator=(const FramePool &) = delete;
+
+    PVOID Allocate(USIZE size);
+    VOID Release(PVOID frame, USIZE size);
+    USIZE GetArenaUsed() const { return arena.GetUsed(); }
+
+    // Allocate through the pool installed on the calling thread, or the heap
+    static PVOID AllocateFrame(USIZE size);
+    static VOID ReleaseFrame(PVOID frame, USIZE size);
+};
+
+/**
+ * PromiseBase - State shared by every Task promise
+ */
+class PromiseBase
+{
+public:
+    Executor *Owner;                       // Executor the coroutine runs on
+    std::coroutine_handle<> Continuation; // Awaiting coroutine, resumed on completion
+    BOOL IsRoot;                           // Spawned on the executor, counted as outstanding
+    BOOL IsDetached;                       // Destroy the frame on completion
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename TPromise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+        {
+            return Complete(handle.promise(), handle);
+        }
+
+        VOID await_resume() const noexcept {}
+    };
+
+    PromiseBase() : Owner(NULL), Continuation(), IsRoot(FALSE), IsDetached(FALSE) {}
+
+    static PVOID operator new(USIZE size) noexcept { return FramePool::AllocateFrame(size); }
+    static VOID operator delete(PVOID frame, USIZE size) noexcept { FramePool::ReleaseFrame(frame, size); }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    VOID unhandled_exception() const noexcept {}
+
+    // Pick the coroutine to run after handle finished
+    static std::coroutine_handle<> Complete(PromiseBase &promise, std::coroutine_handle<> handle);
+
+    // Frames start with the resume and destroy addresses, stored as link-time
+    // absolutes on i386; rebase them so the frame can be resumed in a PIC blob
+    static VOID RelocateFrame(std::coroutine_handle<> handle)
+    {
+#if defined(PLATFORM_WINDOWS_I386)
+        PPVOID slots = (PPVOID)handle.address();
+        slots[0] = PerformRelocation(slots[0]);
+        slots[1] = PerformRelocation(slots[1]);
+#else
+        (VOID)handle;
+#endif
+    }
+};
+
+// Result storage of a promise; specialized for tasks without a value
+template <typename T>
+class PromiseResult : public PromiseBase
+{
+private:
+    T value;
+
+public:
+    VOID return_value(const T &result) { value = result; }
+    T TakeResult() { return static_cast<T &&>(value); }
+};
+
+template <>
+class PromiseResult<VOID> : public PromiseBase
+{
+public:
+    VOID return_void() const noexcept {}
+    VOID TakeResult() const noexcept {}
+};
+
+/**
+ * Task - Lazily started coroutine producing a T
+ *
+ * Owns the coroutine frame. Await it from another coroutine, or hand it to
+ * Executor::Spawn. T must be default constructible and movable.
+ */
+template <typename T>
+class Task
+{
+public:
+    class promise_type : public PromiseResult<T>
+    {
+    public:
+        Task get_return_object() noexcept
+        {
+            std::coroutine_handle<promise_type> handle = std::coroutine_handle<promise_type>::from_promise(*this);
+            PromiseBase::RelocateFrame(handle);
+            return Task(handle);
+        }
+
+        static Task get_return_object_on_allocation_failure() noexcept { return Task(); }
+    };
+
+private:
+    friend class Executor;
+    friend class PromiseBase;
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    std::coroutine_handle<promise_type> Release()
+    {
+        std::coroutine_handle<promise_type> h = handle;
+        handle = nullptr;
+        return h;
+    }
+
+public:
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> Callee;
+
+        bool await_ready() const noexcept { return !Callee || Callee.done(); }
+
+        template <typename TPromise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> caller) noexcept
+        {
+            promise_type &promise = Callee.promise();
+            promise.Owner = caller.promise().Owner;
+            promise.Continuation = caller;
+            return Callee;
+        }
+
+        T await_resume() { return Callee.promise().TakeResult(); }
+    };
+
+    Task() : handle() {}
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    Task(Task &&other) noexcept : handle(other.Release()) {}
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+                handle.destroy();
+            handle = other.Release();
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    // FALSE if the frame could not be allocated
+    BOOL IsValid() const { return (BOOL)handle; }
+    BOOL IsDone() const { return handle && handle.done(); }
+
+    // Result of a finished task; moves the value out
+    T GetResult() { return handle.promise().TakeResult(); }
+
+    Awaiter operator co_await() const noexcept { return Awaiter{handle}; }
+};
+
+// Called when no coroutine is runnable: wait for I/O completions, schedule
+// their waiters and return how many were dispatched (0 = nothing pending)
+typedef USIZE (*EXECUTOR_POLL_ROUTINE)(PVOID context, Executor &executor);
+
+/**
+ * Executor - Single-threaded run loop for Task coroutines
+ */
+class Executor
+{
+private:
+    FramePool frames;
+    FramePool *previousFrames;
+
+    // Growable ring of runnable coroutine frames
+    PPVOID ready;
+    USIZE readyCapacity;
+    USIZE readyHead;
+    USIZE readyCount;
+
+    USIZE outstanding; // Spawned tasks not yet finished
+
+    EXECUTOR_POLL_ROUTINE pollRoutine;
+    PVOID pollContext;
+
+    // Target of the final transfer of a spawned task: a coroutine that
+    // suspends as soon as it is resumed, returning control to Run
+    Task<VOID> idle;
+
+    static Task<VOID> IdleLoop();
+    VOID Start(PromiseBase &promise, std::coroutine_handle<> handle, BOOL detached);
+
+    friend class PromiseBase;
+
+public:
+    // Installs the executor's frame pool on the calling thread
+    Executor();
+    ~Executor();
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    // Run the task on this executor; the caller keeps it and reads the result after Run
+    template <typename T>
+    VOID Spawn(Task<T> &task)
+    {
+        if (task.handle)
+            Start(task.handle.promise(), task.handle, FALSE);
+    }
+
+    // Run the task on this executor; its frame is freed when it finishes
+    template <typename T>
+    VOID Spawn(Task<T> &&task)
+    {
+        std::coroutine_handle<typename Task<T>::promise_type> handle = task.Release();
+        if (handle)
+            Start(handle.promise(), handle, TRUE);
+    }
+
+    // Queue a suspended coroutine to be resumed by Run
+    VOID Schedule(std::coroutine_handle<> handle);
+
+    VOID SetPoller(EXECUTOR_POLL_ROUTINE routine, PVOID context)
+    {
+        pollRoutine = (EXECUTOR_POLL_ROUTINE)PerformRelocation((PVOID)routine);
+        pollContext = context;
+    }
+
+    /**
+     * Run - Resume runnable coroutines until every spawned task finished
+     *
+     * @return FALSE if tasks are still suspended but nothing can wake them
+     *         (no poller, or the poller has nothing pending)
+     */
+    BOOL Run();
+
+    USIZE GetOutstandingCount() const { return outstanding; }
+    const FramePool &GetFramePool() const { return frames; }
+
+    // co_await Executor::Yield() lets every other runnable coroutine run first
+    struct YieldAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename TPromise>
+        VOID await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+        {
+            handle.promise().Owner->Schedule(handle);
+        }
+
+        VOID await_resume() const noexcept {}
+    };
+
+    static YieldAwaiter Yield() { return {}; }
+};
+
+/**
+ * AsyncEvent - Manual-reset event awaited by coroutines
+ *
+ * co_await completes immediately while the event is set; otherwise the
+ * coroutine is queued until Set(), which schedules every waiter on its
+ * executor in the order they started waiting. I/O backends use the same
+ * pattern: record the suspended handle, schedule it from the poll routine.
+ */
+class AsyncEvent
+{
+private:
+    typedef struct _WAITER
+    {
+        std::coroutine_handle<> Handle;
+        Executor *Owner;
+        struct _WAITER *Next;
+    } WAITER;
+
+    BOOL signaled;
+    WAITER *head;
+    WAITER *tail;
+
+public:
+    struct Awaiter
+    {
+        AsyncEvent &Event;
+        WAITER Node;
+
+        bool await_ready() const noexcept { return Event.signaled; }
+
+        template <typename TPromise>
+        VOID await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+        {
+            Node.Handle = handle;
+            Node.Owner = handle.promise().Owner;
+            Node.Next = NULL;
+            if (Event.tail != NULL)
+                Event.tail->Next = &Node;
+            else
+                Event.head = &Node;
+            Event.tail = &Node;
+        }
+
+        VOID await_resume() const noexcept {}
+    };
+
+    AsyncEvent(BOOL initiallySet = FALSE) : signaled(initiallySet), head(NULL), tail(NULL) {}
+
+    AsyncEvent(const AsyncEvent &) = delete;
+    AsyncEvent &operator=(const AsyncEvent &) = delete;
+
+    VOID Set();
+    VOID Reset() { signaled = FALSE; }
+    BOOL IsSet() const { return signaled; }
+
+    Awaiter operator co_await() noexcept { return Awaiter{*this, {}}; }
+};
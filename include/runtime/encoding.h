@@ -0,0 +1,388 @@
+/**
+ * encoding.h - Base64 and Hex Text Encoding
+ *
+ * Converts between bytes and CHAR or WCHAR text without lookup tables:
+ * the alphabets are computed from each 6-bit or 4-bit value with a few
+ * comparisons and additions, done for a whole word of characters at once
+ * with the lane helpers in swar.h. A 64-bit target handles 6 bytes (8
+ * Base64 characters) or 4 bytes (8 hex digits) per step, a 32-bit target
+ * half of that; only the final partial step runs on a padded copy.
+ *
+ * BASE64:
+ *   Standard alphabet (A-Z a-z 0-9 + /) with '=' padding (RFC 4648).
+ *   Decode also accepts input without padding. Whitespace, line breaks and
+ *   the URL-safe alphabet are rejected.
+ *
+ * HEX:
+ *   Two digits per byte, most significant first. Encode writes lowercase
+ *   unless asked for uppercase; Decode accepts both.
+ *
+ * BUFFERS:
+ *   Encode writes a null terminator and returns the number of characters
+ *   before it. Decode writes exactly the decoded bytes. Both return -1
+ *   without writing anything when the output does not fit. Decode also
+ *   returns -1 when the length is impossible or a character is outside the
+ *   alphabet; in that last case the output holds garbage, since characters
+ *   are validated a word at a time while decoding.
+ *
+ * USAGE:
+ *   CHAR text[Base64::GetEncodedLength(sizeof(key)) + 1];
+ *   Base64::Encode(key, sizeof(key), text, sizeof(text));
+ *   SSIZE size = Hex::Decode(L"deadbeef"_embed, 8, bytes, sizeof(bytes));
+ */
+
+#pragma once
+
+#include "swar.h"
+
+class Base64
+{
+private:
+    // Bytes consumed and characters produced per word
+    static constexpr USIZE GroupBytes = SWAR_LANES / 4 * 3;
+    static constexpr USIZE GroupChars = SWAR_LANES;
+
+    // GroupBytes input bytes (the top of a byte-swapped load) as one 6-bit value per lane, in output order
+    static FORCE_INLINE USIZE SplitSextets(USIZE bytes)
+    {
+        USIZE triples = 0;
+        for (USIZE group = 0; group < SWAR_LANES / 4; group++)
+            triples |= ((bytes >> (SWAR_LANES * 8 - 24 * (group + 1))) & 0xFFFFFF) << (group * 32);
+        // 24 bits per 32-bit lane -> 12 per 16-bit lane -> 6 per byte, first value lowest
+        USIZE pairs = ((triples >> 12) & Swar::Broadcast32(0xFFF)) | ((triples & Swar::Broadcast32(0xFFF)) << 16);
+        return ((pairs >> 6) & Swar::Broadcast16(0x3F)) | ((pairs & Swar::Broadcast16(0x3F)) << 8);
+    }
+
+    // Inverse of SplitSextets; the low SWAR_LANES - GroupBytes bytes of the result are zero
+    static FORCE_INLINE USIZE JoinSextets(USIZE sextets)
+    {
+        USIZE pairs = ((sextets & Swar::Broadcast16(0x3F)) << 6) | ((sextets >> 8) & Swar::Broadcast16(0x3F));
+        USIZE triples = ((pairs & Swar::Broadcast32(0xFFF)) << 12) | ((pairs >> 16) & Swar::Broadcast32(0xFFF));
+        USIZE bytes = 0;
+        for (USIZE group = 0; group < SWAR_LANES / 4; group++)
+            bytes |= ((triples >> (group * 32)) & 0xFFFFFF) << (SWAR_LANES * 8 - 24 * (group + 1));
+        return bytes;
+    }
+
+    // 'A' + v, then +6 from 26 ('a'), -75 from 52 ('0'), -15 at 62 ('+'), +3 at 63 ('/')
+    static FORCE_INLINE USIZE SextetsToAscii(USIZE sextets)
+    {
+        USIZE from26 = Swar::GreaterOrEqual(sextets, 26) >> 7;
+        USIZE from52 = Swar::GreaterOrEqual(sextets, 52) >> 7;
+        USIZE from62 = Swar::GreaterOrEqual(sextets, 62) >> 7;
+        USIZE from63 = Swar::GreaterOrEqual(sextets, 63) >> 7;
+        // Additions and subtractions are grouped so no lane carries or borrows into the next
+        return sextets + Swar::Broadcast('A') + from26 * 6 + from63 * 3 - (from52 * 75 + from62 * 15);
+    }
+
+    /**
+     * AsciiToSextets - Inverse of SextetsToAscii
+     *
+     * Classifies each lane against the boundaries of the alphabet's four runs.
+     * The step at each boundary a lane has passed adds up to that run's delta.
+     * Lanes outside the alphabet get 0x80 in errors; their result is garbage.
+     */
+    static FORCE_INLINE USIZE AsciiToSextets(USIZE lanes, USIZE &errors)
+    {
+        USIZE from43 = Swar::GreaterOrEqual(lanes, '+');
+        USIZE from44 = Swar::GreaterOrEqual(lanes, '+' + 1);
+        USIZE from47 = Swar::GreaterOrEqual(lanes, '/');
+        USIZE from48 = Swar::GreaterOrEqual(lanes, '0');
+        USIZE from58 = Swar::GreaterOrEqual(lanes, '9' + 1);
+        USIZE from65 = Swar::GreaterOrEqual(lanes, 'A');
+        USIZE from91 = Swar::GreaterOrEqual(lanes, 'Z' + 1);
+        USIZE from97 = Swar::GreaterOrEqual(lanes, 'a');
+        USIZE from123 = Swar::GreaterOrEqual(lanes, 'z' + 1);
+        USIZE valid = (from43 ^ from44) | (from47 ^ from58) | (from65 ^ from91) | (from97 ^ from123);
+        errors |= lanes | (valid ^ Swar::Broadcast(0x80));
+        // '+' 62, '/' 63, '0' 52, 'A' 0, 'a' 26
+        return lanes + (from43 >> 7) * 19 - ((from47 >> 7) * 3 + (from48 >> 7) * 12 + (from65 >> 7) * 69 + (from97 >> 7) * 6);
+    }
+
+public:
+    // Characters Encode writes for size bytes, without the null terminator
+    static constexpr USIZE GetEncodedLength(USIZE size) { return (size + 2) / 3 * 4; }
+
+    // Upper bound on the bytes Decode writes for length characters
+    static constexpr USIZE GetMaxDecodedLength(USIZE length) { return length / 4 * 3 + 2; }
+
+    /**
+     * Encode - Base64-encode bytes into null-terminated text
+     *
+     * @param data     - Bytes to encode
+     * @param size     - Number of bytes
+     * @param text     - Output buffer
+     * @param capacity - Output size in characters; at least GetEncodedLength(size) + 1
+     * @return Characters written before the terminator, or -1 if they do not fit
+     */
+    template <TCHAR TChar>
+    static SSIZE Encode(PCVOID data, USIZE size, TChar *text, USIZE capacity);
+
+    /**
+     * Decode - Decode Base64 text into bytes
+     *
+     * @param text     - Characters to decode (need not be null-terminated)
+     * @param length   - Number of characters, including any '=' padding
+     * @param data     - Output buffer
+     * @param capacity - Output size in bytes
+     * @return Bytes written, or -1 on invalid text or a too small buffer
+     */
+    template <TCHAR TChar>
+    static SSIZE Decode(const TChar *text, USIZE length, PVOID data, USIZE capacity);
+};
+
+class Hex
+{
+private:
+    // Bytes consumed and characters produced per word
+    static constexpr USIZE GroupBytes = SWAR_LANES / 2;
+    static constexpr USIZE GroupChars = SWAR_LANES;
+
+    static FORCE_INLINE USIZE LoadGroup(const UINT8 *data)
+    {
+        if constexpr (GroupBytes == 4)
+            return *(const UNALIGNED_UINT32 *)data;
+        else
+            return *(const UNALIGNED_UINT16 *)data;
+    }
+
+    static FORCE_INLINE VOID StoreGroup(UINT8 *data, USIZE bytes)
+    {
+        if constexpr (GroupBytes == 4)
+            *(UNALIGNED_UINT32 *)data = (UINT32)bytes;
+        else
+            *(UNALIGNED_UINT16 *)data = (UINT16)bytes;
+    }
+
+    // GroupBytes bytes as one nibble per lane, high nibble of each byte first
+    static FORCE_INLINE USIZE SplitNibbles(USIZE bytes)
+    {
+        // One byte per 16-bit lane, then its nibbles swapped into output order
+        if constexpr (sizeof(USIZE) == 8)
+            bytes = (bytes | (bytes << 16)) & Swar::Broadcast32(0xFFFF);
+        bytes = (bytes | (bytes << 8)) & Swar::Broadcast16(0xFF);
+        return ((bytes >> 4) & Swar::Broadcast16(0x0F)) | ((bytes & Swar::Broadcast16(0x0F)) << 8);
+    }
+
+    // Inverse of SplitNibbles
+    static FORCE_INLINE USIZE JoinNibbles(USIZE nibbles)
+    {
+        USIZE bytes = ((nibbles & Swar::Broadcast16(0x0F)) << 4) | ((nibbles >> 8) & Swar::Broadcast16(0x0F));
+        bytes = (bytes | (bytes >> 8)) & Swar::Broadcast32(0xFFFF);
+        if constexpr (sizeof(USIZE) == 8)
+            bytes = (bytes | (bytes >> 16)) & 0xFFFFFFFF;
+        return bytes;
+    }
+
+    // '0' + v, then +39 ('a') or +7 ('A') from 10
+    static FORCE_INLINE USIZE NibblesToAscii(USIZE nibbles, BOOL uppercase)
+    {
+        USIZE letters = Swar::GreaterOrEqual(nibbles, 10) >> 7;
+        return nibbles + Swar::Broadcast('0') + letters * (uppercase ? 7 : 39);
+    }
+
+    /**
+     * AsciiToNibbles - Inverse of NibblesToAscii for either case
+     *
+     * Same boundary scheme as Base64::AsciiToSextets: lanes outside 0-9, A-F
+     * and a-f get 0x80 in errors.
+     */
+    static FORCE_INLINE USIZE AsciiToNibbles(USIZE lanes, USIZE &errors)
+    {
+        USIZE from48 = Swar::GreaterOrEqual(lanes, '0');
+        USIZE from58 = Swar::GreaterOrEqual(lanes, '9' + 1);
+        USIZE from65 = Swar::GreaterOrEqual(lanes, 'A');
+        USIZE from71 = Swar::GreaterOrEqual(lanes, 'F' + 1);
+        USIZE from97 = Swar::GreaterOrEqual(lanes, 'a');
+        USIZE from103 = Swar::GreaterOrEqual(lanes, 'f' + 1);
+        USIZE valid = (from48 ^ from58) | (from65 ^ from71) | (from97 ^ from103);
+        errors |= lanes | (valid ^ Swar::Broadcast(0x80));
+        return lanes - ((from48 >> 7) * '0' + (from65 >> 7) * 7 + (from97 >> 7) * 32);
+    }
+
+public:
+    // Characters Encode writes for size bytes, without the null terminator
+    static constexpr USIZE GetEncodedLength(USIZE size) { return size * 2; }
+
+    /**
+     * Encode - Hex-encode bytes into null-terminated text
+     *
+     * @param data      - Bytes to encode
+     * @param size      - Number of bytes
+     * @param text      - Output buffer
+     * @param capacity  - Output size in characters; at least GetEncodedLength(size) + 1
+     * @param uppercase - Use A-F instead of a-f
+     * @return Characters written before the terminator, or -1 if they do not fit
+     */
+    template <TCHAR TChar>
+    static SSIZE Encode(PCVOID data, USIZE size, TChar *text, USIZE capacity, BOOL uppercase = FALSE);
+
+    /**
+     * Decode - Decode hex digits into bytes
+     *
+     * @param text     - Digits to decode, two per byte (need not be null-terminated)
+     * @param length   - Number of characters; must be even
+     * @param data     - Output buffer
+     * @param capacity - Output size in bytes
+     * @return Bytes written, or -1 on invalid text or a too small buffer
+     */
+    template <TCHAR TChar>
+    static SSIZE Decode(const TChar *text, USIZE length, PVOID data, USIZE capacity);
+};
+
+template <TCHAR TChar>
+SSIZE Base64::Encode(PCVOID data, USIZE size, TChar *text, USIZE capacity)
+{
+    USIZE length = GetEncodedLength(size);
+    if (size > (USIZE)-1 / 2 || capacity <= length)
+        return -1;
+
+    const UINT8 *input = (const UINT8 *)data;
+    TChar *output = text;
+    USIZE remaining = size;
+
+    // Each step loads a whole word but consumes GroupBytes of it
+    for (; remaining >= SWAR_LANES; remaining -= GroupBytes)
+    {
+        Swar::StoreChars(output, SextetsToAscii(SplitSextets(Swar::ByteSwap(Swar::Load(input)))));
+        input += GroupBytes;
+        output += GroupChars;
+    }
+
+    // The rest goes through the same path on zero-padded copies
+    while (remaining > 0)
+    {
+        USIZE chunk = remaining < GroupBytes ? remaining : GroupBytes;
+        UINT8 tail[SWAR_LANES] = {};
+        for (USIZE i = 0; i < chunk; i++)
+            tail[i] = input[i];
+        USIZE lanes = SextetsToAscii(SplitSextets(Swar::ByteSwap(Swar::Load(tail))));
+
+        USIZE used = (chunk * 4 + 2) / 3;
+        USIZE padded = (chunk + 2) / 3 * 4;
+        for (USIZE i = 0; i < padded; i++)
+            output[i] = i < used ? (TChar)((lanes >> (i * 8)) & 0xFF) : (TChar)'=';
+        input += chunk;
+        output += padded;
+        remaining -= chunk;
+    }
+
+    *output = (TChar)0;
+    return (SSIZE)length;
+}
+
+template <TCHAR TChar>
+SSIZE Base64::Decode(const TChar *text, USIZE length, PVOID data, USIZE capacity)
+{
+    // Up to two '=' when the text is padded to whole quads
+    if (length % 4 == 0 && length > 0 && text[length - 1] == (TChar)'=')
+    {
+        length--;
+        if (text[length - 1] == (TChar)'=')
+            length--;
+    }
+    if (length % 4 == 1)
+        return -1;
+
+    USIZE size = length / 4 * 3 + (length % 4 == 0 ? 0 : length % 4 - 1);
+    if (capacity < size)
+        return -1;
+
+    const TChar *input = text;
+    UINT8 *output = (UINT8 *)data;
+    UINT8 *outputEnd = output + size;
+    USIZE remaining = length;
+    USIZE errors = 0;
+
+    // Each step stores a whole word but advances by GroupBytes; invalid characters
+    // are collected in errors and reported once, keeping branches out of the loop
+    for (; remaining >= GroupChars && (USIZE)(outputEnd - output) >= SWAR_LANES; remaining -= GroupChars)
+    {
+        USIZE sextets = AsciiToSextets(Swar::LoadChars(input), errors);
+        Swar::Store(output, Swar::ByteSwap(JoinSextets(sextets)));
+        input += GroupChars;
+        output += GroupBytes;
+    }
+
+    // Pad with 'A' (zero bits) and keep only the bytes the real characters complete
+    while (remaining > 0)
+    {
+        USIZE chunk = remaining < GroupChars ? remaining : GroupChars;
+        TChar tail[GroupChars];
+        for (USIZE i = 0; i < GroupChars; i++)
+            tail[i] = i < chunk ? input[i] : (TChar)'A';
+        USIZE bytes = JoinSextets(AsciiToSextets(Swar::LoadChars(tail), errors));
+        for (USIZE i = 0; i < chunk * 3 / 4; i++)
+            output[i] = (UINT8)(bytes >> (SWAR_LANES * 8 - 8 * (i + 1)));
+        input += chunk;
+        output += chunk * 3 / 4;
+        remaining -= chunk;
+    }
+
+    if (Swar::HasHighBit(errors))
+        return -1;
+    return (SSIZE)size;
+}
+
+template <TCHAR TChar>
+SSIZE Hex::Encode(PCVOID data, USIZE size, TChar *text, USIZE capacity, BOOL uppercase)
+{
+    if (size > (USIZE)-1 / 2 || capacity <= size * 2)
+        return -1;
+
+    const UINT8 *input = (const UINT8 *)data;
+    TChar *output = text;
+    USIZE remaining = size;
+    for (; remaining >= GroupBytes; remaining -= GroupBytes)
+    {
+        Swar::StoreChars(output, NibblesToAscii(SplitNibbles(LoadGroup(input)), uppercase));
+        input += GroupBytes;
+        output += GroupChars;
+    }
+
+    if (remaining > 0)
+    {
+        UINT8 tail[GroupBytes] = {};
+        for (USIZE i = 0; i < remaining; i++)
+            tail[i] = input[i];
+        USIZE lanes = NibblesToAscii(SplitNibbles(LoadGroup(tail)), uppercase);
+        for (USIZE i = 0; i < remaining * 2; i++)
+            output[i] = (TChar)((lanes >> (i * 8)) & 0xFF);
+        output += remaining * 2;
+    }
+
+    *output = (TChar)0;
+    return (SSIZE)(size * 2);
+}
+
+template <TCHAR TChar>
+SSIZE Hex::Decode(const TChar *text, USIZE length, PVOID data, USIZE capacity)
+{
+    if (length % 2 != 0 || capacity < length / 2)
+        return -1;
+
+    const TChar *input = text;
+    UINT8 *output = (UINT8 *)data;
+    USIZE remaining = length;
+    USIZE errors = 0;
+    for (; remaining >= GroupChars; remaining -= GroupChars)
+    {
+        StoreGroup(output, JoinNibbles(AsciiToNibbles(Swar::LoadChars(input), errors)));
+        input += GroupChars;
+        output += GroupBytes;
+    }
+
+    if (remaining > 0)
+    {
+        TChar tail[GroupChars];
+        for (USIZE i = 0; i < GroupChars; i++)
+            tail[i] = i < remaining ? input[i] : (TChar)'0';
+        USIZE bytes = JoinNibbles(AsciiToNibbles(Swar::LoadChars(tail), errors));
+        for (USIZE i = 0; i < remaining / 2; i++)
+            output[i] = (UINT8)(bytes >> (i * 8));
+    }
+
+    if (Swar::HasHighBit(errors))
+        return -1;
+    return (SSIZE)(length / 2);
+}
@@ -0,0 +1,474 @@
+/**
+ * hash_map.h - Open-Addressing Hash Map
+ *
+ * HashMap<K, V> is a Swiss-table style map: next to the slots sits one
+ * control byte per slot, holding 7 bits of the hash for a full slot or a
+ * marker for an empty or deleted one. A lookup compares a whole group of
+ * control bytes against those 7 bits at once and only looks at the keys
+ * whose bytes match, so most misses touch no key at all.
+ *
+ * GROUPS:
+ *   x86_64/i386: 16 control bytes, SSE2 pcmpeqb + pmovmskb (inline asm:
+ *                the runtime is built with -msoft-float)
+ *   aarch64:     16 control bytes, NEON cmeq + shrn to a 4-bit-per-slot mask
+ *   armv7a:      4 control bytes in a word (SWAR, swar.h)
+ *   Groups are aligned and probed triangularly (1, 2, 3, ... groups on),
+ *   which visits every group of a power-of-two table.
+ *
+ * HASHES:
+ *   Every operation has an overload taking the key's hash, so a hash that
+ *   is already known (a Djb2 export name hash, a module hash) is used as
+ *   is. The others ask HashTraits<K> (the value itself for integers and
+ *   pointers). The hash is stored with the entry: growing never rehashes
+ *   keys, and a hash mismatch skips the key comparison. Hashes are mixed
+ *   with a multiply before use, so weak low bits are fine.
+ *
+ * LOAD:
+ *   At most 7/8 of the slots hold entries or tombstones; beyond that the
+ *   table doubles, or is rebuilt at the same size when mostly tombstones.
+ *   GetStatistics reports the load factor and probe lengths.
+ *
+ * USAGE:
+ *   HashMap<USIZE, PVOID> exports;
+ *   exports.Insert(hash, address, hash);   // key is the hash itself
+ *   PVOID *found = exports.Find(hash, hash);
+ *   for (auto &entry : exports) { entry.Key; entry.Value; }
+ */
+
+#pragma once
+
+#include "utility.h"
+#include "swar.h"
+#include "allocator_policy.h"
+
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386) || defined(ARCHITECTURE_AARCH64)
+#define HASH_MAP_GROUP_WIDTH 16
+#else
+#define HASH_MAP_GROUP_WIDTH SWAR_LANES
+#endif
+
+// Control byte values; a full slot holds the hash's low 7 bits
+#define HASH_MAP_EMPTY 0x80
+#define HASH_MAP_DELETED 0xFE
+
+/**
+ * HashGroup - Match operations on one group of control bytes
+ *
+ * Each returns a mask with one marker per matching slot; NextSlot gives
+ * the lowest marked slot and RemoveSlot clears it. MatchByte may report a
+ * slot that does not match (SWAR only), never miss one that does.
+ */
+class HashGroup
+{
+public:
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // One bit per slot
+    static FORCE_INLINE USIZE MatchByte(const UINT8 *group, UINT8 value)
+    {
+        UINT32 mask;
+        __asm__("movd %[value], %%xmm0\n\t"
+                "pshufd $0, %%xmm0, %%xmm0\n\t"
+                "movdqu %[group], %%xmm1\n\t"
+                "pcmpeqb %%xmm0, %%xmm1\n\t"
+                "pmovmskb %%xmm1, %[mask]"
+                : [mask] "=r"(mask)
+                : [value] "r"((UINT32)value * 0x01010101U), [group] "m"(*(const UINT8(*)[HASH_MAP_GROUP_WIDTH])group)
+                : "xmm0", "xmm1");
+        return mask;
+    }
+
+    // Empty and deleted are the control bytes with the top bit set
+    static FORCE_INLINE USIZE MatchEmptyOrDeleted(const UINT8 *group)
+    {
+        UINT32 mask;
+        __asm__("movdqu %[group], %%xmm0\n\t"
+                "pmovmskb %%xmm0, %[mask]"
+                : [mask] "=r"(mask)
+                : [group] "m"(*(const UINT8(*)[HASH_MAP_GROUP_WIDTH])group)
+                : "xmm0");
+        return mask;
+    }
+
+    static FORCE_INLINE USIZE MatchEmpty(const UINT8 *group) { return MatchByte(group, HASH_MAP_EMPTY); }
+    static FORCE_INLINE UINT32 NextSlot(USIZE mask) { return Swar::CountTrailingZeros(mask); }
+#elif defined(ARCHITECTURE_AARCH64)
+    // The top bit of a nibble per slot: shrn packs each 16-bit pair of compare lanes into a byte
+    static FORCE_INLINE USIZE MatchByte(const UINT8 *group, UINT8 value)
+    {
+        USIZE mask;
+        __asm__("ld1 {v0.16b}, [%[address]]\n\t"
+                "dup v1.16b, %w[value]\n\t"
+                "cmeq v0.16b, v0.16b, v1.16b\n\t"
+                "shrn v0.8b, v0.8h, #4\n\t"
+                "fmov %[mask], d0"
+                : [mask] "=r"(mask)
+                : [address] "r"(group), [value] "r"((UINT32)value), "m"(*(const UINT8(*)[HASH_MAP_GROUP_WIDTH])group)
+                : "v0", "v1");
+        return mask & Swar::Broadcast(0x88);
+    }
+
+    static FORCE_INLINE USIZE MatchEmptyOrDeleted(const UINT8 *group)
+    {
+        USIZE mask;
+        __asm__("ld1 {v0.16b}, [%[address]]\n\t"
+                "cmlt v0.16b, v0.16b, #0\n\t"
+                "shrn v0.8b, v0.8h, #4\n\t"
+                "fmov %[mask], d0"
+                : [mask] "=r"(mask)
+                : [address] "r"(group), "m"(*(const UINT8(*)[HASH_MAP_GROUP_WIDTH])group)
+                : "v0");
+        return mask & Swar::Broadcast(0x88);
+    }
+
+    static FORCE_INLINE USIZE MatchEmpty(const UINT8 *group) { return MatchByte(group, HASH_MAP_EMPTY); }
+    static FORCE_INLINE UINT32 NextSlot(USIZE mask) { return Swar::CountTrailingZeros(mask) / 4; }
+#else
+    // 0x80 per lane; a lane just above a real match may be marked too
+    static FORCE_INLINE USIZE MatchByte(const UINT8 *group, UINT8 value)
+    {
+        USIZE lanes = Swar::Load(group) ^ Swar::Broadcast(value);
+        return (lanes - Swar::Broadcast(0x01)) & ~lanes & Swar::Broadcast(0x80);
+    }
+
+    static FORCE_INLINE USIZE MatchEmptyOrDeleted(const UINT8 *group) { return Swar::Load(group) & Swar::Broadcast(0x80); }
+
+    // 0x80 has bit 1 clear and 0xFE has it set; << 6 lines bit 1 up with bit 7 of the same lane
+    static FORCE_INLINE USIZE MatchEmpty(const UINT8 *group)
+    {
+        USIZE lanes = Swar::Load(group);
+        return lanes & ~(lanes << 6) & Swar::Broadcast(0x80);
+    }
+
+    static FORCE_INLINE UINT32 NextSlot(USIZE mask) { return Swar::CountTrailingZeros(mask) / 8; }
+#endif
+
+    static FORCE_INLINE USIZE RemoveSlot(USIZE mask) { return mask & (mask - 1); }
+};
+
+// Hash and equality used when a call does not pass the hash
+template <typename K>
+struct HashTraits
+{
+    static USIZE Hash(const K &key) { return (USIZE)key; }
+    static BOOL Equals(const K &a, const K &b) { return a == b; }
+};
+
+template <typename K, typename V>
+struct HashMapEntry
+{
+    USIZE Hash; // As passed by the caller, before mixing
+    K Key;
+    V Value;
+};
+
+typedef struct _HASH_MAP_STATISTICS
+{
+    USIZE Size;             // Entries
+    USIZE Capacity;         // Slots
+    USIZE Tombstones;       // Deleted slots not yet reused
+    UINT32 LoadPercent;     // Entries per 100 slots
+    UINT32 MaxProbeLength;  // Most groups a lookup of a present key visits
+    USIZE TotalProbeLength; // Groups visited by looking up every entry once
+} HASH_MAP_STATISTICS, *PHASH_MAP_STATISTICS;
+
+template <typename K, typename V, typename Traits = HashTraits<K>, typename Alloc = HeapAllocator>
+class HashMap
+{
+private:
+    typedef HashMapEntry<K, V> Entry;
+
+    PUINT8 controls; // capacity control bytes, then the entries
+    Entry *entries;
+    USIZE capacity;  // Slots: a power of two, a multiple of HASH_MAP_GROUP_WIDTH
+    USIZE count;
+    USIZE growthLeft; // Empty slots that may still be filled before a rebuild
+    Alloc allocator;
+
+    static FORCE_INLINE USIZE Mix(USIZE hash)
+    {
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_AARCH64)
+        USIZE mixed = hash * (USIZE)0x9E3779B97F4A7C15ULL;
+#else
+        USIZE mixed = hash * (USIZE)0x9E3779B9U;
+#endif
+        return mixed ^ (mixed >> (sizeof(USIZE) * 4));
+    }
+
+    static FORCE_INLINE UINT8 GetTag(USIZE mixed) { return (UINT8)(mixed & 0x7F); }
+    USIZE GetGroupMask() const { return capacity / HASH_MAP_GROUP_WIDTH - 1; }
+    FORCE_INLINE USIZE GetHomeGroup(USIZE mixed) const { return (mixed >> 7) & GetGroupMask(); }
+
+    static USIZE GetBlockSize(USIZE slots) { return slots + slots * sizeof(Entry); }
+    static USIZE GetMaxLoad(USIZE slots) { return slots - slots / 8; }
+
+    // Slot holding key, or -1
+    FORCE_INLINE SSIZE FindSlot(const K &key, USIZE hash) const
+    {
+        if (capacity == 0)
+            return -1;
+        USIZE mixed = Mix(hash);
+        UINT8 tag = GetTag(mixed);
+        USIZE groupMask = GetGroupMask();
+        USIZE group = GetHomeGroup(mixed);
+        for (USIZE step = 1; step <= groupMask + 1; step++)
+        {
+            const UINT8 *controlGroup = controls + group * HASH_MAP_GROUP_WIDTH;
+            for (USIZE mask = HashGroup::MatchByte(controlGroup, tag); mask != 0; mask = HashGroup::RemoveSlot(mask))
+            {
+                USIZE slot = group * HASH_MAP_GROUP_WIDTH + HashGroup::NextSlot(mask);
+                if (entries[slot].Hash == hash && Traits::Equals(entries[slot].Key, key))
+                    return (SSIZE)slot;
+            }
+            // A key is never placed past a group that still has an empty slot
+            if (HashGroup::MatchEmpty(controlGroup) != 0)
+                return -1;
+            group = (group + step) & groupMask;
+        }
+        return -1;
+    }
+
+    // First empty or deleted slot on the probe sequence of mixed
+    USIZE FindFreeSlot(USIZE mixed) const
+    {
+        USIZE groupMask = GetGroupMask();
+        USIZE group = GetHomeGroup(mixed);
+        for (USIZE step = 1;; step++)
+        {
+            USIZE mask = HashGroup::MatchEmptyOrDeleted(controls + group * HASH_MAP_GROUP_WIDTH);
+            if (mask != 0)
+                return group * HASH_MAP_GROUP_WIDTH + HashGroup::NextSlot(mask);
+            group = (group + step) & groupMask;
+        }
+    }
+
+    // Move every entry into a table of newCapacity slots; tombstones are dropped
+    BOOL Rebuild(USIZE newCapacity)
+    {
+        PUINT8 block = (PUINT8)allocator.Allocate(GetBlockSize(newCapacity), HASH_MAP_GROUP_WIDTH);
+        if (block == NULL)
+            return FALSE;
+
+        PUINT8 oldControls = controls;
+        Entry *oldEntries = entries;
+        USIZE oldCapacity = capacity;
+
+        controls = block;
+        entries = (Entry *)(block + newCapacity);
+        capacity = newCapacity;
+        Memory::Set(controls, HASH_MAP_EMPTY, newCapacity);
+
+        for (USIZE i = 0; i < oldCapacity; i++)
+        {
+            if (oldControls[i] & 0x80)
+                continue;
+            USIZE mixed = Mix(oldEntries[i].Hash);
+            USIZE slot = FindFreeSlot(mixed);
+            controls[slot] = GetTag(mixed);
+            new (entries + slot) Entry(Move(oldEntries[i]));
+            oldEntries[i].~Entry();
+        }
+
+        if (oldControls != NULL)
+            allocator.Release(oldControls, GetBlockSize(oldCapacity), HASH_MAP_GROUP_WIDTH);
+        growthLeft = GetMaxLoad(newCapacity) - count;
+        return TRUE;
+    }
+
+    // Make room for one more entry: double, or rebuild in place when tombstones took the space
+    // (up to 25/32 full, a rebuild still frees 3/32 of the slots)
+    BOOL Grow()
+    {
+        if (capacity == 0)
+            return Rebuild(2 * HASH_MAP_GROUP_WIDTH);
+        if (count <= capacity / 32 * 25)
+            return Rebuild(capacity);
+        return Rebuild(capacity * 2);
+    }
+
+    VOID DestroyEntries()
+    {
+        for (USIZE i = 0; i < capacity; i++)
+        {
+            if ((controls[i] & 0x80) == 0)
+                entries[i].~Entry();
+        }
+    }
+
+public:
+    HashMap() : controls(NULL), entries(NULL), capacity(0), count(0), growthLeft(0), allocator() {}
+    explicit HashMap(const Alloc &policy) : controls(NULL), entries(NULL), capacity(0), count(0), growthLeft(0), allocator(policy) {}
+
+    ~HashMap()
+    {
+        DestroyEntries();
+        if (controls != NULL)
+            allocator.Release(controls, GetBlockSize(capacity), HASH_MAP_GROUP_WIDTH);
+    }
+
+    HashMap(const HashMap &) = delete;
+    HashMap &operator=(const HashMap &) = delete;
+
+    // Room for count entries without growing; FALSE if out of memory
+    BOOL Reserve(USIZE entryCount)
+    {
+        USIZE slots = capacity == 0 ? 2 * HASH_MAP_GROUP_WIDTH : capacity;
+        while (GetMaxLoad(slots) < entryCount)
+            slots *= 2;
+        return slots == capacity || Rebuild(slots);
+    }
+
+    /**
+     * Insert - Add key, or replace the value of an existing key
+     *
+     * @return FALSE if the table had to grow and could not (nothing changed)
+     */
+    BOOL Insert(const K &key, const V &value, USIZE hash)
+    {
+        SSIZE found = FindSlot(key, hash);
+        if (found >= 0)
+        {
+            entries[found].Value = value;
+            return TRUE;
+        }
+
+        USIZE mixed = Mix(hash);
+        USIZE slot = capacity == 0 ? 0 : FindFreeSlot(mixed);
+        if (capacity == 0 || (controls[slot] == HASH_MAP_EMPTY && growthLeft == 0))
+        {
+            if (!Grow())
+                return FALSE;
+            slot = FindFreeSlot(mixed);
+        }
+
+        // Reusing a tombstone does not use up an empty slot
+        if (controls[slot] == HASH_MAP_EMPTY)
+            growthLeft--;
+        controls[slot] = GetTag(mixed);
+        new (entries + slot) Entry{hash, key, value};
+        count++;
+        return TRUE;
+    }
+
+    BOOL Insert(const K &key, const V &value) { return Insert(key, value, Traits::Hash(key)); }
+
+    // Value stored for key, or NULL
+    FORCE_INLINE V *Find(const K &key, USIZE hash)
+    {
+        SSIZE slot = FindSlot(key, hash);
+        return slot < 0 ? NULL : &entries[slot].Value;
+    }
+
+    FORCE_INLINE const V *Find(const K &key, USIZE hash) const
+    {
+        SSIZE slot = FindSlot(key, hash);
+        return slot < 0 ? NULL : &entries[slot].Value;
+    }
+
+    FORCE_INLINE V *Find(const K &key) { return Find(key, Traits::Hash(key)); }
+    FORCE_INLINE const V *Find(const K &key) const { return Find(key, Traits::Hash(key)); }
+
+    BOOL Contains(const K &key, USIZE hash) const { return FindSlot(key, hash) >= 0; }
+    BOOL Contains(const K &key) const { return FindSlot(key, Traits::Hash(key)) >= 0; }
+
+    // Remove key; FALSE if it was not present
+    BOOL Remove(const K &key, USIZE hash)
+    {
+        SSIZE found = FindSlot(key, hash);
+        if (found < 0)
+            return FALSE;
+
+        USIZE slot = (USIZE)found;
+        entries[slot].~Entry();
+        count--;
+
+        // A group with an empty slot never had a lookup continue past it, so the slot may be
+        // empty again; otherwise a tombstone keeps later keys reachable
+        if (HashGroup::MatchEmpty(controls + (slot & ~(USIZE)(HASH_MAP_GROUP_WIDTH - 1))) != 0)
+        {
+            controls[slot] = HASH_MAP_EMPTY;
+            growthLeft++;
+        }
+        else
+        {
+            controls[slot] = HASH_MAP_DELETED;
+        }
+        return TRUE;
+    }
+
+    BOOL Remove(const K &key) { return Remove(key, Traits::Hash(key)); }
+
+    // Remove every entry; the table keeps its capacity
+    VOID Clear()
+    {
+        DestroyEntries();
+        if (controls != NULL)
+            Memory::Set(controls, HASH_MAP_EMPTY, capacity);
+        count = 0;
+        growthLeft = GetMaxLoad(capacity);
+    }
+
+    USIZE GetSize() const { return count; }
+    USIZE GetCapacity() const { return capacity; }
+    BOOL IsEmpty() const { return count == 0; }
+
+    // Walks the table and measures each entry's probe sequence
+    HASH_MAP_STATISTICS GetStatistics() const
+    {
+        HASH_MAP_STATISTICS statistics;
+        statistics.Size = count;
+        statistics.Capacity = capacity;
+        statistics.Tombstones = 0;
+        statistics.LoadPercent = capacity == 0 ? 0 : (UINT32)(count * 100 / capacity);
+        statistics.MaxProbeLength = 0;
+        statistics.TotalProbeLength = 0;
+
+        for (USIZE i = 0; i < capacity; i++)
+        {
+            if (controls[i] == HASH_MAP_DELETED)
+                statistics.Tombstones++;
+            if (controls[i] & 0x80)
+                continue;
+
+            USIZE group = GetHomeGroup(Mix(entries[i].Hash));
+            UINT32 length = 1;
+            while (group != i / HASH_MAP_GROUP_WIDTH)
+            {
+                group = (group + length) & GetGroupMask();
+                length++;
+            }
+            statistics.TotalProbeLength += length;
+            if (length > statistics.MaxProbeLength)
+                statistics.MaxProbeLength = length;
+        }
+        return statistics;
+    }
+
+    // Range-based for over the entries, in table order
+    class Iterator
+    {
+    private:
+        const HashMap *map;
+        USIZE slot;
+
+        VOID SkipFree()
+        {
+            while (slot < map->capacity && (map->controls[slot] & 0x80))
+                slot++;
+        }
+
+    public:
+        Iterator(const HashMap *owner, USIZE start) : map(owner), slot(start) { SkipFree(); }
+
+        Entry &operator*() const { return map->entries[slot]; }
+        Iterator &operator++()
+        {
+            slot++;
+            SkipFree();
+            return *this;
+        }
+        BOOL operator!=(const Iterator &other) const { return slot != other.slot; }
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, capacity); }
+};
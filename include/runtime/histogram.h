@@ -0,0 +1,145 @@
+/**
+ * histogram.h - Fixed-Size Log-Linear Histogram
+ *
+ * Records 64-bit samples (typically latencies in nanoseconds) without
+ * allocating. Each power of two is split into HISTOGRAM_SUB_BUCKETS linear
+ * buckets, so any percentile is reported within 1/16 (6.25%) of the true
+ * sample while the whole histogram stays a flat counter array.
+ *
+ * RANGE:
+ *   Values below 16 are counted exactly. Values of 2^40 (about 18 minutes
+ *   in nanoseconds) and above share the last bucket; Min/Max stay exact.
+ *
+ * USAGE:
+ *   Histogram latency;
+ *   latency.Record(elapsed);
+ *   UINT64 median = latency.GetPercentile(50);
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+#include "memory.h"
+
+// Linear buckets per power of two (a power of two)
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+// Values at or above 2^HISTOGRAM_MAX_EXPONENT land in the last bucket
+#define HISTOGRAM_MAX_EXPONENT 40
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+class Histogram
+{
+private:
+    UINT32 buckets[HISTOGRAM_BUCKETS];
+    UINT64 count;
+    UINT64 sum;
+    UINT64 minimum;
+    UINT64 maximum;
+
+    static UINT32 GetExponent(const UINT64 &value)
+    {
+        if (value.High() != 0)
+            return 63 - (UINT32)__builtin_clz(value.High());
+        return 31 - (UINT32)__builtin_clz(value.Low());
+    }
+
+    static USIZE GetBucketIndex(const UINT64 &value)
+    {
+        if (value < (UINT32)HISTOGRAM_SUB_BUCKETS)
+            return value.Low();
+
+        UINT32 exponent = GetExponent(value);
+        if (exponent >= HISTOGRAM_MAX_EXPONENT)
+            return HISTOGRAM_BUCKETS - 1;
+
+        // Bits below the leading one select the linear bucket
+        UINT32 shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+        UINT32 sub = (value >> (INT32)shift).Low() & (HISTOGRAM_SUB_BUCKETS - 1);
+        return (USIZE)(shift + 1) * HISTOGRAM_SUB_BUCKETS + sub;
+    }
+
+    // Largest value that maps to the bucket
+    static UINT64 GetBucketLimit(USIZE index)
+    {
+        if (index < HISTOGRAM_SUB_BUCKETS)
+            return UINT64((UINT32)index);
+
+        UINT32 shift = (UINT32)(index / HISTOGRAM_SUB_BUCKETS) - 1;
+        UINT32 sub = (UINT32)(index % HISTOGRAM_SUB_BUCKETS);
+        UINT64 lower = UINT64((UINT32)(HISTOGRAM_SUB_BUCKETS + sub)) << (INT32)shift;
+        return lower + ((UINT64(1U) << (INT32)shift) - 1U);
+    }
+
+public:
+    Histogram() { Reset(); }
+
+    VOID Reset()
+    {
+        Memory::Zero(buckets, sizeof(buckets));
+        count = UINT64();
+        sum = UINT64();
+        minimum = UINT64(0xFFFFFFFFU, 0xFFFFFFFFU);
+        maximum = UINT64();
+    }
+
+    VOID Record(UINT64 value)
+    {
+        buckets[GetBucketIndex(value)]++;
+        count += UINT64(1U);
+        sum += value;
+        if (value < minimum)
+            minimum = value;
+        if (value > maximum)
+            maximum = value;
+    }
+
+    // Add every sample of other, e.g. per-thread histograms into one
+    VOID Merge(const Histogram &other)
+    {
+        if (other.count == 0)
+            return;
+        for (USIZE i = 0; i < HISTOGRAM_BUCKETS; i++)
+            buckets[i] += other.buckets[i];
+        count += other.count;
+        sum += other.sum;
+        if (other.minimum < minimum)
+            minimum = other.minimum;
+        if (other.maximum > maximum)
+            maximum = other.maximum;
+    }
+
+    UINT64 GetCount() const { return count; }
+    UINT64 GetMinimum() const { return count == 0 ? UINT64() : minimum; }
+    UINT64 GetMaximum() const { return maximum; }
+    UINT64 GetMean() const { return count == 0 ? UINT64() : sum / count; }
+
+    // Smallest recorded value such that percent% of samples are at or below it (bucket precision)
+    UINT64 GetPercentile(UINT32 percent) const
+    {
+        if (count == 0)
+            return UINT64();
+        if (percent >= 100)
+            return maximum;
+
+        // Rank of the sample, 1-based, rounded up
+        UINT64 rank = (count * percent + 99U) / 100U;
+        if (rank == 0)
+            rank = UINT64(1U);
+
+        UINT64 seen;
+        for (USIZE i = 0; i < HISTOGRAM_BUCKETS; i++)
+        {
+            seen += UINT64(buckets[i]);
+            if (seen >= rank)
+            {
+                UINT64 limit = GetBucketLimit(i);
+                if (limit > maximum)
+                    return maximum;
+                return limit < minimum ? minimum : limit;
+            }
+        }
+        return maximum;
+    }
+};
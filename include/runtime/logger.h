@@ -8,22 +8,88 @@
  *   - Template-based for compile-time log level optimization
  *   - ANSI colors: Green (Info), Red (Error), Yellow (Warning/Debug)
  *   - Zero-overhead when LogLevel = None (code eliminated at compile-time)
+ *   - One character type per line, chosen by the sink: the prefix and color
+ *     reset are embedded in the sink's Char, so a CHAR sink receives CHAR
+ *     and a WCHAR sink WCHAR, with no conversion in between
  *
  * USAGE:
  *   LOG_INFO("Server started on port %d", 8080);
  *   LOG_ERROR("Failed to allocate %d bytes", size);
  *   LOG_DEBUG("Variable value: %d", x);
+ *   LOG_INFO_TO(NarrowConsoleSink, "Wrote %s", name); // CHAR all the way to the console
+ *   Logger::Info<WCHAR>(L"Opened %ls"_embed, path);   // Explicit character type
  */
 
 #pragma once
 
 #include "console.h"
 
-// Convenience macros that automatically embed wide strings
-#define LOG_INFO(format, ...) Logger::Info<WCHAR>(L##format##_embed, ##__VA_ARGS__)
-#define LOG_ERROR(format, ...) Logger::Error<WCHAR>(L##format##_embed, ##__VA_ARGS__)
-#define LOG_DEBUG(format, ...) Logger::Debug<WCHAR>(L##format##_embed, ##__VA_ARGS__)
-#define LOG_WARNING(format, ...) Logger::Warning<WCHAR>(L##format##_embed, ##__VA_ARGS__)
+/**
+ * Log sinks - Where log lines go, and in which character type
+ *
+ * A sink names its character type as Char and writes plain and formatted
+ * text in it. The prefix, message and color reset of a line are embedded
+ * as the sink's Char, so nothing is converted on the way. Each call picks
+ * its sink at compile time; a character type names the console in that
+ * type, so Logger::Info<WCHAR> and Logger::Info<ConsoleSink> are the same.
+ *
+ *   ConsoleSink       - WCHAR: a console shows every character through
+ *                       WriteConsoleW, and redirected output receives UTF-8
+ *   NarrowConsoleSink - CHAR: files and pipes receive the bytes unchanged;
+ *                       a console reads them in its active code page
+ */
+template <TCHAR TChar>
+struct BasicConsoleSink
+{
+	typedef TChar Char;
+
+	static VOID Write(const TChar *text) { Console::Write<TChar>(text); }
+	static VOID WriteFormattedV(const TChar *format, VA_LIST args) { Console::WriteFormattedV<TChar>(format, args); }
+};
+
+typedef BasicConsoleSink<WCHAR> ConsoleSink;
+typedef BasicConsoleSink<CHAR> NarrowConsoleSink;
+
+// A sink names itself; CHAR and WCHAR name the console in that type
+template <typename TTarget>
+struct LogSinkOf
+{
+	typedef TTarget Type;
+};
+
+template <>
+struct LogSinkOf<CHAR>
+{
+	typedef NarrowConsoleSink Type;
+};
+
+template <>
+struct LogSinkOf<WCHAR>
+{
+	typedef ConsoleSink Type;
+};
+
+template <typename TTarget>
+using LogSink = typename LogSinkOf<TTarget>::Type;
+
+// Character type a target's lines are written in
+template <typename TTarget>
+using LogChar = typename LogSink<TTarget>::Char;
+
+// Embed a literal as TSink's Char; only the chosen spelling is materialized
+#define LOG_EMBED(TSink, text) ([] { if constexpr (sizeof(LogChar<TSink>) == 1) return text##_embed; else return L##text##_embed; }())
+
+// Convenience macros that embed the format string as the sink's character type
+#define LOG_INFO_TO(TSink, format, ...) Logger::Info<TSink>(LOG_EMBED(TSink, format), ##__VA_ARGS__)
+#define LOG_ERROR_TO(TSink, format, ...) Logger::Error<TSink>(LOG_EMBED(TSink, format), ##__VA_ARGS__)
+#define LOG_DEBUG_TO(TSink, format, ...) Logger::Debug<TSink>(LOG_EMBED(TSink, format), ##__VA_ARGS__)
+#define LOG_WARNING_TO(TSink, format, ...) Logger::Warning<TSink>(LOG_EMBED(TSink, format), ##__VA_ARGS__)
+
+// The same, to the wide console
+#define LOG_INFO(format, ...) LOG_INFO_TO(ConsoleSink, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG_ERROR_TO(ConsoleSink, format, ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_DEBUG_TO(ConsoleSink, format, ##__VA_ARGS__)
+#define LOG_WARNING(format, ...) LOG_WARNING_TO(ConsoleSink, format, ##__VA_ARGS__)
 
 /**
  * LogLevels - Compile-time log filtering levels
@@ -66,14 +132,17 @@ private:
 	 * @param args   - Variadic argument list (already initialized)
 	 *
 	 * TEMPLATE PARAMETERS:
-	 *   TChar - Character type for format string (CHAR or WCHAR)
+	 *   TSink - Sink that receives the line; its Char types the prefix and format string
 	 */
-	template <TCHAR TChar>
-	FORCE_INLINE static VOID LogWithPrefixV(const WCHAR *prefix, const TChar *format, VA_LIST args)
+	template <typename TSink>
+	FORCE_INLINE static VOID LogWithPrefixV(const typename TSink::Char *prefix, const typename TSink::Char *format, VA_LIST args)
 	{
-		Console::Write<WCHAR>(prefix);                 // Colored prefix
-		Console::WriteFormattedV<TChar>(format, args); // User message
-		Console::Write<WCHAR>(L"\033[0m\n"_embed);     // Reset color + newline
+		TSink::Write(prefix);                 // Colored prefix
+		TSink::WriteFormattedV(format, args); // User message
+		if constexpr (sizeof(typename TSink::Char) == 1) // Reset color + newline
+			TSink::Write("\033[0m\n"_embed);
+		else
+			TSink::Write(L"\033[0m\n"_embed);
 	}
 
 public:
@@ -84,8 +153,8 @@ public:
 	 * Enabled when: LogLevel >= Default
 	 * Color: Green (ANSI: \033[0;32m)
 	 */
-	template <TCHAR TChar>
-	static VOID Info(const TChar *format, ...);
+	template <typename TTarget>
+	static VOID Info(const LogChar<TTarget> *format, ...);
 
 	/**
 	 * Error - Error messages (red)
@@ -94,8 +163,8 @@ public:
 	 * Enabled when: LogLevel >= Default
 	 * Color: Red (ANSI: \033[0;31m)
 	 */
-	template <TCHAR TChar>
-	static VOID Error(const TChar *format, ...);
+	template <typename TTarget>
+	static VOID Error(const LogChar<TTarget> *format, ...);
 
 	/**
 	 * Warning - Warning messages (yellow)
@@ -104,8 +173,8 @@ public:
 	 * Enabled when: LogLevel >= Default
 	 * Color: Yellow (ANSI: \033[0;33m)
 	 */
-	template <TCHAR TChar>
-	static VOID Warning(const TChar *format, ...);
+	template <typename TTarget>
+	static VOID Warning(const LogChar<TTarget> *format, ...);
 
 	/**
 	 * Debug - Debug messages (yellow)
@@ -114,8 +183,8 @@ public:
 	 * Enabled when: LogLevel >= Debug
 	 * Color: Yellow (ANSI: \033[0;33m)
 	 */
-	template <TCHAR TChar>
-	static VOID Debug(const TChar *format, ...);
+	template <typename TTarget>
+	static VOID Debug(const LogChar<TTarget> *format, ...);
 };
 
 // ============================================================================
@@ -129,14 +198,17 @@ public:
  *   - If LogLevel == None, entire function body is eliminated
  *   - No runtime overhead when logging is disabled
  */
-template <TCHAR TChar>
-VOID Logger::Info(const TChar *format, ...)
+template <typename TTarget>
+VOID Logger::Info(const LogChar<TTarget> *format, ...)
 {
 	if constexpr (LogLevel != LogLevels::None)
 	{
 		VA_LIST args;
 		VA_START(args, format);
-		LogWithPrefixV<TChar>(L"\033[0;32m[INFO] "_embed, format, args);
+		if constexpr (sizeof(LogChar<TTarget>) == 1)
+			LogWithPrefixV<LogSink<TTarget>>("\033[0;32m[INFO] "_embed, format, args);
+		else
+			LogWithPrefixV<LogSink<TTarget>>(L"\033[0;32m[INFO] "_embed, format, args);
 		VA_END(args);
 	}
 	else
@@ -151,14 +223,17 @@ VOID Logger::Info(const TChar *format, ...)
  * Enabled for Default and Debug log levels.
  * Uses red color to highlight critical issues.
  */
-template <TCHAR TChar>
-VOID Logger::Error(const TChar *format, ...)
+template <typename TTarget>
+VOID Logger::Error(const LogChar<TTarget> *format, ...)
 {
 	if constexpr (LogLevel != LogLevels::None)
 	{
 		VA_LIST args;
 		VA_START(args, format);
-		LogWithPrefixV<TChar>(L"\033[0;31m[ERROR] "_embed, format, args);
+		if constexpr (sizeof(LogChar<TTarget>) == 1)
+			LogWithPrefixV<LogSink<TTarget>>("\033[0;31m[ERROR] "_embed, format, args);
+		else
+			LogWithPrefixV<LogSink<TTarget>>(L"\033[0;31m[ERROR] "_embed, format, args);
 		VA_END(args);
 	}
 	else
@@ -173,14 +248,17 @@ VOID Logger::Error(const TChar *format, ...)
  * Enabled for Default and Debug log levels.
  * Uses yellow color for non-critical warnings.
  */
-template <TCHAR TChar>
-VOID Logger::Warning(const TChar *format, ...)
+template <typename TTarget>
+VOID Logger::Warning(const LogChar<TTarget> *format, ...)
 {
 	if constexpr (LogLevel != LogLevels::None)
 	{
 		VA_LIST args;
 		VA_START(args, format);
-		LogWithPrefixV<TChar>(L"\033[0;33m[WARNING] "_embed, format, args);
+		if constexpr (sizeof(LogChar<TTarget>) == 1)
+			LogWithPrefixV<LogSink<TTarget>>("\033[0;33m[WARNING] "_embed, format, args);
+		else
+			LogWithPrefixV<LogSink<TTarget>>(L"\033[0;33m[WARNING] "_embed, format, args);
 		VA_END(args);
 	}
 	else
@@ -195,14 +273,17 @@ VOID Logger::Warning(const TChar *format, ...)
  * Only enabled when LogLevel == Debug.
  * Compile-time check eliminates debug code in production builds.
  */
-template <TCHAR TChar>
-VOID Logger::Debug(const TChar *format, ...)
+template <typename TTarget>
+VOID Logger::Debug(const LogChar<TTarget> *format, ...)
 {
 	if constexpr (LogLevel == LogLevels::Debug)
 	{
 		VA_LIST args;
 		VA_START(args, format);
-		LogWithPrefixV<TChar>(L"\033[0;33m[DEBUG] "_embed, format, args);
+		if constexpr (sizeof(LogChar<TTarget>) == 1)
+			LogWithPrefixV<LogSink<TTarget>>("\033[0;33m[DEBUG] "_embed, format, args);
+		else
+			LogWithPrefixV<LogSink<TTarget>>(L"\033[0;33m[DEBUG] "_embed, format, args);
 		VA_END(args);
 	}
 	else
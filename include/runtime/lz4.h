@@ -0,0 +1,88 @@
+/**
+ * lz4.h - LZ4 Block Compression and Decompression
+ *
+ * Reads and writes the LZ4 block format (no frame header, no checksum): the
+ * blocks inside .lz4 frames and the payload written by scripts/pack.ps1.
+ * Blocks produced here decode with the reference lz4 library and the other
+ * way round. The self-decompressing stub of packed blobs (stub/start.cc)
+ * uses Decompress.
+ *
+ * BLOCK FORMAT:
+ *   A block is a series of sequences:
+ *     token       - high nibble literal length, low nibble match length - 4
+ *                   (15 means more length bytes follow, each added until one is < 255)
+ *     literals    - copied to the output as is
+ *     offset      - 2 bytes little-endian, distance back into the output (1-65535)
+ *   The last sequence ends after its literals and has no offset. Encoders
+ *   end every block with at least 5 literals and start the last match at
+ *   least 12 bytes before the end.
+ *
+ * COMPRESSION:
+ *   Greedy single-probe matching like the reference LZ4 fast mode: one
+ *   hash table lookup per position, skipping ahead faster through data
+ *   that does not match. The table (LZ4_HASH_ENTRIES positions) comes from
+ *   an arena, by default the thread's scratch arena; without one a smaller
+ *   table on the stack is used, at some cost in ratio.
+ *
+ * DECOMPRESSION:
+ *   Literals and matches are copied a word at a time while the buffers
+ *   have room for the overshoot. Matches closer than a word are first
+ *   widened to a multiple of their period, so word copies never read bytes
+ *   that have not been written yet. Near the buffer ends it falls back to
+ *   exact byte copies, and every length and offset is bounds-checked:
+ *   corrupt or truncated input fails with -1 and never touches memory
+ *   outside the two buffers.
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "arena.h"
+
+// Shortest match the format can express
+#define LZ4_MIN_MATCH 4
+// Largest input Compress accepts (the reference limit)
+#define LZ4_MAX_INPUT_SIZE 0x7E000000
+// Hash table entries for arena-backed compression (4 bytes each)
+#define LZ4_HASH_LOG 12
+#define LZ4_HASH_ENTRIES (1 << LZ4_HASH_LOG)
+// Fallback table on the stack when no arena memory is available
+#define LZ4_STACK_HASH_LOG 9
+
+class Lz4
+{
+public:
+    /**
+     * GetCompressBound - Largest block Compress can produce for sourceSize bytes
+     *
+     * Incompressible data grows by one length byte per 255 literals plus the token.
+     */
+    static constexpr USIZE GetCompressBound(USIZE sourceSize)
+    {
+        return sourceSize + sourceSize / 255 + 16;
+    }
+
+    /**
+     * Compress - Encode source as one LZ4 block
+     *
+     * @param source         - Data to compress (at most LZ4_MAX_INPUT_SIZE bytes)
+     * @param sourceSize     - Size of the data in bytes
+     * @param target         - Output buffer; GetCompressBound(sourceSize) bytes always suffice
+     * @param targetCapacity - Size of the output buffer in bytes
+     * @param arena          - Where the hash table is allocated (NULL: the thread's scratch arena);
+     *                         the arena is rewound before returning
+     * @return Size of the block, or -1 if it does not fit into targetCapacity
+     */
+    static SSIZE Compress(PCVOID source, USIZE sourceSize, PVOID target, USIZE targetCapacity, Arena *arena = NULL);
+
+    /**
+     * Decompress - Decode one LZ4 block
+     *
+     * @param source         - Compressed block
+     * @param sourceSize     - Size of the block in bytes
+     * @param target         - Output buffer
+     * @param targetCapacity - Size of the output buffer in bytes
+     * @return Number of bytes written, or -1 if the block is malformed or does not fit
+     */
+    static SSIZE Decompress(PCVOID source, USIZE sourceSize, PVOID target, USIZE targetCapacity);
+};
@@ -12,6 +12,8 @@ private:
     /* data */
 public:
     // Platform-specific allocation (implemented in platform-specific .cc files)
+    // size passed to ReleaseMemory must be the size that was allocated, or 0 if unknown;
+    // small sized frees are recycled through the calling thread's context
     static PVOID AllocateMemory(USIZE size);
     static VOID ReleaseMemory(PVOID ptr, USIZE size);
 
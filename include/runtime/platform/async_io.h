@@ -0,0 +1,213 @@
+/**
+ * async_io.h - Batched Asynchronous File I/O
+ *
+ * Submission/completion queue engine for overlapping many file reads and
+ * writes from one thread. Callers fill caller-owned ASYNC_REQUEST blocks,
+ * queue them, submit the whole queue at once and later reap completions in
+ * batches, so the number of kernel transitions grows with the number of
+ * batches rather than the number of requests.
+ *
+ * FLOW:
+ *   Queue()  - Append a prepared request to the submission queue (no syscall)
+ *   Submit() - Issue every queued request
+ *   Poll()   - Reap finished requests; optionally block until one finishes
+ *
+ * REGISTERED BUFFERS:
+ *   RegisterBuffers() sets up one page-aligned, pinned region split into
+ *   fixed-size buffers, reusable across requests without per-request
+ *   allocation and aligned for unbuffered (ASYNC_FILE_UNBUFFERED) I/O.
+ *
+ * COROUTINES:
+ *   co_await io.Read(...) / Write(...) / Flush(...) queue a request for the
+ *   awaiting coroutine. Install PollExecutor as the executor's poll routine:
+ *   when nothing is runnable it submits the queued requests in one batch and
+ *   resumes the coroutines whose requests finished.
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: I/O completion port. Files are opened for overlapped I/O and
+ *            bound to the port; requests that finish synchronously skip the
+ *            port entirely and completions are reaped with
+ *            NtRemoveIoCompletionEx, up to ASYNC_IO_REAP_BATCH per call.
+ *            NtFlushBuffersFile blocks and has no completion context, so
+ *            flushes run on a worker thread that posts each result to the
+ *            port; the engine thread never waits on a flush.
+ *
+ * USAGE:
+ *   AsyncIo io;
+ *   io.Create();
+ *   PVOID file = io.OpenFile(L"data.bin"_embed, ASYNC_FILE_READ);
+ *   ASYNC_REQUEST requests[4];
+ *   for (USIZE i = 0; i < 4; i++)
+ *   {
+ *       AsyncIo::PrepareRead(requests[i], file, buffers[i], 4096, i * 4096, NULL);
+ *       io.Queue(&requests[i]);
+ *   }
+ *   io.Submit();
+ *   PASYNC_REQUEST done[4];
+ *   USIZE count = io.Poll(done, 4, TRUE);
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+#include "coroutine.h"
+#include "file.h"
+#include "thread.h"
+
+// Requests held by the submission queue between Submit calls
+#define ASYNC_IO_QUEUE_DEPTH 64
+// Completions removed from the kernel per reap
+#define ASYNC_IO_REAP_BATCH 16
+
+// OpenFile flags (same values as the File open modes)
+#define ASYNC_FILE_READ FILE_MODE_READ
+#define ASYNC_FILE_WRITE FILE_MODE_WRITE
+#define ASYNC_FILE_CREATE FILE_MODE_CREATE
+#define ASYNC_FILE_UNBUFFERED FILE_MODE_UNBUFFERED
+#define ASYNC_FILE_SEQUENTIAL FILE_MODE_SEQUENTIAL
+#define ASYNC_FILE_RANDOM FILE_MODE_RANDOM
+#define ASYNC_FILE_TEMPORARY FILE_MODE_TEMPORARY
+
+enum class AsyncOperation : UINT8
+{
+    Read,
+    Write,
+    Flush
+};
+
+typedef struct _ASYNC_REQUEST
+{
+    USIZE IoStatus[2]; // Platform completion block, written by the kernel
+    PVOID File;
+    PVOID Buffer;
+    UINT32 Length;
+    AsyncOperation Operation;
+    UINT64 Offset;
+    PVOID UserData; // Returned untouched with the completion
+
+    // Filled in on completion; reading past the end succeeds with 0 bytes
+    INT32 Status; // 0 on success, platform status code otherwise
+    USIZE BytesTransferred;
+
+    struct _ASYNC_REQUEST *Next; // Internal: immediate completion list
+} ASYNC_REQUEST, *PASYNC_REQUEST;
+
+typedef struct _ASYNC_RESULT
+{
+    INT32 Status;
+    USIZE BytesTransferred;
+} ASYNC_RESULT;
+
+class AsyncIo
+{
+private:
+    PVOID port;
+
+    // Windows: flushes waiting for the flush worker, created with the first flush
+    PVOID flushQueue;
+    Thread flushWorker;
+
+    PASYNC_REQUEST submissions[ASYNC_IO_QUEUE_DEPTH];
+    USIZE submissionCount;
+    USIZE inFlight;
+
+    // Requests that finished while being issued, handed out by the next Poll
+    PASYNC_REQUEST immediateHead;
+    PASYNC_REQUEST immediateTail;
+
+    PUINT8 registeredBase;
+    USIZE registeredRegionSize;
+    USIZE registeredBufferSize;
+    USIZE registeredCount;
+
+    VOID CompleteImmediately(PASYNC_REQUEST request);
+
+    // Platform-specific (implemented in platform-specific .cc files)
+    BOOL CreatePort();
+    VOID ClosePort();
+    // FALSE if the request already finished and its result is filled in
+    BOOL Issue(PASYNC_REQUEST request);
+    BOOL StartFlushWorker();
+    static INT32 FlushWorker(PVOID context);
+    USIZE Reap(PASYNC_REQUEST *completed, USIZE maxCount, BOOL wait);
+    static PVOID AllocateRegion(USIZE size);
+    static VOID ReleaseRegion(PVOID region, USIZE size);
+
+public:
+    AsyncIo();
+    ~AsyncIo();
+
+    AsyncIo(const AsyncIo &) = delete;
+    AsyncIo &operator=(const AsyncIo &) = delete;
+
+    BOOL Create();
+    // Requests still in flight must be reaped first
+    VOID Destroy();
+    BOOL IsCreated() const { return port != NULL; }
+
+    // Open a file for asynchronous I/O through this engine; NULL on failure
+    PVOID OpenFile(const WCHAR *path, UINT32 flags);
+    static VOID CloseFile(PVOID file);
+
+    static VOID PrepareRead(ASYNC_REQUEST &request, PVOID file, PVOID buffer, UINT32 length, UINT64 offset, PVOID userData);
+    static VOID PrepareWrite(ASYNC_REQUEST &request, PVOID file, PCVOID buffer, UINT32 length, UINT64 offset, PVOID userData);
+    static VOID PrepareFlush(ASYNC_REQUEST &request, PVOID file, PVOID userData);
+
+    // Add a prepared request to the submission queue; FALSE when it is full.
+    // The request must stay valid until it is returned by Poll.
+    BOOL Queue(PASYNC_REQUEST request);
+
+    // Issue every queued request; returns how many were issued
+    USIZE Submit();
+
+    /**
+     * Poll - Collect finished requests
+     *
+     * @param wait Block until at least one request finishes, unless none are outstanding
+     * @return Number of requests stored in completed
+     */
+    USIZE Poll(PASYNC_REQUEST *completed, USIZE maxCount, BOOL wait);
+
+    USIZE GetQueuedCount() const { return submissionCount; }
+    USIZE GetInFlightCount() const { return inFlight; }
+
+    // Reserve count page-aligned buffers of at least size bytes each
+    BOOL RegisterBuffers(USIZE count, USIZE size);
+    VOID UnregisterBuffers();
+    PVOID GetRegisteredBuffer(USIZE index) const;
+    USIZE GetRegisteredBufferSize() const { return registeredBufferSize; }
+
+    /**
+     * Awaiter - Request issued on behalf of a suspended coroutine
+     *
+     * The coroutine handle travels in UserData, so an engine driven through
+     * PollExecutor must only carry requests created by these awaiters.
+     */
+    struct Awaiter
+    {
+        AsyncIo &Io;
+        ASYNC_REQUEST Request;
+
+        bool await_ready() const noexcept { return false; }
+
+        VOID await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            Request.UserData = handle.address();
+            if (!Io.Queue(&Request))
+            {
+                Io.Submit();
+                Io.Queue(&Request);
+            }
+        }
+
+        ASYNC_RESULT await_resume() const noexcept { return {Request.Status, Request.BytesTransferred}; }
+    };
+
+    Awaiter Read(PVOID file, PVOID buffer, UINT32 length, UINT64 offset);
+    Awaiter Write(PVOID file, PCVOID buffer, UINT32 length, UINT64 offset);
+    Awaiter Flush(PVOID file);
+
+    // Executor poll routine; context is the AsyncIo
+    static USIZE PollExecutor(PVOID context, Executor &executor);
+};
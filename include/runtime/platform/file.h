@@ -0,0 +1,151 @@
+/**
+ * file.h - Files and Buffered Streams
+ *
+ * File wraps a platform file handle with blocking read/write/seek. Buffered
+ * streams sit on top of it and turn many small reads or writes into a few
+ * large ones, which is what keeps sequential throughput near disk bandwidth.
+ *
+ * CLASSES:
+ *   File           - Open/Read/Write/Seek/Close on a platform handle
+ *   BufferedReader - Block reads with zero-copy line and record splitting
+ *   BufferedWriter - Accumulates writes and flushes them in large blocks
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: NtCreateFile (synchronous, non-alertable), NtReadFile,
+ *            NtWriteFile, NtQueryInformationFile/NtSetInformationFile for
+ *            position and size
+ *
+ * USAGE:
+ *   File file;
+ *   if (file.Open(L"C:\\logs\\app.log"_embed, FILE_MODE_READ | FILE_MODE_SEQUENTIAL))
+ *   {
+ *       BufferedReader reader(file);
+ *       PCCHAR line;
+ *       USIZE length;
+ *       while (reader.ReadLine(line, length))
+ *           Process(line, length);
+ *   }
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+
+// Open mode flags
+#define FILE_MODE_READ 0x01
+#define FILE_MODE_WRITE 0x02
+#define FILE_MODE_CREATE 0x04     // Create, or truncate an existing file
+#define FILE_MODE_UNBUFFERED 0x08 // Bypass the cache; buffers, offsets and lengths sector aligned
+#define FILE_MODE_SEQUENTIAL 0x10 // Access pattern hint
+#define FILE_MODE_RANDOM 0x20     // Access pattern hint
+#define FILE_MODE_TEMPORARY 0x40  // Deleted when closed
+#define FILE_MODE_APPEND 0x80     // Create if missing, start writing at the end
+
+class File
+{
+private:
+    PVOID handle;
+
+public:
+    File() : handle(NULL) {}
+    ~File() { Close(); }
+
+    File(const File &) = delete;
+    File &operator=(const File &) = delete;
+
+    BOOL Open(const WCHAR *path, UINT32 mode);
+    VOID Close();
+    BOOL IsOpen() const { return handle != NULL; }
+    PVOID GetHandle() const { return handle; }
+
+    // Platform-specific file operations (implemented in platform-specific .cc files)
+
+    // Open path and return its handle, or NULL; overlapped handles serve AsyncIo
+    static PVOID OpenHandle(const WCHAR *path, UINT32 mode, BOOL overlapped);
+    static VOID CloseHandle(PVOID fileHandle);
+
+    // Bytes read (0 at end of file), or -1 on error
+    SSIZE Read(PVOID buffer, USIZE size);
+    // Bytes written, or -1 on error
+    SSIZE Write(PCVOID buffer, USIZE size);
+    BOOL Seek(UINT64 position);
+    BOOL SeekToEnd();
+    UINT64 GetPosition() const;
+    UINT64 GetSize() const;
+    BOOL Flush();
+};
+
+/**
+ * BufferedReader - Reads a File in large blocks
+ *
+ * Lines and records are returned as views into the internal buffer, valid
+ * until the next call. A record longer than the buffer is returned in
+ * buffer-sized pieces.
+ */
+class BufferedReader
+{
+private:
+    File &file;
+    PUINT8 buffer;
+    USIZE capacity;
+    USIZE start; // First unconsumed byte
+    USIZE end;   // One past the last buffered byte
+    BOOL endOfFile;
+
+    // Keep the unconsumed bytes and read more behind them; FALSE when nothing new arrived
+    BOOL Refill();
+
+public:
+    static constexpr USIZE DefaultBufferSize = 256 * 1024;
+
+    explicit BufferedReader(File &source, USIZE bufferSize = DefaultBufferSize);
+    ~BufferedReader();
+
+    BufferedReader(const BufferedReader &) = delete;
+    BufferedReader &operator=(const BufferedReader &) = delete;
+
+    // Copy up to size bytes; large reads bypass the buffer. Returns bytes read, -1 on error
+    SSIZE Read(PVOID destination, USIZE size);
+
+    // Next record ending in delimiter (not included); FALSE at end of input
+    BOOL ReadRecord(UINT8 delimiter, PCCHAR &record, USIZE &length);
+
+    // Next line without its "\n" or "\r\n"; FALSE at end of input
+    BOOL ReadLine(PCCHAR &line, USIZE &length);
+
+    BOOL IsValid() const { return buffer != NULL; }
+};
+
+/**
+ * BufferedWriter - Collects writes and emits them in large blocks
+ *
+ * Writes at least as large as the buffer go straight to the file. The
+ * destructor flushes; call Flush to observe write errors.
+ */
+class BufferedWriter
+{
+private:
+    File &file;
+    PUINT8 buffer;
+    USIZE capacity;
+    USIZE used;
+    BOOL failed;
+
+public:
+    static constexpr USIZE DefaultBufferSize = 256 * 1024;
+
+    explicit BufferedWriter(File &target, USIZE bufferSize = DefaultBufferSize);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    BOOL Write(PCVOID data, USIZE size);
+    BOOL WriteLine(PCCHAR line, USIZE length);
+
+    // Write out buffered bytes; FALSE if this or any earlier write failed
+    BOOL Flush();
+
+    BOOL IsValid() const { return buffer != NULL; }
+};
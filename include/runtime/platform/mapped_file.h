@@ -0,0 +1,83 @@
+/**
+ * mapped_file.h - Memory-Mapped File Views
+ *
+ * Maps a whole file into the address space so read-mostly data (configs,
+ * lookup tables, PE images on disk) is parsed in place instead of being
+ * copied into heap buffers. Pages are faulted in from the file cache on
+ * first touch and shared with every other view of the same file.
+ *
+ * VIEWS:
+ *   ReadOnly    - Writes to the view fault
+ *   CopyOnWrite - Writes land in private pages; the file is never modified
+ *
+ * ACCESS HINTS:
+ *   Normal, Sequential and Random tune read-ahead for the backing file.
+ *   Prefetch asks the memory manager to bring a range in with large
+ *   reads before it is touched.
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: NtCreateSection (SEC_COMMIT) + NtMapViewOfSection, prefetch via
+ *            NtSetInformationVirtualMemory (Windows 8+) or by touching pages
+ *
+ * USAGE:
+ *   MappedFile table;
+ *   if (table.Open(L"table.txt"_embed, MappedView::ReadOnly, MappedAccess::Sequential))
+ *   {
+ *       UINT64 value;
+ *       USIZE used = String::ParseUInt64(table.GetText(), table.GetSize(), value);
+ *   }
+ *
+ * NOTE: The view is not null-terminated. Use the length-bounded String
+ * parsers (ParseUInt64, ParseInt64, ParseHex) over GetText()/GetSize().
+ */
+
+#pragma once
+
+#include "primitives.h"
+
+enum class MappedView : UINT8
+{
+    ReadOnly,
+    CopyOnWrite
+};
+
+enum class MappedAccess : UINT8
+{
+    Normal,
+    Sequential,
+    Random
+};
+
+class MappedFile
+{
+private:
+    PVOID section;
+    PUINT8 view;
+    USIZE size;
+    BOOL open;
+    BOOL writable;
+
+public:
+    MappedFile() : section(NULL), view(NULL), size(0), open(FALSE), writable(FALSE) {}
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Platform-specific mapping operations (implemented in platform-specific .cc files)
+
+    // Map the whole file; an empty file opens with a NULL view and size 0
+    BOOL Open(const WCHAR *path, MappedView mode = MappedView::ReadOnly, MappedAccess access = MappedAccess::Normal);
+    VOID Close();
+
+    // Start reading [offset, offset + length) into memory; clamped to the view, an empty range is a no-op
+    BOOL Prefetch(USIZE offset, USIZE length) const;
+
+    BOOL IsOpen() const { return open; }
+    const UINT8 *GetData() const { return view; }
+    PCCHAR GetText() const { return (PCCHAR)view; }
+    USIZE GetSize() const { return size; }
+
+    // Private copy-on-write pages, or NULL for read-only views
+    PUINT8 GetWritableData() const { return writable ? view : NULL; }
+};
@@ -7,7 +7,8 @@
 #include "embedded_double.h"
 #include "embedded_string.h"
 
-PVOID GetInstructionAddress(VOID);
+// Address of the instruction after the call; never inlined, so it is always inside the caller
+NOINLINE PVOID GetInstructionAddress(VOID);
 PCHAR ReversePatternSearch(PCHAR ip, const CHAR *pattern, UINT32 len);
 
 // Function to get export address from PEB modules
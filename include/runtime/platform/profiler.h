@@ -0,0 +1,116 @@
+/**
+ * profiler.h - Function-Level Cycle Profiler (PROFILE builds only)
+ *
+ * Configured with -DPROFILE=ON, every function that survives inlining is
+ * compiled with enter/exit hooks (-finstrument-functions-after-inlining).
+ * Each hook appends a 16-byte record - cycle count, event, code address -
+ * to a fixed per-thread buffer. Full buffers and the buffer left at
+ * ThreadContext::Detach are appended to profile-<id>.bin in the working
+ * directory, one file per thread.
+ *
+ * PROFILE_SCOPE() additionally brackets a region inside a function; its
+ * records carry the address of the scope, which the host tool reports as
+ * the containing function plus offset.
+ *
+ * ADDRESSES:
+ *   Records store code addresses relative to the hook itself
+ *   (__cyg_profile_func_enter), and every chunk header stores the hook's
+ *   runtime address. scripts/profile-collapse.ps1 looks the hook up in
+ *   output.map.txt, so offsets resolve to symbols wherever the blob ran.
+ *
+ * OVERHEAD:
+ *   Without PROFILE the hooks, thread context fields and PROFILE_SCOPE
+ *   compile to nothing. With it, each event costs a cycle counter read and
+ *   a store; flushing a full buffer is charged to the functions on the
+ *   stack at that moment.
+ *
+ * FILE FORMAT (little-endian, chunks repeat until end of file):
+ *   PROFILE_CHUNK_HEADER, then RecordCount PROFILE_RECORD entries
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+
+// Records per thread before the buffer is written out (16 bytes each)
+#define PROFILE_BUFFER_RECORDS 65536
+
+// 'PRF1'
+#define PROFILE_MAGIC 0x31465250
+
+#define PROFILE_EVENT_ENTER 0
+#define PROFILE_EVENT_EXIT 1
+
+typedef struct _PROFILE_CHUNK_HEADER
+{
+    UINT32 Magic;
+    UINT32 RecordCount;
+    UINT64 ThreadId;
+    UINT64 Anchor;         // Runtime address of __cyg_profile_func_enter
+    UINT64 CycleFrequency; // Timer::ReadCycles ticks per second
+} PROFILE_CHUNK_HEADER, *PPROFILE_CHUNK_HEADER;
+
+typedef struct _PROFILE_RECORD
+{
+    UINT64 Cycles;
+    UINT32 Event;
+    INT32 Offset; // Code address minus Anchor
+} PROFILE_RECORD, *PPROFILE_RECORD;
+
+typedef struct _PROFILE_BUFFER
+{
+    BOOL Created;  // Output file exists; later chunks are appended
+    UINT64 FileId; // Cycle count at allocation, names the output file
+    USIZE Anchor;  // Header.Anchor as an address
+    PROFILE_CHUNK_HEADER Header;
+    PROFILE_RECORD Records[PROFILE_BUFFER_RECORDS];
+} PROFILE_BUFFER, *PPROFILE_BUFFER;
+
+class Profiler
+{
+public:
+    // Append an event for the calling thread (no-op without a thread context)
+    NO_INSTRUMENT static VOID Record(PVOID address, UINT32 event);
+
+    // Write the calling thread's records to its output file
+    NO_INSTRUMENT static VOID Flush();
+
+    // Flush and free the calling thread's buffer (called by ThreadContext::Detach)
+    NO_INSTRUMENT static VOID Release();
+};
+
+#if defined(PROFILE)
+
+/**
+ * ProfileScope - Enter/exit records for a region inside a function
+ *
+ * The constructor is not inlined, so its return address is the scope's
+ * position in the enclosing function.
+ */
+class ProfileScope
+{
+private:
+    PVOID site;
+
+public:
+    NO_INSTRUMENT NOINLINE ProfileScope()
+    {
+        site = __builtin_return_address(0);
+        Profiler::Record(site, PROFILE_EVENT_ENTER);
+    }
+    NO_INSTRUMENT ~ProfileScope() { Profiler::Record(site, PROFILE_EVENT_EXIT); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_SCOPE_NAME(line) profileScope##line
+#define PROFILE_SCOPE_AT(line) ProfileScope PROFILE_SCOPE_NAME(line)
+#define PROFILE_SCOPE() PROFILE_SCOPE_AT(__LINE__)
+
+#else
+
+#define PROFILE_SCOPE()
+
+#endif
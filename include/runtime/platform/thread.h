@@ -0,0 +1,50 @@
+#pragma once
+
+#include "primitives.h"
+
+// Thread entry routine; the return value becomes the thread's exit code
+typedef INT32 (*THREAD_ROUTINE)(PVOID parameter);
+
+class Thread
+{
+private:
+    PVOID handle;  // Platform thread handle, NULL when not running
+    PVOID startup; // Heap block handed to the platform entry trampoline
+
+public:
+    // Default reserve for new thread stacks
+    static constexpr USIZE DefaultStackSize = 256 * 1024;
+
+    Thread() : handle(NULL), startup(NULL) {}
+
+    // A thread that was never joined is joined here: its startup block is written until it exits
+    ~Thread()
+    {
+        if (handle != NULL)
+            Join();
+    }
+
+    // Non-copyable: a handle has exactly one owner that must join it
+    Thread(const Thread &) = delete;
+    Thread &operator=(const Thread &) = delete;
+
+    // Platform-specific thread operations (implemented in platform-specific .cc files)
+
+    // Start routine(parameter) on a new thread with the given stack size
+    BOOL Create(THREAD_ROUTINE routine, PVOID parameter, USIZE stackSize = DefaultStackSize);
+    // Wait for the thread to finish, release its resources and return its exit code
+    INT32 Join();
+    // Give up the rest of the current time slice
+    static VOID Yield();
+    // Identifier of the calling thread
+    static USIZE GetCurrentId();
+    // Block the calling thread until another thread unparks it; may wake spuriously,
+    // so callers re-check their condition in a loop. address identifies the wait for debuggers
+    static VOID Park(PVOID address);
+    // Wake a parked thread by id; a wake that arrives before Park is not lost
+    static VOID Unpark(USIZE threadId);
+    // Number of logical processors available to the process (at least 1)
+    static UINT32 GetProcessorCount();
+
+    BOOL IsJoinable() const { return handle != NULL; }
+};
@@ -0,0 +1,137 @@
+/**
+ * thread_context.h - Per-Thread Runtime State
+ *
+ * The runtime links with -nostdlib and has no writable data section, so
+ * thread_local is not available. Instead each runtime thread owns a
+ * THREAD_CONTEXT (usually on its own stack) and a pointer to it is stored
+ * in a thread-private slot of the OS thread block, giving O(1) access from
+ * anywhere without locks.
+ *
+ * CONTENTS:
+ *   Scratch   - Lazily backed bump arena for temporary allocations
+ *   Allocator - Small-block free lists consulted by Allocator
+ *   Log       - Output buffer used by Console to emit one write per call
+ *   API cache - Resolved export addresses keyed by module/function hash
+ *   Frames    - Coroutine frame pool of the thread's executor, if any
+ *   Timer     - Cycle counter frequency, read or calibrated
+ *   Tables    - Lookup tables generated on first use (CRC32C slicing tables)
+ *   Profile   - Enter/exit record buffer (PROFILE builds only)
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: TEB->NtTib.SubSystemTib (gs:[0x18], fs:[0x0C], x18+0x18)
+ *            The loader's ActiveRpcHandle slot is left untouched.
+ *
+ * LIFETIME:
+ *   _start attaches a context for the main thread and Thread attaches one
+ *   for every thread it creates. Code running on a foreign thread sees
+ *   Get() == NULL and every consumer falls back to its uncached path.
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+#include "arena.h"
+
+class FramePool;
+struct _PROFILE_BUFFER;
+
+// Small-block size classes: 16, 32, 64, 128, 256 bytes
+#define ALLOCATOR_CACHE_CLASSES 5
+#define ALLOCATOR_CACHE_MIN_SIZE 16
+#define ALLOCATOR_CACHE_MAX_SIZE 256
+// Blocks kept per class before frees go back to the heap
+#define ALLOCATOR_CACHE_DEPTH 32
+
+// Bytes of formatted output buffered before a console write
+#define THREAD_LOG_BUFFER_SIZE 512
+
+// Direct-mapped entries of the resolved-API cache (power of two)
+#define API_CACHE_ENTRIES 32
+
+// Default reserve of the scratch arena, allocated on first use
+#define SCRATCH_ARENA_SIZE (64 * 1024)
+
+// Reserve of the table arena, allocated on first use; holds the CRC32C tables
+#define TABLE_ARENA_SIZE (8 * 1024)
+
+typedef struct _API_CACHE_ENTRY
+{
+    USIZE ModuleHash;
+    USIZE FunctionHash;
+    PVOID Address;
+} API_CACHE_ENTRY, *PAPI_CACHE_ENTRY;
+
+typedef struct _THREAD_CONTEXT
+{
+    PVOID PreviousSlotValue; // Restored on Detach
+    USIZE ThreadId;
+
+    Arena Scratch;
+
+    PVOID FreeLists[ALLOCATOR_CACHE_CLASSES];
+    UINT32 FreeCounts[ALLOCATOR_CACHE_CLASSES];
+
+    USIZE LogLength; // Bytes used in LogBuffer
+    alignas(USIZE) UINT8 LogBuffer[THREAD_LOG_BUFFER_SIZE];
+
+    API_CACHE_ENTRY ApiCache[API_CACHE_ENTRIES];
+
+    FramePool *Frames; // Coroutine frame pool of the executor on this thread
+
+    UINT64 CycleFrequency; // Timer::ReadCycles ticks per second, 0 until first use
+
+    Arena Tables;              // Generated lookup tables; never rewound, released on Detach
+    const UINT32 *Crc32cTable; // Slicing-by-8 tables in Tables, NULL until first needed
+    INT32 Crc32cHardware;      // 1 if CRC32C instructions are available, 0 if not, -1 until detected
+    INT32 Sha256Hardware;      // Same for the SHA-256 instructions
+
+#if defined(PROFILE)
+    struct _PROFILE_BUFFER *Profile; // Enter/exit records, allocated on the first event
+    BOOL ProfileBusy;                // Profiler running on this thread; nested events are dropped
+#endif
+} THREAD_CONTEXT, *PTHREAD_CONTEXT;
+
+class ThreadContext
+{
+private:
+    // Platform-specific slot access (implemented in platform-specific .cc files)
+    NO_INSTRUMENT static PVOID ReadSlot();
+    static VOID WriteSlot(PVOID value);
+
+public:
+    // Context of the calling thread, or NULL if none is attached
+    NO_INSTRUMENT static PTHREAD_CONTEXT Get();
+
+    // Install context for the calling thread; it must outlive the matching Detach
+    static VOID Attach(PTHREAD_CONTEXT context);
+
+    // Return cached blocks, free the scratch arena and uninstall the context
+    static VOID Detach();
+
+    // Scratch arena of the calling thread, backed on first use; NULL without a context
+    static Arena *GetScratch();
+
+    // Table arena of the calling thread, backed on first use; NULL without a context
+    static Arena *GetTables();
+
+    // Size class of a small allocation, or -1 if it is too large to cache
+    static FORCE_INLINE INT32 GetSizeClass(USIZE size)
+    {
+        if (size > ALLOCATOR_CACHE_MAX_SIZE)
+            return -1;
+        INT32 sizeClass = 0;
+        USIZE classSize = ALLOCATOR_CACHE_MIN_SIZE;
+        while (classSize < size)
+        {
+            classSize <<= 1;
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+
+    static FORCE_INLINE USIZE GetClassSize(INT32 sizeClass)
+    {
+        return (USIZE)ALLOCATOR_CACHE_MIN_SIZE << sizeClass;
+    }
+};
@@ -0,0 +1,130 @@
+/**
+ * timer.h - Cycle Counter, Monotonic Clock and Stopwatch
+ *
+ * Two time sources with different trade-offs:
+ *   ReadCycles     - Raw CPU counter, a handful of cycles per read, not
+ *                    serializing; the right tool for timing short code paths
+ *   GetNanoseconds - Monotonic wall clock in nanoseconds, unaffected by
+ *                    system time changes; the right tool for timeouts
+ *
+ * Cycle counts are converted with GetCycleFrequency. Where the platform
+ * publishes the counter's frequency it is read; otherwise it is measured
+ * against the monotonic clock once per thread and cached in the thread
+ * context (there is no writable global to keep it in). Threads without a
+ * context never measure: they get the published frequency, or 0 (and
+ * conversions yield 0) where there is none.
+ *
+ * CYCLE COUNTERS:
+ *   x86_64/i386: rdtsc (rdtscp for ordered reads); published frequency when
+ *                QPC is derived from the TSC by a shift, else calibrated
+ *                (~10 ms, once per thread)
+ *   aarch64:     cntvct_el0, frequency read from cntfrq_el0
+ *   armv7a:      PMCCNTR is not reliably enabled for user mode, so the
+ *                monotonic clock's counter is used instead
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: Counter from RtlQueryPerformanceCounter (reads the
+ *            KUSER_SHARED_DATA QPC fields, no system call on current
+ *            systems); frequency from KUSER_SHARED_DATA.QpcFrequency on
+ *            Windows 10+, RtlQueryPerformanceFrequency before that;
+ *            TSC frequency from the QpcBypassEnabled/QpcShift fields
+ *
+ * USAGE:
+ *   Histogram latency;
+ *   for (USIZE i = 0; i < 1000; i++)
+ *   {
+ *       Stopwatch watch(latency);
+ *       DoWork();
+ *   }
+ *   UINT64 p99 = latency.GetPercentile(99);
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+#include "histogram.h"
+
+class Timer
+{
+private:
+    // Platform-specific clock (implemented in platform-specific .cc files)
+    static UINT64 ReadClock();
+    static UINT64 GetClockFrequency();
+    // ReadCycles frequency known without measuring it; 0 if there is none
+    static UINT64 GetPublishedCycleFrequency();
+
+public:
+    // Raw counter value; reads may be reordered with surrounding instructions
+    static FORCE_INLINE UINT64 ReadCycles()
+    {
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+        UINT32 low, high;
+        __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+        return UINT64(high, low);
+#elif defined(ARCHITECTURE_AARCH64)
+        unsigned long long value;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+        return UINT64(value);
+#else
+        return ReadClock();
+#endif
+    }
+
+    // Counter value read only after all earlier instructions have completed
+    static FORCE_INLINE UINT64 ReadCyclesOrdered()
+    {
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+        UINT32 low, high;
+        __asm__ __volatile__("rdtscp" : "=a"(low), "=d"(high)::"ecx", "memory");
+        return UINT64(high, low);
+#elif defined(ARCHITECTURE_AARCH64)
+        unsigned long long value;
+        __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(value)::"memory");
+        return UINT64(value);
+#else
+        return ReadClock();
+#endif
+    }
+
+    // Monotonic time in nanoseconds since an arbitrary point (usually boot)
+    static UINT64 GetNanoseconds();
+
+    // ReadCycles ticks per second; cached per thread, 0 on a thread without a context if unpublished
+    static UINT64 GetCycleFrequency();
+
+    // Measure ReadCycles against the monotonic clock (busy-waits about 10 ms)
+    static UINT64 Calibrate();
+
+    static UINT64 CyclesToNanoseconds(UINT64 cycles);
+};
+
+/**
+ * Stopwatch - Measures the time since construction or Restart
+ *
+ * Built on ReadCycles, so a start/stop pair costs tens of cycles. When
+ * constructed with a Histogram the elapsed nanoseconds are recorded into it
+ * as the stopwatch goes out of scope.
+ */
+class Stopwatch
+{
+private:
+    UINT64 start;
+    Histogram *sink;
+
+public:
+    Stopwatch() : start(Timer::ReadCycles()), sink(NULL) {}
+    explicit Stopwatch(Histogram &histogram) : start(Timer::ReadCycles()), sink(&histogram) {}
+    ~Stopwatch()
+    {
+        if (sink != NULL)
+            sink->Record(GetElapsedNanoseconds());
+    }
+
+    Stopwatch(const Stopwatch &) = delete;
+    Stopwatch &operator=(const Stopwatch &) = delete;
+
+    VOID Restart() { start = Timer::ReadCycles(); }
+    UINT64 GetElapsedCycles() const { return Timer::ReadCycles() - start; }
+    UINT64 GetElapsedNanoseconds() const { return Timer::CyclesToNanoseconds(GetElapsedCycles()); }
+};
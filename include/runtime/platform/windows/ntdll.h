@@ -5,6 +5,8 @@
 #include "platform.h"
 #include "djb2.h"
 
+#define THREAD_ALL_ACCESS 0x001FFFFF
+
 // NTDLL API Wrappers
 class NTDLL
 {
@@ -13,6 +15,33 @@ public:
 	static PVOID RtlAllocateHeap(PVOID HeapHandle, INT32 Flags, USIZE Size);
 	static BOOL RtlFreeHeap(PVOID HeapHandle, INT32 Flags, PVOID Pointer);
 	static NTSTATUS ZwTerminateProcess(PVOID ProcessHandle, NTSTATUS ExitStatus);
+	static NTSTATUS NtCreateThreadEx(PPVOID ThreadHandle, UINT32 DesiredAccess, PVOID ObjectAttributes, PVOID ProcessHandle, PVOID StartRoutine, PVOID Argument, UINT32 CreateFlags, USIZE ZeroBits, USIZE StackSize, USIZE MaximumStackSize, PVOID AttributeList);
+	static NTSTATUS NtWaitForSingleObject(PVOID Handle, BOOL Alertable, PVOID Timeout);
+	static NTSTATUS NtYieldExecution();
+	static NTSTATUS NtClose(PVOID Handle);
+	static NTSTATUS NtWaitForAlertByThreadId(PVOID Address, PVOID Timeout);
+	static NTSTATUS NtAlertThreadByThreadId(PVOID ThreadId);
+	static NTSTATUS NtQuerySystemInformation(UINT32 SystemInformationClass, PVOID SystemInformation, UINT32 SystemInformationLength, PUINT32 ReturnLength);
+	static NTSTATUS NtAllocateVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, PUSIZE RegionSize, UINT32 AllocationType, UINT32 Protect);
+	static NTSTATUS NtFreeVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 FreeType);
+	static NTSTATUS NtProtectVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 NewProtect, PUINT32 OldProtect);
+	static NTSTATUS NtFlushInstructionCache(PVOID ProcessHandle, PVOID BaseAddress, USIZE Length);
+	static NTSTATUS NtLockVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 MapType);
+	static NTSTATUS NtCreateFile(PPVOID FileHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PIO_STATUS_BLOCK IoStatusBlock, PVOID AllocationSize, UINT32 FileAttributes, UINT32 ShareAccess, UINT32 CreateDisposition, UINT32 CreateOptions, PVOID EaBuffer, UINT32 EaLength);
+	static NTSTATUS NtReadFile(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key);
+	static NTSTATUS NtWriteFile(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key);
+	static NTSTATUS NtFlushBuffersFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock);
+	static NTSTATUS NtQueryInformationFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass);
+	static NTSTATUS NtSetInformationFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass);
+	static NTSTATUS NtCreateSection(PPVOID SectionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PVOID MaximumSize, UINT32 SectionPageProtection, UINT32 AllocationAttributes, PVOID FileHandle);
+	static NTSTATUS NtMapViewOfSection(PVOID SectionHandle, PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, USIZE CommitSize, PVOID SectionOffset, PUSIZE ViewSize, UINT32 InheritDisposition, UINT32 AllocationType, UINT32 Win32Protect);
+	static NTSTATUS NtUnmapViewOfSection(PVOID ProcessHandle, PVOID BaseAddress);
+	static NTSTATUS NtSetInformationVirtualMemory(PVOID ProcessHandle, UINT32 VmInformationClass, USIZE NumberOfEntries, PMEMORY_RANGE_ENTRY VirtualAddresses, PVOID VmInformation, UINT32 VmInformationLength);
+	static BOOL RtlQueryPerformanceCounter(PUINT64 PerformanceCounter);
+	static BOOL RtlQueryPerformanceFrequency(PUINT64 PerformanceFrequency);
+	static NTSTATUS NtCreateIoCompletion(PPVOID IoCompletionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, UINT32 NumberOfConcurrentThreads);
+	static NTSTATUS NtSetIoCompletion(PVOID IoCompletionHandle, PVOID KeyContext, PVOID ApcContext, NTSTATUS IoStatus, USIZE IoStatusInformation);
+	static NTSTATUS NtRemoveIoCompletionEx(PVOID IoCompletionHandle, PFILE_IO_COMPLETION_INFORMATION IoCompletionInformation, UINT32 Count, PUINT32 NumEntriesRemoved, PVOID Timeout, BOOL Alertable);
 	static PVOID NtCurrentProcess() { return (PVOID)(USIZE)-1L; }
 	static PVOID NtCurrentThread() { return (PVOID)(USIZE)-2L; }
 };
@@ -44,6 +44,13 @@ typedef struct _PEB_LDR_DATA
     LIST_ENTRY InInitializationOrderModuleList;
 } PEB_LDR_DATA, *PPEB_LDR_DATA;
 
+// Current directory of a process
+typedef struct _CURDIR
+{
+    UNICODE_STRING DosPath;
+    PVOID Handle;
+} CURDIR, *PCURDIR;
+
 // Process parameters structure
 typedef struct _RTL_USER_PROCESS_PARAMETERS
 {
@@ -56,6 +63,7 @@ typedef struct _RTL_USER_PROCESS_PARAMETERS
     PVOID StandardInput;
     PVOID StandardOutput;
     PVOID StandardError;
+    CURDIR CurrentDirectory;
 } RTL_USER_PROCESS_PARAMETERS, *PRTL_USER_PROCESS_PARAMETERS;
 
 // Process Environment Block
@@ -73,8 +81,33 @@ typedef struct _PEB
     PVOID ProcessHeap;
 } PEB, *PPEB;
 
+// Thread information block (leading part of the TEB)
+typedef struct _NT_TIB
+{
+    PVOID ExceptionList;
+    PVOID StackBase;
+    PVOID StackLimit;
+    PVOID SubSystemTib;
+    PVOID FiberData;
+    PVOID ArbitraryUserPointer;
+    struct _NT_TIB *Self;
+} NT_TIB, *PNT_TIB;
+
+// Thread Environment Block (only the fields the runtime reads)
+typedef struct _TEB
+{
+    NT_TIB NtTib;
+    PVOID EnvironmentPointer;
+    CLIENT_ID ClientId;
+    PVOID ActiveRpcHandle;
+    PVOID ThreadLocalStoragePointer;
+    PPEB ProcessEnvironmentBlock;
+} TEB, *PTEB;
+
 // Function to get the current process's PEB pointer
 PPEB GetCurrentPEB(VOID);
+// Function to get the current thread's TEB pointer
+PTEB GetCurrentTEB(VOID);
 // Function to resolve module handle by its name
 PVOID GetModuleHandleFromPEB(USIZE moduleNameHash);
 
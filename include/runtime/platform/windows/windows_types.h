@@ -1,10 +1,14 @@
 #pragma once
 
 #include "primitives.h"
+#include "uint64.h"
 
 // NTSTATUS type definition
 typedef INT32 NTSTATUS;
 
+// Success and informational codes are non-negative
+#define NT_SUCCESS(Status) (((NTSTATUS)(Status)) >= 0)
+
 // Structure for async I/O operations
 typedef struct _OVERLAPPED
 {
@@ -31,3 +35,170 @@ typedef struct _UNICODE_STRING
     PWCHAR Buffer;
 } UNICODE_STRING, *PUNICODE_STRING;
 
+// SystemBasicInformation class for NtQuerySystemInformation
+#define SystemBasicInformation 0
+
+// Basic system information (processor count, page size)
+typedef struct _SYSTEM_BASIC_INFORMATION
+{
+    UINT32 Reserved;
+    UINT32 TimerResolution;
+    UINT32 PageSize;
+    UINT32 NumberOfPhysicalPages;
+    UINT32 LowestPhysicalPageNumber;
+    UINT32 HighestPhysicalPageNumber;
+    UINT32 AllocationGranularity;
+    USIZE MinimumUserModeAddress;
+    USIZE MaximumUserModeAddress;
+    USIZE ActiveProcessorsAffinityMask;
+    UINT8 NumberOfProcessors;
+} SYSTEM_BASIC_INFORMATION, *PSYSTEM_BASIC_INFORMATION;
+
+// Process and thread identifiers as stored in the TEB
+typedef struct _CLIENT_ID
+{
+    PVOID UniqueProcess;
+    PVOID UniqueThread;
+} CLIENT_ID, *PCLIENT_ID;
+
+
+// Status codes checked by the I/O paths
+#define STATUS_SUCCESS ((NTSTATUS)0x00000000)
+#define STATUS_TIMEOUT ((NTSTATUS)0x00000102)
+#define STATUS_PENDING ((NTSTATUS)0x00000103)
+#define STATUS_END_OF_FILE ((NTSTATUS)0xC0000011)
+#define STATUS_NO_MEMORY ((NTSTATUS)0xC0000017)
+#define STATUS_NOT_IMPLEMENTED ((NTSTATUS)0xC0000002)
+
+// Error codes have both severity bits set
+#define NT_ERROR(Status) ((((UINT32)(Status)) >> 30) == 3)
+
+// Completion status of an I/O request
+typedef struct _IO_STATUS_BLOCK
+{
+    union
+    {
+        NTSTATUS Status;
+        PVOID Pointer;
+    };
+    USIZE Information;
+} IO_STATUS_BLOCK, *PIO_STATUS_BLOCK;
+
+// Named object passed to NtCreateFile and friends
+typedef struct _OBJECT_ATTRIBUTES
+{
+    UINT32 Length;
+    PVOID RootDirectory;
+    PUNICODE_STRING ObjectName;
+    UINT32 Attributes;
+    PVOID SecurityDescriptor;
+    PVOID SecurityQualityOfService;
+} OBJECT_ATTRIBUTES, *POBJECT_ATTRIBUTES;
+
+#define OBJ_CASE_INSENSITIVE 0x00000040
+
+// Access rights
+#define DELETE 0x00010000
+#define SYNCHRONIZE 0x00100000
+#define GENERIC_READ 0x80000000
+#define GENERIC_WRITE 0x40000000
+#define IO_COMPLETION_ALL_ACCESS 0x001F0003
+
+// NtCreateFile attributes, sharing, disposition and options
+#define FILE_ATTRIBUTE_NORMAL 0x00000080
+#define FILE_SHARE_READ 0x00000001
+#define FILE_SHARE_WRITE 0x00000002
+#define FILE_SHARE_DELETE 0x00000004
+#define FILE_OPEN 0x00000001
+#define FILE_OPEN_IF 0x00000003
+#define FILE_OVERWRITE_IF 0x00000005
+#define FILE_SEQUENTIAL_ONLY 0x00000004
+#define FILE_NO_INTERMEDIATE_BUFFERING 0x00000008
+#define FILE_SYNCHRONOUS_IO_NONALERT 0x00000020
+#define FILE_NON_DIRECTORY_FILE 0x00000040
+#define FILE_RANDOM_ACCESS 0x00000800
+#define FILE_DELETE_ON_CLOSE 0x00001000
+
+// FILE_INFORMATION_CLASS values used with NtQueryInformationFile/NtSetInformationFile
+#define FileStandardInformation 5
+#define FilePositionInformation 14
+#define FileCompletionInformation 30
+#define FileIoCompletionNotificationInformation 41
+
+// Current byte offset of a synchronous file handle
+typedef struct _FILE_POSITION_INFORMATION
+{
+    UINT64 CurrentByteOffset;
+} FILE_POSITION_INFORMATION, *PFILE_POSITION_INFORMATION;
+
+typedef struct _FILE_STANDARD_INFORMATION
+{
+    UINT64 AllocationSize;
+    UINT64 EndOfFile;
+    UINT32 NumberOfLinks;
+    UINT8 DeletePending;
+    UINT8 Directory;
+} FILE_STANDARD_INFORMATION, *PFILE_STANDARD_INFORMATION;
+
+// Binds a file handle to an I/O completion port
+typedef struct _FILE_COMPLETION_INFORMATION
+{
+    PVOID Port;
+    PVOID Key;
+} FILE_COMPLETION_INFORMATION, *PFILE_COMPLETION_INFORMATION;
+
+// Don't queue a completion packet for requests that succeed synchronously
+#define FILE_SKIP_COMPLETION_PORT_ON_SUCCESS 0x1
+#define FILE_SKIP_SET_EVENT_ON_HANDLE 0x2
+
+// One entry returned by NtRemoveIoCompletionEx
+typedef struct _FILE_IO_COMPLETION_INFORMATION
+{
+    PVOID KeyContext;
+    PVOID ApcContext;
+    IO_STATUS_BLOCK IoStatusBlock;
+} FILE_IO_COMPLETION_INFORMATION, *PFILE_IO_COMPLETION_INFORMATION;
+
+// Virtual memory allocation
+#define MEM_COMMIT 0x00001000
+#define MEM_RESERVE 0x00002000
+#define MEM_RELEASE 0x00008000
+#define PAGE_READONLY 0x02
+#define PAGE_READWRITE 0x04
+#define PAGE_WRITECOPY 0x08
+#define PAGE_EXECUTE_READ 0x20
+#define MAP_PROCESS 1
+
+// File-backed sections
+#define SECTION_QUERY 0x0001
+#define SECTION_MAP_READ 0x0004
+#define SEC_COMMIT 0x08000000
+#define ViewUnmap 2
+
+// KUSER_SHARED_DATA is mapped read-only at the same address in every process
+#define KUSER_SHARED_DATA_ADDRESS 0x7FFE0000
+#define KUSER_NT_MAJOR_VERSION_OFFSET 0x26C
+#define KUSER_QPC_FREQUENCY_OFFSET 0x300 // Windows 10 and later
+#define KUSER_QPC_BYPASS_OFFSET 0x3C6 // QpcBypassEnabled, Windows 10 and later
+#define KUSER_QPC_SHIFT_OFFSET 0x3C7
+
+// QpcBypassEnabled flags: QPC reads the TSC in user mode, directly or through the hypervisor's reference page
+#define SHARED_GLOBAL_FLAGS_QPC_BYPASS_ENABLED 0x01
+#define SHARED_GLOBAL_FLAGS_QPC_BYPASS_USE_HV_PAGE 0x02
+#define KUSER_PROCESSOR_FEATURES_OFFSET 0x274 // One byte per PF_* value, as read by IsProcessorFeaturePresent
+
+// ProcessorFeatures index of SSE4.2; only set by recent Windows releases
+#define PF_SSE4_2_INSTRUCTIONS_AVAILABLE 38
+
+// ProcessorFeatures indices of the ARMv8 crypto (AES, SHA1, SHA2) and CRC32 instructions
+#define PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE 30
+#define PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE 31
+
+// VIRTUAL_MEMORY_INFORMATION_CLASS value for NtSetInformationVirtualMemory
+#define VmPrefetchInformation 0
+
+typedef struct _MEMORY_RANGE_ENTRY
+{
+    PVOID VirtualAddress;
+    USIZE NumberOfBytes;
+} MEMORY_RANGE_ENTRY, *PMEMORY_RANGE_ENTRY;
@@ -0,0 +1,129 @@
+/**
+ * atomic.h - Lock-Free Atomic Operations
+ *
+ * Thin wrapper over the Clang __atomic builtins. Every operation takes an
+ * explicit memory order that defaults to sequential consistency, so call
+ * sites can relax ordering only where they have reasoned about it.
+ *
+ * CONSTRAINTS:
+ *   - T must be a scalar no wider than a machine word (USIZE). Wider types
+ *     would fall back to libatomic calls, which this runtime does not have.
+ *   - FetchAdd/FetchSub on pointer types add raw byte offsets, not elements.
+ *
+ * USAGE:
+ *   Atomic<UINT32> counter;
+ *   counter.FetchAdd(1, MemoryOrder::Relaxed);
+ *   UINT32 value = counter.Load(MemoryOrder::Acquire);
+ */
+
+#pragma once
+
+#include "primitives.h"
+
+// Destructive interference size on every supported architecture
+#define CACHE_LINE_SIZE 64
+
+enum class MemoryOrder : INT32
+{
+    Relaxed = __ATOMIC_RELAXED,
+    Acquire = __ATOMIC_ACQUIRE,
+    Release = __ATOMIC_RELEASE,
+    AcquireRelease = __ATOMIC_ACQ_REL,
+    SequentiallyConsistent = __ATOMIC_SEQ_CST,
+};
+
+template <typename T>
+class Atomic
+{
+private:
+    static_assert(sizeof(T) <= sizeof(USIZE), "Atomic<T> requires a word-sized or smaller type");
+
+    alignas(sizeof(T)) volatile T value;
+
+    // Failure order of a compare-exchange may not contain a release component
+    static constexpr INT32 FailureOrder(MemoryOrder order)
+    {
+        if (order == MemoryOrder::AcquireRelease)
+            return __ATOMIC_ACQUIRE;
+        if (order == MemoryOrder::Release)
+            return __ATOMIC_RELAXED;
+        return (INT32)order;
+    }
+
+public:
+    constexpr Atomic() : value() {}
+    constexpr Atomic(T initial) : value(initial) {}
+
+    Atomic(const Atomic &) = delete;
+    Atomic &operator=(const Atomic &) = delete;
+
+    FORCE_INLINE T Load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+        return __atomic_load_n(&value, (INT32)order);
+    }
+
+    FORCE_INLINE VOID Store(T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        __atomic_store_n(&value, desired, (INT32)order);
+    }
+
+    FORCE_INLINE T Exchange(T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_exchange_n(&value, desired, (INT32)order);
+    }
+
+    // On failure, expected receives the value that was observed
+    FORCE_INLINE BOOL CompareExchangeStrong(T &expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_compare_exchange_n(&value, &expected, desired, FALSE, (INT32)order, FailureOrder(order));
+    }
+
+    // May fail spuriously; use inside retry loops
+    FORCE_INLINE BOOL CompareExchangeWeak(T &expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_compare_exchange_n(&value, &expected, desired, TRUE, (INT32)order, FailureOrder(order));
+    }
+
+    FORCE_INLINE T FetchAdd(T operand, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_fetch_add(&value, operand, (INT32)order);
+    }
+
+    FORCE_INLINE T FetchSub(T operand, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_fetch_sub(&value, operand, (INT32)order);
+    }
+
+    FORCE_INLINE T FetchAnd(T operand, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_fetch_and(&value, operand, (INT32)order);
+    }
+
+    FORCE_INLINE T FetchOr(T operand, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_fetch_or(&value, operand, (INT32)order);
+    }
+
+    FORCE_INLINE T FetchXor(T operand, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return __atomic_fetch_xor(&value, operand, (INT32)order);
+    }
+};
+
+// Full memory barrier with the given ordering
+FORCE_INLINE VOID AtomicThreadFence(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+{
+    __atomic_thread_fence((INT32)order);
+}
+
+// Spin-wait hint: lets the sibling hyperthread run and saves power while spinning
+FORCE_INLINE VOID CpuRelax()
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    __asm__ __volatile__("pause" ::: "memory");
+#elif defined(ARCHITECTURE_AARCH64) || defined(ARCHITECTURE_ARMV7A)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
@@ -0,0 +1,101 @@
+/**
+ * coroutine_support.h - Compiler Support Types for C++20 Coroutines
+ *
+ * The compiler lowers co_await/co_return into calls on a handful of library
+ * types it looks up by name in namespace std. The runtime links without the
+ * standard library, so this header provides the minimal versions of them:
+ *
+ *   std::coroutine_traits  - Maps a coroutine's return type to its promise
+ *   std::coroutine_handle  - Non-owning pointer to a coroutine frame
+ *   std::suspend_always    - Awaitable that always suspends
+ *   std::suspend_never     - Awaitable that never suspends
+ *
+ * Handles are thin wrappers over the __builtin_coro_* intrinsics that clang
+ * and GCC both provide. std::noop_coroutine is deliberately absent: its frame
+ * is a constant holding absolute function addresses, which cannot be
+ * relocated on i386 PIC builds (see Executor for the replacement).
+ *
+ * This is the only code in the runtime that lives in namespace std.
+ */
+
+#pragma once
+
+#include "primitives.h"
+
+namespace std
+{
+    template <typename TReturn, typename... TArgs>
+    struct coroutine_traits
+    {
+        using promise_type = typename TReturn::promise_type;
+    };
+
+    template <typename TPromise = void>
+    struct coroutine_handle;
+
+    template <>
+    struct coroutine_handle<void>
+    {
+    protected:
+        PVOID frame;
+
+    public:
+        constexpr coroutine_handle() noexcept : frame(NULL) {}
+        constexpr coroutine_handle(decltype(nullptr)) noexcept : frame(NULL) {}
+
+        static coroutine_handle from_address(PVOID address) noexcept
+        {
+            coroutine_handle handle;
+            handle.frame = address;
+            return handle;
+        }
+
+        PVOID address() const noexcept { return frame; }
+        explicit operator bool() const noexcept { return frame != NULL; }
+
+        bool done() const { return __builtin_coro_done(frame); }
+        VOID resume() const { __builtin_coro_resume(frame); }
+        VOID destroy() const { __builtin_coro_destroy(frame); }
+        VOID operator()() const { resume(); }
+    };
+
+    template <typename TPromise>
+    struct coroutine_handle : coroutine_handle<void>
+    {
+        constexpr coroutine_handle() noexcept {}
+        constexpr coroutine_handle(decltype(nullptr)) noexcept {}
+
+        static coroutine_handle from_address(PVOID address) noexcept
+        {
+            coroutine_handle handle;
+            handle.frame = address;
+            return handle;
+        }
+
+        static coroutine_handle from_promise(TPromise &promise) noexcept
+        {
+            coroutine_handle handle;
+            handle.frame = __builtin_coro_promise(&promise, alignof(TPromise), true);
+            return handle;
+        }
+
+        TPromise &promise() const
+        {
+            return *(TPromise *)__builtin_coro_promise(frame, alignof(TPromise), false);
+        }
+    };
+
+    struct suspend_always
+    {
+        constexpr bool await_ready() const noexcept { return false; }
+        constexpr VOID await_suspend(coroutine_handle<>) const noexcept {}
+        constexpr VOID await_resume() const noexcept {}
+    };
+
+    struct suspend_never
+    {
+        constexpr bool await_ready() const noexcept { return true; }
+        constexpr VOID await_suspend(coroutine_handle<>) const noexcept {}
+        constexpr VOID await_resume() const noexcept {}
+    };
+} // namespace std
@@ -67,12 +67,7 @@ public:
     }
 
     // Assignment operators
-    constexpr INT64 &operator=(const INT64 &other) noexcept
-    {
-        low = other.low;
-        high = other.high;
-        return *this;
-    }
+    constexpr INT64 &operator=(const INT64 &) noexcept = default;
 
     constexpr INT64 &operator=(INT32 val) noexcept
     {
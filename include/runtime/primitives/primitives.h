@@ -12,6 +12,8 @@
 
 #define NOINLINE __attribute__((noinline))
 #define DISABLE_OPTIMIZATION __attribute__((optnone))
+// No -finstrument-functions hooks (code the profiler itself runs through)
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
 
 #define NO_RETURN extern "C" __attribute__((noreturn))
 
@@ -121,12 +121,7 @@ public:
     }
 
     // Assignment operators
-    constexpr UINT64 &operator=(const UINT64 &other) noexcept
-    {
-        low = other.low;
-        high = other.high;
-        return *this;
-    }
+    constexpr UINT64 &operator=(const UINT64 &) noexcept = default;
 
     constexpr UINT64 &operator=(UINT32 val) noexcept
     {
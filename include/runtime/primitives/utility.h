@@ -0,0 +1,70 @@
+/**
+ * utility.h - Move Semantics and Object Placement
+ *
+ * The pieces of <utility> and <new> that containers need, without the
+ * standard library:
+ *   Move / Forward         - Casts for move construction and perfect forwarding
+ *   Swap                   - Exchange two values by moving
+ *   operator new(size, p)  - Placement new: construct into storage already owned
+ *   IsTriviallyRelocatable - TRUE if moving an object to new storage and
+ *                            dropping the old bytes may be one memory copy;
+ *                            trivially copyable types by default, specialize
+ *                            for types that own memory but never point into
+ *                            themselves
+ */
+
+#pragma once
+
+#include "primitives.h"
+
+inline PVOID operator new(USIZE, PVOID where) noexcept { return where; }
+
+template <typename T>
+struct RemoveReference
+{
+    typedef T Type;
+};
+
+template <typename T>
+struct RemoveReference<T &>
+{
+    typedef T Type;
+};
+
+template <typename T>
+struct RemoveReference<T &&>
+{
+    typedef T Type;
+};
+
+template <typename T>
+constexpr typename RemoveReference<T>::Type &&Move(T &&value) noexcept
+{
+    return static_cast<typename RemoveReference<T>::Type &&>(value);
+}
+
+template <typename T>
+constexpr T &&Forward(typename RemoveReference<T>::Type &value) noexcept
+{
+    return static_cast<T &&>(value);
+}
+
+template <typename T>
+constexpr T &&Forward(typename RemoveReference<T>::Type &&value) noexcept
+{
+    return static_cast<T &&>(value);
+}
+
+template <typename T>
+constexpr VOID Swap(T &a, T &b)
+{
+    T temporary = Move(a);
+    a = Move(b);
+    b = Move(temporary);
+}
+
+template <typename T>
+struct IsTriviallyRelocatable
+{
+    static constexpr BOOL Value = __is_trivially_copyable(T);
+};
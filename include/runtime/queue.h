@@ -0,0 +1,316 @@
+/**
+ * queue.h - Bounded Lock-Free Queues
+ *
+ * Fixed-capacity ring buffers for passing values between threads without
+ * locks or allocation. Capacity is a compile-time power of two so index
+ * wrapping is a mask; storage is inline, so large queues belong on the heap.
+ *
+ * QUEUES:
+ *   SpscQueue - Single producer, single consumer. Each side keeps a cached
+ *               copy of the other side's index and only reloads the shared
+ *               one when the cache says full/empty, so steady-state transfers
+ *               touch no shared cache line except the slots themselves.
+ *   MpmcQueue - Any number of producers and consumers (Dmitry Vyukov's
+ *               bounded queue). Each cell carries a sequence number, so a
+ *               push or pop is one compare-exchange on the shared index.
+ *
+ * Both queues offer batch operations that claim a run of slots with a single
+ * update of the shared index and return how many elements were transferred.
+ *
+ * USAGE:
+ *   SpscQueue<UINT32, 1024> *queue = new SpscQueue<UINT32, 1024>();
+ *   queue->TryPush(42);              // producer thread
+ *   UINT32 value;
+ *   if (queue->TryPop(value)) { }    // consumer thread
+ */
+
+#pragma once
+
+#include "atomic.h"
+
+template <typename T, USIZE Capacity>
+class SpscQueue
+{
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static constexpr USIZE Mask = Capacity - 1;
+
+    // Consumer line: the read index and the consumer's view of the write index
+    Atomic<USIZE> head;
+    USIZE cachedTail;
+    UINT8 headPadding[CACHE_LINE_SIZE - 2 * sizeof(USIZE)];
+
+    // Producer line: the write index and the producer's view of the read index
+    Atomic<USIZE> tail;
+    USIZE cachedHead;
+    UINT8 tailPadding[CACHE_LINE_SIZE - 2 * sizeof(USIZE)];
+
+    T slots[Capacity];
+
+public:
+    SpscQueue() : head(0), cachedTail(0), tail(0), cachedHead(0) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Producer only
+    BOOL TryPush(const T &item)
+    {
+        USIZE t = tail.Load(MemoryOrder::Relaxed);
+        if (t - cachedHead == Capacity)
+        {
+            cachedHead = head.Load(MemoryOrder::Acquire);
+            if (t - cachedHead == Capacity)
+                return FALSE;
+        }
+        slots[t & Mask] = item;
+        tail.Store(t + 1, MemoryOrder::Release);
+        return TRUE;
+    }
+
+    // Producer only; pushes up to count items and publishes them with one store
+    USIZE TryPushBatch(const T *items, USIZE count)
+    {
+        USIZE t = tail.Load(MemoryOrder::Relaxed);
+        USIZE space = Capacity - (t - cachedHead);
+        if (space < count)
+        {
+            cachedHead = head.Load(MemoryOrder::Acquire);
+            space = Capacity - (t - cachedHead);
+        }
+        if (count > space)
+            count = space;
+        if (count == 0)
+            return 0;
+
+        for (USIZE i = 0; i < count; i++)
+            slots[(t + i) & Mask] = items[i];
+        tail.Store(t + count, MemoryOrder::Release);
+        return count;
+    }
+
+    // Consumer only
+    BOOL TryPop(T &item)
+    {
+        USIZE h = head.Load(MemoryOrder::Relaxed);
+        if (h == cachedTail)
+        {
+            cachedTail = tail.Load(MemoryOrder::Acquire);
+            if (h == cachedTail)
+                return FALSE;
+        }
+        item = slots[h & Mask];
+        head.Store(h + 1, MemoryOrder::Release);
+        return TRUE;
+    }
+
+    // Consumer only; pops up to maxCount items and releases their slots with one store
+    USIZE TryPopBatch(T *items, USIZE maxCount)
+    {
+        USIZE h = head.Load(MemoryOrder::Relaxed);
+        USIZE available = cachedTail - h;
+        if (available < maxCount)
+        {
+            cachedTail = tail.Load(MemoryOrder::Acquire);
+            available = cachedTail - h;
+        }
+        if (maxCount > available)
+            maxCount = available;
+        if (maxCount == 0)
+            return 0;
+
+        for (USIZE i = 0; i < maxCount; i++)
+            items[i] = slots[(h + i) & Mask];
+        head.Store(h + maxCount, MemoryOrder::Release);
+        return maxCount;
+    }
+
+    // Approximate when called concurrently with the other side
+    USIZE GetSize() const
+    {
+        return tail.Load(MemoryOrder::Acquire) - head.Load(MemoryOrder::Acquire);
+    }
+
+    static constexpr USIZE GetCapacity() { return Capacity; }
+};
+
+template <typename T, USIZE Capacity>
+class MpmcQueue
+{
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static constexpr USIZE Mask = Capacity - 1;
+
+    // sequence == position: free for the producer claiming position
+    // sequence == position + 1: holds data for the consumer claiming position
+    struct CELL
+    {
+        Atomic<USIZE> Sequence;
+        T Data;
+    };
+
+    UINT8 leadingPadding[CACHE_LINE_SIZE];
+    Atomic<USIZE> enqueuePosition;
+    UINT8 enqueuePadding[CACHE_LINE_SIZE - sizeof(USIZE)];
+    Atomic<USIZE> dequeuePosition;
+    UINT8 dequeuePadding[CACHE_LINE_SIZE - sizeof(USIZE)];
+    CELL cells[Capacity];
+
+public:
+    MpmcQueue() : enqueuePosition(0), dequeuePosition(0)
+    {
+        for (USIZE i = 0; i < Capacity; i++)
+            cells[i].Sequence.Store(i, MemoryOrder::Relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    BOOL TryPush(const T &item)
+    {
+        USIZE position = enqueuePosition.Load(MemoryOrder::Relaxed);
+        for (;;)
+        {
+            CELL &cell = cells[position & Mask];
+            USIZE sequence = cell.Sequence.Load(MemoryOrder::Acquire);
+            SSIZE difference = (SSIZE)(sequence - position);
+
+            if (difference == 0)
+            {
+                if (enqueuePosition.CompareExchangeWeak(position, position + 1, MemoryOrder::Relaxed))
+                {
+                    cell.Data = item;
+                    cell.Sequence.Store(position + 1, MemoryOrder::Release);
+                    return TRUE;
+                }
+                // position was reloaded by the failed exchange
+            }
+            else if (difference < 0)
+            {
+                // Cell still holds an unconsumed element from the previous lap: full
+                return FALSE;
+            }
+            else
+            {
+                position = enqueuePosition.Load(MemoryOrder::Relaxed);
+            }
+        }
+    }
+
+    BOOL TryPop(T &item)
+    {
+        USIZE position = dequeuePosition.Load(MemoryOrder::Relaxed);
+        for (;;)
+        {
+            CELL &cell = cells[position & Mask];
+            USIZE sequence = cell.Sequence.Load(MemoryOrder::Acquire);
+            SSIZE difference = (SSIZE)(sequence - (position + 1));
+
+            if (difference == 0)
+            {
+                if (dequeuePosition.CompareExchangeWeak(position, position + 1, MemoryOrder::Relaxed))
+                {
+                    item = cell.Data;
+                    // Hand the cell to the producer of the next lap
+                    cell.Sequence.Store(position + Capacity, MemoryOrder::Release);
+                    return TRUE;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Producer has not filled this cell yet: empty
+                return FALSE;
+            }
+            else
+            {
+                position = dequeuePosition.Load(MemoryOrder::Relaxed);
+            }
+        }
+    }
+
+    // Claims a run of free cells with a single exchange on the shared index,
+    // then fills them in order; returns how many items were pushed
+    USIZE TryPushBatch(const T *items, USIZE count)
+    {
+        USIZE position = enqueuePosition.Load(MemoryOrder::Relaxed);
+        for (;;)
+        {
+            USIZE run = 0;
+            while (run < count && run < Capacity)
+            {
+                USIZE sequence = cells[(position + run) & Mask].Sequence.Load(MemoryOrder::Acquire);
+                if (sequence != position + run)
+                    break;
+                run++;
+            }
+
+            if (run == 0)
+            {
+                USIZE sequence = cells[position & Mask].Sequence.Load(MemoryOrder::Acquire);
+                if ((SSIZE)(sequence - position) < 0)
+                    return 0;
+                position = enqueuePosition.Load(MemoryOrder::Relaxed);
+                continue;
+            }
+
+            if (enqueuePosition.CompareExchangeWeak(position, position + run, MemoryOrder::Relaxed))
+            {
+                for (USIZE i = 0; i < run; i++)
+                {
+                    CELL &cell = cells[(position + i) & Mask];
+                    cell.Data = items[i];
+                    cell.Sequence.Store(position + i + 1, MemoryOrder::Release);
+                }
+                return run;
+            }
+        }
+    }
+
+    // Claims a run of filled cells with a single exchange on the shared index,
+    // then drains them in order; returns how many items were popped
+    USIZE TryPopBatch(T *items, USIZE maxCount)
+    {
+        USIZE position = dequeuePosition.Load(MemoryOrder::Relaxed);
+        for (;;)
+        {
+            USIZE run = 0;
+            while (run < maxCount && run < Capacity)
+            {
+                USIZE sequence = cells[(position + run) & Mask].Sequence.Load(MemoryOrder::Acquire);
+                if (sequence != position + run + 1)
+                    break;
+                run++;
+            }
+
+            if (run == 0)
+            {
+                USIZE sequence = cells[position & Mask].Sequence.Load(MemoryOrder::Acquire);
+                if ((SSIZE)(sequence - (position + 1)) < 0)
+                    return 0;
+                position = dequeuePosition.Load(MemoryOrder::Relaxed);
+                continue;
+            }
+
+            if (dequeuePosition.CompareExchangeWeak(position, position + run, MemoryOrder::Relaxed))
+            {
+                for (USIZE i = 0; i < run; i++)
+                {
+                    CELL &cell = cells[(position + i) & Mask];
+                    items[i] = cell.Data;
+                    cell.Sequence.Store(position + i + Capacity, MemoryOrder::Release);
+                }
+                return run;
+            }
+        }
+    }
+
+    // Approximate when called concurrently
+    USIZE GetSize() const
+    {
+        USIZE enqueued = enqueuePosition.Load(MemoryOrder::Acquire);
+        USIZE dequeued = dequeuePosition.Load(MemoryOrder::Acquire);
+        return (SSIZE)(enqueued - dequeued) > 0 ? enqueued - dequeued : 0;
+    }
+
+    static constexpr USIZE GetCapacity() { return Capacity; }
+};
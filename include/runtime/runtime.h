@@ -9,8 +9,29 @@
  *   Console    - Console I/O and formatted output
  *   Logger     - Structured logging with ANSI colors
  *   Memory     - Memory operations (copy, set, compare, zero)
- *   String     - String utilities and conversions
+ *   String     - String utilities and conversions; owned BasicString with inline storage
  *   Allocator  - Low-level memory allocation
+ *   Thread     - Thread creation, join and yield
+ *   Context    - Per-thread context (scratch arena, caches, log buffer)
+ *   Arena      - Bump-pointer scratch allocation
+ *   Vector     - Growable array with inline capacity and allocator policies
+ *   HashMap    - Open-addressing hash map keyed by precomputed hashes
+ *   Sort       - Introsort, LSD radix sort, LowerBound/UpperBound
+ *   Atomic     - Lock-free atomic operations with explicit memory orders
+ *   Sync       - SpinLock, Mutex and LockGuard
+ *   ThreadPool - Work-stealing fork/join scheduler and ParallelFor
+ *   Queue      - Bounded lock-free SPSC and MPMC queues
+ *   Coroutine  - Task<T>, single-threaded executor and AsyncEvent
+ *   AsyncIo    - Batched asynchronous file I/O with registered buffers
+ *   File       - Blocking file I/O with buffered readers and writers
+ *   MappedFile - Read-only and copy-on-write file views for in-place parsing
+ *   Timer      - Cycle counter, monotonic clock, Stopwatch and Histogram
+ *   Profiler   - Function enter/exit cycle records (PROFILE builds)
+ *   Lz4        - LZ4 block compression and decompression
+ *   Swar       - Byte-lane word helpers (SIMD within a register)
+ *   Encoding   - Base64 and hex text encoding
+ *   Checksum   - CRC32C (hardware-accelerated) and XXH64 checksums
+ *   Sha        - Streaming SHA-256 (hardware-accelerated) and SHA-1
  *   Djb2       - Hash functions for strings
  *
  * USAGE:
@@ -33,19 +54,49 @@
 #include "double.h"
 #include "embedded_double.h"
 #include "embedded_string.h"
+#include "atomic.h"
+#include "utility.h"
 
 // Platform abstraction layer
 #include "platform.h"
 #include "allocator.h"
+#include "thread.h"
+#include "arena.h"
+#include "thread_context.h"
+
+// Synchronization
+#include "synchronization.h"
+#include "thread_pool.h"
+#include "queue.h"
+#include "coroutine.h"
+#include "async_io.h"
+#include "file.h"
+#include "mapped_file.h"
+#include "timer.h"
+#include "profiler.h"
+#include "lz4.h"
 
 // String utilities
 #include "string.h"
 #include "string_formatter.h"
 #include "djb2.h"
+#include "swar.h"
+#include "encoding.h"
+#include "checksum.h"
+#include "sha.h"
 
 // Memory operations
 #include "memory.h"
 
+// Containers
+#include "allocator_policy.h"
+#include "vector.h"
+#include "hash_map.h"
+#include "basic_string.h"
+
+// Algorithms
+#include "sort.h"
+
 // Console and logging
 #include "console.h"
 #include "logger.h"
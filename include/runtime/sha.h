@@ -0,0 +1,110 @@
+/**
+ * sha.h - SHA-256 and SHA-1 Hashing
+ *
+ * Streaming FIPS 180-4 hashes for integrity checks: Init, any number of
+ * Update calls, then Final. SHA-1 is only there to check digests that
+ * other systems publish; new formats should use SHA-256.
+ *
+ * ROUND CONSTANTS:
+ *   The portable rounds are fully unrolled, so every round constant is an
+ *   immediate operand of the instruction that adds it. The instruction
+ *   paths need the constants in memory; they are stored to the stack from
+ *   immediates (a NOINLINE DISABLE_OPTIMIZATION function, so they are not
+ *   folded back into a constant table) once per Update call.
+ *
+ * SHA-256 IMPLEMENTATIONS:
+ *   x86_64/i386: SHA-NI (sha256rnds2, sha256msg1/2) when cpuid reports SHA,
+ *                SSSE3 and SSE4.1. The runtime is built with -msoft-float,
+ *                so this path is a single asm block that names its xmm
+ *                registers itself and saves the callee-saved xmm6/xmm7.
+ *   aarch64:     ARMv8 SHA2 instructions (sha256h/h2, sha256su0/su1) when
+ *                Windows reports the crypto extension
+ *   Otherwise:   Portable rounds (and always for SHA-1)
+ *
+ *   Detection is cached in the thread context. A thread without one gets
+ *   only what Windows publishes in KUSER_SHARED_DATA, which has no x86 SHA
+ *   bit; such callers detect once and pass the choice in:
+ *
+ *     BOOL hardware = Sha256::IsHardwareAvailable();   // once
+ *     Sha256::Compute(message, messageSize, digest, hardware);
+ *
+ * USAGE:
+ *   Sha256 sha;
+ *   sha.Update(header, headerSize);
+ *   sha.Update(body, bodySize);
+ *   UINT8 digest[SHA256_DIGEST_SIZE];
+ *   sha.Final(digest);
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "uint64.h"
+
+#define SHA_BLOCK_SIZE 64
+#define SHA256_DIGEST_SIZE 32
+#define SHA1_DIGEST_SIZE 20
+
+class Sha256
+{
+private:
+    UINT32 state[8];
+    UINT64 length; // Bytes hashed so far
+    UINT8 block[SHA_BLOCK_SIZE];
+    USIZE buffered; // Bytes of block in use
+    BOOL hardware;
+
+    // Platform-specific instruction support (implemented in platform-specific .cc files)
+    static BOOL DetectHardware();
+    // Support as reported by the OS: a memory read, no cpuid; Windows publishes no SHA bit for x86
+    static BOOL ReadPublishedHardware();
+
+    VOID ProcessBlocks(const UINT8 *data, USIZE count);
+
+public:
+    Sha256() { Init(); }
+    explicit Sha256(BOOL useHardware) { Init(useHardware); }
+
+    // Start a new hash, discarding any input so far. Uses the per-thread detection,
+    // or only the OS's published processor features on a thread without a context
+    VOID Init();
+    // Same, with the choice made by the caller: IsHardwareAvailable(), or FALSE for the portable rounds
+    VOID Init(BOOL useHardware);
+
+    // Hash size more bytes
+    VOID Update(PCVOID data, USIZE size);
+
+    // Write the digest of everything passed to Update; Init before reusing the object
+    VOID Final(PUINT8 digest);
+
+    // Hash with the portable rounds even where instructions exist (tests, benchmarks)
+    VOID UsePortable() { hardware = FALSE; }
+
+    // TRUE if the SHA-256 instructions can be used; detected once per thread, but on every call
+    // on a thread without a context, where callers query once and pass the result to Init or Compute
+    static BOOL IsHardwareAvailable();
+
+    // One-shot hash of size bytes
+    static VOID Compute(PCVOID data, USIZE size, PUINT8 digest);
+    static VOID Compute(PCVOID data, USIZE size, PUINT8 digest, BOOL useHardware);
+};
+
+class Sha1
+{
+private:
+    UINT32 state[5];
+    UINT64 length;
+    UINT8 block[SHA_BLOCK_SIZE];
+    USIZE buffered;
+
+    VOID ProcessBlocks(const UINT8 *data, USIZE count);
+
+public:
+    Sha1() { Init(); }
+
+    VOID Init();
+    VOID Update(PCVOID data, USIZE size);
+    VOID Final(PUINT8 digest);
+
+    static VOID Compute(PCVOID data, USIZE size, PUINT8 digest);
+};
@@ -0,0 +1,330 @@
+/**
+ * sort.h - Sorting and Binary Search
+ *
+ * Sort orders an array in place with introsort: quicksort on a
+ * median-of-three pivot, heapsort for any range that has been partitioned
+ * more than 2 log2(n) times (so no input is quadratic), and one insertion
+ * sort pass over ranges left below SORT_INSERTION_THRESHOLD elements.
+ * Recursion only follows the smaller side of each partition, so the stack
+ * depth is at most log2(n) frames. Sort is not stable.
+ *
+ * RadixSort is a stable LSD radix sort on integer keys: one counting pass
+ * and one scatter pass per key byte, skipping bytes that are equal across
+ * the whole array. Keys are unsigned or signed integers of any width, or
+ * the software UINT64 (digits come from Low() and High(), so 32-bit targets
+ * never shift a 64-bit value).
+ *
+ * LowerBound and UpperBound binary-search a sorted array without
+ * branching on the comparison, so the loop runs log2(n) steps whatever
+ * the data.
+ *
+ * COMPARATORS:
+ *   Functors or lambdas taken by value, so each call site gets its own
+ *   instantiation and the comparison inlines; no function pointers. A
+ *   comparator is a strict "less than" (Less, the default, uses operator<).
+ *   LowerBound calls less(element, key) and UpperBound less(key, element),
+ *   so the key may be of another type than the elements.
+ *
+ * USAGE:
+ *   Sort(rvas, count);                                              // ascending
+ *   Sort(records, count, [](const Record &a, const Record &b) { return a.Time < b.Time; });
+ *   USIZE index = LowerBound(rvas, count, target);                  // first rva >= target
+ *   if (!RadixSort(hashes, count))                                  // allocates scratch
+ *       return FALSE; // out of memory
+ *   RadixSort(records, scratch, count, [](const Record &r) { return r.Hash; });
+ */
+
+#pragma once
+
+#include "utility.h"
+#include "memory.h"
+#include "allocator_policy.h"
+
+// Ranges of fewer elements are left to the final insertion sort pass
+#define SORT_INSERTION_THRESHOLD 16
+
+// Default comparator: operator<
+struct Less
+{
+    template <typename A, typename B>
+    FORCE_INLINE BOOL operator()(const A &a, const B &b) const { return a < b; }
+};
+
+// Default RadixSort key: the element itself
+struct RadixIdentity
+{
+    template <typename T>
+    FORCE_INLINE T operator()(const T &item) const { return item; }
+};
+
+/**
+ * InsertionSort - Stable sort, fast on short or nearly sorted ranges
+ */
+template <typename T, typename Compare = Less>
+VOID InsertionSort(T *items, USIZE count, Compare less = Compare())
+{
+    for (USIZE i = 1; i < count; i++)
+    {
+        if (!less(items[i], items[i - 1]))
+            continue;
+        T value = Move(items[i]);
+        USIZE j = i;
+        do
+        {
+            items[j] = Move(items[j - 1]);
+            j--;
+        } while (j > 0 && less(value, items[j - 1]));
+        items[j] = Move(value);
+    }
+}
+
+// Move the larger child up until items[root] is no smaller than its children
+template <typename T, typename Compare>
+VOID SortSiftDown(T *items, USIZE root, USIZE count, Compare &less)
+{
+    for (;;)
+    {
+        USIZE child = root * 2 + 1;
+        if (child >= count)
+            return;
+        if (child + 1 < count && less(items[child], items[child + 1]))
+            child++;
+        if (!less(items[root], items[child]))
+            return;
+        Swap(items[root], items[child]);
+        root = child;
+    }
+}
+
+/**
+ * HeapSort - O(n log n) in every case, no extra memory; Sort's fallback
+ */
+template <typename T, typename Compare = Less>
+VOID HeapSort(T *items, USIZE count, Compare less = Compare())
+{
+    for (USIZE root = count / 2; root > 0; root--)
+        SortSiftDown(items, root - 1, count, less);
+    for (USIZE end = count; end > 1; end--)
+    {
+        Swap(items[0], items[end - 1]);
+        SortSiftDown(items, 0, end - 1, less);
+    }
+}
+
+/**
+ * SortPartition - Partition around the median of three, moved to items[0]
+ *
+ * The median sits between the two other samples, which stay inside the
+ * range, so neither scan needs a bounds check. Scans stop on elements
+ * equal to the pivot, which keeps runs of equal keys evenly split.
+ *
+ * @return Start of the upper part; both parts are non-empty
+ */
+template <typename T, typename Compare>
+T *SortPartition(T *items, USIZE count, Compare &less)
+{
+    T *a = items + 1;
+    T *b = items + count / 2;
+    T *c = items + count - 1;
+    if (less(*a, *b))
+    {
+        if (less(*b, *c))
+            Swap(*items, *b);
+        else if (less(*a, *c))
+            Swap(*items, *c);
+        else
+            Swap(*items, *a);
+    }
+    else if (less(*a, *c))
+        Swap(*items, *a);
+    else if (less(*b, *c))
+        Swap(*items, *c);
+    else
+        Swap(*items, *b);
+
+    T *low = items + 1;
+    T *high = items + count;
+    for (;;)
+    {
+        while (less(*low, *items))
+            low++;
+        high--;
+        while (less(*items, *high))
+            high--;
+        if (!(low < high))
+            return low;
+        Swap(*low, *high);
+        low++;
+    }
+}
+
+template <typename T, typename Compare>
+VOID IntroSortLoop(T *items, USIZE count, UINT32 depthLimit, Compare &less)
+{
+    while (count > SORT_INSERTION_THRESHOLD)
+    {
+        if (depthLimit == 0)
+        {
+            HeapSort(items, count, less);
+            return;
+        }
+        depthLimit--;
+
+        T *cut = SortPartition(items, count, less);
+        USIZE lower = (USIZE)(cut - items);
+        USIZE upper = count - lower;
+        if (lower < upper)
+        {
+            IntroSortLoop(items, lower, depthLimit, less);
+            items = cut;
+            count = upper;
+        }
+        else
+        {
+            IntroSortLoop(cut, upper, depthLimit, less);
+            count = lower;
+        }
+    }
+}
+
+/**
+ * Sort - Introsort: O(n log n) comparisons in the worst case, not stable
+ */
+template <typename T, typename Compare = Less>
+VOID Sort(T *items, USIZE count, Compare less = Compare())
+{
+    if (count < 2)
+        return;
+
+    UINT32 log2 = 0;
+    for (USIZE n = count; n > 1; n >>= 1)
+        log2++;
+    IntroSortLoop(items, count, log2 * 2, less);
+
+    // Every element is now within its final range of SORT_INSERTION_THRESHOLD
+    InsertionSort(items, count, less);
+}
+
+// Byte at shift of an integer key, ordered so that unsigned digit order is key order
+template <typename K>
+FORCE_INLINE UINT32 RadixDigit(const K &key, UINT32 shift)
+{
+    UINT32 digit = (UINT32)(key >> shift) & 0xFF;
+    if constexpr ((K)-1 < (K)0)
+    {
+        // Signed: negative keys have the top bit set and must come first
+        if (shift == (sizeof(K) - 1) * 8)
+            digit ^= 0x80;
+    }
+    return digit;
+}
+
+inline UINT32 RadixDigit(const UINT64 &key, UINT32 shift)
+{
+    return (shift < 32 ? key.Low() >> shift : key.High() >> (shift - 32)) & 0xFF;
+}
+
+/**
+ * RadixSort - Stable LSD radix sort with caller-provided scratch
+ *
+ * scratch must hold count elements; its contents are overwritten. keyOf
+ * returns an element's integer key by value. Elements are copied between
+ * the two arrays, so T must be trivially copyable.
+ */
+template <typename T, typename KeyOf = RadixIdentity>
+VOID RadixSort(T *items, T *scratch, USIZE count, KeyOf keyOf = KeyOf())
+{
+    static_assert(__is_trivially_copyable(T), "RadixSort copies elements between arrays");
+    typedef decltype(keyOf(*items)) Key;
+
+    T *source = items;
+    T *target = scratch;
+    for (UINT32 shift = 0; shift < sizeof(Key) * 8; shift += 8)
+    {
+        USIZE offsets[256];
+        Memory::Zero(offsets, sizeof(offsets));
+        for (USIZE i = 0; i < count; i++)
+            offsets[RadixDigit(keyOf(source[i]), shift)]++;
+
+        // A byte shared by every key does not change the order
+        if (count == 0 || offsets[RadixDigit(keyOf(source[0]), shift)] == count)
+            continue;
+
+        USIZE total = 0;
+        for (UINT32 digit = 0; digit < 256; digit++)
+        {
+            USIZE bucket = offsets[digit];
+            offsets[digit] = total;
+            total += bucket;
+        }
+        for (USIZE i = 0; i < count; i++)
+            target[offsets[RadixDigit(keyOf(source[i]), shift)]++] = source[i];
+
+        T *swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != items)
+        Memory::Copy(items, source, count * sizeof(T));
+}
+
+/**
+ * RadixSort - Stable LSD radix sort with scratch taken from an allocator policy
+ *
+ * @return FALSE if the scratch allocation failed (the array is unchanged)
+ */
+template <typename T, typename KeyOf = RadixIdentity, typename Alloc = HeapAllocator>
+BOOL RadixSort(T *items, USIZE count, KeyOf keyOf = KeyOf(), Alloc allocator = Alloc())
+{
+    if (count < 2)
+        return TRUE;
+    if (count > (USIZE)-1 / sizeof(T))
+        return FALSE;
+    T *scratch = (T *)allocator.Allocate(count * sizeof(T), alignof(T));
+    if (scratch == NULL)
+        return FALSE;
+    RadixSort(items, scratch, count, keyOf);
+    allocator.Release(scratch, count * sizeof(T), alignof(T));
+    return TRUE;
+}
+
+/**
+ * LowerBound - Index of the first element not less than key
+ *
+ * @return count if every element is less than key
+ */
+template <typename T, typename K, typename Compare = Less>
+USIZE LowerBound(const T *items, USIZE count, const K &key, Compare less = Compare())
+{
+    if (count == 0)
+        return 0;
+    const T *base = items;
+    while (count > 1)
+    {
+        USIZE half = count / 2;
+        base = less(base[half - 1], key) ? base + half : base;
+        count -= half;
+    }
+    return (USIZE)(base - items) + (less(*base, key) ? 1 : 0);
+}
+
+/**
+ * UpperBound - Index of the first element greater than key
+ *
+ * @return count if no element is greater than key
+ */
+template <typename T, typename K, typename Compare = Less>
+USIZE UpperBound(const T *items, USIZE count, const K &key, Compare less = Compare())
+{
+    if (count == 0)
+        return 0;
+    const T *base = items;
+    while (count > 1)
+    {
+        USIZE half = count / 2;
+        base = less(key, base[half - 1]) ? base : base + half;
+        count -= half;
+    }
+    return (USIZE)(base - items) + (less(key, *base) ? 0 : 1);
+}
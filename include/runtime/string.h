@@ -2,65 +2,76 @@
 
 #include "primitives.h"
 #include "platform.h"
+#include "memory.h"
+#include "swar.h"
+
+// Pattern length from which IndexOf switches from the first/last-unit filter to Horspool skips
+#define STRING_HORSPOOL_MIN_LENGTH 16
 
 class String
 {
 private:
+    // Units per word and bits per unit in a SWAR word of TChar
+    template <TCHAR TChar>
+    static constexpr USIZE WordUnits = SWAR_LANES / sizeof(TChar);
+    template <TCHAR TChar>
+    static constexpr UINT32 UnitBits = sizeof(TChar) * 8;
+
+    template <TCHAR TChar>
+    static USIZE ZeroUnits(USIZE word);
+    template <TCHAR TChar>
+    static USIZE FoldCase(USIZE word);
+    template <TCHAR TChar>
+    static USIZE Mismatch(const TChar *a, const TChar *b, USIZE count);
+
 public:
     template <TCHAR TChar>
     static USIZE Length(const TChar *pChar);
     template <TCHAR TChar>
     static TChar ToLowerCase(TChar c);
 
+    // UTF-16 <-> UTF-8 over explicit lengths; no terminator is read or written.
+    // Input must be well-formed: an unpaired surrogate, a malformed, overlong
+    // or surrogate-encoding UTF-8 sequence, or a code point above U+10FFFF
+    // gives -1. The Get*Length functions return the exact output length
+    // without writing, so buffers can be sized up front; the converters
+    // return the units written, or -1 (with partial output) when the input
+    // is malformed or the output does not fit.
+    static SSIZE GetUtf8Length(PCWCHAR wide, USIZE length);
+    static SSIZE GetWideLength(PCCHAR utf8, USIZE length);
+    static SSIZE WideToUtf8(PCWCHAR wide, USIZE length, PCHAR utf8, USIZE capacity);
+    static SSIZE Utf8ToWide(PCCHAR utf8, USIZE length, PWCHAR wide, USIZE capacity);
+
+    // Null-terminated form: the output is terminated; returns the bytes before
+    // the terminator, or 0 with an empty output when the input is malformed or
+    // does not fit
     static USIZE WideToUtf8(PCWCHAR wide, PCHAR utf8, USIZE utf8BufferSize);
-};
 
-// Converts a wide string (UTF-16) to UTF-8
-// Returns the number of bytes written (excluding null terminator)
-inline USIZE String::WideToUtf8(PCWCHAR wide, PCHAR utf8, USIZE utf8BufferSize)
-{
-    if (!wide || !utf8 || utf8BufferSize == 0)
-        return 0;
-
-    USIZE utf8Len = 0;
-
-    while (*wide && utf8Len < utf8BufferSize - 4)
-    {
-        UINT32 ch = *wide++;
-
-        // Handle surrogate pairs for characters > 0xFFFF
-        if (ch >= 0xD800 && ch <= 0xDBFF && *wide >= 0xDC00 && *wide <= 0xDFFF)
-        {
-            ch = 0x10000 + ((ch - 0xD800) << 10) + (*wide++ - 0xDC00);
-        }
-
-        if (ch < 0x80)
-        {
-            utf8[utf8Len++] = (CHAR)ch;
-        }
-        else if (ch < 0x800)
-        {
-            utf8[utf8Len++] = (CHAR)(0xC0 | (ch >> 6));
-            utf8[utf8Len++] = (CHAR)(0x80 | (ch & 0x3F));
-        }
-        else if (ch < 0x10000)
-        {
-            utf8[utf8Len++] = (CHAR)(0xE0 | (ch >> 12));
-            utf8[utf8Len++] = (CHAR)(0x80 | ((ch >> 6) & 0x3F));
-            utf8[utf8Len++] = (CHAR)(0x80 | (ch & 0x3F));
-        }
-        else
-        {
-            utf8[utf8Len++] = (CHAR)(0xF0 | (ch >> 18));
-            utf8[utf8Len++] = (CHAR)(0x80 | ((ch >> 12) & 0x3F));
-            utf8[utf8Len++] = (CHAR)(0x80 | ((ch >> 6) & 0x3F));
-            utf8[utf8Len++] = (CHAR)(0x80 | (ch & 0x3F));
-        }
-    }
-
-    utf8[utf8Len] = '\0';
-    return utf8Len;
-}
+    // Length-bounded number parsers: the text need not be null-terminated, so they
+    // run directly over mapped or buffered bytes. Each returns the number of
+    // characters consumed, or 0 when no number starts at text or it overflows.
+    template <TCHAR TChar>
+    static USIZE ParseUInt64(const TChar *text, USIZE length, UINT64 &value);
+    template <TCHAR TChar>
+    static USIZE ParseInt64(const TChar *text, USIZE length, INT64 &value);
+    template <TCHAR TChar>
+    static USIZE ParseHex(const TChar *text, USIZE length, UINT64 &value);
+
+    // Length-explicit search and comparison. Neither side needs a terminator,
+    // and embedded nulls are ordinary units. Case folding covers ASCII only.
+    template <TCHAR TChar>
+    static SSIZE IndexOf(const TChar *text, USIZE length, TChar unit);
+    template <TCHAR TChar>
+    static SSIZE IndexOf(const TChar *text, USIZE length, const TChar *pattern, USIZE patternLength);
+    template <TCHAR TChar>
+    static INT32 Compare(const TChar *a, USIZE aLength, const TChar *b, USIZE bLength);
+    template <TCHAR TChar>
+    static BOOL EqualsIgnoreCase(const TChar *a, USIZE aLength, const TChar *b, USIZE bLength);
+    template <TCHAR TChar>
+    static BOOL StartsWith(const TChar *text, USIZE length, const TChar *prefix, USIZE prefixLength);
+    template <TCHAR TChar>
+    static BOOL EndsWith(const TChar *text, USIZE length, const TChar *suffix, USIZE suffixLength);
+};
 
 /**
  * ToLowerCase - Convert character to lowercase
@@ -100,3 +111,336 @@ FORCE_INLINE USIZE String::Length(const TChar *p)
 
 	return i;
 }
+
+/**
+ * ParseUInt64 - Parse an unsigned decimal number
+ *
+ * Stops at the first non-digit. Values above 2^64-1 are rejected rather than
+ * wrapped.
+ *
+ * @param text   - First character; not required to be null-terminated
+ * @param length - Characters available at text
+ * @param value  - Receives the parsed value on success
+ * @return Digits consumed, or 0 if text does not start with a digit or the value overflows
+ */
+template <TCHAR TChar>
+USIZE String::ParseUInt64(const TChar *text, USIZE length, UINT64 &value)
+{
+	// Largest value that can still be multiplied by ten
+	constexpr UINT64 limit(0x19999999U, 0x99999999U);
+
+	UINT64 result;
+	USIZE i = 0;
+	for (; i < length; i++)
+	{
+		TChar c = text[i];
+		if (c < (TChar)'0' || c > (TChar)'9')
+			break;
+
+		UINT32 digit = (UINT32)(c - (TChar)'0');
+		if (result > limit || (result == limit && digit > 5))
+			return 0;
+		result = result * 10U + digit;
+	}
+
+	if (i == 0)
+		return 0;
+	value = result;
+	return i;
+}
+
+/**
+ * ParseInt64 - Parse an optionally signed decimal number
+ *
+ * Accepts a leading '+' or '-'. The range is -2^63 to 2^63-1.
+ *
+ * @return Characters consumed including the sign, or 0 on no digits or overflow
+ */
+template <TCHAR TChar>
+USIZE String::ParseInt64(const TChar *text, USIZE length, INT64 &value)
+{
+	USIZE sign = 0;
+	BOOL negative = FALSE;
+	if (length > 0 && (text[0] == (TChar)'-' || text[0] == (TChar)'+'))
+	{
+		negative = text[0] == (TChar)'-';
+		sign = 1;
+	}
+
+	UINT64 magnitude;
+	USIZE digits = ParseUInt64(text + sign, length - sign, magnitude);
+	if (digits == 0)
+		return 0;
+
+	// 2^63 only fits when negated
+	constexpr UINT64 maximum(0x80000000U, 0U);
+	if (magnitude > maximum || (magnitude == maximum && !negative))
+		return 0;
+
+	// Negate in unsigned arithmetic so -2^63 does not overflow
+	UINT64 bits = negative ? UINT64() - magnitude : magnitude;
+	value = INT64((INT32)bits.High(), bits.Low());
+	return sign + digits;
+}
+
+/**
+ * ParseHex - Parse a hexadecimal number
+ *
+ * Accepts an optional "0x"/"0X" prefix and digits in either case, up to 16
+ * significant digits.
+ *
+ * @return Characters consumed including the prefix, or 0 on no digits or overflow
+ */
+template <TCHAR TChar>
+USIZE String::ParseHex(const TChar *text, USIZE length, UINT64 &value)
+{
+	USIZE prefix = 0;
+	if (length > 2 && text[0] == (TChar)'0' && (text[1] == (TChar)'x' || text[1] == (TChar)'X'))
+		prefix = 2;
+
+	UINT64 result;
+	USIZE i = prefix;
+	for (; i < length; i++)
+	{
+		TChar c = ToLowerCase(text[i]);
+		UINT32 digit;
+		if (c >= (TChar)'0' && c <= (TChar)'9')
+			digit = (UINT32)(c - (TChar)'0');
+		else if (c >= (TChar)'a' && c <= (TChar)'f')
+			digit = (UINT32)(c - (TChar)'a') + 10;
+		else
+			break;
+
+		if (result.High() >= 0x10000000U)
+			return 0;
+		result = (result << 4) | digit;
+	}
+
+	// A bare "0x" parses as the single digit zero
+	if (i == prefix)
+	{
+		if (prefix == 0)
+			return 0;
+		value = UINT64();
+		return 1;
+	}
+	value = result;
+	return i;
+}
+
+/**
+ * ZeroUnits - Mark the units of a word that are zero
+ *
+ * Exact, unlike the borrow trick: the top bit of each zero unit is set and
+ * nothing else, so every mark is a real match.
+ */
+template <TCHAR TChar>
+FORCE_INLINE USIZE String::ZeroUnits(USIZE word)
+{
+	USIZE low = sizeof(TChar) == 1 ? Swar::Broadcast(0x7F) : Swar::Broadcast16(0x7FFF);
+	return ~(((word & low) + low) | word | low);
+}
+
+/**
+ * FoldCase - Lower-case the ASCII letters of a word of units
+ *
+ * A unit is a letter when its low byte is in 'A'..'Z' and nothing above
+ * bit 6 is set; InRange sees only the low 7 bits of every byte.
+ */
+template <TCHAR TChar>
+FORCE_INLINE USIZE String::FoldCase(USIZE word)
+{
+	USIZE letters = Swar::InRange(word & Swar::Broadcast(0x7F), 'A', 'Z') & ~word;
+	if constexpr (sizeof(TChar) == 2)
+	{
+		// Only the low byte of a unit is a character; a unit above 0x7F is never a letter
+		USIZE above = word & Swar::Broadcast16(0xFF80);
+		USIZE nonAscii = (((above & Swar::Broadcast16(0x7FFF)) + Swar::Broadcast16(0x7FFF)) | above) & Swar::Broadcast16(0x8000);
+		letters &= Swar::Broadcast16(0x0080) & ~(nonAscii >> 8);
+	}
+	return word | (letters >> 2);
+}
+
+/**
+ * Mismatch - Index of the first unit where a and b differ, or count
+ *
+ * Compares a word at a time; the lowest set bit of the difference names
+ * the unit (the targets are little-endian).
+ */
+template <TCHAR TChar>
+FORCE_INLINE USIZE String::Mismatch(const TChar *a, const TChar *b, USIZE count)
+{
+	USIZE i = 0;
+	for (; i + WordUnits<TChar> <= count; i += WordUnits<TChar>)
+	{
+		USIZE difference = Swar::Load(a + i) ^ Swar::Load(b + i);
+		if (difference != 0)
+			return i + Swar::CountTrailingZeros(difference) / UnitBits<TChar>;
+	}
+	for (; i < count; i++)
+	{
+		if (a[i] != b[i])
+			return i;
+	}
+	return count;
+}
+
+/**
+ * IndexOf - First position of a unit
+ *
+ * @return Index of the first unit equal to unit, or -1
+ */
+template <TCHAR TChar>
+SSIZE String::IndexOf(const TChar *text, USIZE length, TChar unit)
+{
+	USIZE broadcast = sizeof(TChar) == 1 ? Swar::Broadcast((UINT8)unit) : Swar::Broadcast16((UINT16)unit);
+	USIZE i = 0;
+	for (; i + WordUnits<TChar> <= length; i += WordUnits<TChar>)
+	{
+		USIZE found = ZeroUnits<TChar>(Swar::Load(text + i) ^ broadcast);
+		if (found != 0)
+			return (SSIZE)(i + Swar::CountTrailingZeros(found) / UnitBits<TChar>);
+	}
+	for (; i < length; i++)
+	{
+		if (text[i] == unit)
+			return (SSIZE)i;
+	}
+	return -1;
+}
+
+/**
+ * IndexOf - First occurrence of a pattern
+ *
+ * Short patterns: a word of candidate positions at a time is filtered by
+ * comparing its units with the pattern's first unit and the units
+ * patternLength - 1 further on with its last unit; only positions passing
+ * both are compared in full. Pairing two units rejects far more positions
+ * than the first unit alone on text with common letters.
+ *
+ * Patterns of STRING_HORSPOOL_MIN_LENGTH units and more: Horspool. The unit
+ * under the pattern's end decides how far the pattern can move (up to its
+ * length, capped at 255). WCHAR units share the 256 skip entries by their
+ * low byte, which only shortens some skips.
+ *
+ * @return Index of the first match, 0 for an empty pattern, or -1
+ */
+template <TCHAR TChar>
+SSIZE String::IndexOf(const TChar *text, USIZE length, const TChar *pattern, USIZE patternLength)
+{
+	if (patternLength == 0)
+		return 0;
+	if (patternLength > length)
+		return -1;
+	if (patternLength == 1)
+		return IndexOf(text, length, pattern[0]);
+
+	USIZE lastStart = length - patternLength;
+	TChar lastUnit = pattern[patternLength - 1];
+
+	if (patternLength < STRING_HORSPOOL_MIN_LENGTH)
+	{
+		USIZE firstBroadcast = sizeof(TChar) == 1 ? Swar::Broadcast((UINT8)pattern[0]) : Swar::Broadcast16((UINT16)pattern[0]);
+		USIZE lastBroadcast = sizeof(TChar) == 1 ? Swar::Broadcast((UINT8)lastUnit) : Swar::Broadcast16((UINT16)lastUnit);
+		USIZE i = 0;
+		for (; i + WordUnits<TChar> - 1 <= lastStart; i += WordUnits<TChar>)
+		{
+			USIZE first = Swar::Load(text + i) ^ firstBroadcast;
+			USIZE last = Swar::Load(text + i + patternLength - 1) ^ lastBroadcast;
+			for (USIZE candidates = ZeroUnits<TChar>(first | last); candidates != 0; candidates &= candidates - 1)
+			{
+				USIZE start = i + Swar::CountTrailingZeros(candidates) / UnitBits<TChar>;
+				if (Mismatch(text + start + 1, pattern + 1, patternLength - 2) == patternLength - 2)
+					return (SSIZE)start;
+			}
+		}
+		for (; i <= lastStart; i++)
+		{
+			if (text[i] == pattern[0] && text[i + patternLength - 1] == lastUnit &&
+				Mismatch(text + i + 1, pattern + 1, patternLength - 2) == patternLength - 2)
+				return (SSIZE)i;
+		}
+		return -1;
+	}
+
+	// Skip table on the stack; the last occurrence of a unit before the end sets its shift
+	UINT8 skip[256];
+	Memory::Set(skip, patternLength < 255 ? (INT32)patternLength : 255, sizeof(skip));
+	for (USIZE j = 0; j + 1 < patternLength; j++)
+	{
+		USIZE shift = patternLength - 1 - j;
+		skip[(UINT8)pattern[j]] = (UINT8)(shift < 255 ? shift : 255);
+	}
+
+	for (USIZE i = 0; i <= lastStart;)
+	{
+		TChar unit = text[i + patternLength - 1];
+		if (unit == lastUnit && Mismatch(text + i, pattern, patternLength - 1) == patternLength - 1)
+			return (SSIZE)i;
+		i += skip[(UINT8)unit];
+	}
+	return -1;
+}
+
+/**
+ * Compare - Order two strings by unit value, then by length
+ *
+ * @return Negative, zero or positive as a sorts before, equal to or after b
+ */
+template <TCHAR TChar>
+INT32 String::Compare(const TChar *a, USIZE aLength, const TChar *b, USIZE bLength)
+{
+	USIZE common = aLength < bLength ? aLength : bLength;
+	USIZE i = Mismatch(a, b, common);
+	if (i < common)
+	{
+		// CHAR is signed; units order as unsigned values
+		if constexpr (sizeof(TChar) == 1)
+			return (UINT8)a[i] < (UINT8)b[i] ? -1 : 1;
+		else
+			return a[i] < b[i] ? -1 : 1;
+	}
+	if (aLength == bLength)
+		return 0;
+	return aLength < bLength ? -1 : 1;
+}
+
+/**
+ * EqualsIgnoreCase - Equality with ASCII letters folded to lower case
+ *
+ * Words that already match skip folding; others are folded and compared
+ * whole, so mixed-case module names stay on the word path.
+ */
+template <TCHAR TChar>
+BOOL String::EqualsIgnoreCase(const TChar *a, USIZE aLength, const TChar *b, USIZE bLength)
+{
+	if (aLength != bLength)
+		return FALSE;
+
+	USIZE i = 0;
+	for (; i + WordUnits<TChar> <= aLength; i += WordUnits<TChar>)
+	{
+		USIZE left = Swar::Load(a + i);
+		USIZE right = Swar::Load(b + i);
+		if (left != right && FoldCase<TChar>(left) != FoldCase<TChar>(right))
+			return FALSE;
+	}
+	for (; i < aLength; i++)
+	{
+		if (ToLowerCase(a[i]) != ToLowerCase(b[i]))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+template <TCHAR TChar>
+BOOL String::StartsWith(const TChar *text, USIZE length, const TChar *prefix, USIZE prefixLength)
+{
+	return prefixLength <= length && Mismatch(text, prefix, prefixLength) == prefixLength;
+}
+
+template <TCHAR TChar>
+BOOL String::EndsWith(const TChar *text, USIZE length, const TChar *suffix, USIZE suffixLength)
+{
+	return suffixLength <= length && Mismatch(text + length - suffixLength, suffix, suffixLength) == suffixLength;
+}
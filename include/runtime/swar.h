@@ -0,0 +1,135 @@
+/**
+ * swar.h - SIMD Within A Register
+ *
+ * Treats a USIZE as a vector of byte lanes (8 on 64-bit targets, 4 on
+ * 32-bit ones) so text and byte codecs can classify and transform a word
+ * of characters with plain integer instructions. Nothing here depends on
+ * an instruction set extension, and every constant is built from
+ * immediates, so it works the same on all four architectures and keeps
+ * .rdata empty.
+ *
+ * LANE ORDER:
+ *   Lane 0 is the lowest byte of the word, which is the first byte in
+ *   memory on every supported target (all little-endian).
+ *
+ * CLASSIFICATION:
+ *   GreaterOrEqual and InRange set 0x80 in each matching lane and require
+ *   every lane to be below 0x80. A lane at or above 0x80 carries into its
+ *   neighbours, so callers reject such words with HasHighBit, before or
+ *   after classifying. A lane mask shifted right by 7 has 1 per matching lane and
+ *   can be multiplied by a per-lane delta below 256.
+ *
+ * TEXT:
+ *   LoadChars and StoreChars move SWAR_LANES characters between text and
+ *   lanes. CHAR text is a plain word access; WCHAR text is narrowed and
+ *   widened, and characters above 0x7F load as 0x80, so ASCII-only
+ *   classification rejects them like any other non-ASCII byte.
+ */
+
+#pragma once
+
+#include "primitives.h"
+#include "embedded_string.h"
+
+// Unaligned loads and stores; the compiler picks instructions that allow any address
+typedef UINT16 __attribute__((aligned(1), may_alias)) UNALIGNED_UINT16;
+typedef UINT32 __attribute__((aligned(1), may_alias)) UNALIGNED_UINT32;
+typedef USIZE __attribute__((aligned(1), may_alias)) UNALIGNED_USIZE;
+
+// Byte lanes per word
+#define SWAR_LANES sizeof(USIZE)
+
+class Swar
+{
+public:
+    // value in every byte lane
+    static constexpr USIZE Broadcast(UINT8 value) { return (USIZE)-1 / 0xFF * value; }
+    // value in every 16-bit lane
+    static constexpr USIZE Broadcast16(UINT16 value) { return (USIZE)-1 / 0xFFFF * value; }
+    // value in every 32-bit lane
+    static constexpr USIZE Broadcast32(UINT32 value) { return (USIZE)-1 / 0xFFFFFFFF * value; }
+
+    static FORCE_INLINE USIZE Load(PCVOID address) { return *(const UNALIGNED_USIZE *)address; }
+    static FORCE_INLINE VOID Store(PVOID address, USIZE value) { *(UNALIGNED_USIZE *)address = value; }
+
+    // Reverses the byte order, so the first byte in memory becomes the most significant
+    static FORCE_INLINE USIZE ByteSwap(USIZE value)
+    {
+        if constexpr (sizeof(USIZE) == 8)
+            return __builtin_bswap64(value);
+        else
+            return __builtin_bswap32(value);
+    }
+
+    // SWAR_LANES characters as byte lanes; a WCHAR above 0x7F keeps its low 7 bits plus 0x80
+    template <TCHAR TChar>
+    static FORCE_INLINE USIZE LoadChars(const TChar *text)
+    {
+        if constexpr (sizeof(TChar) == 1)
+            return Load(text);
+        else
+            return NarrowWide(Load(text)) | (NarrowWide(Load(text + SWAR_LANES / 2)) << (SWAR_LANES * 4));
+    }
+
+    // Byte lanes as SWAR_LANES characters
+    template <TCHAR TChar>
+    static FORCE_INLINE VOID StoreChars(TChar *text, USIZE lanes)
+    {
+        if constexpr (sizeof(TChar) == 1)
+        {
+            Store(text, lanes);
+        }
+        else
+        {
+            Store(text, WidenBytes(lanes));
+            Store(text + SWAR_LANES / 2, WidenBytes(lanes >> (SWAR_LANES * 4)));
+        }
+    }
+
+    // TRUE if any lane is 0x80 or above
+    static FORCE_INLINE BOOL HasHighBit(USIZE lanes) { return (lanes & Broadcast(0x80)) != 0; }
+
+    // 0x80 in lanes >= bound (1-0x80); lanes must be below 0x80
+    static FORCE_INLINE USIZE GreaterOrEqual(USIZE lanes, UINT8 bound)
+    {
+        return (lanes + Broadcast((UINT8)(0x80 - bound))) & Broadcast(0x80);
+    }
+
+    // 0x80 in lanes within [low, high], high < 0x80; lanes must be below 0x80
+    static FORCE_INLINE USIZE InRange(USIZE lanes, UINT8 low, UINT8 high)
+    {
+        return GreaterOrEqual(lanes, low) & ~GreaterOrEqual(lanes, (UINT8)(high + 1));
+    }
+
+    // Lowest set bit of a non-zero word; (bit / 8) is the first marked lane
+    static FORCE_INLINE UINT32 CountTrailingZeros(USIZE value)
+    {
+        if constexpr (sizeof(USIZE) == 8)
+            return (UINT32)__builtin_ctzll(value);
+        else
+            return (UINT32)__builtin_ctz(value);
+    }
+
+private:
+    // SWAR_LANES / 2 16-bit characters -> the same number of bytes in the low half
+    static FORCE_INLINE USIZE NarrowWide(USIZE characters)
+    {
+        USIZE above = characters & Broadcast16(0xFF80);
+        USIZE flagged = (((above & Broadcast16(0x7FFF)) + Broadcast16(0x7FFF)) | above) & Broadcast16(0x8000);
+        USIZE bytes = (characters & Broadcast16(0x7F)) | (flagged >> 8);
+        bytes = (bytes | (bytes >> 8)) & Broadcast32(0xFFFF);
+        if constexpr (sizeof(USIZE) == 8)
+            bytes = (bytes | (bytes >> 16)) & 0xFFFFFFFF;
+        return bytes;
+    }
+
+    // Low SWAR_LANES / 2 bytes -> one per 16-bit lane
+    static FORCE_INLINE USIZE WidenBytes(USIZE bytes)
+    {
+        if constexpr (sizeof(USIZE) == 8)
+            bytes = ((bytes & 0xFFFFFFFF) | ((bytes & 0xFFFFFFFF) << 16)) & Broadcast32(0xFFFF);
+        else
+            bytes &= 0xFFFF;
+        return (bytes | (bytes << 8)) & Broadcast16(0xFF);
+    }
+};
@@ -0,0 +1,176 @@
+/**
+ * synchronization.h - Locking Primitives
+ *
+ * Provides mutual exclusion built on Atomic<T> and the platform Thread
+ * park/unpark operations. No lock owns kernel objects, so each one is a
+ * single machine word (SpinLock: two 32-bit counters), needs no
+ * initialization beyond zeroing, and can be embedded anywhere.
+ *
+ * PRIMITIVES:
+ *   SpinLock  - FIFO ticket lock with proportional pause backoff, falls back
+ *               to yielding the time slice under heavy contention
+ *   Mutex     - Word-sized lock that spins briefly, then queues the thread
+ *               on an intrusive stack-allocated list and parks it
+ *   LockGuard - Scoped acquire/release helper for either lock
+ *
+ * PLATFORM IMPLEMENTATION:
+ *   Windows: Park/Unpark map to NtWaitForAlertByThreadId/NtAlertThreadByThreadId
+ *
+ * USAGE:
+ *   Mutex lock;
+ *   {
+ *       LockGuard<Mutex> guard(lock);
+ *       // critical section
+ *   }
+ */
+
+#pragma once
+
+#include "atomic.h"
+#include "thread.h"
+
+/**
+ * SpinLock - Ticket spinlock
+ *
+ * Threads take a ticket and wait until it is served, which gives FIFO
+ * fairness. Waiters pause proportionally to their distance from the head
+ * of the line so they do not hammer the shared cache line.
+ */
+class SpinLock
+{
+private:
+    Atomic<UINT32> nextTicket;
+    Atomic<UINT32> nowServing;
+
+    // Pause iterations per waiter ahead of us
+    static constexpr UINT32 BackoffPerWaiter = 32;
+    // Spin rounds before giving up the time slice
+    static constexpr UINT32 YieldThreshold = 64;
+
+public:
+    constexpr SpinLock() : nextTicket(0), nowServing(0) {}
+
+    SpinLock(const SpinLock &) = delete;
+    SpinLock &operator=(const SpinLock &) = delete;
+
+    VOID Lock()
+    {
+        UINT32 ticket = nextTicket.FetchAdd(1, MemoryOrder::Relaxed);
+        UINT32 rounds = 0;
+
+        for (;;)
+        {
+            UINT32 serving = nowServing.Load(MemoryOrder::Acquire);
+            if (serving == ticket)
+                return;
+
+            if (++rounds >= YieldThreshold)
+            {
+                // Likely preempted lock holder or oversubscription
+                Thread::Yield();
+                continue;
+            }
+
+            UINT32 pauses = (ticket - serving) * BackoffPerWaiter;
+            for (UINT32 i = 0; i < pauses; i++)
+                CpuRelax();
+        }
+    }
+
+    BOOL TryLock()
+    {
+        UINT32 serving = nowServing.Load(MemoryOrder::Relaxed);
+        UINT32 expected = serving;
+        return nextTicket.CompareExchangeStrong(expected, serving + 1, MemoryOrder::Acquire);
+    }
+
+    VOID Unlock()
+    {
+        // Only the holder writes nowServing, so a plain increment is enough
+        nowServing.Store(nowServing.Load(MemoryOrder::Relaxed) + 1, MemoryOrder::Release);
+    }
+
+    BOOL IsLocked() const
+    {
+        return nextTicket.Load(MemoryOrder::Relaxed) != nowServing.Load(MemoryOrder::Relaxed);
+    }
+};
+
+/**
+ * Mutex - Parking mutex in a single word
+ *
+ * Word layout:
+ *   bit 0     - locked
+ *   bit 1     - waiter queue is being modified
+ *   bits 2..  - pointer to the head of the waiter queue (stack nodes)
+ *
+ * The uncontended paths are a single compare-exchange inline. Contended
+ * acquisitions spin a bounded number of times, then enqueue a node on
+ * their own stack and park until the unlocking thread hands them a wakeup.
+ * Woken threads compete for the lock again (no direct handoff), which keeps
+ * throughput high under contention.
+ */
+class Mutex
+{
+private:
+    static constexpr USIZE LockedBit = 1;
+    static constexpr USIZE QueueLockedBit = 2;
+    static constexpr USIZE FlagsMask = LockedBit | QueueLockedBit;
+
+    Atomic<USIZE> word;
+
+    VOID LockSlow();
+    VOID UnlockSlow();
+
+public:
+    constexpr Mutex() : word(0) {}
+
+    Mutex(const Mutex &) = delete;
+    Mutex &operator=(const Mutex &) = delete;
+
+    FORCE_INLINE VOID Lock()
+    {
+        USIZE expected = 0;
+        if (word.CompareExchangeWeak(expected, LockedBit, MemoryOrder::Acquire))
+            return;
+        LockSlow();
+    }
+
+    FORCE_INLINE BOOL TryLock()
+    {
+        USIZE current = word.Load(MemoryOrder::Relaxed);
+        if (current & LockedBit)
+            return FALSE;
+        return word.CompareExchangeStrong(current, current | LockedBit, MemoryOrder::Acquire);
+    }
+
+    FORCE_INLINE VOID Unlock()
+    {
+        USIZE expected = LockedBit;
+        if (word.CompareExchangeWeak(expected, 0, MemoryOrder::Release))
+            return;
+        UnlockSlow();
+    }
+
+    BOOL IsLocked() const
+    {
+        return (word.Load(MemoryOrder::Relaxed) & LockedBit) != 0;
+    }
+};
+
+/**
+ * LockGuard - Holds a lock for the lifetime of a scope
+ */
+template <typename TLock>
+class LockGuard
+{
+private:
+    TLock &lock;
+
+public:
+    explicit LockGuard(TLock &l) : lock(l) { lock.Lock(); }
+    ~LockGuard() { lock.Unlock(); }
+
+    LockGuard(const LockGuard &) = delete;
+    LockGuard &operator=(const LockGuard &) = delete;
+};
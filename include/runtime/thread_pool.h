@@ -0,0 +1,315 @@
+/**
+ * thread_pool.h - Work-Stealing Thread Pool
+ *
+ * Fork/join scheduler for CPU-bound work. Each participating thread owns a
+ * Chase-Lev deque: it pushes and pops tasks at the bottom while idle threads
+ * steal from the top, so local work stays cache-hot and load balances itself.
+ *
+ * DESIGN:
+ *   - Tasks are intrusive TASK headers embedded in caller-owned objects
+ *     (usually on the stack of the forking frame). Scheduling a task never
+ *     allocates, and the fork/join structure guarantees the frame outlives it.
+ *   - Dispatch goes through one relocated function pointer per task type,
+ *     generated from templates; no virtual functions, so no vtables in .rdata.
+ *   - Idle workers spin briefly, then park. A spawn wakes a single sleeper.
+ *   - Waiting threads execute other tasks instead of blocking.
+ *
+ * THREADS:
+ *   The thread that calls Start() becomes participant 0 and may spawn and
+ *   wait; pool workers may spawn and wait freely. Spawns from any other thread
+ *   run inline, which keeps results correct without parallelism.
+ *
+ * USAGE:
+ *   ThreadPool pool;
+ *   pool.Start(0); // 0 = one worker per logical processor
+ *
+ *   auto body = [&](USIZE i) { output[i] = Process(input[i]); };
+ *   pool.ParallelFor(0, count, 256, body);
+ *
+ *   auto left = MakeJob([&]() { SortLeft(); });
+ *   TaskGroup group;
+ *   group.Run(pool, left);
+ *   SortRight();
+ *   group.Wait(pool);
+ */
+
+#pragma once
+
+#include "platform.h"
+#include "synchronization.h"
+
+class ThreadPool;
+class TaskGroup;
+
+// Intrusive task header; Invoke receives the TASK it was scheduled with
+typedef struct _TASK
+{
+    VOID (*Invoke)(struct _TASK *task);
+    TaskGroup *Group;
+} TASK, *PTASK;
+
+/**
+ * TaskDeque - Chase-Lev work-stealing deque with fixed capacity
+ *
+ * Owner: Push/Take at the bottom. Thieves: Steal at the top.
+ * Memory orders follow Le, Pop, Cohen and Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ */
+class TaskDeque
+{
+public:
+    static constexpr SSIZE Capacity = 1024;
+
+private:
+    static constexpr SSIZE Mask = Capacity - 1;
+    static_assert((Capacity & Mask) == 0, "Capacity must be a power of two");
+
+    // top is written by thieves, bottom by the owner: keep them on separate lines
+    Atomic<SSIZE> top;
+    UINT8 topPadding[CACHE_LINE_SIZE - sizeof(SSIZE)];
+    Atomic<SSIZE> bottom;
+    UINT8 bottomPadding[CACHE_LINE_SIZE - sizeof(SSIZE)];
+    Atomic<PTASK> slots[Capacity];
+
+public:
+    TaskDeque() : top(0), bottom(0) {}
+
+    // Owner only; FALSE when full
+    BOOL Push(PTASK task)
+    {
+        SSIZE b = bottom.Load(MemoryOrder::Relaxed);
+        SSIZE t = top.Load(MemoryOrder::Acquire);
+        if (b - t >= Capacity)
+            return FALSE;
+        slots[b & Mask].Store(task, MemoryOrder::Relaxed);
+        AtomicThreadFence(MemoryOrder::Release);
+        bottom.Store(b + 1, MemoryOrder::Relaxed);
+        return TRUE;
+    }
+
+    // Owner only; newest task first
+    PTASK Take()
+    {
+        SSIZE b = bottom.Load(MemoryOrder::Relaxed) - 1;
+        bottom.Store(b, MemoryOrder::Relaxed);
+        AtomicThreadFence(MemoryOrder::SequentiallyConsistent);
+        SSIZE t = top.Load(MemoryOrder::Relaxed);
+
+        if (t > b)
+        {
+            // Empty
+            bottom.Store(b + 1, MemoryOrder::Relaxed);
+            return NULL;
+        }
+
+        PTASK task = slots[b & Mask].Load(MemoryOrder::Relaxed);
+        if (t == b)
+        {
+            // Last element: race against thieves for it
+            if (!top.CompareExchangeStrong(t, t + 1, MemoryOrder::SequentiallyConsistent))
+                task = NULL;
+            bottom.Store(b + 1, MemoryOrder::Relaxed);
+        }
+        return task;
+    }
+
+    // Any thread; oldest task first, NULL when empty or when losing a race
+    PTASK Steal()
+    {
+        SSIZE t = top.Load(MemoryOrder::Acquire);
+        AtomicThreadFence(MemoryOrder::SequentiallyConsistent);
+        SSIZE b = bottom.Load(MemoryOrder::Acquire);
+        if (t >= b)
+            return NULL;
+
+        PTASK task = slots[t & Mask].Load(MemoryOrder::Relaxed);
+        if (!top.CompareExchangeStrong(t, t + 1, MemoryOrder::SequentiallyConsistent))
+            return NULL;
+        return task;
+    }
+
+    BOOL IsEmpty() const
+    {
+        return top.Load(MemoryOrder::Acquire) >= bottom.Load(MemoryOrder::Acquire);
+    }
+};
+
+/**
+ * TaskGroup - Counts outstanding tasks of one fork/join scope
+ */
+class TaskGroup
+{
+private:
+    friend class ThreadPool;
+    Atomic<USIZE> pending;
+
+public:
+    TaskGroup() : pending(0) {}
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    // Schedule job; it must stay alive until Wait returns
+    template <typename TJob>
+    VOID Run(ThreadPool &pool, TJob &job);
+
+    // Execute pending work until every task of this group has finished
+    VOID Wait(ThreadPool &pool);
+
+    BOOL IsDone() const { return pending.Load(MemoryOrder::Acquire) == 0; }
+};
+
+/**
+ * Job - Binds a functor to a TASK header
+ *
+ * TFunc is called with no arguments. The functor is stored by value, so a
+ * lambda capturing by reference costs only its captures.
+ */
+template <typename TFunc>
+class Job
+{
+private:
+    TASK task; // Must stay the first member
+    TFunc function;
+
+    static VOID Execute(PTASK task)
+    {
+        ((Job *)task)->function();
+    }
+
+public:
+    Job(const TFunc &f) : function(f)
+    {
+        task.Invoke = (VOID(*)(PTASK))PerformRelocation((PVOID)Execute);
+        task.Group = NULL;
+    }
+
+    PTASK GetTask() { return &task; }
+};
+
+template <typename TFunc>
+FORCE_INLINE Job<TFunc> MakeJob(const TFunc &function)
+{
+    return Job<TFunc>(function);
+}
+
+class ThreadPool
+{
+public:
+    // Upper bound on participants (workers plus the owning thread)
+    static constexpr UINT32 MaxParticipants = 64;
+
+private:
+    // Per-participant state; padding keeps hot fields of neighbours apart
+    struct WORKER
+    {
+        TaskDeque Deque;
+        Thread Handle;
+        ThreadPool *Pool;
+        Atomic<USIZE> ThreadId;
+        Atomic<BOOL> Sleeping;
+        UINT32 Index;
+        UINT32 Random;
+        UINT8 Padding[CACHE_LINE_SIZE];
+    };
+
+    WORKER *workers;
+    UINT32 participantCount;
+    Atomic<BOOL> stopping;
+    Atomic<UINT32> sleeperCount;
+
+    static INT32 WorkerMain(PVOID parameter);
+
+    // Index of the calling thread, or -1 for foreign threads
+    INT32 FindParticipant() const;
+    // Try the own deque, then steal from others
+    PTASK FindTask(WORKER &self);
+    VOID WakeOne();
+    BOOL HasVisibleWork() const;
+
+    static VOID RunTask(PTASK task);
+
+    template <typename TFunc>
+    struct RANGE_JOB
+    {
+        TASK Task; // Must stay the first member
+        ThreadPool *Pool;
+        USIZE Begin;
+        USIZE End;
+        USIZE Grain;
+        TFunc *Function;
+
+        static VOID Execute(PTASK task)
+        {
+            RANGE_JOB *job = (RANGE_JOB *)task;
+            job->Pool->ParallelFor(job->Begin, job->End, job->Grain, *job->Function);
+        }
+    };
+
+public:
+    ThreadPool() : workers(NULL), participantCount(0), stopping(FALSE), sleeperCount(0) {}
+    ~ThreadPool() { Stop(); }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Start workerCount threads (0 = one per logical processor minus the caller)
+    BOOL Start(UINT32 workerCount);
+    // Wake and join all workers; pending tasks must have been waited for
+    VOID Stop();
+
+    // Threads executing tasks, including the owning thread
+    UINT32 GetParticipantCount() const { return participantCount; }
+
+    // Queue a task owned by the caller; runs it inline if it cannot be queued
+    VOID Spawn(PTASK task);
+    // Run at most one queued task on behalf of the calling thread
+    BOOL RunPendingTask();
+
+    /**
+     * ParallelFor - Invoke function(i) for every i in [begin, end)
+     *
+     * The range is split in halves until a piece holds at most grain
+     * indices; each split forks the upper half as a stack-resident task.
+     */
+    template <typename TFunc>
+    VOID ParallelFor(USIZE begin, USIZE end, USIZE grain, TFunc &function)
+    {
+        if (grain == 0)
+            grain = 1;
+
+        if (end - begin <= grain)
+        {
+            for (USIZE i = begin; i < end; i++)
+                function(i);
+            return;
+        }
+
+        USIZE middle = begin + ((end - begin) >> 1);
+
+        RANGE_JOB<TFunc> upper;
+        upper.Task.Invoke = (VOID(*)(PTASK))PerformRelocation((PVOID)RANGE_JOB<TFunc>::Execute);
+        upper.Pool = this;
+        upper.Begin = middle;
+        upper.End = end;
+        upper.Grain = grain;
+        upper.Function = &function;
+
+        TaskGroup group;
+        group.pending.Store(1, MemoryOrder::Relaxed);
+        upper.Task.Group = &group;
+        Spawn(&upper.Task);
+
+        ParallelFor(begin, middle, grain, function);
+        group.Wait(*this);
+    }
+};
+
+template <typename TJob>
+VOID TaskGroup::Run(ThreadPool &pool, TJob &job)
+{
+    PTASK task = job.GetTask();
+    task->Group = this;
+    pending.FetchAdd(1, MemoryOrder::Relaxed);
+    pool.Spawn(task);
+}
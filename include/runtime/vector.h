@@ -0,0 +1,340 @@
+/**
+ * vector.h - Growable Array
+ *
+ * Vector<T, Alloc, InlineCapacity> owns a contiguous run of elements and
+ * grows geometrically (capacity doubles), so n pushes cost O(n) element
+ * moves in total.
+ *
+ * DESIGN:
+ *   - No exceptions: operations that may allocate return FALSE when the
+ *     allocator is out of memory and leave the vector unchanged
+ *   - Relocation on growth is one Memory::Copy for IsTriviallyRelocatable
+ *     types, and move construction plus destruction otherwise
+ *   - The first InlineCapacity elements live inside the object; the vector
+ *     only allocates once it outgrows them
+ *   - Alloc is a policy from allocator_policy.h; with ArenaAllocator the
+ *     last block grows in place instead of being copied
+ *   - Not copyable (a copy could fail); move construction and assignment
+ *     take the elements over
+ *
+ * USAGE:
+ *   Vector<UINT32> values;
+ *   if (!values.Push(42))
+ *       return FALSE; // out of memory
+ *   for (UINT32 value : values) { }
+ *
+ *   SmallVector<PCWCHAR, 8> names; // no allocation for up to 8 names
+ */
+
+#pragma once
+
+#include "utility.h"
+#include "memory.h"
+#include "allocator_policy.h"
+
+// Elements in the first heap block of a vector without inline storage
+#define VECTOR_MIN_CAPACITY 4
+
+template <typename T, USIZE InlineCapacity>
+struct VectorInlineStorage
+{
+    alignas(T) UINT8 Bytes[InlineCapacity * sizeof(T)];
+
+    T *Get() const { return (T *)Bytes; }
+};
+
+template <typename T>
+struct VectorInlineStorage<T, 0>
+{
+    T *Get() const { return NULL; }
+};
+
+template <typename T, typename Alloc = HeapAllocator, USIZE InlineCapacity = 0>
+class Vector
+{
+private:
+    T *items;
+    USIZE count;
+    USIZE capacity;
+    Alloc allocator;
+    VectorInlineStorage<T, InlineCapacity> storage;
+
+    BOOL IsInline() const { return items == storage.Get(); }
+
+    // Move n elements to uninitialized target, leaving source uninitialized
+    static VOID Relocate(T *target, T *source, USIZE n)
+    {
+        if constexpr (IsTriviallyRelocatable<T>::Value)
+        {
+            Memory::Copy(target, source, n * sizeof(T));
+        }
+        else
+        {
+            for (USIZE i = 0; i < n; i++)
+            {
+                new (target + i) T(Move(source[i]));
+                source[i].~T();
+            }
+        }
+    }
+
+    static VOID Destroy(T *first, USIZE n)
+    {
+        if constexpr (!__is_trivially_destructible(T))
+        {
+            for (USIZE i = 0; i < n; i++)
+                first[i].~T();
+        }
+    }
+
+    VOID ReleaseBlock()
+    {
+        if (!IsInline())
+            allocator.Release(items, capacity * sizeof(T), alignof(T));
+    }
+
+    // Capacity for at least needed elements: double the current one
+    USIZE GetGrownCapacity(USIZE needed) const
+    {
+        USIZE grown = capacity * 2;
+        if (grown < VECTOR_MIN_CAPACITY)
+            grown = VECTOR_MIN_CAPACITY;
+        return grown < needed ? needed : grown;
+    }
+
+    // Resize the current block in place, or allocate a new one and leave moving to the caller
+    T *PrepareBlock(USIZE newCapacity, BOOL &inPlace)
+    {
+        inPlace = FALSE;
+        if (newCapacity > (USIZE)-1 / sizeof(T))
+            return NULL;
+        if (!IsInline() && allocator.Resize(items, capacity * sizeof(T), newCapacity * sizeof(T)))
+        {
+            inPlace = TRUE;
+            return items;
+        }
+        return (T *)allocator.Allocate(newCapacity * sizeof(T), alignof(T));
+    }
+
+    // Push when full; the new element is built before the old ones move, since args may refer to one
+    template <typename... Args>
+    NOINLINE BOOL EmplaceGrow(Args &&...args)
+    {
+        USIZE newCapacity = GetGrownCapacity(count + 1);
+        BOOL inPlace;
+        T *block = PrepareBlock(newCapacity, inPlace);
+        if (block == NULL)
+            return FALSE;
+
+        new (block + count) T(Forward<Args>(args)...);
+        if (!inPlace)
+        {
+            Relocate(block, items, count);
+            ReleaseBlock();
+            items = block;
+        }
+        capacity = newCapacity;
+        count++;
+        return TRUE;
+    }
+
+    // Take over other's elements; this vector must hold none
+    VOID TakeFrom(Vector &other)
+    {
+        if (other.IsInline())
+        {
+            Relocate(items, other.items, other.count);
+        }
+        else
+        {
+            items = other.items;
+            capacity = other.capacity;
+            other.items = other.storage.Get();
+            other.capacity = InlineCapacity;
+        }
+        count = other.count;
+        other.count = 0;
+    }
+
+public:
+    // items is set in the body: storage is constructed after it
+    Vector() : count(0), capacity(InlineCapacity), allocator() { items = storage.Get(); }
+    explicit Vector(const Alloc &policy) : count(0), capacity(InlineCapacity), allocator(policy) { items = storage.Get(); }
+
+    ~Vector()
+    {
+        Destroy(items, count);
+        ReleaseBlock();
+    }
+
+    Vector(const Vector &) = delete;
+    Vector &operator=(const Vector &) = delete;
+
+    Vector(Vector &&other) : count(0), capacity(InlineCapacity), allocator(other.allocator)
+    {
+        items = storage.Get();
+        TakeFrom(other);
+    }
+
+    Vector &operator=(Vector &&other)
+    {
+        if (this != &other)
+        {
+            Destroy(items, count);
+            ReleaseBlock();
+            items = storage.Get();
+            count = 0;
+            capacity = InlineCapacity;
+            allocator = other.allocator;
+            TakeFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * Reserve - Make room for at least newCapacity elements
+     *
+     * @return FALSE if the allocation failed (the vector is unchanged)
+     */
+    BOOL Reserve(USIZE newCapacity)
+    {
+        if (newCapacity <= capacity)
+            return TRUE;
+        BOOL inPlace;
+        T *block = PrepareBlock(newCapacity, inPlace);
+        if (block == NULL)
+            return FALSE;
+        if (!inPlace)
+        {
+            Relocate(block, items, count);
+            ReleaseBlock();
+            items = block;
+        }
+        capacity = newCapacity;
+        return TRUE;
+    }
+
+    // Construct an element at the end from args; FALSE if out of memory
+    template <typename... Args>
+    FORCE_INLINE BOOL Emplace(Args &&...args)
+    {
+        if (count == capacity)
+            return EmplaceGrow(Forward<Args>(args)...);
+        new (items + count) T(Forward<Args>(args)...);
+        count++;
+        return TRUE;
+    }
+
+    FORCE_INLINE BOOL Push(const T &value) { return Emplace(value); }
+    FORCE_INLINE BOOL Push(T &&value) { return Emplace(Move(value)); }
+
+    // Append n elements copied from values (which must not point into this vector)
+    BOOL Append(const T *values, USIZE n)
+    {
+        if (count + n > capacity && !Reserve(GetGrownCapacity(count + n)))
+            return FALSE;
+        if constexpr (__is_trivially_copyable(T))
+        {
+            Memory::Copy(items + count, values, n * sizeof(T));
+        }
+        else
+        {
+            for (USIZE i = 0; i < n; i++)
+                new (items + count + i) T(values[i]);
+        }
+        count += n;
+        return TRUE;
+    }
+
+    // Insert value before index (index == size appends), shifting the rest up
+    BOOL Insert(USIZE index, T value)
+    {
+        if (index >= count)
+            return Push(Move(value));
+        if (count == capacity && !Reserve(GetGrownCapacity(count + 1)))
+            return FALSE;
+        new (items + count) T(Move(items[count - 1]));
+        for (USIZE i = count - 1; i > index; i--)
+            items[i] = Move(items[i - 1]);
+        items[index] = Move(value);
+        count++;
+        return TRUE;
+    }
+
+    // Remove the element at index, keeping the order of the rest
+    VOID RemoveAt(USIZE index)
+    {
+        for (USIZE i = index; i + 1 < count; i++)
+            items[i] = Move(items[i + 1]);
+        count--;
+        Destroy(items + count, 1);
+    }
+
+    // Remove the element at index by moving the last one into its place (O(1), reorders)
+    VOID RemoveSwap(USIZE index)
+    {
+        count--;
+        if (index != count)
+            items[index] = Move(items[count]);
+        Destroy(items + count, 1);
+    }
+
+    VOID Pop()
+    {
+        count--;
+        Destroy(items + count, 1);
+    }
+
+    // Grow with value-initialized elements or shrink by destroying the tail
+    BOOL Resize(USIZE newCount)
+    {
+        if (newCount <= count)
+        {
+            Destroy(items + newCount, count - newCount);
+            count = newCount;
+            return TRUE;
+        }
+        if (newCount > capacity && !Reserve(newCount))
+            return FALSE;
+        for (USIZE i = count; i < newCount; i++)
+            new (items + i) T();
+        count = newCount;
+        return TRUE;
+    }
+
+    // Destroy every element; the capacity is kept
+    VOID Clear()
+    {
+        Destroy(items, count);
+        count = 0;
+    }
+
+    T &operator[](USIZE index) { return items[index]; }
+    const T &operator[](USIZE index) const { return items[index]; }
+
+    T &First() { return items[0]; }
+    T &Last() { return items[count - 1]; }
+
+    T *GetData() { return items; }
+    const T *GetData() const { return items; }
+    USIZE GetSize() const { return count; }
+    USIZE GetCapacity() const { return capacity; }
+    BOOL IsEmpty() const { return count == 0; }
+
+    // Range-based for support
+    T *begin() { return items; }
+    T *end() { return items + count; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + count; }
+};
+
+// Vector with room for InlineCapacity elements before it allocates
+template <typename T, USIZE InlineCapacity, typename Alloc = HeapAllocator>
+using SmallVector = Vector<T, Alloc, InlineCapacity>;
+
+// A vector without inline storage never points into itself, so vectors of vectors relocate by copy
+template <typename T, typename Alloc>
+struct IsTriviallyRelocatable<Vector<T, Alloc, 0>>
+{
+    static constexpr BOOL Value = __is_trivially_copyable(Alloc);
+};
@@ -0,0 +1,125 @@
+#!/usr/bin/env pwsh
+# Generate orderfile.txt from the profile-*.bin records of a PROFILE build.
+#
+# The blob runs cold, so its first pass pays for every i-cache line and
+# i-TLB page it touches. The generated order is:
+#   1. _start, which must stay at offset 0 of .text
+#   2. hot functions, most entries first
+#   3. the remaining executed functions, in the order they first ran
+# Functions that never ran are not listed; lld-link places them after every
+# listed one, so error paths and unused code end up at the back of the blob.
+
+param(
+    [Parameter(Mandatory = $true)]
+    [string]$MapFile,
+
+    # Directory holding profile-*.bin, or a single profile file
+    [string]$ProfilePath = ".",
+
+    # Output order file (default: orderfile.txt in the project root)
+    [string]$OutFile = "",
+
+    # Entries at which a function counts as hot
+    [int]$HotThreshold = 64
+)
+
+$ErrorActionPreference = "Stop"
+
+. "$PSScriptRoot\profile-common.ps1"
+
+if (-not $OutFile) {
+    $OutFile = Join-Path (Split-Path -Parent $PSScriptRoot) "orderfile.txt"
+}
+
+$symbols = Read-Symbols $MapFile
+if ($symbols.Count -eq 0) {
+    Write-Error "No symbols found in $MapFile (expected an lld-link /MAP file)"
+    exit 1
+}
+
+$anchor = Find-Anchor $symbols $MapFile
+$files = @(Get-ProfileFiles $ProfilePath)
+
+# lld-link adds the i386 underscore to undecorated /ORDER names itself, so
+# names are written as they appear on the other architectures
+$i386 = $anchor.Name -eq "___cyg_profile_func_enter"
+
+# -----------------------------------------------------------------------------
+# Count function entries and note the cycle of each function's first entry
+# -----------------------------------------------------------------------------
+$entries = @{}
+$firstCycles = @{}
+$names = @{}
+
+foreach ($file in $files) {
+    $bytes = [System.IO.File]::ReadAllBytes($file.FullName)
+    $position = 0
+
+    while ($position + $ChunkHeaderSize -le $bytes.Length) {
+        if ([BitConverter]::ToUInt32($bytes, $position) -ne $ProfileMagic) {
+            Write-Warning "$($file.Name): bad chunk header at offset $position"
+            break
+        }
+        $count = [BitConverter]::ToUInt32($bytes, $position + 4)
+        $position += $ChunkHeaderSize
+
+        for ($i = 0; $i -lt $count -and $position + $RecordSize -le $bytes.Length; $i++) {
+            $cycles = [BitConverter]::ToUInt64($bytes, $position)
+            $kind = [BitConverter]::ToUInt32($bytes, $position + 8)
+            $offset = [BitConverter]::ToInt32($bytes, $position + 12)
+            $position += $RecordSize
+
+            if ($kind -ne $EventEnter) {
+                continue
+            }
+
+            # Only function entries; PROFILE_SCOPE records point inside a function
+            $address = [UInt64]([Int64]$anchor.Address + $offset)
+            if (-not $names.ContainsKey($address)) {
+                $found = Find-Symbol $symbols $address
+                $names[$address] = if ($found -ge 0 -and $symbols[$found].Address -eq $address) { $symbols[$found].Name } else { $null }
+            }
+            $name = $names[$address]
+            if ($null -eq $name) {
+                continue
+            }
+
+            if ($entries.ContainsKey($name)) {
+                $entries[$name]++
+                if ($cycles -lt $firstCycles[$name]) {
+                    $firstCycles[$name] = $cycles
+                }
+            }
+            else {
+                $entries[$name] = 1
+                $firstCycles[$name] = $cycles
+            }
+        }
+    }
+}
+
+if ($entries.Count -eq 0) {
+    Write-Error "No function entries in $ProfilePath"
+    exit 1
+}
+
+# -----------------------------------------------------------------------------
+# Order: _start, hot by entry count, the rest by first entry
+# -----------------------------------------------------------------------------
+$executed = @($entries.Keys | Where-Object { $_ -ne "_start" -and $_ -ne "__start" })
+$hot = @($executed | Where-Object { $entries[$_] -ge $HotThreshold } |
+    Sort-Object @{ Expression = { $entries[$_] }; Descending = $true }, @{ Expression = { $firstCycles[$_] } }, @{ Expression = { $_ } })
+$warm = @($executed | Where-Object { $entries[$_] -lt $HotThreshold } |
+    Sort-Object @{ Expression = { $firstCycles[$_] } }, @{ Expression = { $_ } })
+
+$lines = New-Object System.Collections.Generic.List[string]
+$lines.Add("_start")
+foreach ($name in @($hot) + @($warm)) {
+    if ($i386 -and $name.StartsWith("_")) {
+        $name = $name.Substring(1)
+    }
+    $lines.Add($name)
+}
+
+$lines | Set-Content -Path $OutFile -Encoding ascii
+Write-Host "Wrote $($lines.Count) functions ($($hot.Count) hot, $($warm.Count) warm) from $($files.Count) thread(s) to $OutFile"
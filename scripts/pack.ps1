@@ -0,0 +1,157 @@
+#!/usr/bin/env pwsh
+# Pack a PIC blob: decompression stub + header + LZ4-compressed payload.
+#
+# Run by the build when configured with -DPACK=ON. The output loads and runs
+# exactly like the payload; see stub/start.cc for the layout and the stub's
+# side of the header.
+
+param(
+    [Parameter(Mandatory = $true)]
+    [string]$StubPath,
+
+    [Parameter(Mandatory = $true)]
+    [string]$PayloadPath,
+
+    [Parameter(Mandatory = $true)]
+    [string]$OutFile,
+
+    # Match candidates tried per position; higher packs tighter and slower, never slower to unpack
+    [int]$SearchDepth = 256
+)
+
+$ErrorActionPreference = "Stop"
+
+$PackMagic = 0x314B4350
+
+# LZ4 block compressor with hash chains. Build-time only, so it trades
+# compression speed for ratio; the output is plain LZ4 block format.
+Add-Type -TypeDefinition @'
+using System;
+using System.IO;
+
+public static class Lz4BlockEncoder
+{
+    const int MinMatch = 4;
+    const int LastLiterals = 5;   // The block ends with at least 5 literals
+    const int MatchStartLimit = 12; // The last match starts at least 12 bytes before the end
+    const int MaxOffset = 65535;
+    const int HashBits = 16;
+
+    static int Hash(byte[] data, int position)
+    {
+        uint value = (uint)(data[position] | data[position + 1] << 8 | data[position + 2] << 16 | data[position + 3] << 24);
+        return (int)((value * 2654435761u) >> (32 - HashBits));
+    }
+
+    static void WriteLength(MemoryStream output, int length)
+    {
+        while (length >= 255)
+        {
+            output.WriteByte(255);
+            length -= 255;
+        }
+        output.WriteByte((byte)length);
+    }
+
+    static void WriteSequence(MemoryStream output, byte[] data, int literalStart, int literalLength, int offset, int matchLength)
+    {
+        int matchCode = matchLength - MinMatch;
+        int token = (Math.Min(literalLength, 15) << 4) | (offset == 0 ? 0 : Math.Min(matchCode, 15));
+        output.WriteByte((byte)token);
+        if (literalLength >= 15)
+            WriteLength(output, literalLength - 15);
+        output.Write(data, literalStart, literalLength);
+        if (offset == 0)
+            return;
+        output.WriteByte((byte)offset);
+        output.WriteByte((byte)(offset >> 8));
+        if (matchCode >= 15)
+            WriteLength(output, matchCode - 15);
+    }
+
+    public static byte[] Compress(byte[] data, int searchDepth)
+    {
+        int length = data.Length;
+        int[] head = new int[1 << HashBits];
+        int[] previous = new int[length];
+        for (int i = 0; i < head.Length; i++)
+            head[i] = -1;
+
+        MemoryStream output = new MemoryStream();
+        int matchEndLimit = length - LastLiterals;
+        int anchor = 0;
+        int position = 0;
+
+        while (position + MatchStartLimit <= length)
+        {
+            int bestLength = 0;
+            int bestOffset = 0;
+            int hash = Hash(data, position);
+            int attempts = searchDepth;
+            for (int candidate = head[hash]; candidate >= 0 && position - candidate <= MaxOffset && attempts > 0; candidate = previous[candidate], attempts--)
+            {
+                if (data[candidate + bestLength] != data[position + bestLength])
+                    continue;
+                int matched = 0;
+                while (position + matched < matchEndLimit && data[candidate + matched] == data[position + matched])
+                    matched++;
+                if (matched > bestLength)
+                {
+                    bestLength = matched;
+                    bestOffset = position - candidate;
+                }
+            }
+
+            previous[position] = head[hash];
+            head[hash] = position;
+
+            if (bestLength < MinMatch)
+            {
+                position++;
+                continue;
+            }
+
+            WriteSequence(output, data, anchor, position - anchor, bestOffset, bestLength);
+
+            // Positions inside the match become candidates for later ones
+            int matchEnd = position + bestLength;
+            for (position++; position < matchEnd; position++)
+            {
+                if (position + MinMatch > length)
+                    continue;
+                int inner = Hash(data, position);
+                previous[position] = head[inner];
+                head[inner] = position;
+            }
+            anchor = position;
+        }
+
+        WriteSequence(output, data, anchor, length - anchor, 0, 0);
+        return output.ToArray();
+    }
+}
+'@
+
+$stub = [System.IO.File]::ReadAllBytes($StubPath)
+$payload = [System.IO.File]::ReadAllBytes($PayloadPath)
+if ($stub.Length -eq 0 -or $payload.Length -eq 0) {
+    Write-Error "Empty stub or payload"
+    exit 1
+}
+
+$packed = [Lz4BlockEncoder]::Compress($payload, $SearchDepth)
+
+# Header: Magic, ~Magic, PackedSize, UnpackedSize (PACKED_BLOB_HEADER in stub/start.cc)
+# The stub only searches the padding after its last function, StubEnd, so the header follows the stub directly
+$padding = (4 - ($stub.Length % 4)) % 4
+$stream = New-Object System.IO.MemoryStream
+$stream.Write($stub, 0, $stub.Length)
+$stream.Write((New-Object byte[] $padding), 0, $padding)
+foreach ($field in @([UInt32]$PackMagic, ([UInt32]::MaxValue - [UInt32]$PackMagic), [UInt32]$packed.Length, [UInt32]$payload.Length)) {
+    $stream.Write([BitConverter]::GetBytes([UInt32]$field), 0, 4)
+}
+$stream.Write($packed, 0, $packed.Length)
+[System.IO.File]::WriteAllBytes($OutFile, $stream.ToArray())
+
+$total = $stream.Length
+Write-Host ("Packed {0} -> {1} bytes ({2:P1}): stub {3}, header 16, LZ4 {4}" -f $payload.Length, $total, ($total / $payload.Length), $stub.Length, $packed.Length)
@@ -0,0 +1,152 @@
+#!/usr/bin/env pwsh
+# Collapse profile-*.bin records from a PROFILE build into flame graph input.
+#
+# Every line of the output is "outer;...;inner <self cycles>", the folded
+# format read by flamegraph.pl, inferno and speedscope. Code addresses are
+# resolved against the linker map written next to output.exe.
+
+param(
+    [Parameter(Mandatory = $true)]
+    [string]$MapFile,
+
+    # Directory holding profile-*.bin, or a single profile file
+    [string]$ProfilePath = ".",
+
+    # Write here instead of the console
+    [string]$OutFile = "",
+
+    # Pass symbol names through llvm-cxxfilt
+    [switch]$Demangle
+)
+
+$ErrorActionPreference = "Stop"
+
+. "$PSScriptRoot\profile-common.ps1"
+
+$symbols = Read-Symbols $MapFile
+if ($symbols.Count -eq 0) {
+    Write-Error "No symbols found in $MapFile (expected an lld-link /MAP file)"
+    exit 1
+}
+
+$anchor = Find-Anchor $symbols $MapFile
+$files = @(Get-ProfileFiles $ProfilePath)
+
+# -----------------------------------------------------------------------------
+# Replay enter/exit events per thread and charge self time to each stack
+# -----------------------------------------------------------------------------
+$folded = @{}
+$names = @{}
+
+function Add-Folded([System.Collections.Generic.List[object]]$stack, [UInt64]$selfCycles) {
+    $key = ($stack | ForEach-Object { $_.Name }) -join ";"
+    if ($folded.ContainsKey($key)) {
+        $folded[$key] += $selfCycles
+    }
+    else {
+        $folded[$key] = $selfCycles
+    }
+}
+
+# Close the innermost frame at $cycles
+function Pop-Frame([System.Collections.Generic.List[object]]$stack, [UInt64]$cycles) {
+    $frame = $stack[$stack.Count - 1]
+    $elapsed = if ($cycles -gt $frame.Start) { $cycles - $frame.Start } else { [UInt64]0 }
+    $self = if ($elapsed -gt $frame.Children) { $elapsed - $frame.Children } else { [UInt64]0 }
+    Add-Folded $stack $self
+    $stack.RemoveAt($stack.Count - 1)
+    if ($stack.Count -gt 0) {
+        $stack[$stack.Count - 1].Children += $elapsed
+    }
+}
+
+foreach ($file in $files) {
+    $bytes = [System.IO.File]::ReadAllBytes($file.FullName)
+    $stack = New-Object System.Collections.Generic.List[object]
+    $lastCycles = [UInt64]0
+    $position = 0
+
+    while ($position + $ChunkHeaderSize -le $bytes.Length) {
+        if ([BitConverter]::ToUInt32($bytes, $position) -ne $ProfileMagic) {
+            Write-Warning "$($file.Name): bad chunk header at offset $position"
+            break
+        }
+        $count = [BitConverter]::ToUInt32($bytes, $position + 4)
+        $position += $ChunkHeaderSize
+
+        for ($i = 0; $i -lt $count -and $position + $RecordSize -le $bytes.Length; $i++) {
+            $cycles = [BitConverter]::ToUInt64($bytes, $position)
+            $kind = [BitConverter]::ToUInt32($bytes, $position + 8)
+            $offset = [BitConverter]::ToInt32($bytes, $position + 12)
+            $position += $RecordSize
+            $lastCycles = $cycles
+
+            $address = [UInt64]([Int64]$anchor.Address + $offset)
+            if (-not $names.ContainsKey($address)) {
+                $names[$address] = Resolve-Address $symbols $address
+            }
+            $name = $names[$address]
+
+            if ($kind -eq $EventEnter) {
+                $stack.Add([pscustomobject]@{ Name = $name; Start = $cycles; Children = [UInt64]0 })
+                continue
+            }
+
+            # Exits without a matching enter started before the profiler was attached
+            $depth = $stack.Count - 1
+            while ($depth -ge 0 -and $stack[$depth].Name -ne $name) {
+                $depth--
+            }
+            if ($depth -lt 0) {
+                continue
+            }
+            while ($stack.Count -gt $depth) {
+                Pop-Frame $stack $cycles
+            }
+        }
+    }
+
+    # Frames still open when the thread stopped recording
+    while ($stack.Count -gt 0) {
+        Pop-Frame $stack $lastCycles
+    }
+}
+
+# -----------------------------------------------------------------------------
+# Output
+# -----------------------------------------------------------------------------
+$lines = @($folded.Keys | Sort-Object | ForEach-Object { "$_ $($folded[$_])" })
+
+if ($Demangle) {
+    $filter = Get-Command llvm-cxxfilt -ErrorAction SilentlyContinue
+    if ($null -eq $filter) {
+        Write-Warning "llvm-cxxfilt not found; names are left mangled"
+    }
+    else {
+        # Demangle each frame; i386 symbols carry an extra leading underscore
+        $unique = @($names.Values | ForEach-Object { ($_ -split '\+0x')[0] } | Sort-Object -Unique)
+        $plain = @($unique | ForEach-Object { if ($_ -like "__Z*") { $_.Substring(1) } else { $_ } })
+        $demangled = @($plain | & $filter.Source)
+        $map = @{}
+        for ($i = 0; $i -lt $unique.Count; $i++) {
+            $map[$unique[$i]] = $demangled[$i]
+        }
+        $lines = @($lines | ForEach-Object {
+                $space = $_.LastIndexOf(' ')
+                $frames = $_.Substring(0, $space) -split ';' | ForEach-Object {
+                    $parts = $_ -split '\+0x', 2
+                    $text = $map[$parts[0]]
+                    if ($parts.Count -eq 2) { "$text+0x$($parts[1])" } else { $text }
+                }
+                ($frames -join ';') + $_.Substring($space)
+            })
+    }
+}
+
+if ($OutFile) {
+    $lines | Set-Content -Path $OutFile -Encoding ascii
+    Write-Host "Wrote $($lines.Count) stacks from $($files.Count) thread(s) to $OutFile"
+}
+else {
+    $lines
+}
@@ -0,0 +1,83 @@
+# Shared by the profiling scripts; dot-source it:  . "$PSScriptRoot\profile-common.ps1"
+#
+# Reads the lld-link map of a -DPROFILE=ON build and locates profile-*.bin
+# files. Record layout matches PROFILE_CHUNK_HEADER / PROFILE_RECORD in
+# include/runtime/platform/profiler.h.
+
+$ProfileMagic = 0x31465250
+$ChunkHeaderSize = 32
+$RecordSize = 16
+$EventEnter = 0
+
+# -----------------------------------------------------------------------------
+# Linker map: "Publics by Value" lines of lld-link /MAP
+#   0001:00000010       _ZN7Profiler6RecordEPvj    0000000140001010 f   profiler.cc.obj
+# -----------------------------------------------------------------------------
+function Read-Symbols([string]$Path) {
+    $symbols = New-Object System.Collections.Generic.List[object]
+    foreach ($line in [System.IO.File]::ReadLines($Path)) {
+        if ($line -match '^\s*[0-9a-fA-F]{4}:[0-9a-fA-F]{8}\s+(\S+)\s+([0-9a-fA-F]{8,16})\b') {
+            $address = [Convert]::ToUInt64($Matches[2], 16)
+            if ($address -ne 0) {
+                $symbols.Add([pscustomobject]@{ Address = $address; Name = $Matches[1] })
+            }
+        }
+    }
+    return @($symbols | Sort-Object Address)
+}
+
+# Index of the largest symbol address at or below $address (binary search), -1 if none
+function Find-Symbol($symbols, [UInt64]$address) {
+    $low = 0
+    $high = $symbols.Count - 1
+    $found = -1
+    while ($low -le $high) {
+        $middle = [int][Math]::Floor(($low + $high) / 2)
+        if ($symbols[$middle].Address -le $address) {
+            $found = $middle
+            $low = $middle + 1
+        }
+        else {
+            $high = $middle - 1
+        }
+    }
+    return $found
+}
+
+function Resolve-Address($symbols, [UInt64]$address) {
+    $found = Find-Symbol $symbols $address
+    if ($found -lt 0) {
+        return ("0x{0:x}" -f $address)
+    }
+    $symbol = $symbols[$found]
+    if ($symbol.Address -eq $address) {
+        return $symbol.Name
+    }
+    # PROFILE_SCOPE records point into the function
+    return ("{0}+0x{1:x}" -f $symbol.Name, ($address - $symbol.Address))
+}
+
+# The enter hook is the anchor; i386 adds a leading underscore to C names
+function Find-Anchor($symbols, [string]$MapFile) {
+    $anchor = $symbols | Where-Object { $_.Name -eq "__cyg_profile_func_enter" -or $_.Name -eq "___cyg_profile_func_enter" } | Select-Object -First 1
+    if ($null -eq $anchor) {
+        Write-Error "__cyg_profile_func_enter not in $MapFile; was the blob built with -DPROFILE=ON?"
+        exit 1
+    }
+    return $anchor
+}
+
+# A directory holding profile-*.bin, or a single profile file
+function Get-ProfileFiles([string]$ProfilePath) {
+    if (Test-Path $ProfilePath -PathType Container) {
+        $files = @(Get-ChildItem -Path $ProfilePath -Filter "profile-*.bin" | Sort-Object Name)
+    }
+    else {
+        $files = @(Get-Item $ProfilePath)
+    }
+    if ($files.Count -eq 0) {
+        Write-Error "No profile-*.bin files in $ProfilePath"
+        exit 1
+    }
+    return $files
+}
@@ -0,0 +1,298 @@
+#include "checksum.h"
+#include "thread_context.h"
+#include "swar.h"
+
+// Bytes per stream in one interleaved step of the instruction path
+#define CRC32C_BLOCK 2048
+#define CRC32C_SHORT_BLOCK 256
+
+static FORCE_INLINE UINT32 Read32(const UINT8 *p)
+{
+    return *(const UNALIGNED_UINT32 *)p;
+}
+
+// One 64-bit load on 64-bit targets, two 32-bit loads elsewhere
+static FORCE_INLINE unsigned long long Read64(const UINT8 *p)
+{
+    return (unsigned long long)Read32(p) | ((unsigned long long)Read32(p + 4) << 32);
+}
+
+// CRC register multiplied by x: reflected, so x^0 is the top bit
+static constexpr UINT32 MultiplyByX(UINT32 value)
+{
+    return (value >> 1) ^ (CRC32C_POLYNOMIAL & (0 - (value & 1)));
+}
+
+// x^(8 * bytes) mod P: what a register is multiplied by when bytes more are appended
+static consteval UINT32 GetShiftConstant(USIZE bytes)
+{
+    UINT32 value = 0x80000000;
+    for (USIZE i = 0; i < bytes * 8; i++)
+        value = MultiplyByX(value);
+    return value;
+}
+
+// Carry-less product a * b mod P, one bit of a per step
+static FORCE_INLINE UINT32 MultiplyModP(UINT32 a, UINT32 b)
+{
+    UINT32 product = 0;
+    for (UINT32 bit = 0; bit < 32; bit++)
+    {
+        product ^= b & (0 - ((a >> (31 - bit)) & 1));
+        b = MultiplyByX(b);
+    }
+    return product;
+}
+
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386) || defined(ARCHITECTURE_AARCH64)
+
+#if defined(ARCHITECTURE_AARCH64)
+// The instructions are enabled inside the asm, so no function needs the crc target feature
+#define CRC32C_TARGET
+
+static FORCE_INLINE CRC32C_TARGET UINT32 StepByte(UINT32 crc, UINT8 value)
+{
+    __asm__(".arch_extension crc\n\tcrc32cb %w0, %w0, %w1" : "+r"(crc) : "r"((UINT32)value));
+    return crc;
+}
+
+static FORCE_INLINE CRC32C_TARGET UINT32 StepWord(UINT32 crc, USIZE value)
+{
+    __asm__(".arch_extension crc\n\tcrc32cx %w0, %w0, %x1" : "+r"(crc) : "r"(value));
+    return crc;
+}
+#else
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+
+static FORCE_INLINE CRC32C_TARGET UINT32 StepByte(UINT32 crc, UINT8 value)
+{
+    return __builtin_ia32_crc32qi(crc, value);
+}
+
+static FORCE_INLINE CRC32C_TARGET UINT32 StepWord(UINT32 crc, USIZE value)
+{
+#if defined(ARCHITECTURE_X86_64)
+    return (UINT32)__builtin_ia32_crc32di(crc, value);
+#else
+    return __builtin_ia32_crc32si(crc, value);
+#endif
+}
+#endif
+
+// Each instruction waits for the previous result, so three blocks are checksummed side by
+// side; the first two are then moved past the blocks that follow them and merged
+template <USIZE BlockSize>
+static FORCE_INLINE CRC32C_TARGET UINT32 StepBlocks(const UINT8 *&data, USIZE &size, UINT32 crc)
+{
+    while (size >= 3 * BlockSize)
+    {
+        UINT32 crc1 = 0;
+        UINT32 crc2 = 0;
+        for (USIZE i = 0; i < BlockSize; i += sizeof(USIZE))
+        {
+            crc = StepWord(crc, Swar::Load(data + i));
+            crc1 = StepWord(crc1, Swar::Load(data + BlockSize + i));
+            crc2 = StepWord(crc2, Swar::Load(data + 2 * BlockSize + i));
+        }
+        crc = MultiplyModP(crc, GetShiftConstant(2 * BlockSize)) ^ MultiplyModP(crc1, GetShiftConstant(BlockSize)) ^ crc2;
+        data += 3 * BlockSize;
+        size -= 3 * BlockSize;
+    }
+    return crc;
+}
+
+// CRC instruction over the whole buffer; crc is the raw register
+static CRC32C_TARGET UINT32 ComputeHardware(const UINT8 *data, USIZE size, UINT32 crc)
+{
+    // Long blocks while they fit, so the merge cost is spread thin, then short ones
+    crc = StepBlocks<CRC32C_BLOCK>(data, size, crc);
+    crc = StepBlocks<CRC32C_SHORT_BLOCK>(data, size, crc);
+
+    for (; size >= sizeof(USIZE); size -= sizeof(USIZE))
+    {
+        crc = StepWord(crc, Swar::Load(data));
+        data += sizeof(USIZE);
+    }
+    while (size-- > 0)
+        crc = StepByte(crc, *data++);
+    return crc;
+}
+
+#endif
+
+// Slicing-by-8: eight table lookups per 8 bytes instead of one per byte
+static UINT32 ComputeTable(const UINT32 *table, const UINT8 *data, USIZE size, UINT32 crc)
+{
+    for (; size >= 8; size -= 8)
+    {
+        UINT32 low = Read32(data) ^ crc;
+        UINT32 high = Read32(data + 4);
+        crc = table[7 * 256 + (low & 0xFF)] ^ table[6 * 256 + ((low >> 8) & 0xFF)] ^
+              table[5 * 256 + ((low >> 16) & 0xFF)] ^ table[4 * 256 + (low >> 24)] ^
+              table[3 * 256 + (high & 0xFF)] ^ table[2 * 256 + ((high >> 8) & 0xFF)] ^
+              table[1 * 256 + ((high >> 16) & 0xFF)] ^ table[high >> 24];
+        data += 8;
+    }
+    while (size-- > 0)
+        crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static UINT32 ComputeBitwise(const UINT8 *data, USIZE size, UINT32 crc)
+{
+    while (size-- > 0)
+    {
+        crc ^= *data++;
+        for (UINT32 bit = 0; bit < 8; bit++)
+            crc = MultiplyByX(crc);
+    }
+    return crc;
+}
+
+BOOL Crc32c::IsHardwareAvailable()
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    // Without a context a cpuid would run on every call
+    if (context == NULL)
+        return ReadPublishedHardware();
+    if (context->Crc32cHardware < 0)
+        context->Crc32cHardware = DetectHardware() ? 1 : 0;
+    return context->Crc32cHardware != 0;
+}
+
+const UINT32 *Crc32c::BuildTable(Arena &arena)
+{
+    UINT32 *table = (UINT32 *)arena.Allocate(CRC32C_TABLE_ENTRIES * sizeof(UINT32), sizeof(UINT32));
+    if (table == NULL)
+        return NULL;
+
+    // Slice 0 is the classic byte table; slice k advances a byte k more positions
+    for (UINT32 i = 0; i < 256; i++)
+    {
+        UINT32 crc = i;
+        for (UINT32 bit = 0; bit < 8; bit++)
+            crc = MultiplyByX(crc);
+        table[i] = crc;
+    }
+    for (UINT32 i = 256; i < CRC32C_TABLE_ENTRIES; i++)
+        table[i] = (table[i - 256] >> 8) ^ table[table[i - 256] & 0xFF];
+    return table;
+}
+
+UINT32 Crc32c::Compute(PCVOID data, USIZE size, UINT32 crc)
+{
+    return Compute(data, size, crc, IsHardwareAvailable());
+}
+
+UINT32 Crc32c::Compute(PCVOID data, USIZE size, UINT32 crc, BOOL hardware)
+{
+    const UINT8 *bytes = (const UINT8 *)data;
+    crc = ~crc;
+
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386) || defined(ARCHITECTURE_AARCH64)
+    if (hardware)
+        return ~ComputeHardware(bytes, size, crc);
+#else
+    (VOID)hardware;
+#endif
+
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL && context->Crc32cTable == NULL)
+    {
+        Arena *tables = ThreadContext::GetTables();
+        if (tables != NULL)
+            context->Crc32cTable = BuildTable(*tables);
+    }
+    if (context != NULL && context->Crc32cTable != NULL)
+        return ~ComputeTable(context->Crc32cTable, bytes, size, crc);
+
+    return ~ComputeBitwise(bytes, size, crc);
+}
+
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+static FORCE_INLINE unsigned long long RotateLeft(unsigned long long value, UINT32 count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+static FORCE_INLINE unsigned long long XxhRound(unsigned long long accumulator, unsigned long long input)
+{
+    accumulator += input * XXH_PRIME64_2;
+    return RotateLeft(accumulator, 31) * XXH_PRIME64_1;
+}
+
+static FORCE_INLINE unsigned long long XxhMerge(unsigned long long hash, unsigned long long accumulator)
+{
+    hash ^= XxhRound(0, accumulator);
+    return hash * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+UINT64 XxHash64::Compute(PCVOID data, USIZE size, UINT64 seed)
+{
+    const UINT8 *input = (const UINT8 *)data;
+    unsigned long long start = (unsigned long long)seed;
+    unsigned long long hash;
+
+    // Four independent lanes over 32-byte stripes
+    if (size >= 32)
+    {
+        unsigned long long v1 = start + XXH_PRIME64_1 + XXH_PRIME64_2;
+        unsigned long long v2 = start + XXH_PRIME64_2;
+        unsigned long long v3 = start;
+        unsigned long long v4 = start - XXH_PRIME64_1;
+        const UINT8 *limit = input + size - 32;
+        do
+        {
+            v1 = XxhRound(v1, Read64(input));
+            v2 = XxhRound(v2, Read64(input + 8));
+            v3 = XxhRound(v3, Read64(input + 16));
+            v4 = XxhRound(v4, Read64(input + 24));
+            input += 32;
+        } while (input <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = XxhMerge(hash, v1);
+        hash = XxhMerge(hash, v2);
+        hash = XxhMerge(hash, v3);
+        hash = XxhMerge(hash, v4);
+    }
+    else
+    {
+        hash = start + XXH_PRIME64_5;
+    }
+
+    hash += (unsigned long long)size;
+    size &= 31;
+
+    for (; size >= 8; size -= 8)
+    {
+        hash ^= XxhRound(0, Read64(input));
+        hash = RotateLeft(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        input += 8;
+    }
+    if (size >= 4)
+    {
+        hash ^= (unsigned long long)Read32(input) * XXH_PRIME64_1;
+        hash = RotateLeft(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        input += 4;
+        size -= 4;
+    }
+    while (size-- > 0)
+    {
+        hash ^= (unsigned long long)*input++ * XXH_PRIME64_5;
+        hash = RotateLeft(hash, 11) * XXH_PRIME64_1;
+    }
+
+    // Final avalanche so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return UINT64(hash);
+}
@@ -0,0 +1,303 @@
+#include "lz4.h"
+#include "thread_context.h"
+#include "swar.h"
+
+#define LZ4_WORD sizeof(USIZE)
+// Block end rules shared with the reference encoder
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MATCH_START_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+// Misses before the search step grows by one byte (2^6)
+#define LZ4_SKIP_TRIGGER 6
+
+static FORCE_INLINE UINT32 Read32(const UINT8 *p)
+{
+    return *(const UNALIGNED_UINT32 *)p;
+}
+
+// Copies whole words from source until target reaches targetEnd; writes up to LZ4_WORD - 1 bytes past it
+static FORCE_INLINE VOID CopyWords(UINT8 *target, const UINT8 *source, const UINT8 *targetEnd)
+{
+    while (target < targetEnd)
+    {
+        Swar::Store(target, Swar::Load(source));
+        target += LZ4_WORD;
+        source += LZ4_WORD;
+    }
+}
+
+// Adds 255-continued length bytes to length; FALSE if the input ends first
+static BOOL ReadLength(const UINT8 *&input, const UINT8 *inputEnd, USIZE &length)
+{
+    UINT8 value;
+    do
+    {
+        if (input >= inputEnd)
+            return FALSE;
+        value = *input++;
+        length += value;
+    } while (value == 255);
+    return TRUE;
+}
+
+// Bytes that follow the token for a length field of value length
+static FORCE_INLINE USIZE GetLengthBytes(USIZE length)
+{
+    return length >= 15 ? (length - 15) / 255 + 1 : 0;
+}
+
+static VOID WriteLength(UINT8 *&output, USIZE length)
+{
+    for (length -= 15; length >= 255; length -= 255)
+        *output++ = 255;
+    *output++ = (UINT8)length;
+}
+
+/**
+ * WriteSequence - Emit one sequence: literals, then a match unless offset is 0
+ *
+ * @return FALSE if the sequence does not fit before outputEnd
+ */
+static BOOL WriteSequence(UINT8 *&output, UINT8 *outputEnd, const UINT8 *literals, USIZE literalLength, USIZE offset, USIZE matchLength)
+{
+    USIZE matchCode = matchLength - LZ4_MIN_MATCH;
+    USIZE required = 1 + GetLengthBytes(literalLength) + literalLength;
+    if (offset != 0)
+        required += 2 + GetLengthBytes(matchCode);
+    if ((USIZE)(outputEnd - output) < required)
+        return FALSE;
+
+    UINT8 *token = output++;
+    *token = (UINT8)((literalLength < 15 ? literalLength : 15) << 4);
+    if (literalLength >= 15)
+        WriteLength(output, literalLength);
+    for (USIZE i = 0; i < literalLength; i++)
+        output[i] = literals[i];
+    output += literalLength;
+
+    if (offset == 0)
+        return TRUE;
+
+    *output++ = (UINT8)offset;
+    *output++ = (UINT8)(offset >> 8);
+    *token |= (UINT8)(matchCode < 15 ? matchCode : 15);
+    if (matchCode >= 15)
+        WriteLength(output, matchCode);
+    return TRUE;
+}
+
+// Length of the common prefix of input and match, stopping at inputLimit
+static FORCE_INLINE USIZE CountMatch(const UINT8 *input, const UINT8 *match, const UINT8 *inputLimit)
+{
+    const UINT8 *start = input;
+    while ((USIZE)(inputLimit - input) >= LZ4_WORD)
+    {
+        USIZE difference = Swar::Load(input) ^ Swar::Load(match);
+        if (difference != 0)
+            return (USIZE)(input - start) + Swar::CountTrailingZeros(difference) / 8;
+        input += LZ4_WORD;
+        match += LZ4_WORD;
+    }
+    while (input < inputLimit && *input == *match)
+    {
+        input++;
+        match++;
+    }
+    return (USIZE)(input - start);
+}
+
+// 64-bit targets hash 5 bytes, as the reference does; fewer false candidates on text
+static FORCE_INLINE UINT32 Hash(const UINT8 *p, UINT32 hashLog)
+{
+    if constexpr (sizeof(USIZE) == 8)
+        return (UINT32)(((Swar::Load(p) << 24) * 889523592379ULL) >> (64 - hashLog));
+    else
+        return (Read32(p) * 2654435761U) >> (32 - hashLog);
+}
+
+// Greedy encoder over a zeroed table of (1 << hashLog) input offsets
+static SSIZE CompressBlock(const UINT8 *source, USIZE sourceSize, UINT8 *target, USIZE targetCapacity, UINT32 *table, UINT32 hashLog)
+{
+    const UINT8 *input = source;
+    const UINT8 *inputEnd = source + sourceSize;
+    const UINT8 *anchor = source;
+    UINT8 *output = target;
+    UINT8 *outputEnd = target + targetCapacity;
+
+    // Shorter inputs are a single literal run
+    if (sourceSize > LZ4_MATCH_START_LIMIT)
+    {
+        const UINT8 *matchStartLimit = inputEnd - LZ4_MATCH_START_LIMIT;
+        const UINT8 *matchEndLimit = inputEnd - LZ4_LAST_LITERALS;
+        BOOL done = FALSE;
+
+        table[Hash(input, hashLog)] = 0;
+        input++;
+
+        while (!done)
+        {
+            // Probe one candidate per position, stepping faster the longer nothing matches
+            const UINT8 *match;
+            const UINT8 *next = input;
+            UINT32 attempts = 1 << LZ4_SKIP_TRIGGER;
+            do
+            {
+                input = next;
+                next += attempts++ >> LZ4_SKIP_TRIGGER;
+                if (next > matchStartLimit)
+                {
+                    done = TRUE;
+                    break;
+                }
+                UINT32 hash = Hash(input, hashLog);
+                match = source + table[hash];
+                table[hash] = (UINT32)(input - source);
+            } while ((USIZE)(input - match) > LZ4_MAX_OFFSET || Read32(match) != Read32(input));
+            if (done)
+                break;
+
+            // Extend backwards over literals that also match
+            while (input > anchor && match > source && input[-1] == match[-1])
+            {
+                input--;
+                match--;
+            }
+
+            for (;;)
+            {
+                USIZE matchLength = LZ4_MIN_MATCH + CountMatch(input + LZ4_MIN_MATCH, match + LZ4_MIN_MATCH, matchEndLimit);
+                if (!WriteSequence(output, outputEnd, anchor, (USIZE)(input - anchor), (USIZE)(input - match), matchLength))
+                    return -1;
+                input += matchLength;
+                anchor = input;
+
+                if (input > matchStartLimit)
+                {
+                    done = TRUE;
+                    break;
+                }
+
+                // Index a position inside the match, then try an immediate follow-up match
+                table[Hash(input - 2, hashLog)] = (UINT32)(input - 2 - source);
+                UINT32 hash = Hash(input, hashLog);
+                match = source + table[hash];
+                table[hash] = (UINT32)(input - source);
+                if ((USIZE)(input - match) > LZ4_MAX_OFFSET || Read32(match) != Read32(input))
+                {
+                    input++;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!WriteSequence(output, outputEnd, anchor, (USIZE)(inputEnd - anchor), 0, 0))
+        return -1;
+    return (SSIZE)(output - target);
+}
+
+SSIZE Lz4::Compress(PCVOID source, USIZE sourceSize, PVOID target, USIZE targetCapacity, Arena *arena)
+{
+    if (sourceSize > LZ4_MAX_INPUT_SIZE)
+        return -1;
+
+    if (arena == NULL)
+        arena = ThreadContext::GetScratch();
+
+    if (arena != NULL)
+    {
+        USIZE mark = arena->Mark();
+        UINT32 *table = (UINT32 *)arena->Allocate(LZ4_HASH_ENTRIES * sizeof(UINT32), sizeof(UINT32));
+        if (table != NULL)
+        {
+            for (USIZE i = 0; i < LZ4_HASH_ENTRIES; i++)
+                table[i] = 0;
+            SSIZE written = CompressBlock((const UINT8 *)source, sourceSize, (UINT8 *)target, targetCapacity, table, LZ4_HASH_LOG);
+            arena->Rewind(mark);
+            return written;
+        }
+    }
+
+    // 2KB keeps the frame below the stack probe threshold
+    UINT32 table[1 << LZ4_STACK_HASH_LOG];
+    for (USIZE i = 0; i < (1 << LZ4_STACK_HASH_LOG); i++)
+        table[i] = 0;
+    return CompressBlock((const UINT8 *)source, sourceSize, (UINT8 *)target, targetCapacity, table, LZ4_STACK_HASH_LOG);
+}
+
+SSIZE Lz4::Decompress(PCVOID source, USIZE sourceSize, PVOID target, USIZE targetCapacity)
+{
+    const UINT8 *input = (const UINT8 *)source;
+    const UINT8 *inputEnd = input + sourceSize;
+    UINT8 *output = (UINT8 *)target;
+    UINT8 *outputStart = output;
+    UINT8 *outputEnd = output + targetCapacity;
+
+    while (input < inputEnd)
+    {
+        UINT32 token = *input++;
+
+        USIZE literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(input, inputEnd, literalLength))
+            return -1;
+        if ((USIZE)(inputEnd - input) < literalLength || (USIZE)(outputEnd - output) < literalLength)
+            return -1;
+        // Word copies may run up to a word past the literals on both sides
+        if ((USIZE)(inputEnd - input) >= literalLength + LZ4_WORD && (USIZE)(outputEnd - output) >= literalLength + LZ4_WORD)
+        {
+            CopyWords(output, input, output + literalLength);
+        }
+        else
+        {
+            for (USIZE i = 0; i < literalLength; i++)
+                output[i] = input[i];
+        }
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence is literals only
+        if (input == inputEnd)
+            break;
+
+        if (inputEnd - input < 2)
+            return -1;
+        USIZE offset = (USIZE)input[0] | ((USIZE)input[1] << 8);
+        input += 2;
+        if (offset == 0 || offset > (USIZE)(output - outputStart))
+            return -1;
+
+        USIZE matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+            return -1;
+        matchLength += LZ4_MIN_MATCH;
+        if ((USIZE)(outputEnd - output) < matchLength)
+            return -1;
+
+        const UINT8 *match = output - offset;
+        UINT8 *matchEnd = output + matchLength;
+
+        // A match closer than a word repeats with period offset, so it also repeats with
+        // the first multiple of offset that is at least a word. Bytes up to that distance
+        // are copied one at a time; from there every word read is already written.
+        if (offset < LZ4_WORD)
+        {
+            USIZE distance = offset * ((LZ4_WORD + offset - 1) / offset);
+            for (USIZE i = distance - offset; i > 0 && output < matchEnd; i--)
+                *output++ = *match++;
+            match = output - distance;
+        }
+
+        // Whole words while a word still fits into the buffer, then the exact tail
+        while (output < matchEnd && (USIZE)(outputEnd - output) >= LZ4_WORD)
+        {
+            Swar::Store(output, Swar::Load(match));
+            output += LZ4_WORD;
+            match += LZ4_WORD;
+        }
+        while (output < matchEnd)
+            *output++ = *match++;
+        output = matchEnd;
+    }
+
+    return (SSIZE)(output - outputStart);
+}
@@ -3,25 +3,55 @@
 #include "console.h"
 #include "platform.h"
 #include "kernel32.h"
+#include "ntdll.h"
 #include "peb.h"
 
+// Wide units converted per NtWriteFile call when output is redirected
+#define CONSOLE_UTF8_CHUNK 128
+
+// Redirected output (a file or pipe) is not a console and WriteConsole fails on it, so the bytes are written as-is
+static BOOL WriteBytes(PVOID handle, const CHAR *bytes, USIZE length)
+{
+	IO_STATUS_BLOCK ioStatus;
+	NTSTATUS status = NTDLL::NtWriteFile(handle, NULL, NULL, NULL, &ioStatus, (PVOID)bytes, (UINT32)length, NULL, NULL);
+	return NT_SUCCESS(status) && ioStatus.Information == length;
+}
+
 UINT32 Console::Write(const CHAR *text, USIZE length)
 {
 	PPEB peb = GetCurrentPEB();
+	PVOID output = peb->ProcessParameters->StandardOutput;
 	UINT32 numberOfCharsWritten = 0;
-	// Call the WriteConsoleA function
-	Kernel32::WriteConsoleA(peb->ProcessParameters->StandardOutput, text, length, &numberOfCharsWritten, NULL);
-	return numberOfCharsWritten;
+	// Call the WriteConsoleA function; text is read in the console's code page
+	if (Kernel32::WriteConsoleA(output, text, length, &numberOfCharsWritten, NULL))
+		return numberOfCharsWritten;
+
+	return WriteBytes(output, text, length) ? (UINT32)length : 0;
 }
 
 UINT32 Console::Write(const WCHAR *text, USIZE length)
 {
 	PPEB peb = GetCurrentPEB();
+	PVOID output = peb->ProcessParameters->StandardOutput;
 	UINT32 numberOfCharsWritten = 0;
 	// Call the WriteConsoleW function
-	Kernel32::WriteConsoleW(peb->ProcessParameters->StandardOutput, text, length, &numberOfCharsWritten, NULL);
+	if (Kernel32::WriteConsoleW(output, text, length, &numberOfCharsWritten, NULL))
+		return numberOfCharsWritten;
 
-	return numberOfCharsWritten;
+	// Files and pipes get UTF-8, converted in chunks that never split a surrogate pair
+	CHAR utf8[CONSOLE_UTF8_CHUNK * 3];
+	USIZE done = 0;
+	while (done < length)
+	{
+		USIZE units = length - done < CONSOLE_UTF8_CHUNK ? length - done : CONSOLE_UTF8_CHUNK;
+		if (units == CONSOLE_UTF8_CHUNK && text[done + units - 1] >= 0xD800 && text[done + units - 1] <= 0xDBFF)
+			units--;
+		SSIZE bytes = String::WideToUtf8(text + done, units, utf8, sizeof(utf8));
+		if (bytes < 0 || !WriteBytes(output, utf8, (USIZE)bytes))
+			break;
+		done += units;
+	}
+	return (UINT32)done;
 }
 #else
 
@@ -0,0 +1,219 @@
+#include "coroutine.h"
+#include "memory.h"
+
+// Smallest class that fits size, or -1 for frames that bypass the pool
+static INT32 GetFrameClass(USIZE size)
+{
+    USIZE granules = (size + COROUTINE_FRAME_GRANULE - 1) / COROUTINE_FRAME_GRANULE;
+    if (granules == 0 || granules > COROUTINE_FRAME_CLASSES)
+        return -1;
+    return (INT32)(granules - 1);
+}
+
+FramePool::FramePool()
+{
+    Memory::Zero(freeLists, sizeof(freeLists));
+}
+
+FramePool::~FramePool()
+{
+    // Arena frames vanish with the arena; heap overflow frames are freed one by one
+    for (INT32 frameClass = 0; frameClass < COROUTINE_FRAME_CLASSES; frameClass++)
+    {
+        USIZE classSize = (USIZE)(frameClass + 1) * COROUTINE_FRAME_GRANULE;
+        PVOID frame = freeLists[frameClass];
+        while (frame != NULL)
+        {
+            PVOID next = *(PPVOID)frame;
+            if (!arena.Contains(frame))
+                Allocator::ReleaseMemory(frame, classSize);
+            frame = next;
+        }
+    }
+}
+
+PVOID FramePool::Allocate(USIZE size)
+{
+    INT32 frameClass = GetFrameClass(size);
+    if (frameClass < 0)
+        return Allocator::AllocateMemory(size);
+
+    PVOID frame = freeLists[frameClass];
+    if (frame != NULL)
+    {
+        freeLists[frameClass] = *(PPVOID)frame;
+        return frame;
+    }
+
+    USIZE classSize = (USIZE)(frameClass + 1) * COROUTINE_FRAME_GRANULE;
+    if (!arena.IsInitialized())
+        arena.InitializeHeap(COROUTINE_FRAME_ARENA_SIZE);
+    frame = arena.Allocate(classSize, 2 * sizeof(USIZE));
+    if (frame == NULL)
+        frame = Allocator::AllocateMemory(classSize);
+    return frame;
+}
+
+VOID FramePool::Release(PVOID frame, USIZE size)
+{
+    INT32 frameClass = GetFrameClass(size);
+    if (frameClass < 0)
+    {
+        Allocator::ReleaseMemory(frame, size);
+        return;
+    }
+
+    // Heap frames of a pooled size are class-sized too, so both kinds share the lists
+    *(PPVOID)frame = freeLists[frameClass];
+    freeLists[frameClass] = frame;
+}
+
+PVOID FramePool::AllocateFrame(USIZE size)
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL && context->Frames != NULL)
+        return context->Frames->Allocate(size);
+
+    // Round pooled sizes so the frame can later be released into a pool
+    INT32 frameClass = GetFrameClass(size);
+    if (frameClass >= 0)
+        size = (USIZE)(frameClass + 1) * COROUTINE_FRAME_GRANULE;
+    return Allocator::AllocateMemory(size);
+}
+
+VOID FramePool::ReleaseFrame(PVOID frame, USIZE size)
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL && context->Frames != NULL)
+    {
+        context->Frames->Release(frame, size);
+        return;
+    }
+
+    INT32 frameClass = GetFrameClass(size);
+    if (frameClass >= 0)
+        size = (USIZE)(frameClass + 1) * COROUTINE_FRAME_GRANULE;
+    Allocator::ReleaseMemory(frame, size);
+}
+
+std::coroutine_handle<> PromiseBase::Complete(PromiseBase &promise, std::coroutine_handle<> handle)
+{
+    if (promise.Continuation)
+        return promise.Continuation;
+
+    Executor *owner = promise.Owner;
+    if (promise.IsRoot)
+        owner->outstanding--;
+    // The coroutine is suspended at its final point, so its frame may go now
+    if (promise.IsDetached)
+        handle.destroy();
+    return owner->idle.handle;
+}
+
+Task<VOID> Executor::IdleLoop()
+{
+    for (;;)
+        co_await std::suspend_always();
+}
+
+Executor::Executor()
+    : previousFrames(NULL), ready(NULL), readyCapacity(0), readyHead(0), readyCount(0),
+      outstanding(0), pollRoutine(NULL), pollContext(NULL)
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL)
+    {
+        previousFrames = context->Frames;
+        context->Frames = &frames;
+    }
+    idle = IdleLoop();
+}
+
+Executor::~Executor()
+{
+    // The idle frame lives in the pool, so free it while the pool is installed
+    idle = Task<VOID>();
+
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL && context->Frames == &frames)
+        context->Frames = previousFrames;
+
+    if (ready != NULL)
+        Allocator::ReleaseMemory(ready, readyCapacity * sizeof(PVOID));
+}
+
+VOID Executor::Start(PromiseBase &promise, std::coroutine_handle<> handle, BOOL detached)
+{
+    promise.Owner = this;
+    promise.IsRoot = TRUE;
+    promise.IsDetached = detached;
+    outstanding++;
+    Schedule(handle);
+}
+
+VOID Executor::Schedule(std::coroutine_handle<> handle)
+{
+    if (readyCount == readyCapacity)
+    {
+        USIZE capacity = readyCapacity == 0 ? 64 : readyCapacity * 2;
+        PPVOID grown = (PPVOID)Allocator::AllocateMemory(capacity * sizeof(PVOID));
+        if (grown == NULL)
+        {
+            // Out of memory: run the coroutine now rather than lose it
+            handle.resume();
+            return;
+        }
+        for (USIZE i = 0; i < readyCount; i++)
+            grown[i] = ready[(readyHead + i) & (readyCapacity - 1)];
+        if (ready != NULL)
+            Allocator::ReleaseMemory(ready, readyCapacity * sizeof(PVOID));
+        ready = grown;
+        readyCapacity = capacity;
+        readyHead = 0;
+    }
+
+    ready[(readyHead + readyCount) & (readyCapacity - 1)] = handle.address();
+    readyCount++;
+}
+
+BOOL Executor::Run()
+{
+    for (;;)
+    {
+        while (readyCount > 0)
+        {
+            PVOID frame = ready[readyHead];
+            readyHead = (readyHead + 1) & (readyCapacity - 1);
+            readyCount--;
+            std::coroutine_handle<>::from_address(frame).resume();
+        }
+
+        if (outstanding == 0)
+            return TRUE;
+
+        if (pollRoutine == NULL || pollRoutine(pollContext, *this) == 0)
+        {
+            if (readyCount == 0)
+                return FALSE;
+        }
+    }
+}
+
+VOID AsyncEvent::Set()
+{
+    signaled = TRUE;
+
+    // Detach the list first: a resumed waiter may Reset and wait again
+    WAITER *waiter = head;
+    head = NULL;
+    tail = NULL;
+    while (waiter != NULL)
+    {
+        WAITER *next = waiter->Next;
+        if (waiter->Owner != NULL)
+            waiter->Owner->Schedule(waiter->Handle);
+        else
+            waiter->Handle.resume();
+        waiter = next;
+    }
+}
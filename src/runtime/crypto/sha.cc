@@ -0,0 +1,731 @@
+#include "sha.h"
+#include "thread_context.h"
+#include "memory.h"
+
+// Round constants, then (x86) the pshufb byte-swap mask and a 64-byte spill area for the asm
+#define SHA256_CONSTANT_WORDS (64 + 4 + 16)
+
+static FORCE_INLINE UINT32 RotateRight(UINT32 value, UINT32 count)
+{
+    return (value >> count) | (value << (32 - count));
+}
+
+static FORCE_INLINE UINT32 RotateLeft(UINT32 value, UINT32 count)
+{
+    return (value << count) | (value >> (32 - count));
+}
+
+static FORCE_INLINE UINT32 LoadBigEndian(const UINT8 *p)
+{
+    return ((UINT32)p[0] << 24) | ((UINT32)p[1] << 16) | ((UINT32)p[2] << 8) | p[3];
+}
+
+static FORCE_INLINE VOID StoreBigEndian(PUINT8 p, UINT32 value)
+{
+    p[0] = (UINT8)(value >> 24);
+    p[1] = (UINT8)(value >> 16);
+    p[2] = (UINT8)(value >> 8);
+    p[3] = (UINT8)value;
+}
+
+// Buffers a partial block and hands every complete block to process
+template <typename Process>
+static FORCE_INLINE VOID Absorb(PUINT8 block, USIZE &buffered, UINT64 &length, const UINT8 *data, USIZE size, Process process)
+{
+    length += UINT64((unsigned long long)size);
+
+    if (buffered > 0)
+    {
+        USIZE take = SHA_BLOCK_SIZE - buffered;
+        if (take > size)
+            take = size;
+        Memory::Copy(block + buffered, data, take);
+        buffered += take;
+        data += take;
+        size -= take;
+        if (buffered < SHA_BLOCK_SIZE)
+            return;
+        process(block, 1);
+        buffered = 0;
+    }
+
+    // Whole blocks straight from the caller's buffer
+    if (size >= SHA_BLOCK_SIZE)
+    {
+        process(data, size / SHA_BLOCK_SIZE);
+        data += size & ~(USIZE)(SHA_BLOCK_SIZE - 1);
+        size &= SHA_BLOCK_SIZE - 1;
+    }
+
+    Memory::Copy(block, data, size);
+    buffered = size;
+}
+
+// Appends 0x80, zeros and the message length in bits (big-endian) to fill the last block or two
+template <typename Process>
+static FORCE_INLINE VOID Pad(PUINT8 block, USIZE buffered, UINT64 length, Process process)
+{
+    block[buffered++] = 0x80;
+    if (buffered > SHA_BLOCK_SIZE - 8)
+    {
+        Memory::Zero(block + buffered, SHA_BLOCK_SIZE - buffered);
+        process(block, 1);
+        buffered = 0;
+    }
+    Memory::Zero(block + buffered, SHA_BLOCK_SIZE - 8 - buffered);
+
+    unsigned long long bits = (unsigned long long)length << 3;
+    StoreBigEndian(block + SHA_BLOCK_SIZE - 8, (UINT32)(bits >> 32));
+    StoreBigEndian(block + SHA_BLOCK_SIZE - 4, (UINT32)bits);
+    process(block, 1);
+}
+
+// One SHA-256 round; callers rotate the roles of a-h instead of moving the values
+static FORCE_INLINE VOID Round(UINT32 a, UINT32 b, UINT32 c, UINT32 &d, UINT32 e, UINT32 f, UINT32 g, UINT32 &h, UINT32 constant, UINT32 word)
+{
+    UINT32 t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + (g ^ (e & (f ^ g))) + constant + word;
+    UINT32 t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) | (c & (a | b)));
+    d += t1;
+    h = t1 + t2;
+}
+
+// Message word i (16 or later), computed in place in a 16-word window
+static FORCE_INLINE UINT32 Schedule(UINT32 *w, UINT32 i)
+{
+    UINT32 w15 = w[(i - 15) & 15];
+    UINT32 w2 = w[(i - 2) & 15];
+    w[i & 15] += (RotateRight(w15, 7) ^ RotateRight(w15, 18) ^ (w15 >> 3)) + w[(i - 7) & 15] +
+                 (RotateRight(w2, 17) ^ RotateRight(w2, 19) ^ (w2 >> 10));
+    return w[i & 15];
+}
+
+// Fully unrolled, so each round constant is an immediate
+static VOID CompressPortable(UINT32 *state, const UINT8 *data, USIZE count)
+{
+    for (; count > 0; count--, data += SHA_BLOCK_SIZE)
+    {
+        UINT32 w[16];
+        for (UINT32 i = 0; i < 16; i++)
+            w[i] = LoadBigEndian(data + i * 4);
+
+        UINT32 a = state[0], b = state[1], c = state[2], d = state[3];
+        UINT32 e = state[4], f = state[5], g = state[6], h = state[7];
+
+        Round(a, b, c, d, e, f, g, h, 0x428A2F98, w[0]);
+        Round(h, a, b, c, d, e, f, g, 0x71374491, w[1]);
+        Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w[2]);
+        Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w[3]);
+        Round(e, f, g, h, a, b, c, d, 0x3956C25B, w[4]);
+        Round(d, e, f, g, h, a, b, c, 0x59F111F1, w[5]);
+        Round(c, d, e, f, g, h, a, b, 0x923F82A4, w[6]);
+        Round(b, c, d, e, f, g, h, a, 0xAB1C5ED5, w[7]);
+        Round(a, b, c, d, e, f, g, h, 0xD807AA98, w[8]);
+        Round(h, a, b, c, d, e, f, g, 0x12835B01, w[9]);
+        Round(g, h, a, b, c, d, e, f, 0x243185BE, w[10]);
+        Round(f, g, h, a, b, c, d, e, 0x550C7DC3, w[11]);
+        Round(e, f, g, h, a, b, c, d, 0x72BE5D74, w[12]);
+        Round(d, e, f, g, h, a, b, c, 0x80DEB1FE, w[13]);
+        Round(c, d, e, f, g, h, a, b, 0x9BDC06A7, w[14]);
+        Round(b, c, d, e, f, g, h, a, 0xC19BF174, w[15]);
+        Round(a, b, c, d, e, f, g, h, 0xE49B69C1, Schedule(w, 16));
+        Round(h, a, b, c, d, e, f, g, 0xEFBE4786, Schedule(w, 17));
+        Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, Schedule(w, 18));
+        Round(f, g, h, a, b, c, d, e, 0x240CA1CC, Schedule(w, 19));
+        Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, Schedule(w, 20));
+        Round(d, e, f, g, h, a, b, c, 0x4A7484AA, Schedule(w, 21));
+        Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, Schedule(w, 22));
+        Round(b, c, d, e, f, g, h, a, 0x76F988DA, Schedule(w, 23));
+        Round(a, b, c, d, e, f, g, h, 0x983E5152, Schedule(w, 24));
+        Round(h, a, b, c, d, e, f, g, 0xA831C66D, Schedule(w, 25));
+        Round(g, h, a, b, c, d, e, f, 0xB00327C8, Schedule(w, 26));
+        Round(f, g, h, a, b, c, d, e, 0xBF597FC7, Schedule(w, 27));
+        Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, Schedule(w, 28));
+        Round(d, e, f, g, h, a, b, c, 0xD5A79147, Schedule(w, 29));
+        Round(c, d, e, f, g, h, a, b, 0x06CA6351, Schedule(w, 30));
+        Round(b, c, d, e, f, g, h, a, 0x14292967, Schedule(w, 31));
+        Round(a, b, c, d, e, f, g, h, 0x27B70A85, Schedule(w, 32));
+        Round(h, a, b, c, d, e, f, g, 0x2E1B2138, Schedule(w, 33));
+        Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, Schedule(w, 34));
+        Round(f, g, h, a, b, c, d, e, 0x53380D13, Schedule(w, 35));
+        Round(e, f, g, h, a, b, c, d, 0x650A7354, Schedule(w, 36));
+        Round(d, e, f, g, h, a, b, c, 0x766A0ABB, Schedule(w, 37));
+        Round(c, d, e, f, g, h, a, b, 0x81C2C92E, Schedule(w, 38));
+        Round(b, c, d, e, f, g, h, a, 0x92722C85, Schedule(w, 39));
+        Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, Schedule(w, 40));
+        Round(h, a, b, c, d, e, f, g, 0xA81A664B, Schedule(w, 41));
+        Round(g, h, a, b, c, d, e, f, 0xC24B8B70, Schedule(w, 42));
+        Round(f, g, h, a, b, c, d, e, 0xC76C51A3, Schedule(w, 43));
+        Round(e, f, g, h, a, b, c, d, 0xD192E819, Schedule(w, 44));
+        Round(d, e, f, g, h, a, b, c, 0xD6990624, Schedule(w, 45));
+        Round(c, d, e, f, g, h, a, b, 0xF40E3585, Schedule(w, 46));
+        Round(b, c, d, e, f, g, h, a, 0x106AA070, Schedule(w, 47));
+        Round(a, b, c, d, e, f, g, h, 0x19A4C116, Schedule(w, 48));
+        Round(h, a, b, c, d, e, f, g, 0x1E376C08, Schedule(w, 49));
+        Round(g, h, a, b, c, d, e, f, 0x2748774C, Schedule(w, 50));
+        Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, Schedule(w, 51));
+        Round(e, f, g, h, a, b, c, d, 0x391C0CB3, Schedule(w, 52));
+        Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, Schedule(w, 53));
+        Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, Schedule(w, 54));
+        Round(b, c, d, e, f, g, h, a, 0x682E6FF3, Schedule(w, 55));
+        Round(a, b, c, d, e, f, g, h, 0x748F82EE, Schedule(w, 56));
+        Round(h, a, b, c, d, e, f, g, 0x78A5636F, Schedule(w, 57));
+        Round(g, h, a, b, c, d, e, f, 0x84C87814, Schedule(w, 58));
+        Round(f, g, h, a, b, c, d, e, 0x8CC70208, Schedule(w, 59));
+        Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, Schedule(w, 60));
+        Round(d, e, f, g, h, a, b, c, 0xA4506CEB, Schedule(w, 61));
+        Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, Schedule(w, 62));
+        Round(b, c, d, e, f, g, h, a, 0xC67178F2, Schedule(w, 63));
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386) || defined(ARCHITECTURE_AARCH64)
+
+// The instructions read the constants from memory; stored one immediate at a time so the
+// optimizer cannot turn them back into a constant table
+static NOINLINE DISABLE_OPTIMIZATION VOID LoadRoundConstants(UINT32 *k)
+{
+    k[0] = 0x428A2F98;
+    k[1] = 0x71374491;
+    k[2] = 0xB5C0FBCF;
+    k[3] = 0xE9B5DBA5;
+    k[4] = 0x3956C25B;
+    k[5] = 0x59F111F1;
+    k[6] = 0x923F82A4;
+    k[7] = 0xAB1C5ED5;
+    k[8] = 0xD807AA98;
+    k[9] = 0x12835B01;
+    k[10] = 0x243185BE;
+    k[11] = 0x550C7DC3;
+    k[12] = 0x72BE5D74;
+    k[13] = 0x80DEB1FE;
+    k[14] = 0x9BDC06A7;
+    k[15] = 0xC19BF174;
+    k[16] = 0xE49B69C1;
+    k[17] = 0xEFBE4786;
+    k[18] = 0x0FC19DC6;
+    k[19] = 0x240CA1CC;
+    k[20] = 0x2DE92C6F;
+    k[21] = 0x4A7484AA;
+    k[22] = 0x5CB0A9DC;
+    k[23] = 0x76F988DA;
+    k[24] = 0x983E5152;
+    k[25] = 0xA831C66D;
+    k[26] = 0xB00327C8;
+    k[27] = 0xBF597FC7;
+    k[28] = 0xC6E00BF3;
+    k[29] = 0xD5A79147;
+    k[30] = 0x06CA6351;
+    k[31] = 0x14292967;
+    k[32] = 0x27B70A85;
+    k[33] = 0x2E1B2138;
+    k[34] = 0x4D2C6DFC;
+    k[35] = 0x53380D13;
+    k[36] = 0x650A7354;
+    k[37] = 0x766A0ABB;
+    k[38] = 0x81C2C92E;
+    k[39] = 0x92722C85;
+    k[40] = 0xA2BFE8A1;
+    k[41] = 0xA81A664B;
+    k[42] = 0xC24B8B70;
+    k[43] = 0xC76C51A3;
+    k[44] = 0xD192E819;
+    k[45] = 0xD6990624;
+    k[46] = 0xF40E3585;
+    k[47] = 0x106AA070;
+    k[48] = 0x19A4C116;
+    k[49] = 0x1E376C08;
+    k[50] = 0x2748774C;
+    k[51] = 0x34B0BCB5;
+    k[52] = 0x391C0CB3;
+    k[53] = 0x4ED8AA4A;
+    k[54] = 0x5B9CCA4F;
+    k[55] = 0x682E6FF3;
+    k[56] = 0x748F82EE;
+    k[57] = 0x78A5636F;
+    k[58] = 0x84C87814;
+    k[59] = 0x8CC70208;
+    k[60] = 0x90BEFFFA;
+    k[61] = 0xA4506CEB;
+    k[62] = 0xBEF9A3F7;
+    k[63] = 0xC67178F2;
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // pshufb mask reversing the bytes of each dword
+    k[64] = 0x00010203;
+    k[65] = 0x04050607;
+    k[66] = 0x08090A0B;
+    k[67] = 0x0C0D0E0F;
+#endif
+}
+
+// count > 0 blocks with the SHA instructions
+static VOID CompressHardware(UINT32 *state, const UINT8 *data, USIZE count)
+{
+    alignas(16) UINT32 k[SHA256_CONSTANT_WORDS];
+    LoadRoundConstants(k);
+
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // Intrinsics need SSE types, which -msoft-float rules out, so the registers are named here:
+    // xmm0 message + constants, xmm1 ABEF, xmm2 CDGH, xmm3-6 message schedule, xmm7 scratch.
+    // xmm6/xmm7 are callee-saved on x64 and parked in the spill area (k + 272) with the state
+    __asm__ __volatile__(
+        "movdqa %%xmm6, 272(%[k])\n\t"
+        "movdqa %%xmm7, 288(%[k])\n\t"
+        "movdqu (%[state]), %%xmm7\n\t"
+        "movdqu 16(%[state]), %%xmm2\n\t"
+        "pshufd $0xB1, %%xmm7, %%xmm7\n\t"
+        "pshufd $0x1B, %%xmm2, %%xmm2\n\t"
+        "movdqa %%xmm7, %%xmm1\n\t"
+        "palignr $8, %%xmm2, %%xmm1\n\t"
+        "pblendw $0xF0, %%xmm7, %%xmm2\n\t"
+        "1:\n\t"
+        "movdqa %%xmm1, 304(%[k])\n\t"
+        "movdqa %%xmm2, 320(%[k])\n\t"
+        "movdqu (%[data]), %%xmm3\n\t"
+        "pshufb 256(%[k]), %%xmm3\n\t"
+        "movdqa %%xmm3, %%xmm0\n\t"
+        "paddd (%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "movdqu 16(%[data]), %%xmm4\n\t"
+        "pshufb 256(%[k]), %%xmm4\n\t"
+        "movdqa %%xmm4, %%xmm0\n\t"
+        "paddd 16(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm4, %%xmm3\n\t"
+        "movdqu 32(%[data]), %%xmm5\n\t"
+        "pshufb 256(%[k]), %%xmm5\n\t"
+        "movdqa %%xmm5, %%xmm0\n\t"
+        "paddd 32(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm5, %%xmm4\n\t"
+        "movdqu 48(%[data]), %%xmm6\n\t"
+        "pshufb 256(%[k]), %%xmm6\n\t"
+        "movdqa %%xmm6, %%xmm0\n\t"
+        "paddd 48(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm6, %%xmm7\n\t"
+        "palignr $4, %%xmm5, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm3\n\t"
+        "sha256msg2 %%xmm6, %%xmm3\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm6, %%xmm5\n\t"
+        "movdqa %%xmm3, %%xmm0\n\t"
+        "paddd 64(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm3, %%xmm7\n\t"
+        "palignr $4, %%xmm6, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm4\n\t"
+        "sha256msg2 %%xmm3, %%xmm4\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm3, %%xmm6\n\t"
+        "movdqa %%xmm4, %%xmm0\n\t"
+        "paddd 80(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm4, %%xmm7\n\t"
+        "palignr $4, %%xmm3, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm5\n\t"
+        "sha256msg2 %%xmm4, %%xmm5\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm4, %%xmm3\n\t"
+        "movdqa %%xmm5, %%xmm0\n\t"
+        "paddd 96(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm5, %%xmm7\n\t"
+        "palignr $4, %%xmm4, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm6\n\t"
+        "sha256msg2 %%xmm5, %%xmm6\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm5, %%xmm4\n\t"
+        "movdqa %%xmm6, %%xmm0\n\t"
+        "paddd 112(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm6, %%xmm7\n\t"
+        "palignr $4, %%xmm5, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm3\n\t"
+        "sha256msg2 %%xmm6, %%xmm3\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm6, %%xmm5\n\t"
+        "movdqa %%xmm3, %%xmm0\n\t"
+        "paddd 128(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm3, %%xmm7\n\t"
+        "palignr $4, %%xmm6, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm4\n\t"
+        "sha256msg2 %%xmm3, %%xmm4\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm3, %%xmm6\n\t"
+        "movdqa %%xmm4, %%xmm0\n\t"
+        "paddd 144(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm4, %%xmm7\n\t"
+        "palignr $4, %%xmm3, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm5\n\t"
+        "sha256msg2 %%xmm4, %%xmm5\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm4, %%xmm3\n\t"
+        "movdqa %%xmm5, %%xmm0\n\t"
+        "paddd 160(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm5, %%xmm7\n\t"
+        "palignr $4, %%xmm4, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm6\n\t"
+        "sha256msg2 %%xmm5, %%xmm6\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm5, %%xmm4\n\t"
+        "movdqa %%xmm6, %%xmm0\n\t"
+        "paddd 176(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm6, %%xmm7\n\t"
+        "palignr $4, %%xmm5, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm3\n\t"
+        "sha256msg2 %%xmm6, %%xmm3\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm6, %%xmm5\n\t"
+        "movdqa %%xmm3, %%xmm0\n\t"
+        "paddd 192(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm3, %%xmm7\n\t"
+        "palignr $4, %%xmm6, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm4\n\t"
+        "sha256msg2 %%xmm3, %%xmm4\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "sha256msg1 %%xmm3, %%xmm6\n\t"
+        "movdqa %%xmm4, %%xmm0\n\t"
+        "paddd 208(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm4, %%xmm7\n\t"
+        "palignr $4, %%xmm3, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm5\n\t"
+        "sha256msg2 %%xmm4, %%xmm5\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "movdqa %%xmm5, %%xmm0\n\t"
+        "paddd 224(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "movdqa %%xmm5, %%xmm7\n\t"
+        "palignr $4, %%xmm4, %%xmm7\n\t"
+        "paddd %%xmm7, %%xmm6\n\t"
+        "sha256msg2 %%xmm5, %%xmm6\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "movdqa %%xmm6, %%xmm0\n\t"
+        "paddd 240(%[k]), %%xmm0\n\t"
+        "sha256rnds2 %%xmm1, %%xmm2\n\t"
+        "pshufd $0x0E, %%xmm0, %%xmm0\n\t"
+        "sha256rnds2 %%xmm2, %%xmm1\n\t"
+        "paddd 304(%[k]), %%xmm1\n\t"
+        "paddd 320(%[k]), %%xmm2\n\t"
+        "add $64, %[data]\n\t"
+        "sub $1, %[blocks]\n\t"
+        "jnz 1b\n\t"
+        "pshufd $0x1B, %%xmm1, %%xmm7\n\t"
+        "pshufd $0xB1, %%xmm2, %%xmm2\n\t"
+        "movdqa %%xmm7, %%xmm1\n\t"
+        "pblendw $0xF0, %%xmm2, %%xmm1\n\t"
+        "palignr $8, %%xmm7, %%xmm2\n\t"
+        "movdqu %%xmm1, (%[state])\n\t"
+        "movdqu %%xmm2, 16(%[state])\n\t"
+        "movdqa 272(%[k]), %%xmm6\n\t"
+        "movdqa 288(%[k]), %%xmm7\n\t"
+        : [data] "+r"(data), [blocks] "+r"(count)
+        : [state] "r"(state), [k] "r"(k)
+        : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "cc", "memory");
+#else
+    // v0 ABCD, v1 EFGH, v2/v3 state at block start, v4-v7 message schedule, v16/v17 message +
+    // constants, v18 ABCD before sha256h, v19 constants; v8-v15 are callee-saved and left alone
+    __asm__ __volatile__(
+        ".arch_extension sha2\n\t"
+        "ld1 {v0.4s, v1.4s}, [%[state]]\n\t"
+        "1:\n\t"
+        "mov v2.16b, v0.16b\n\t"
+        "mov v3.16b, v1.16b\n\t"
+        "ld1 {v4.16b, v5.16b, v6.16b, v7.16b}, [%[data]], #64\n\t"
+        "rev32 v4.16b, v4.16b\n\t"
+        "rev32 v5.16b, v5.16b\n\t"
+        "rev32 v6.16b, v6.16b\n\t"
+        "rev32 v7.16b, v7.16b\n\t"
+        "ldr q19, [%[k]]\n\t"
+        "add v16.4s, v4.4s, v19.4s\n\t"
+        "sha256su0 v4.4s, v5.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #16]\n\t"
+        "add v17.4s, v5.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v4.4s, v6.4s, v7.4s\n\t"
+        "sha256su0 v5.4s, v6.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #32]\n\t"
+        "add v16.4s, v6.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v5.4s, v7.4s, v4.4s\n\t"
+        "sha256su0 v6.4s, v7.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #48]\n\t"
+        "add v17.4s, v7.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v6.4s, v4.4s, v5.4s\n\t"
+        "sha256su0 v7.4s, v4.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #64]\n\t"
+        "add v16.4s, v4.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v7.4s, v5.4s, v6.4s\n\t"
+        "sha256su0 v4.4s, v5.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #80]\n\t"
+        "add v17.4s, v5.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v4.4s, v6.4s, v7.4s\n\t"
+        "sha256su0 v5.4s, v6.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #96]\n\t"
+        "add v16.4s, v6.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v5.4s, v7.4s, v4.4s\n\t"
+        "sha256su0 v6.4s, v7.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #112]\n\t"
+        "add v17.4s, v7.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v6.4s, v4.4s, v5.4s\n\t"
+        "sha256su0 v7.4s, v4.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #128]\n\t"
+        "add v16.4s, v4.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v7.4s, v5.4s, v6.4s\n\t"
+        "sha256su0 v4.4s, v5.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #144]\n\t"
+        "add v17.4s, v5.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v4.4s, v6.4s, v7.4s\n\t"
+        "sha256su0 v5.4s, v6.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #160]\n\t"
+        "add v16.4s, v6.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v5.4s, v7.4s, v4.4s\n\t"
+        "sha256su0 v6.4s, v7.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #176]\n\t"
+        "add v17.4s, v7.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "sha256su1 v6.4s, v4.4s, v5.4s\n\t"
+        "sha256su0 v7.4s, v4.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #192]\n\t"
+        "add v16.4s, v4.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "sha256su1 v7.4s, v5.4s, v6.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #208]\n\t"
+        "add v17.4s, v5.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #224]\n\t"
+        "add v16.4s, v6.4s, v19.4s\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "ldr q19, [%[k], #240]\n\t"
+        "add v17.4s, v7.4s, v19.4s\n\t"
+        "sha256h q0, q1, v16.4s\n\t"
+        "sha256h2 q1, q18, v16.4s\n\t"
+        "mov v18.16b, v0.16b\n\t"
+        "sha256h q0, q1, v17.4s\n\t"
+        "sha256h2 q1, q18, v17.4s\n\t"
+        "add v0.4s, v0.4s, v2.4s\n\t"
+        "add v1.4s, v1.4s, v3.4s\n\t"
+        "subs %[blocks], %[blocks], #1\n\t"
+        "b.ne 1b\n\t"
+        "st1 {v0.4s, v1.4s}, [%[state]]\n\t"
+        : [data] "+r"(data), [blocks] "+r"(count)
+        : [state] "r"(state), [k] "r"(k)
+        : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16", "v17", "v18", "v19", "cc", "memory");
+#endif
+}
+
+#endif
+
+BOOL Sha256::IsHardwareAvailable()
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context == NULL)
+        return DetectHardware();
+    if (context->Sha256Hardware < 0)
+        context->Sha256Hardware = DetectHardware() ? 1 : 0;
+    return context->Sha256Hardware != 0;
+}
+
+VOID Sha256::Init()
+{
+    // Without a context every Init would run cpuid
+    Init(ThreadContext::Get() != NULL ? IsHardwareAvailable() : ReadPublishedHardware());
+}
+
+VOID Sha256::Init(BOOL useHardware)
+{
+    state[0] = 0x6A09E667;
+    state[1] = 0xBB67AE85;
+    state[2] = 0x3C6EF372;
+    state[3] = 0xA54FF53A;
+    state[4] = 0x510E527F;
+    state[5] = 0x9B05688C;
+    state[6] = 0x1F83D9AB;
+    state[7] = 0x5BE0CD19;
+    length = UINT64();
+    buffered = 0;
+    hardware = useHardware;
+}
+
+VOID Sha256::ProcessBlocks(const UINT8 *data, USIZE count)
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386) || defined(ARCHITECTURE_AARCH64)
+    if (hardware)
+    {
+        CompressHardware(state, data, count);
+        return;
+    }
+#endif
+    CompressPortable(state, data, count);
+}
+
+VOID Sha256::Update(PCVOID data, USIZE size)
+{
+    Absorb(block, buffered, length, (const UINT8 *)data, size, [this](const UINT8 *blocks, USIZE count)
+           { ProcessBlocks(blocks, count); });
+}
+
+VOID Sha256::Final(PUINT8 digest)
+{
+    Pad(block, buffered, length, [this](const UINT8 *blocks, USIZE count)
+        { ProcessBlocks(blocks, count); });
+    for (UINT32 i = 0; i < 8; i++)
+        StoreBigEndian(digest + i * 4, state[i]);
+}
+
+VOID Sha256::Compute(PCVOID data, USIZE size, PUINT8 digest)
+{
+    Sha256 sha;
+    sha.Update(data, size);
+    sha.Final(digest);
+}
+
+VOID Sha256::Compute(PCVOID data, USIZE size, PUINT8 digest, BOOL useHardware)
+{
+    Sha256 sha(useHardware);
+    sha.Update(data, size);
+    sha.Final(digest);
+}
+
+VOID Sha1::Init()
+{
+    state[0] = 0x67452301;
+    state[1] = 0xEFCDAB89;
+    state[2] = 0x98BADCFE;
+    state[3] = 0x10325476;
+    state[4] = 0xC3D2E1F0;
+    length = UINT64();
+    buffered = 0;
+}
+
+VOID Sha1::ProcessBlocks(const UINT8 *data, USIZE count)
+{
+    for (; count > 0; count--, data += SHA_BLOCK_SIZE)
+    {
+        UINT32 w[16];
+        for (UINT32 i = 0; i < 16; i++)
+            w[i] = LoadBigEndian(data + i * 4);
+
+        UINT32 a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        // Four groups of 20 rounds, each with its own function and immediate constant
+        for (UINT32 i = 0; i < 80; i++)
+        {
+            if (i >= 16)
+                w[i & 15] = RotateLeft(w[(i - 3) & 15] ^ w[(i - 8) & 15] ^ w[(i - 14) & 15] ^ w[i & 15], 1);
+
+            UINT32 t;
+            if (i < 20)
+                t = (d ^ (b & (c ^ d))) + 0x5A827999;
+            else if (i < 40)
+                t = (b ^ c ^ d) + 0x6ED9EBA1;
+            else if (i < 60)
+                t = ((b & c) | (d & (b | c))) + 0x8F1BBCDC;
+            else
+                t = (b ^ c ^ d) + 0xCA62C1D6;
+
+            t += RotateLeft(a, 5) + e + w[i & 15];
+            e = d;
+            d = c;
+            c = RotateLeft(b, 30);
+            b = a;
+            a = t;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+VOID Sha1::Update(PCVOID data, USIZE size)
+{
+    Absorb(block, buffered, length, (const UINT8 *)data, size, [this](const UINT8 *blocks, USIZE count)
+           { ProcessBlocks(blocks, count); });
+}
+
+VOID Sha1::Final(PUINT8 digest)
+{
+    Pad(block, buffered, length, [this](const UINT8 *blocks, USIZE count)
+        { ProcessBlocks(blocks, count); });
+    for (UINT32 i = 0; i < 5; i++)
+        StoreBigEndian(digest + i * 4, state[i]);
+}
+
+VOID Sha1::Compute(PCVOID data, USIZE size, PUINT8 digest)
+{
+    Sha1 sha;
+    sha.Update(data, size);
+    sha.Final(digest);
+}
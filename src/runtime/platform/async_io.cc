@@ -0,0 +1,199 @@
+#include "async_io.h"
+
+// Granularity of the registered buffer region
+#define REGISTERED_BUFFER_ALIGNMENT 4096
+
+AsyncIo::AsyncIo()
+    : port(NULL), flushQueue(NULL), submissionCount(0), inFlight(0), immediateHead(NULL), immediateTail(NULL),
+      registeredBase(NULL), registeredRegionSize(0), registeredBufferSize(0), registeredCount(0)
+{
+}
+
+AsyncIo::~AsyncIo()
+{
+    Destroy();
+}
+
+BOOL AsyncIo::Create()
+{
+    if (port != NULL)
+        return TRUE;
+    return CreatePort();
+}
+
+VOID AsyncIo::Destroy()
+{
+    UnregisterBuffers();
+    if (port != NULL)
+        ClosePort();
+    port = NULL;
+    submissionCount = 0;
+    inFlight = 0;
+    immediateHead = NULL;
+    immediateTail = NULL;
+}
+
+static VOID PrepareRequest(ASYNC_REQUEST &request, AsyncOperation operation, PVOID file, PVOID buffer, UINT32 length, UINT64 offset, PVOID userData)
+{
+    request.IoStatus[0] = 0;
+    request.IoStatus[1] = 0;
+    request.File = file;
+    request.Buffer = buffer;
+    request.Length = length;
+    request.Operation = operation;
+    request.Offset = offset;
+    request.UserData = userData;
+    request.Status = 0;
+    request.BytesTransferred = 0;
+    request.Next = NULL;
+}
+
+VOID AsyncIo::PrepareRead(ASYNC_REQUEST &request, PVOID file, PVOID buffer, UINT32 length, UINT64 offset, PVOID userData)
+{
+    PrepareRequest(request, AsyncOperation::Read, file, buffer, length, offset, userData);
+}
+
+VOID AsyncIo::PrepareWrite(ASYNC_REQUEST &request, PVOID file, PCVOID buffer, UINT32 length, UINT64 offset, PVOID userData)
+{
+    PrepareRequest(request, AsyncOperation::Write, file, (PVOID)buffer, length, offset, userData);
+}
+
+VOID AsyncIo::PrepareFlush(ASYNC_REQUEST &request, PVOID file, PVOID userData)
+{
+    PrepareRequest(request, AsyncOperation::Flush, file, NULL, 0, UINT64(), userData);
+}
+
+BOOL AsyncIo::Queue(PASYNC_REQUEST request)
+{
+    if (submissionCount == ASYNC_IO_QUEUE_DEPTH)
+        return FALSE;
+    submissions[submissionCount++] = request;
+    return TRUE;
+}
+
+VOID AsyncIo::CompleteImmediately(PASYNC_REQUEST request)
+{
+    request->Next = NULL;
+    if (immediateTail != NULL)
+        immediateTail->Next = request;
+    else
+        immediateHead = request;
+    immediateTail = request;
+}
+
+USIZE AsyncIo::Submit()
+{
+    USIZE count = submissionCount;
+    submissionCount = 0;
+
+    for (USIZE i = 0; i < count; i++)
+    {
+        PASYNC_REQUEST request = submissions[i];
+        if (port != NULL && Issue(request))
+        {
+            inFlight++;
+            continue;
+        }
+        if (port == NULL)
+        {
+            request->Status = -1;
+            request->BytesTransferred = 0;
+        }
+        CompleteImmediately(request);
+    }
+
+    return count;
+}
+
+USIZE AsyncIo::Poll(PASYNC_REQUEST *completed, USIZE maxCount, BOOL wait)
+{
+    USIZE count = 0;
+    while (immediateHead != NULL && count < maxCount)
+    {
+        completed[count++] = immediateHead;
+        immediateHead = immediateHead->Next;
+    }
+    if (immediateHead == NULL)
+        immediateTail = NULL;
+
+    // Only block when there is nothing to hand back yet
+    if (count < maxCount && inFlight > 0)
+    {
+        USIZE reaped = Reap(completed + count, maxCount - count, wait && count == 0);
+        inFlight -= reaped;
+        count += reaped;
+    }
+
+    return count;
+}
+
+BOOL AsyncIo::RegisterBuffers(USIZE count, USIZE size)
+{
+    UnregisterBuffers();
+    if (count == 0 || size == 0)
+        return FALSE;
+
+    USIZE stride = (size + REGISTERED_BUFFER_ALIGNMENT - 1) & ~(USIZE)(REGISTERED_BUFFER_ALIGNMENT - 1);
+    USIZE regionSize = stride * count;
+    PVOID region = AllocateRegion(regionSize);
+    if (region == NULL)
+        return FALSE;
+
+    registeredBase = (PUINT8)region;
+    registeredRegionSize = regionSize;
+    registeredBufferSize = stride;
+    registeredCount = count;
+    return TRUE;
+}
+
+VOID AsyncIo::UnregisterBuffers()
+{
+    if (registeredBase != NULL)
+        ReleaseRegion(registeredBase, registeredRegionSize);
+    registeredBase = NULL;
+    registeredRegionSize = 0;
+    registeredBufferSize = 0;
+    registeredCount = 0;
+}
+
+PVOID AsyncIo::GetRegisteredBuffer(USIZE index) const
+{
+    if (index >= registeredCount)
+        return NULL;
+    return registeredBase + index * registeredBufferSize;
+}
+
+AsyncIo::Awaiter AsyncIo::Read(PVOID file, PVOID buffer, UINT32 length, UINT64 offset)
+{
+    Awaiter awaiter{*this, {}};
+    PrepareRead(awaiter.Request, file, buffer, length, offset, NULL);
+    return awaiter;
+}
+
+AsyncIo::Awaiter AsyncIo::Write(PVOID file, PCVOID buffer, UINT32 length, UINT64 offset)
+{
+    Awaiter awaiter{*this, {}};
+    PrepareWrite(awaiter.Request, file, buffer, length, offset, NULL);
+    return awaiter;
+}
+
+AsyncIo::Awaiter AsyncIo::Flush(PVOID file)
+{
+    Awaiter awaiter{*this, {}};
+    PrepareFlush(awaiter.Request, file, NULL);
+    return awaiter;
+}
+
+USIZE AsyncIo::PollExecutor(PVOID context, Executor &executor)
+{
+    AsyncIo *io = (AsyncIo *)context;
+
+    // Everything queued since the last poll goes to the kernel in one batch
+    io->Submit();
+
+    PASYNC_REQUEST completed[ASYNC_IO_REAP_BATCH];
+    USIZE count = io->Poll(completed, ASYNC_IO_REAP_BATCH, TRUE);
+    for (USIZE i = 0; i < count; i++)
+        executor.Schedule(std::coroutine_handle<>::from_address(completed[i]->UserData));
+    return count;
+}
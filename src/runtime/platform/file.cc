@@ -0,0 +1,208 @@
+#include "file.h"
+#include "allocator.h"
+#include "memory.h"
+
+BOOL File::Open(const WCHAR *path, UINT32 mode)
+{
+    Close();
+    handle = OpenHandle(path, mode, FALSE);
+    if (handle == NULL)
+        return FALSE;
+    if ((mode & FILE_MODE_APPEND) && !SeekToEnd())
+    {
+        Close();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+VOID File::Close()
+{
+    if (handle != NULL)
+        CloseHandle(handle);
+    handle = NULL;
+}
+
+BufferedReader::BufferedReader(File &source, USIZE bufferSize)
+    : file(source), capacity(bufferSize), start(0), end(0), endOfFile(FALSE)
+{
+    buffer = (PUINT8)Allocator::AllocateMemory(capacity);
+}
+
+BufferedReader::~BufferedReader()
+{
+    if (buffer != NULL)
+        Allocator::ReleaseMemory(buffer, capacity);
+}
+
+BOOL BufferedReader::Refill()
+{
+    if (endOfFile || buffer == NULL)
+        return FALSE;
+
+    // Slide the partial record to the front; ranges may overlap, so copy forward by hand
+    if (start > 0)
+    {
+        USIZE remaining = end - start;
+        for (USIZE i = 0; i < remaining; i++)
+            buffer[i] = buffer[start + i];
+        start = 0;
+        end = remaining;
+    }
+    if (end == capacity)
+        return FALSE;
+
+    SSIZE count = file.Read(buffer + end, capacity - end);
+    if (count <= 0)
+    {
+        endOfFile = TRUE;
+        return FALSE;
+    }
+    end += (USIZE)count;
+    return TRUE;
+}
+
+SSIZE BufferedReader::Read(PVOID destination, USIZE size)
+{
+    PUINT8 out = (PUINT8)destination;
+    USIZE total = 0;
+
+    USIZE buffered = end - start;
+    if (buffered > 0)
+    {
+        USIZE count = buffered < size ? buffered : size;
+        Memory::Copy(out, buffer + start, count);
+        start += count;
+        total = count;
+    }
+
+    while (total < size && !endOfFile)
+    {
+        USIZE wanted = size - total;
+        if (buffer == NULL || wanted >= capacity)
+        {
+            // Large request: read straight into the caller's memory
+            SSIZE count = file.Read(out + total, wanted);
+            if (count < 0)
+                return total > 0 ? (SSIZE)total : -1;
+            if (count == 0)
+                endOfFile = TRUE;
+            total += (USIZE)count;
+            continue;
+        }
+
+        start = 0;
+        end = 0;
+        if (!Refill())
+            break;
+        USIZE count = end < wanted ? end : wanted;
+        Memory::Copy(out + total, buffer, count);
+        start = count;
+        total += count;
+    }
+
+    return (SSIZE)total;
+}
+
+BOOL BufferedReader::ReadRecord(UINT8 delimiter, PCCHAR &record, USIZE &length)
+{
+    USIZE scanned = start;
+    for (;;)
+    {
+        for (USIZE i = scanned; i < end; i++)
+        {
+            if (buffer[i] == delimiter)
+            {
+                record = (PCCHAR)(buffer + start);
+                length = i - start;
+                start = i + 1;
+                return TRUE;
+            }
+        }
+
+        // No delimiter yet: keep what was scanned and fetch more
+        USIZE offset = end - start;
+        if (!Refill())
+            break;
+        scanned = start + offset;
+    }
+
+    // Final record without a delimiter, or a piece of an oversized one
+    if (end == start)
+        return FALSE;
+    record = (PCCHAR)(buffer + start);
+    length = end - start;
+    start = end;
+    return TRUE;
+}
+
+BOOL BufferedReader::ReadLine(PCCHAR &line, USIZE &length)
+{
+    if (!ReadRecord('\n', line, length))
+        return FALSE;
+    if (length > 0 && line[length - 1] == '\r')
+        length--;
+    return TRUE;
+}
+
+BufferedWriter::BufferedWriter(File &target, USIZE bufferSize)
+    : file(target), capacity(bufferSize), used(0), failed(FALSE)
+{
+    buffer = (PUINT8)Allocator::AllocateMemory(capacity);
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    Flush();
+    if (buffer != NULL)
+        Allocator::ReleaseMemory(buffer, capacity);
+}
+
+// Write the whole range, retrying short writes
+static BOOL WriteAll(File &file, const UINT8 *data, USIZE size)
+{
+    while (size > 0)
+    {
+        SSIZE written = file.Write(data, size);
+        if (written <= 0)
+            return FALSE;
+        data += written;
+        size -= (USIZE)written;
+    }
+    return TRUE;
+}
+
+BOOL BufferedWriter::Write(PCVOID data, USIZE size)
+{
+    const UINT8 *bytes = (const UINT8 *)data;
+
+    if (buffer == NULL || size >= capacity)
+    {
+        if (!Flush() || !WriteAll(file, bytes, size))
+            failed = TRUE;
+        return !failed;
+    }
+
+    if (used + size > capacity && !Flush())
+        return FALSE;
+    Memory::Copy(buffer + used, bytes, size);
+    used += size;
+    return !failed;
+}
+
+BOOL BufferedWriter::WriteLine(PCCHAR line, USIZE length)
+{
+    UINT8 newline = '\n';
+    return Write(line, length) && Write(&newline, 1);
+}
+
+BOOL BufferedWriter::Flush()
+{
+    if (used > 0)
+    {
+        if (!WriteAll(file, buffer, used))
+            failed = TRUE;
+        used = 0;
+    }
+    return !failed;
+}
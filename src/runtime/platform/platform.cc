@@ -1,7 +1,7 @@
 #include "platform.h"
 #include "primitives.h"
 
-PVOID GetInstructionAddress(VOID)
+NOINLINE PVOID GetInstructionAddress(VOID)
 {
     return __builtin_return_address(0);
 }
@@ -0,0 +1,150 @@
+#include "profiler.h"
+
+#if defined(PROFILE)
+
+#include "platform.h"
+#include "thread_context.h"
+#include "allocator.h"
+#include "timer.h"
+#include "file.h"
+
+static_assert(sizeof(PROFILE_CHUNK_HEADER) == 32 && sizeof(PROFILE_RECORD) == 16, "Profile records are read by a host tool");
+
+extern "C" NO_INSTRUMENT VOID __cyg_profile_func_enter(PVOID function, PVOID callSite);
+
+// Runtime address of the anchor; on i386 function addresses are link-time until relocated
+NO_INSTRUMENT static USIZE GetAnchor()
+{
+    return (USIZE)PerformRelocation((PVOID)__cyg_profile_func_enter);
+}
+
+// "profile-" + 16 hex digits + ".bin"
+NO_INSTRUMENT static VOID FormatFileName(WCHAR (&name)[30], UINT64 id)
+{
+    auto prefix = L"profile-"_embed;
+    auto suffix = L".bin"_embed;
+    USIZE length = 0;
+    for (const WCHAR *p = (const WCHAR *)prefix; *p != 0; p++)
+        name[length++] = *p;
+    for (INT32 shift = 60; shift >= 0; shift -= 4)
+    {
+        UINT32 digit = (id >> shift).Low() & 0xF;
+        name[length++] = (WCHAR)(digit < 10 ? L'0' + digit : L'a' + digit - 10);
+    }
+    for (const WCHAR *p = (const WCHAR *)suffix; *p != 0; p++)
+        name[length++] = *p;
+    name[length] = 0;
+}
+
+NO_INSTRUMENT static VOID WriteChunk(PPROFILE_BUFFER buffer)
+{
+    if (buffer->Header.RecordCount == 0)
+        return;
+
+    WCHAR name[30];
+    FormatFileName(name, buffer->FileId);
+
+    // The first chunk replaces a leftover file of the same name
+    File file;
+    UINT32 mode = buffer->Created ? FILE_MODE_WRITE | FILE_MODE_APPEND : FILE_MODE_WRITE | FILE_MODE_CREATE;
+    if (file.Open(name, mode))
+    {
+        buffer->Header.CycleFrequency = Timer::GetCycleFrequency();
+        file.Write(&buffer->Header, sizeof(PROFILE_CHUNK_HEADER) + buffer->Header.RecordCount * sizeof(PROFILE_RECORD));
+        buffer->Created = TRUE;
+    }
+    buffer->Header.RecordCount = 0;
+}
+
+NO_INSTRUMENT static PPROFILE_BUFFER CreateBuffer(PTHREAD_CONTEXT context, UINT64 cycles)
+{
+    PPROFILE_BUFFER buffer = (PPROFILE_BUFFER)Allocator::AllocateMemory(sizeof(PROFILE_BUFFER));
+    if (buffer == NULL)
+        return NULL;
+
+    buffer->Created = FALSE;
+    buffer->FileId = cycles;
+    buffer->Anchor = GetAnchor();
+    buffer->Header.Magic = PROFILE_MAGIC;
+    buffer->Header.RecordCount = 0;
+    buffer->Header.ThreadId = (UINT64)context->ThreadId;
+    buffer->Header.Anchor = (UINT64)buffer->Anchor;
+    buffer->Header.CycleFrequency = UINT64();
+    return buffer;
+}
+
+// Instrumented functions are reported by their link-time address on i386
+NO_INSTRUMENT static VOID RecordEvent(PVOID address, UINT32 event, BOOL linkTime)
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context == NULL || context->ProfileBusy)
+        return;
+
+    // Everything below may call instrumented code; those events are dropped
+    context->ProfileBusy = TRUE;
+    UINT64 cycles = Timer::ReadCycles();
+    if (linkTime)
+        address = PerformRelocation(address);
+
+    PPROFILE_BUFFER buffer = context->Profile;
+    if (buffer == NULL)
+        buffer = context->Profile = CreateBuffer(context, cycles);
+
+    if (buffer != NULL)
+    {
+        if (buffer->Header.RecordCount == PROFILE_BUFFER_RECORDS)
+            WriteChunk(buffer);
+
+        PPROFILE_RECORD record = &buffer->Records[buffer->Header.RecordCount++];
+        record->Cycles = cycles;
+        record->Event = event;
+        record->Offset = (INT32)((SSIZE)address - (SSIZE)buffer->Anchor);
+    }
+
+    context->ProfileBusy = FALSE;
+}
+
+// Hooks emitted by -finstrument-functions; the enter hook doubles as the address anchor.
+// Calls to them are inserted during code generation, after LTO could have dropped them.
+extern "C" NO_INSTRUMENT __attribute__((used)) VOID __cyg_profile_func_enter(PVOID function, PVOID callSite)
+{
+    (VOID)callSite;
+    RecordEvent(function, PROFILE_EVENT_ENTER, TRUE);
+}
+
+extern "C" NO_INSTRUMENT __attribute__((used)) VOID __cyg_profile_func_exit(PVOID function, PVOID callSite)
+{
+    (VOID)callSite;
+    RecordEvent(function, PROFILE_EVENT_EXIT, TRUE);
+}
+
+VOID Profiler::Record(PVOID address, UINT32 event)
+{
+    RecordEvent(address, event, FALSE);
+}
+
+VOID Profiler::Flush()
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context == NULL || context->Profile == NULL || context->ProfileBusy)
+        return;
+
+    context->ProfileBusy = TRUE;
+    WriteChunk(context->Profile);
+    context->ProfileBusy = FALSE;
+}
+
+VOID Profiler::Release()
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context == NULL || context->Profile == NULL)
+        return;
+
+    context->ProfileBusy = TRUE;
+    WriteChunk(context->Profile);
+    Allocator::ReleaseMemory(context->Profile, sizeof(PROFILE_BUFFER));
+    context->Profile = NULL;
+    context->ProfileBusy = FALSE;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "thread_context.h"
+#include "thread.h"
+#include "memory.h"
+#include "profiler.h"
+
+PTHREAD_CONTEXT ThreadContext::Get()
+{
+    return (PTHREAD_CONTEXT)ReadSlot();
+}
+
+VOID ThreadContext::Attach(PTHREAD_CONTEXT context)
+{
+    context->PreviousSlotValue = ReadSlot();
+    context->ThreadId = Thread::GetCurrentId();
+    context->LogLength = 0;
+    context->Frames = NULL;
+    context->CycleFrequency = UINT64();
+    context->Crc32cTable = NULL;
+    context->Crc32cHardware = -1;
+    context->Sha256Hardware = -1;
+#if defined(PROFILE)
+    context->Profile = NULL;
+    context->ProfileBusy = FALSE;
+#endif
+    Memory::Zero(context->FreeLists, sizeof(context->FreeLists));
+    Memory::Zero(context->FreeCounts, sizeof(context->FreeCounts));
+    Memory::Zero(context->ApiCache, sizeof(context->ApiCache));
+
+    WriteSlot(context);
+}
+
+VOID ThreadContext::Detach()
+{
+    PTHREAD_CONTEXT context = Get();
+    if (context == NULL)
+        return;
+
+#if defined(PROFILE)
+    Profiler::Release();
+#endif
+
+    // Uninstall first so the frees below go straight to the heap
+    WriteSlot(context->PreviousSlotValue);
+
+    for (INT32 sizeClass = 0; sizeClass < ALLOCATOR_CACHE_CLASSES; sizeClass++)
+    {
+        PVOID block = context->FreeLists[sizeClass];
+        while (block != NULL)
+        {
+            PVOID next = *(PPVOID)block;
+            Allocator::ReleaseMemory(block, 0);
+            block = next;
+        }
+        context->FreeLists[sizeClass] = NULL;
+        context->FreeCounts[sizeClass] = 0;
+    }
+
+    context->Scratch.Release();
+    context->Tables.Release();
+    context->Crc32cTable = NULL;
+}
+
+Arena *ThreadContext::GetScratch()
+{
+    PTHREAD_CONTEXT context = Get();
+    if (context == NULL)
+        return NULL;
+
+    if (!context->Scratch.IsInitialized() && !context->Scratch.InitializeHeap(SCRATCH_ARENA_SIZE))
+        return NULL;
+
+    return &context->Scratch;
+}
+
+Arena *ThreadContext::GetTables()
+{
+    PTHREAD_CONTEXT context = Get();
+    if (context == NULL)
+        return NULL;
+
+    if (!context->Tables.IsInitialized() && !context->Tables.InitializeHeap(TABLE_ARENA_SIZE))
+        return NULL;
+
+    return &context->Tables;
+}
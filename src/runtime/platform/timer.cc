@@ -0,0 +1,77 @@
+#include "timer.h"
+#include "thread_context.h"
+#include "atomic.h"
+
+// Length of the calibration window, as a fraction of a second
+#define TIMER_CALIBRATION_DIVISOR 100
+
+// ticks * 10^9 / frequency without overflowing for long intervals
+static UINT64 ScaleToNanoseconds(UINT64 ticks, UINT64 frequency)
+{
+    if (frequency == 0)
+        return UINT64();
+    UINT64 seconds = ticks / frequency;
+    UINT64 remainder = ticks % frequency;
+    return seconds * 1000000000U + remainder * 1000000000U / frequency;
+}
+
+UINT64 Timer::GetNanoseconds()
+{
+    return ScaleToNanoseconds(ReadClock(), GetClockFrequency());
+}
+
+UINT64 Timer::Calibrate()
+{
+#if defined(ARCHITECTURE_AARCH64)
+    // The generic timer publishes its own frequency
+    unsigned long long frequency;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return UINT64(frequency);
+#elif defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    UINT64 clockFrequency = GetClockFrequency();
+    UINT64 window = clockFrequency / TIMER_CALIBRATION_DIVISOR;
+
+    // Start on a fresh clock tick so a coarse clock doesn't shorten the window
+    UINT64 previous = ReadClock();
+    UINT64 clockStart;
+    do
+    {
+        clockStart = ReadClock();
+    } while (clockStart == previous);
+    UINT64 cycleStart = ReadCyclesOrdered();
+
+    UINT64 clockEnd;
+    do
+    {
+        CpuRelax();
+        clockEnd = ReadClock();
+    } while (clockEnd - clockStart < window);
+    UINT64 cycleEnd = ReadCyclesOrdered();
+
+    return (cycleEnd - cycleStart) * clockFrequency / (clockEnd - clockStart);
+#else
+    // Cycles are the clock's own ticks
+    return GetClockFrequency();
+#endif
+}
+
+UINT64 Timer::GetCycleFrequency()
+{
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    if (context != NULL && context->CycleFrequency != 0)
+        return context->CycleFrequency;
+
+    // A foreign thread has nowhere to keep a measurement, so it never calibrates
+    UINT64 frequency = GetPublishedCycleFrequency();
+    if (context == NULL)
+        return frequency;
+    if (frequency == 0)
+        frequency = Calibrate();
+    context->CycleFrequency = frequency;
+    return frequency;
+}
+
+UINT64 Timer::CyclesToNanoseconds(UINT64 cycles)
+{
+    return ScaleToNanoseconds(cycles, GetCycleFrequency());
+}
@@ -1,13 +1,47 @@
 #include "allocator.h"
+#include "thread_context.h"
 #include "ntdll.h"
 #include "peb.h"
 
 PVOID Allocator::AllocateMemory(USIZE len)
 {
+    // Small blocks are always rounded to their size class, so any of them can
+    // later be recycled through a thread cache no matter which thread frees it
+    INT32 sizeClass = ThreadContext::GetSizeClass(len);
+    if (sizeClass >= 0)
+    {
+        PTHREAD_CONTEXT context = ThreadContext::Get();
+        if (context != NULL && context->FreeLists[sizeClass] != NULL)
+        {
+            PVOID block = context->FreeLists[sizeClass];
+            context->FreeLists[sizeClass] = *(PPVOID)block;
+            context->FreeCounts[sizeClass]--;
+            return block;
+        }
+        len = ThreadContext::GetClassSize(sizeClass);
+    }
+
     return NTDLL::RtlAllocateHeap(GetCurrentPEB()->ProcessHeap, 0, len);
 }
 
-VOID Allocator::ReleaseMemory(PVOID ptr, USIZE)
+VOID Allocator::ReleaseMemory(PVOID ptr, USIZE size)
 {
+    if (ptr == NULL)
+        return;
+
+    // Only sized frees can be cached; unsized ones go straight back to the heap
+    INT32 sizeClass = size != 0 ? ThreadContext::GetSizeClass(size) : -1;
+    if (sizeClass >= 0)
+    {
+        PTHREAD_CONTEXT context = ThreadContext::Get();
+        if (context != NULL && context->FreeCounts[sizeClass] < ALLOCATOR_CACHE_DEPTH)
+        {
+            *(PPVOID)ptr = context->FreeLists[sizeClass];
+            context->FreeLists[sizeClass] = ptr;
+            context->FreeCounts[sizeClass]++;
+            return;
+        }
+    }
+
     NTDLL::RtlFreeHeap(GetCurrentPEB()->ProcessHeap, 0, ptr);
-}
\ No newline at end of file
+}
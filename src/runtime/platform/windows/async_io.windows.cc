@@ -0,0 +1,212 @@
+#include "async_io.h"
+#include "ntdll.h"
+
+static_assert(sizeof(IO_STATUS_BLOCK) == sizeof(((PASYNC_REQUEST)0)->IoStatus), "IoStatus must hold an IO_STATUS_BLOCK");
+
+BOOL AsyncIo::CreatePort()
+{
+    PVOID handle = NULL;
+    if (!NT_SUCCESS(NTDLL::NtCreateIoCompletion(&handle, IO_COMPLETION_ALL_ACCESS, NULL, 0)))
+        return FALSE;
+    port = handle;
+    return TRUE;
+}
+
+VOID AsyncIo::ClosePort()
+{
+    if (flushQueue != NULL)
+    {
+        // Packets leave a port in order, so the worker finishes queued flushes before the NULL request
+        NTDLL::NtSetIoCompletion(flushQueue, NULL, NULL, STATUS_SUCCESS, 0);
+        flushWorker.Join();
+        NTDLL::NtClose(flushQueue);
+        flushQueue = NULL;
+    }
+    NTDLL::NtClose(port);
+}
+
+INT32 AsyncIo::FlushWorker(PVOID context)
+{
+    AsyncIo *io = (AsyncIo *)context;
+    for (;;)
+    {
+        FILE_IO_COMPLETION_INFORMATION entry;
+        UINT32 removed = 0;
+        if (NTDLL::NtRemoveIoCompletionEx(io->flushQueue, &entry, 1, &removed, NULL, FALSE) != STATUS_SUCCESS)
+            return -1;
+        if (removed == 0)
+            continue;
+        PASYNC_REQUEST request = (PASYNC_REQUEST)entry.ApcContext;
+        if (request == NULL)
+            return 0;
+
+        // NtFlushBuffersFile waits for the flush itself, also on handles opened for overlapped I/O
+        PIO_STATUS_BLOCK ioStatus = (PIO_STATUS_BLOCK)request->IoStatus;
+        NTSTATUS status = NTDLL::NtFlushBuffersFile(request->File, ioStatus);
+        NTDLL::NtSetIoCompletion(io->port, NULL, request, status, NT_SUCCESS(status) ? ioStatus->Information : 0);
+    }
+}
+
+BOOL AsyncIo::StartFlushWorker()
+{
+    if (flushQueue != NULL)
+        return TRUE;
+
+    PVOID queue = NULL;
+    if (!NT_SUCCESS(NTDLL::NtCreateIoCompletion(&queue, IO_COMPLETION_ALL_ACCESS, NULL, 1)))
+        return FALSE;
+    flushQueue = queue;
+    if (!flushWorker.Create(FlushWorker, this))
+    {
+        NTDLL::NtClose(queue);
+        flushQueue = NULL;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+PVOID AsyncIo::OpenFile(const WCHAR *path, UINT32 flags)
+{
+    if (port == NULL || path == NULL)
+        return NULL;
+
+    // No FILE_SYNCHRONOUS_IO_* option: the handle is opened for overlapped I/O
+    PVOID file = File::OpenHandle(path, flags, TRUE);
+    if (file == NULL)
+        return NULL;
+
+    IO_STATUS_BLOCK ioStatus;
+    FILE_COMPLETION_INFORMATION completion;
+    completion.Port = port;
+    completion.Key = NULL;
+    if (!NT_SUCCESS(NTDLL::NtSetInformationFile(file, &ioStatus, &completion, sizeof(completion), FileCompletionInformation)))
+    {
+        File::CloseHandle(file);
+        return NULL;
+    }
+
+    // Requests that finish inline are reported by Issue, saving a reap per cached read.
+    // Issue relies on this: without it the port would report those requests a second time.
+    UINT32 notification = FILE_SKIP_COMPLETION_PORT_ON_SUCCESS | FILE_SKIP_SET_EVENT_ON_HANDLE;
+    if (!NT_SUCCESS(NTDLL::NtSetInformationFile(file, &ioStatus, &notification, sizeof(notification), FileIoCompletionNotificationInformation)))
+    {
+        File::CloseHandle(file);
+        return NULL;
+    }
+
+    return file;
+}
+
+VOID AsyncIo::CloseFile(PVOID file)
+{
+    File::CloseHandle(file);
+}
+
+// Copy the kernel's completion block into the request's result fields
+static VOID StoreResult(PASYNC_REQUEST request, NTSTATUS status, USIZE information)
+{
+    if (status == STATUS_END_OF_FILE)
+    {
+        status = STATUS_SUCCESS;
+        information = 0;
+    }
+    request->Status = NT_SUCCESS(status) ? 0 : status;
+    request->BytesTransferred = information;
+}
+
+BOOL AsyncIo::Issue(PASYNC_REQUEST request)
+{
+    PIO_STATUS_BLOCK ioStatus = (PIO_STATUS_BLOCK)request->IoStatus;
+    ioStatus->Status = STATUS_PENDING;
+    ioStatus->Information = 0;
+
+    NTSTATUS status;
+    switch (request->Operation)
+    {
+    case AsyncOperation::Read:
+        status = NTDLL::NtReadFile(request->File, NULL, NULL, request, ioStatus, request->Buffer, request->Length, &request->Offset, NULL);
+        break;
+    case AsyncOperation::Write:
+        status = NTDLL::NtWriteFile(request->File, NULL, NULL, request, ioStatus, request->Buffer, request->Length, &request->Offset, NULL);
+        break;
+    default:
+        // NtFlushBuffersFile takes no completion context and blocks until the data is written,
+        // so the flush worker runs it and posts the result to the port like any other completion
+        if (!StartFlushWorker())
+        {
+            StoreResult(request, STATUS_NO_MEMORY, 0);
+            return FALSE;
+        }
+        status = NTDLL::NtSetIoCompletion(flushQueue, NULL, request, STATUS_SUCCESS, 0);
+        if (!NT_SUCCESS(status))
+        {
+            StoreResult(request, status, 0);
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    if (status == STATUS_PENDING)
+        return TRUE;
+
+    // Errors never reach the port; successes skip it (FILE_SKIP_COMPLETION_PORT_ON_SUCCESS)
+    if (NT_ERROR(status))
+    {
+        StoreResult(request, status, 0);
+        return FALSE;
+    }
+    if (NT_SUCCESS(status))
+    {
+        StoreResult(request, status, ioStatus->Information);
+        return FALSE;
+    }
+
+    // Warning statuses are still delivered through the port
+    return TRUE;
+}
+
+USIZE AsyncIo::Reap(PASYNC_REQUEST *completed, USIZE maxCount, BOOL wait)
+{
+    FILE_IO_COMPLETION_INFORMATION entries[ASYNC_IO_REAP_BATCH];
+    UINT32 count = (UINT32)(maxCount < ASYNC_IO_REAP_BATCH ? maxCount : ASYNC_IO_REAP_BATCH);
+    UINT32 removed = 0;
+    UINT64 zero;
+
+    // A NULL timeout waits forever, a zero timeout only polls
+    NTSTATUS status = NTDLL::NtRemoveIoCompletionEx(port, entries, count, &removed, wait ? NULL : &zero, FALSE);
+    if (status != STATUS_SUCCESS)
+        return 0;
+
+    USIZE reaped = 0;
+    for (UINT32 i = 0; i < removed; i++)
+    {
+        PASYNC_REQUEST request = (PASYNC_REQUEST)entries[i].ApcContext;
+        if (request == NULL)
+            continue;
+        StoreResult(request, entries[i].IoStatusBlock.Status, entries[i].IoStatusBlock.Information);
+        completed[reaped++] = request;
+    }
+    return reaped;
+}
+
+PVOID AsyncIo::AllocateRegion(USIZE size)
+{
+    PVOID base = NULL;
+    USIZE regionSize = size;
+    if (!NT_SUCCESS(NTDLL::NtAllocateVirtualMemory(NTDLL::NtCurrentProcess(), &base, 0, &regionSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+        return NULL;
+
+    // Pinning is best effort: it fails once the working-set quota is used up
+    PVOID lockBase = base;
+    USIZE lockSize = regionSize;
+    NTDLL::NtLockVirtualMemory(NTDLL::NtCurrentProcess(), &lockBase, &lockSize, MAP_PROCESS);
+    return base;
+}
+
+VOID AsyncIo::ReleaseRegion(PVOID region, USIZE size)
+{
+    (VOID)size;
+    PVOID base = region;
+    USIZE regionSize = 0;
+    NTDLL::NtFreeVirtualMemory(NTDLL::NtCurrentProcess(), &base, &regionSize, MEM_RELEASE);
+}
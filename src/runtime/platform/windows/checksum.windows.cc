@@ -0,0 +1,29 @@
+#include "checksum.h"
+#include "windows_types.h"
+
+BOOL Crc32c::DetectHardware()
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // CPUID leaf 1: ECX bit 20 is SSE4.2
+    UINT32 eax, ebx, ecx, edx;
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+    return (ecx >> 20) & 1;
+#elif defined(ARCHITECTURE_AARCH64)
+    // The ID registers are not readable from user mode; Windows publishes the result
+    const volatile UINT8 *features = (const volatile UINT8 *)(KUSER_SHARED_DATA_ADDRESS + KUSER_PROCESSOR_FEATURES_OFFSET);
+    return features[PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE] != 0;
+#else
+    // armv7a code cannot encode the ARMv8 CRC instructions
+    return FALSE;
+#endif
+}
+
+BOOL Crc32c::ReadPublishedHardware()
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    const volatile UINT8 *features = (const volatile UINT8 *)(KUSER_SHARED_DATA_ADDRESS + KUSER_PROCESSOR_FEATURES_OFFSET);
+    return features[PF_SSE4_2_INSTRUCTIONS_AVAILABLE] != 0;
+#else
+    return DetectHardware();
+#endif
+}
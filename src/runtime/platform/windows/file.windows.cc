@@ -0,0 +1,170 @@
+#include "file.h"
+#include "ntdll.h"
+#include "peb.h"
+
+// Largest transfer handed to a single NtReadFile/NtWriteFile call
+#define FILE_MAX_TRANSFER 0x40000000
+
+PVOID File::OpenHandle(const WCHAR *path, UINT32 mode, BOOL overlapped)
+{
+    if (path == NULL)
+        return NULL;
+
+    USIZE length = 0;
+    while (path[length] != 0)
+        length++;
+
+    // Drive-letter paths become NT paths; relative paths resolve against the current directory
+    WCHAR ntPath[512];
+    USIZE prefix = 0;
+    PVOID root = NULL;
+    if (length >= 2 && path[1] == L':')
+    {
+        ntPath[0] = L'\\';
+        ntPath[1] = L'?';
+        ntPath[2] = L'?';
+        ntPath[3] = L'\\';
+        prefix = 4;
+    }
+    else if (path[0] != L'\\')
+    {
+        root = GetCurrentPEB()->ProcessParameters->CurrentDirectory.Handle;
+    }
+    if (prefix + length > sizeof(ntPath) / sizeof(WCHAR))
+        return NULL;
+    for (USIZE i = 0; i < length; i++)
+        ntPath[prefix + i] = path[i];
+
+    UNICODE_STRING name;
+    name.Length = (UINT16)((prefix + length) * sizeof(WCHAR));
+    name.MaximumLength = name.Length;
+    name.Buffer = ntPath;
+
+    OBJECT_ATTRIBUTES attributes;
+    attributes.Length = sizeof(OBJECT_ATTRIBUTES);
+    attributes.RootDirectory = root;
+    attributes.ObjectName = &name;
+    attributes.Attributes = OBJ_CASE_INSENSITIVE;
+    attributes.SecurityDescriptor = NULL;
+    attributes.SecurityQualityOfService = NULL;
+
+    UINT32 access = 0;
+    if (mode & FILE_MODE_READ)
+        access |= GENERIC_READ;
+    if (mode & (FILE_MODE_WRITE | FILE_MODE_APPEND))
+        access |= GENERIC_WRITE;
+
+    // Overlapped handles carry no FILE_SYNCHRONOUS_IO_* option and track no file position
+    UINT32 options = FILE_NON_DIRECTORY_FILE;
+    if (!overlapped)
+    {
+        access |= SYNCHRONIZE;
+        options |= FILE_SYNCHRONOUS_IO_NONALERT;
+    }
+    if (mode & FILE_MODE_UNBUFFERED)
+        options |= FILE_NO_INTERMEDIATE_BUFFERING;
+    if (mode & FILE_MODE_SEQUENTIAL)
+        options |= FILE_SEQUENTIAL_ONLY;
+    if (mode & FILE_MODE_RANDOM)
+        options |= FILE_RANDOM_ACCESS;
+    if (mode & FILE_MODE_TEMPORARY)
+    {
+        options |= FILE_DELETE_ON_CLOSE;
+        access |= DELETE;
+    }
+
+    UINT32 disposition = FILE_OPEN;
+    if (mode & FILE_MODE_CREATE)
+        disposition = FILE_OVERWRITE_IF;
+    else if (mode & FILE_MODE_APPEND)
+        disposition = FILE_OPEN_IF;
+
+    PVOID file = NULL;
+    IO_STATUS_BLOCK ioStatus;
+    NTSTATUS status = NTDLL::NtCreateFile(&file, access, &attributes, &ioStatus, NULL, FILE_ATTRIBUTE_NORMAL,
+                                          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                          disposition, options, NULL, 0);
+    if (!NT_SUCCESS(status))
+        return NULL;
+    return file;
+}
+
+VOID File::CloseHandle(PVOID fileHandle)
+{
+    if (fileHandle != NULL)
+        NTDLL::NtClose(fileHandle);
+}
+
+SSIZE File::Read(PVOID buffer, USIZE size)
+{
+    if (handle == NULL)
+        return -1;
+
+    // A NULL byte offset reads at the handle's current position
+    IO_STATUS_BLOCK ioStatus;
+    UINT32 length = (UINT32)(size < FILE_MAX_TRANSFER ? size : FILE_MAX_TRANSFER);
+    NTSTATUS status = NTDLL::NtReadFile(handle, NULL, NULL, NULL, &ioStatus, buffer, length, NULL, NULL);
+    if (status == STATUS_END_OF_FILE)
+        return 0;
+    if (!NT_SUCCESS(status))
+        return -1;
+    return (SSIZE)ioStatus.Information;
+}
+
+SSIZE File::Write(PCVOID buffer, USIZE size)
+{
+    if (handle == NULL)
+        return -1;
+
+    IO_STATUS_BLOCK ioStatus;
+    UINT32 length = (UINT32)(size < FILE_MAX_TRANSFER ? size : FILE_MAX_TRANSFER);
+    NTSTATUS status = NTDLL::NtWriteFile(handle, NULL, NULL, NULL, &ioStatus, (PVOID)buffer, length, NULL, NULL);
+    if (!NT_SUCCESS(status))
+        return -1;
+    return (SSIZE)ioStatus.Information;
+}
+
+BOOL File::Seek(UINT64 position)
+{
+    if (handle == NULL)
+        return FALSE;
+
+    IO_STATUS_BLOCK ioStatus;
+    FILE_POSITION_INFORMATION information;
+    information.CurrentByteOffset = position;
+    return NT_SUCCESS(NTDLL::NtSetInformationFile(handle, &ioStatus, &information, sizeof(information), FilePositionInformation));
+}
+
+BOOL File::SeekToEnd()
+{
+    if (handle == NULL)
+        return FALSE;
+    return Seek(GetSize());
+}
+
+UINT64 File::GetPosition() const
+{
+    IO_STATUS_BLOCK ioStatus;
+    FILE_POSITION_INFORMATION information;
+    if (handle == NULL || !NT_SUCCESS(NTDLL::NtQueryInformationFile(handle, &ioStatus, &information, sizeof(information), FilePositionInformation)))
+        return UINT64();
+    return information.CurrentByteOffset;
+}
+
+UINT64 File::GetSize() const
+{
+    IO_STATUS_BLOCK ioStatus;
+    FILE_STANDARD_INFORMATION information;
+    if (handle == NULL || !NT_SUCCESS(NTDLL::NtQueryInformationFile(handle, &ioStatus, &information, sizeof(information), FileStandardInformation)))
+        return UINT64();
+    return information.EndOfFile;
+}
+
+BOOL File::Flush()
+{
+    if (handle == NULL)
+        return FALSE;
+
+    IO_STATUS_BLOCK ioStatus;
+    return NT_SUCCESS(NTDLL::NtFlushBuffersFile(handle, &ioStatus));
+}
@@ -0,0 +1,96 @@
+#include "mapped_file.h"
+#include "file.h"
+#include "ntdll.h"
+
+// Stride used when pages have to be touched by hand
+#define MAPPED_FILE_PAGE_SIZE 4096
+
+BOOL MappedFile::Open(const WCHAR *path, MappedView mode, MappedAccess access)
+{
+    Close();
+
+    // Read-ahead hints go to the file object; the section inherits them for its page-ins
+    UINT32 fileMode = FILE_MODE_READ;
+    if (access == MappedAccess::Sequential)
+        fileMode |= FILE_MODE_SEQUENTIAL;
+    else if (access == MappedAccess::Random)
+        fileMode |= FILE_MODE_RANDOM;
+
+    File file;
+    if (!file.Open(path, fileMode))
+        return FALSE;
+
+    // A view covers the whole file, so it must fit the address space
+    UINT64 fileSize = file.GetSize();
+    if (sizeof(USIZE) < sizeof(UINT64) && fileSize.High() != 0)
+        return FALSE;
+
+    // Sections cannot be created over empty files; there is simply nothing to map
+    if (fileSize == 0)
+    {
+        open = TRUE;
+        return TRUE;
+    }
+
+    // Copy-on-write only needs read access to the file: private pages are never written back
+    UINT32 protection = mode == MappedView::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+    PVOID sectionHandle = NULL;
+    if (!NT_SUCCESS(NTDLL::NtCreateSection(&sectionHandle, SECTION_QUERY | SECTION_MAP_READ, NULL, NULL, protection, SEC_COMMIT, file.GetHandle())))
+        return FALSE;
+
+    PVOID base = NULL;
+    USIZE viewSize = 0;
+    if (!NT_SUCCESS(NTDLL::NtMapViewOfSection(sectionHandle, NTDLL::NtCurrentProcess(), &base, 0, 0, NULL, &viewSize, ViewUnmap, 0, protection)))
+    {
+        NTDLL::NtClose(sectionHandle);
+        return FALSE;
+    }
+
+    // The file handle can go now; the section keeps the file referenced
+    section = sectionHandle;
+    view = (PUINT8)base;
+    size = (USIZE)(unsigned long long)fileSize;
+    writable = mode == MappedView::CopyOnWrite;
+    open = TRUE;
+    return TRUE;
+}
+
+VOID MappedFile::Close()
+{
+    if (view != NULL)
+        NTDLL::NtUnmapViewOfSection(NTDLL::NtCurrentProcess(), view);
+    if (section != NULL)
+        NTDLL::NtClose(section);
+    section = NULL;
+    view = NULL;
+    size = 0;
+    open = FALSE;
+    writable = FALSE;
+}
+
+BOOL MappedFile::Prefetch(USIZE offset, USIZE length) const
+{
+    if (view == NULL || offset >= size)
+        return FALSE;
+    if (length > size - offset)
+        length = size - offset;
+    if (length == 0)
+        return TRUE;
+
+    // One request covering the range is turned into large asynchronous page-ins
+    MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = view + offset;
+    range.NumberOfBytes = length;
+    UINT32 flags = 0;
+    if (NT_SUCCESS(NTDLL::NtSetInformationVirtualMemory(NTDLL::NtCurrentProcess(), VmPrefetchInformation, 1, &range, &flags, sizeof(flags))))
+        return TRUE;
+
+    // Older systems: fault the pages in now, one read per page
+    volatile const UINT8 *bytes = view + offset;
+    UINT8 sink = 0;
+    for (USIZE i = 0; i < length; i += MAPPED_FILE_PAGE_SIZE)
+        sink ^= bytes[i];
+    sink ^= bytes[length - 1];
+    (VOID)sink;
+    return TRUE;
+}
@@ -17,3 +17,142 @@ NTSTATUS NTDLL::ZwTerminateProcess(PVOID ProcessHandle, NTSTATUS ExitStatus)
 {
     return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, NTSTATUS ExitStatus))ResolveNtdllExportAddress("ZwTerminateProcess"))(ProcessHandle, ExitStatus);
 }
+
+NTSTATUS NTDLL::NtCreateThreadEx(PPVOID ThreadHandle, UINT32 DesiredAccess, PVOID ObjectAttributes, PVOID ProcessHandle, PVOID StartRoutine, PVOID Argument, UINT32 CreateFlags, USIZE ZeroBits, USIZE StackSize, USIZE MaximumStackSize, PVOID AttributeList)
+{
+    return ((NTSTATUS(STDCALL *)(PPVOID ThreadHandle, UINT32 DesiredAccess, PVOID ObjectAttributes, PVOID ProcessHandle, PVOID StartRoutine, PVOID Argument, UINT32 CreateFlags, USIZE ZeroBits, USIZE StackSize, USIZE MaximumStackSize, PVOID AttributeList))ResolveNtdllExportAddress("NtCreateThreadEx"))(ThreadHandle, DesiredAccess, ObjectAttributes, ProcessHandle, StartRoutine, Argument, CreateFlags, ZeroBits, StackSize, MaximumStackSize, AttributeList);
+}
+
+NTSTATUS NTDLL::NtWaitForSingleObject(PVOID Handle, BOOL Alertable, PVOID Timeout)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID Handle, BOOL Alertable, PVOID Timeout))ResolveNtdllExportAddress("NtWaitForSingleObject"))(Handle, Alertable, Timeout);
+}
+
+NTSTATUS NTDLL::NtYieldExecution()
+{
+    return ((NTSTATUS(STDCALL *)())ResolveNtdllExportAddress("NtYieldExecution"))();
+}
+
+NTSTATUS NTDLL::NtClose(PVOID Handle)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID Handle))ResolveNtdllExportAddress("NtClose"))(Handle);
+}
+
+NTSTATUS NTDLL::NtWaitForAlertByThreadId(PVOID Address, PVOID Timeout)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID Address, PVOID Timeout))ResolveNtdllExportAddress("NtWaitForAlertByThreadId"))(Address, Timeout);
+}
+
+NTSTATUS NTDLL::NtAlertThreadByThreadId(PVOID ThreadId)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ThreadId))ResolveNtdllExportAddress("NtAlertThreadByThreadId"))(ThreadId);
+}
+
+NTSTATUS NTDLL::NtQuerySystemInformation(UINT32 SystemInformationClass, PVOID SystemInformation, UINT32 SystemInformationLength, PUINT32 ReturnLength)
+{
+    return ((NTSTATUS(STDCALL *)(UINT32 SystemInformationClass, PVOID SystemInformation, UINT32 SystemInformationLength, PUINT32 ReturnLength))ResolveNtdllExportAddress("NtQuerySystemInformation"))(SystemInformationClass, SystemInformation, SystemInformationLength, ReturnLength);
+}
+
+NTSTATUS NTDLL::NtAllocateVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, PUSIZE RegionSize, UINT32 AllocationType, UINT32 Protect)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, PUSIZE RegionSize, UINT32 AllocationType, UINT32 Protect))ResolveNtdllExportAddress("NtAllocateVirtualMemory"))(ProcessHandle, BaseAddress, ZeroBits, RegionSize, AllocationType, Protect);
+}
+
+NTSTATUS NTDLL::NtFreeVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 FreeType)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 FreeType))ResolveNtdllExportAddress("NtFreeVirtualMemory"))(ProcessHandle, BaseAddress, RegionSize, FreeType);
+}
+
+NTSTATUS NTDLL::NtProtectVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 NewProtect, PUINT32 OldProtect)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 NewProtect, PUINT32 OldProtect))ResolveNtdllExportAddress("NtProtectVirtualMemory"))(ProcessHandle, BaseAddress, RegionSize, NewProtect, OldProtect);
+}
+
+NTSTATUS NTDLL::NtFlushInstructionCache(PVOID ProcessHandle, PVOID BaseAddress, USIZE Length)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PVOID BaseAddress, USIZE Length))ResolveNtdllExportAddress("NtFlushInstructionCache"))(ProcessHandle, BaseAddress, Length);
+}
+
+NTSTATUS NTDLL::NtLockVirtualMemory(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 MapType)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PPVOID BaseAddress, PUSIZE RegionSize, UINT32 MapType))ResolveNtdllExportAddress("NtLockVirtualMemory"))(ProcessHandle, BaseAddress, RegionSize, MapType);
+}
+
+NTSTATUS NTDLL::NtCreateFile(PPVOID FileHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PIO_STATUS_BLOCK IoStatusBlock, PVOID AllocationSize, UINT32 FileAttributes, UINT32 ShareAccess, UINT32 CreateDisposition, UINT32 CreateOptions, PVOID EaBuffer, UINT32 EaLength)
+{
+    return ((NTSTATUS(STDCALL *)(PPVOID FileHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PIO_STATUS_BLOCK IoStatusBlock, PVOID AllocationSize, UINT32 FileAttributes, UINT32 ShareAccess, UINT32 CreateDisposition, UINT32 CreateOptions, PVOID EaBuffer, UINT32 EaLength))ResolveNtdllExportAddress("NtCreateFile"))(FileHandle, DesiredAccess, ObjectAttributes, IoStatusBlock, AllocationSize, FileAttributes, ShareAccess, CreateDisposition, CreateOptions, EaBuffer, EaLength);
+}
+
+NTSTATUS NTDLL::NtReadFile(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key))ResolveNtdllExportAddress("NtReadFile"))(FileHandle, Event, ApcRoutine, ApcContext, IoStatusBlock, Buffer, Length, ByteOffset, Key);
+}
+
+NTSTATUS NTDLL::NtWriteFile(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID FileHandle, PVOID Event, PVOID ApcRoutine, PVOID ApcContext, PIO_STATUS_BLOCK IoStatusBlock, PVOID Buffer, UINT32 Length, PVOID ByteOffset, PUINT32 Key))ResolveNtdllExportAddress("NtWriteFile"))(FileHandle, Event, ApcRoutine, ApcContext, IoStatusBlock, Buffer, Length, ByteOffset, Key);
+}
+
+NTSTATUS NTDLL::NtFlushBuffersFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock))ResolveNtdllExportAddress("NtFlushBuffersFile"))(FileHandle, IoStatusBlock);
+}
+
+NTSTATUS NTDLL::NtQueryInformationFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass))ResolveNtdllExportAddress("NtQueryInformationFile"))(FileHandle, IoStatusBlock, FileInformation, Length, FileInformationClass);
+}
+
+NTSTATUS NTDLL::NtSetInformationFile(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID FileHandle, PIO_STATUS_BLOCK IoStatusBlock, PVOID FileInformation, UINT32 Length, UINT32 FileInformationClass))ResolveNtdllExportAddress("NtSetInformationFile"))(FileHandle, IoStatusBlock, FileInformation, Length, FileInformationClass);
+}
+
+NTSTATUS NTDLL::NtCreateSection(PPVOID SectionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PVOID MaximumSize, UINT32 SectionPageProtection, UINT32 AllocationAttributes, PVOID FileHandle)
+{
+    return ((NTSTATUS(STDCALL *)(PPVOID SectionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, PVOID MaximumSize, UINT32 SectionPageProtection, UINT32 AllocationAttributes, PVOID FileHandle))ResolveNtdllExportAddress("NtCreateSection"))(SectionHandle, DesiredAccess, ObjectAttributes, MaximumSize, SectionPageProtection, AllocationAttributes, FileHandle);
+}
+
+NTSTATUS NTDLL::NtMapViewOfSection(PVOID SectionHandle, PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, USIZE CommitSize, PVOID SectionOffset, PUSIZE ViewSize, UINT32 InheritDisposition, UINT32 AllocationType, UINT32 Win32Protect)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID SectionHandle, PVOID ProcessHandle, PPVOID BaseAddress, USIZE ZeroBits, USIZE CommitSize, PVOID SectionOffset, PUSIZE ViewSize, UINT32 InheritDisposition, UINT32 AllocationType, UINT32 Win32Protect))ResolveNtdllExportAddress("NtMapViewOfSection"))(SectionHandle, ProcessHandle, BaseAddress, ZeroBits, CommitSize, SectionOffset, ViewSize, InheritDisposition, AllocationType, Win32Protect);
+}
+
+NTSTATUS NTDLL::NtUnmapViewOfSection(PVOID ProcessHandle, PVOID BaseAddress)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, PVOID BaseAddress))ResolveNtdllExportAddress("NtUnmapViewOfSection"))(ProcessHandle, BaseAddress);
+}
+
+NTSTATUS NTDLL::NtSetInformationVirtualMemory(PVOID ProcessHandle, UINT32 VmInformationClass, USIZE NumberOfEntries, PMEMORY_RANGE_ENTRY VirtualAddresses, PVOID VmInformation, UINT32 VmInformationLength)
+{
+    // Exported from Windows 8 on; report older systems as unsupported instead of calling NULL
+    PVOID function = ResolveNtdllExportAddress("NtSetInformationVirtualMemory");
+    if (function == NULL)
+        return STATUS_NOT_IMPLEMENTED;
+    return ((NTSTATUS(STDCALL *)(PVOID ProcessHandle, UINT32 VmInformationClass, USIZE NumberOfEntries, PMEMORY_RANGE_ENTRY VirtualAddresses, PVOID VmInformation, UINT32 VmInformationLength))function)(ProcessHandle, VmInformationClass, NumberOfEntries, VirtualAddresses, VmInformation, VmInformationLength);
+}
+
+BOOL NTDLL::RtlQueryPerformanceCounter(PUINT64 PerformanceCounter)
+{
+    return ((BOOL(STDCALL *)(PUINT64 PerformanceCounter))ResolveNtdllExportAddress("RtlQueryPerformanceCounter"))(PerformanceCounter);
+}
+
+BOOL NTDLL::RtlQueryPerformanceFrequency(PUINT64 PerformanceFrequency)
+{
+    return ((BOOL(STDCALL *)(PUINT64 PerformanceFrequency))ResolveNtdllExportAddress("RtlQueryPerformanceFrequency"))(PerformanceFrequency);
+}
+
+NTSTATUS NTDLL::NtCreateIoCompletion(PPVOID IoCompletionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, UINT32 NumberOfConcurrentThreads)
+{
+    return ((NTSTATUS(STDCALL *)(PPVOID IoCompletionHandle, UINT32 DesiredAccess, POBJECT_ATTRIBUTES ObjectAttributes, UINT32 NumberOfConcurrentThreads))ResolveNtdllExportAddress("NtCreateIoCompletion"))(IoCompletionHandle, DesiredAccess, ObjectAttributes, NumberOfConcurrentThreads);
+}
+
+NTSTATUS NTDLL::NtSetIoCompletion(PVOID IoCompletionHandle, PVOID KeyContext, PVOID ApcContext, NTSTATUS IoStatus, USIZE IoStatusInformation)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID IoCompletionHandle, PVOID KeyContext, PVOID ApcContext, NTSTATUS IoStatus, USIZE IoStatusInformation))ResolveNtdllExportAddress("NtSetIoCompletion"))(IoCompletionHandle, KeyContext, ApcContext, IoStatus, IoStatusInformation);
+}
+
+NTSTATUS NTDLL::NtRemoveIoCompletionEx(PVOID IoCompletionHandle, PFILE_IO_COMPLETION_INFORMATION IoCompletionInformation, UINT32 Count, PUINT32 NumEntriesRemoved, PVOID Timeout, BOOL Alertable)
+{
+    return ((NTSTATUS(STDCALL *)(PVOID IoCompletionHandle, PFILE_IO_COMPLETION_INFORMATION IoCompletionInformation, UINT32 Count, PUINT32 NumEntriesRemoved, PVOID Timeout, BOOL Alertable))ResolveNtdllExportAddress("NtRemoveIoCompletionEx"))(IoCompletionHandle, IoCompletionInformation, Count, NumEntriesRemoved, Timeout, Alertable);
+}
@@ -30,6 +30,32 @@ PPEB GetCurrentPEB(VOID)
     return peb;
 }
 
+// Returns the current thread's TEB pointer
+PTEB GetCurrentTEB(VOID)
+{
+    PTEB teb;
+#if defined(PLATFORM_WINDOWS_X86_64)
+
+    __asm__("movq %%gs:%1, %0" : "=r"(teb) : "m"(*(PUINT64)(0x30)));
+
+#elif defined(PLATFORM_WINDOWS_I386)
+
+    __asm__("movl %%fs:%1, %0" : "=r"(teb) : "m"(*(PUINT32)(0x18)));
+
+#elif defined(PLATFORM_WINDOWS_ARMV7A)
+
+    __asm__("mrc p15, 0, %0, c13, c0, 2" : "=r"(teb));
+
+#elif defined(PLATFORM_WINDOWS_AARCH64)
+
+    __asm__("mov %0, x18" : "=r"(teb));
+
+#else
+#error Unsupported platform
+#endif
+    return teb;
+}
+
 // Get the base address of a module by its name
 PVOID GetModuleHandleFromPEB(USIZE moduleNameHash)
 {
@@ -1,4 +1,5 @@
 #include "platform.h"
+#include "thread_context.h"
 #include "ntdll.h"
 #include "peb.h"
 #include "pe.h"
@@ -7,6 +8,17 @@
 
 PVOID ResolveExportAddressFromPebModule(USIZE moduleNameHash, USIZE functionNameHash)
 {
+    // Every API wrapper lands here; a per-thread cache skips the PEB and export walks
+    PTHREAD_CONTEXT context = ThreadContext::Get();
+    PAPI_CACHE_ENTRY entry = NULL;
+    if (context != NULL)
+    {
+        USIZE mixed = functionNameHash ^ (moduleNameHash >> 7) ^ (functionNameHash >> 13);
+        entry = &context->ApiCache[mixed & (API_CACHE_ENTRIES - 1)];
+        if (entry->Address != NULL && entry->FunctionHash == functionNameHash && entry->ModuleHash == moduleNameHash)
+            return entry->Address;
+    }
+
     // Resolve the module handle
     PVOID moduleBase = GetModuleHandleFromPEB(moduleNameHash);
     // Validate the module handle
@@ -14,6 +26,13 @@ PVOID ResolveExportAddressFromPebModule(USIZE moduleNameHash, USIZE functionName
         return NULL;
     // Resolve the function address
     PVOID functionAddress = GetExportAddress(moduleBase, functionNameHash);
+
+    if (entry != NULL && functionAddress != NULL)
+    {
+        entry->ModuleHash = moduleNameHash;
+        entry->FunctionHash = functionNameHash;
+        entry->Address = functionAddress;
+    }
     return functionAddress;
 }
 
@@ -0,0 +1,35 @@
+#include "sha.h"
+#include "windows_types.h"
+
+BOOL Sha256::DetectHardware()
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // CPUID leaf 7: EBX bit 29 is SHA; the asm also uses SSSE3 (pshufb, palignr) and SSE4.1 (pblendw)
+    UINT32 eax, ebx, ecx, edx;
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0), "c"(0));
+    if (eax < 7)
+        return FALSE;
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(7), "c"(0));
+    if (((ebx >> 29) & 1) == 0)
+        return FALSE;
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+    return ((ecx >> 9) & 1) && ((ecx >> 19) & 1);
+#elif defined(ARCHITECTURE_AARCH64)
+    // The ID registers are not readable from user mode; Windows publishes the result
+    const volatile UINT8 *features = (const volatile UINT8 *)(KUSER_SHARED_DATA_ADDRESS + KUSER_PROCESSOR_FEATURES_OFFSET);
+    return features[PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE] != 0;
+#else
+    // armv7a code cannot encode the ARMv8 SHA instructions
+    return FALSE;
+#endif
+}
+
+BOOL Sha256::ReadPublishedHardware()
+{
+#if defined(ARCHITECTURE_AARCH64)
+    return DetectHardware();
+#else
+    // No PF_* value covers SHA-NI, and armv7a has no instruction path
+    return FALSE;
+#endif
+}
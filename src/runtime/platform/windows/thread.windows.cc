@@ -0,0 +1,104 @@
+#include "thread.h"
+#include "thread_context.h"
+#include "platform.h"
+#include "allocator.h"
+#include "ntdll.h"
+#include "peb.h"
+
+// Startup block shared between the creating thread and the new thread
+typedef struct _THREAD_STARTUP
+{
+    THREAD_ROUTINE Routine;
+    PVOID Parameter;
+    INT32 ExitCode;
+} THREAD_STARTUP, *PTHREAD_STARTUP;
+
+// Native entry point; runs the user routine with a thread context and records its exit code
+static UINT32 STDCALL ThreadTrampoline(PVOID parameter)
+{
+    PTHREAD_STARTUP startup = (PTHREAD_STARTUP)parameter;
+
+    THREAD_CONTEXT context;
+    ThreadContext::Attach(&context);
+    INT32 exitCode = startup->Routine(startup->Parameter);
+    ThreadContext::Detach();
+
+    startup->ExitCode = exitCode;
+    return (UINT32)exitCode;
+}
+
+BOOL Thread::Create(THREAD_ROUTINE routine, PVOID parameter, USIZE stackSize)
+{
+    if (routine == NULL || handle != NULL)
+        return FALSE;
+
+    PTHREAD_STARTUP block = (PTHREAD_STARTUP)Allocator::AllocateMemory(sizeof(THREAD_STARTUP));
+    if (block == NULL)
+        return FALSE;
+
+    // Both the routine and the trampoline are called through pointers, rebase them for PIC
+    block->Routine = (THREAD_ROUTINE)PerformRelocation((PVOID)routine);
+    block->Parameter = parameter;
+    block->ExitCode = 0;
+
+    // Commit the whole stack up front: the runtime builds without stack probes,
+    // so large frames must not rely on guard-page growth
+    PVOID threadHandle = NULL;
+    NTSTATUS status = NTDLL::NtCreateThreadEx(&threadHandle, THREAD_ALL_ACCESS, NULL, NTDLL::NtCurrentProcess(),
+                                              PerformRelocation((PVOID)ThreadTrampoline), block, 0, 0,
+                                              stackSize, stackSize, NULL);
+    if (!NT_SUCCESS(status))
+    {
+        Allocator::ReleaseMemory(block, sizeof(THREAD_STARTUP));
+        return FALSE;
+    }
+
+    handle = threadHandle;
+    startup = block;
+    return TRUE;
+}
+
+INT32 Thread::Join()
+{
+    if (handle == NULL)
+        return -1;
+
+    NTDLL::NtWaitForSingleObject(handle, FALSE, NULL);
+    NTDLL::NtClose(handle);
+
+    PTHREAD_STARTUP block = (PTHREAD_STARTUP)startup;
+    INT32 exitCode = block->ExitCode;
+    Allocator::ReleaseMemory(block, sizeof(THREAD_STARTUP));
+
+    handle = NULL;
+    startup = NULL;
+    return exitCode;
+}
+
+VOID Thread::Yield()
+{
+    NTDLL::NtYieldExecution();
+}
+
+VOID Thread::Park(PVOID address)
+{
+    NTDLL::NtWaitForAlertByThreadId(address, NULL);
+}
+
+VOID Thread::Unpark(USIZE threadId)
+{
+    NTDLL::NtAlertThreadByThreadId((PVOID)threadId);
+}
+
+UINT32 Thread::GetProcessorCount()
+{
+    SYSTEM_BASIC_INFORMATION info;
+    if (!NT_SUCCESS(NTDLL::NtQuerySystemInformation(SystemBasicInformation, &info, sizeof(info), NULL)) || info.NumberOfProcessors == 0)
+        return 1;
+    return (UINT32)info.NumberOfProcessors;
+}
+
+USIZE Thread::GetCurrentId()
+{
+    return (USIZE)GetCurrentTEB()->ClientId.UniqueThread;
+}
@@ -0,0 +1,55 @@
+#include "thread_context.h"
+#include "platform.h"
+
+// The slot is TEB->NtTib.SubSystemTib, read straight through the TEB register
+PVOID ThreadContext::ReadSlot()
+{
+    PVOID value;
+#if defined(PLATFORM_WINDOWS_X86_64)
+
+    __asm__ __volatile__("movq %%gs:%1, %0" : "=r"(value) : "m"(*(PUINT64)(0x18)));
+
+#elif defined(PLATFORM_WINDOWS_I386)
+
+    __asm__ __volatile__("movl %%fs:%1, %0" : "=r"(value) : "m"(*(PUINT32)(0x0C)));
+
+#elif defined(PLATFORM_WINDOWS_ARMV7A)
+
+    PUINT8 teb;
+    __asm__("mrc p15, 0, %0, c13, c0, 2" : "=r"(teb));
+    value = *(volatile PVOID *)(teb + 0x0C);
+
+#elif defined(PLATFORM_WINDOWS_AARCH64)
+
+    __asm__ __volatile__("ldr %0, [x18, #%1]" : "=r"(value) : "i"(0x18));
+
+#else
+#error Unsupported platform
+#endif
+    return value;
+}
+
+VOID ThreadContext::WriteSlot(PVOID value)
+{
+#if defined(PLATFORM_WINDOWS_X86_64)
+
+    __asm__ __volatile__("movq %1, %%gs:%0" : "=m"(*(PUINT64)(0x18)) : "r"(value));
+
+#elif defined(PLATFORM_WINDOWS_I386)
+
+    __asm__ __volatile__("movl %1, %%fs:%0" : "=m"(*(PUINT32)(0x0C)) : "r"(value));
+
+#elif defined(PLATFORM_WINDOWS_ARMV7A)
+
+    PUINT8 teb;
+    __asm__("mrc p15, 0, %0, c13, c0, 2" : "=r"(teb));
+    *(volatile PVOID *)(teb + 0x0C) = value;
+
+#elif defined(PLATFORM_WINDOWS_AARCH64)
+
+    __asm__ __volatile__("str %0, [x18, #%1]" : : "r"(value), "i"(0x18) : "memory");
+
+#else
+#error Unsupported platform
+#endif
+}
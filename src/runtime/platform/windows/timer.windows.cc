@@ -0,0 +1,43 @@
+#include "timer.h"
+#include "ntdll.h"
+
+UINT64 Timer::ReadClock()
+{
+    UINT64 counter;
+    NTDLL::RtlQueryPerformanceCounter(&counter);
+    return counter;
+}
+
+UINT64 Timer::GetClockFrequency()
+{
+    // Windows 10 publishes the QPC frequency in KUSER_SHARED_DATA; the offset means something else before that
+    const volatile UINT8 *shared = (const volatile UINT8 *)KUSER_SHARED_DATA_ADDRESS;
+    if (*(const volatile UINT32 *)(shared + KUSER_NT_MAJOR_VERSION_OFFSET) >= 10)
+    {
+        const volatile UINT32 *frequency = (const volatile UINT32 *)(shared + KUSER_QPC_FREQUENCY_OFFSET);
+        return UINT64(frequency[1], frequency[0]);
+    }
+
+    UINT64 frequency;
+    NTDLL::RtlQueryPerformanceFrequency(&frequency);
+    return frequency;
+}
+
+UINT64 Timer::GetPublishedCycleFrequency()
+{
+#if defined(ARCHITECTURE_X86_64) || defined(ARCHITECTURE_I386)
+    // With the plain QPC bypass a QPC value is (rdtsc + QpcBias) >> QpcShift, so the TSC
+    // runs at QpcFrequency << QpcShift. Through the hypervisor's reference page the ratio
+    // is not a shift, and before Windows 10 the fields are not there.
+    const volatile UINT8 *shared = (const volatile UINT8 *)KUSER_SHARED_DATA_ADDRESS;
+    if (*(const volatile UINT32 *)(shared + KUSER_NT_MAJOR_VERSION_OFFSET) < 10)
+        return UINT64();
+    UINT8 bypass = shared[KUSER_QPC_BYPASS_OFFSET];
+    if ((bypass & (SHARED_GLOBAL_FLAGS_QPC_BYPASS_ENABLED | SHARED_GLOBAL_FLAGS_QPC_BYPASS_USE_HV_PAGE)) != SHARED_GLOBAL_FLAGS_QPC_BYPASS_ENABLED)
+        return UINT64();
+    return GetClockFrequency() << shared[KUSER_QPC_SHIFT_OFFSET];
+#else
+    // Both ARM counters have a frequency that is read, not measured
+    return Calibrate();
+#endif
+}
@@ -0,0 +1,267 @@
+#include "string.h"
+
+// Units validated and copied per step of the ASCII runs
+#define UTF_ASCII_BLOCK 8
+
+// TRUE if the UTF_ASCII_BLOCK units at wide are all below 0x80
+static FORCE_INLINE BOOL IsAsciiBlock(PCWCHAR wide)
+{
+    USIZE any = 0;
+    for (USIZE k = 0; k < UTF_ASCII_BLOCK; k += SWAR_LANES / 2)
+        any |= Swar::Load(wide + k);
+    return (any & Swar::Broadcast16(0xFF80)) == 0;
+}
+
+static FORCE_INLINE BOOL IsAsciiBlock(PCCHAR utf8)
+{
+    USIZE any = 0;
+    for (USIZE k = 0; k < UTF_ASCII_BLOCK; k += SWAR_LANES)
+        any |= Swar::Load(utf8 + k);
+    return !Swar::HasHighBit(any);
+}
+
+/**
+ * DecodeWide - One code point from UTF-16
+ *
+ * @return Units consumed (1 or 2), or 0 for an unpaired surrogate
+ */
+static FORCE_INLINE USIZE DecodeWide(PCWCHAR wide, USIZE available, UINT32 &codePoint)
+{
+    UINT32 unit = wide[0];
+    if (unit < 0xD800 || unit > 0xDFFF)
+    {
+        codePoint = unit;
+        return 1;
+    }
+
+    // A high surrogate must be followed by a low one
+    if (unit > 0xDBFF || available < 2)
+        return 0;
+    UINT32 low = wide[1];
+    if (low < 0xDC00 || low > 0xDFFF)
+        return 0;
+    codePoint = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+    return 2;
+}
+
+/**
+ * DecodeUtf8 - One code point from UTF-8
+ *
+ * Follows the well-formed byte sequences of the Unicode standard (table
+ * 3-7): the second byte's range excludes overlong forms (after E0 and F0),
+ * encoded surrogates (after ED) and code points above U+10FFFF (after F4).
+ *
+ * @return Bytes consumed (1 to 4), or 0 for a malformed or truncated sequence
+ */
+static FORCE_INLINE USIZE DecodeUtf8(const UINT8 *bytes, USIZE available, UINT32 &codePoint)
+{
+    UINT32 lead = bytes[0];
+    if (lead < 0x80)
+    {
+        codePoint = lead;
+        return 1;
+    }
+
+    USIZE size;
+    UINT32 low = 0x80;
+    UINT32 high = 0xBF;
+    if (lead < 0xC2)
+    {
+        // A continuation byte, or the lead of an overlong two-byte form
+        return 0;
+    }
+    else if (lead < 0xE0)
+    {
+        size = 2;
+        codePoint = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+        size = 3;
+        codePoint = lead & 0x0F;
+        if (lead == 0xE0)
+            low = 0xA0;
+        else if (lead == 0xED)
+            high = 0x9F;
+    }
+    else if (lead < 0xF5)
+    {
+        size = 4;
+        codePoint = lead & 0x07;
+        if (lead == 0xF0)
+            low = 0x90;
+        else if (lead == 0xF4)
+            high = 0x8F;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (size > available)
+        return 0;
+    UINT32 second = bytes[1];
+    if (second < low || second > high)
+        return 0;
+    codePoint = (codePoint << 6) | (second & 0x3F);
+    for (USIZE k = 2; k < size; k++)
+    {
+        UINT32 next = bytes[k];
+        if ((next & 0xC0) != 0x80)
+            return 0;
+        codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+    return size;
+}
+
+static FORCE_INLINE USIZE GetUtf8Size(UINT32 codePoint)
+{
+    if (codePoint < 0x80)
+        return 1;
+    if (codePoint < 0x800)
+        return 2;
+    return codePoint < 0x10000 ? 3 : 4;
+}
+
+static FORCE_INLINE VOID EncodeUtf8(UINT32 codePoint, USIZE size, PCHAR utf8)
+{
+    if (size == 1)
+    {
+        utf8[0] = (CHAR)codePoint;
+        return;
+    }
+
+    // Continuation bytes from the end, then the lead with its size marker
+    for (USIZE k = size - 1; k > 0; k--)
+    {
+        utf8[k] = (CHAR)(0x80 | (codePoint & 0x3F));
+        codePoint >>= 6;
+    }
+    utf8[0] = (CHAR)((0xF00 >> size) | codePoint);
+}
+
+SSIZE String::GetUtf8Length(PCWCHAR wide, USIZE length)
+{
+    USIZE i = 0;
+    USIZE bytes = 0;
+    while (i < length)
+    {
+        if (i + UTF_ASCII_BLOCK <= length && IsAsciiBlock(wide + i))
+        {
+            i += UTF_ASCII_BLOCK;
+            bytes += UTF_ASCII_BLOCK;
+            continue;
+        }
+
+        UINT32 codePoint;
+        USIZE units = DecodeWide(wide + i, length - i, codePoint);
+        if (units == 0)
+            return -1;
+        i += units;
+        bytes += GetUtf8Size(codePoint);
+    }
+    return (SSIZE)bytes;
+}
+
+SSIZE String::GetWideLength(PCCHAR utf8, USIZE length)
+{
+    USIZE i = 0;
+    USIZE units = 0;
+    while (i < length)
+    {
+        if (i + UTF_ASCII_BLOCK <= length && IsAsciiBlock(utf8 + i))
+        {
+            i += UTF_ASCII_BLOCK;
+            units += UTF_ASCII_BLOCK;
+            continue;
+        }
+
+        UINT32 codePoint;
+        USIZE bytes = DecodeUtf8((const UINT8 *)utf8 + i, length - i, codePoint);
+        if (bytes == 0)
+            return -1;
+        i += bytes;
+        units += codePoint < 0x10000 ? 1 : 2;
+    }
+    return (SSIZE)units;
+}
+
+SSIZE String::WideToUtf8(PCWCHAR wide, USIZE length, PCHAR utf8, USIZE capacity)
+{
+    USIZE i = 0;
+    USIZE written = 0;
+    while (i < length)
+    {
+        // ASCII runs: a block is checked, then narrowed a word of lanes at a time
+        if (i + UTF_ASCII_BLOCK <= length && written + UTF_ASCII_BLOCK <= capacity && IsAsciiBlock(wide + i))
+        {
+            for (USIZE k = 0; k < UTF_ASCII_BLOCK; k += SWAR_LANES)
+                Swar::Store(utf8 + written + k, Swar::LoadChars(wide + i + k));
+            i += UTF_ASCII_BLOCK;
+            written += UTF_ASCII_BLOCK;
+            continue;
+        }
+
+        UINT32 codePoint;
+        USIZE units = DecodeWide(wide + i, length - i, codePoint);
+        if (units == 0)
+            return -1;
+        USIZE size = GetUtf8Size(codePoint);
+        if (size > capacity - written)
+            return -1;
+        EncodeUtf8(codePoint, size, utf8 + written);
+        i += units;
+        written += size;
+    }
+    return (SSIZE)written;
+}
+
+SSIZE String::Utf8ToWide(PCCHAR utf8, USIZE length, PWCHAR wide, USIZE capacity)
+{
+    USIZE i = 0;
+    USIZE written = 0;
+    while (i < length)
+    {
+        if (i + UTF_ASCII_BLOCK <= length && written + UTF_ASCII_BLOCK <= capacity && IsAsciiBlock(utf8 + i))
+        {
+            for (USIZE k = 0; k < UTF_ASCII_BLOCK; k += SWAR_LANES)
+                Swar::StoreChars(wide + written + k, Swar::Load(utf8 + i + k));
+            i += UTF_ASCII_BLOCK;
+            written += UTF_ASCII_BLOCK;
+            continue;
+        }
+
+        UINT32 codePoint;
+        USIZE bytes = DecodeUtf8((const UINT8 *)utf8 + i, length - i, codePoint);
+        if (bytes == 0)
+            return -1;
+        if (codePoint < 0x10000)
+        {
+            if (written == capacity)
+                return -1;
+            wide[written++] = (WCHAR)codePoint;
+        }
+        else
+        {
+            if (capacity - written < 2)
+                return -1;
+            codePoint -= 0x10000;
+            wide[written++] = (WCHAR)(0xD800 + (codePoint >> 10));
+            wide[written++] = (WCHAR)(0xDC00 + (codePoint & 0x3FF));
+        }
+        i += bytes;
+    }
+    return (SSIZE)written;
+}
+
+USIZE String::WideToUtf8(PCWCHAR wide, PCHAR utf8, USIZE utf8BufferSize)
+{
+    if (!wide || !utf8 || utf8BufferSize == 0)
+        return 0;
+
+    SSIZE written = WideToUtf8(wide, Length(wide), utf8, utf8BufferSize - 1);
+    if (written < 0)
+        written = 0;
+    utf8[written] = '\0';
+    return (USIZE)written;
+}
@@ -0,0 +1,116 @@
+#include "synchronization.h"
+
+// Waiter node, lives on the stack of the parked thread
+typedef struct _MUTEX_WAITER
+{
+    USIZE ThreadId;
+    struct _MUTEX_WAITER *Next;
+    struct _MUTEX_WAITER *Tail; // Valid on the queue head only
+    Atomic<BOOL> ShouldPark;
+} MUTEX_WAITER, *PMUTEX_WAITER;
+
+static_assert(alignof(MUTEX_WAITER) > 2, "Waiter nodes must leave the flag bits free");
+
+// Spin rounds before queueing; each round yields so the holder can run
+static constexpr UINT32 MutexSpinLimit = 40;
+
+VOID Mutex::LockSlow()
+{
+    UINT32 spinCount = 0;
+
+    for (;;)
+    {
+        USIZE current = word.Load();
+
+        if (!(current & LockedBit))
+        {
+            if (word.CompareExchangeWeak(current, current | LockedBit, MemoryOrder::Acquire))
+                return;
+            continue;
+        }
+
+        // Spin only while nobody is queued, otherwise we would barge past sleepers forever
+        if (!(current & ~FlagsMask) && spinCount < MutexSpinLimit)
+        {
+            spinCount++;
+            Thread::Yield();
+            continue;
+        }
+
+        // Take the queue lock; give up and retry if the lock was released meanwhile
+        if ((current & QueueLockedBit) || !word.CompareExchangeWeak(current, current | QueueLockedBit))
+        {
+            Thread::Yield();
+            continue;
+        }
+
+        MUTEX_WAITER self;
+        self.ThreadId = Thread::GetCurrentId();
+        self.Next = NULL;
+        self.Tail = NULL;
+        self.ShouldPark.Store(TRUE, MemoryOrder::Relaxed);
+
+        // Append ourselves and drop the queue lock (the locked bit may have changed meanwhile)
+        current = word.Load();
+        PMUTEX_WAITER head = (PMUTEX_WAITER)(current & ~FlagsMask);
+        if (head != NULL)
+        {
+            head->Tail->Next = &self;
+            head->Tail = &self;
+            word.Store(current & ~QueueLockedBit);
+        }
+        else
+        {
+            self.Tail = &self;
+            word.Store((current | (USIZE)&self) & ~QueueLockedBit);
+        }
+
+        while (self.ShouldPark.Load(MemoryOrder::Acquire))
+            Thread::Park(&self);
+
+        // Woken: compete for the lock again
+    }
+}
+
+VOID Mutex::UnlockSlow()
+{
+    USIZE current;
+
+    // Either release an uncontended lock or take the queue lock
+    for (;;)
+    {
+        current = word.Load();
+
+        if (current == LockedBit)
+        {
+            if (word.CompareExchangeWeak(current, 0, MemoryOrder::Release))
+                return;
+            continue;
+        }
+
+        if (current & QueueLockedBit)
+        {
+            Thread::Yield();
+            continue;
+        }
+
+        if (word.CompareExchangeWeak(current, current | QueueLockedBit))
+            break;
+    }
+
+    // Dequeue the head and release both the lock and the queue lock in one store
+    current = word.Load();
+    PMUTEX_WAITER head = (PMUTEX_WAITER)(current & ~FlagsMask);
+    PMUTEX_WAITER next = head->Next;
+    if (next != NULL)
+        next->Tail = head->Tail;
+
+    word.Store((USIZE)next, MemoryOrder::Release);
+
+    // Read the id before signalling: the waiter's stack node is gone once it sees the flag
+    USIZE threadId = head->ThreadId;
+    head->Next = NULL;
+    head->Tail = NULL;
+    head->ShouldPark.Store(FALSE, MemoryOrder::Release);
+    Thread::Unpark(threadId);
+}
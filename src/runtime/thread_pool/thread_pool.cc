@@ -0,0 +1,246 @@
+#include "thread_pool.h"
+
+// Failed find rounds before a worker goes to sleep
+static constexpr UINT32 IdleSpinRounds = 64;
+
+BOOL ThreadPool::Start(UINT32 workerCount)
+{
+    if (workers != NULL)
+        return FALSE;
+
+    if (workerCount == 0)
+    {
+        UINT32 processors = Thread::GetProcessorCount();
+        workerCount = processors > 1 ? processors - 1 : 1;
+    }
+    if (workerCount > MaxParticipants - 1)
+        workerCount = MaxParticipants - 1;
+
+    participantCount = workerCount + 1;
+    workers = new WORKER[participantCount];
+    if (workers == NULL)
+    {
+        participantCount = 0;
+        return FALSE;
+    }
+
+    stopping.Store(FALSE);
+    sleeperCount.Store(0);
+
+    for (UINT32 i = 0; i < participantCount; i++)
+    {
+        workers[i].Pool = this;
+        workers[i].Index = i;
+        workers[i].Random = 0x9E3779B9u * (i + 1);
+        workers[i].ThreadId.Store(0);
+        workers[i].Sleeping.Store(FALSE);
+    }
+
+    // Participant 0 is the owning thread
+    workers[0].ThreadId.Store(Thread::GetCurrentId());
+
+    for (UINT32 i = 1; i < participantCount; i++)
+    {
+        if (!workers[i].Handle.Create(WorkerMain, &workers[i]))
+        {
+            // Run with the workers that did start
+            participantCount = i;
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+VOID ThreadPool::Stop()
+{
+    if (workers == NULL)
+        return;
+
+    stopping.Store(TRUE);
+    for (UINT32 i = 1; i < participantCount; i++)
+    {
+        workers[i].Sleeping.Store(FALSE);
+        USIZE threadId = workers[i].ThreadId.Load();
+        if (threadId != 0)
+            Thread::Unpark(threadId);
+    }
+
+    for (UINT32 i = 1; i < participantCount; i++)
+    {
+        if (workers[i].Handle.IsJoinable())
+            workers[i].Handle.Join();
+    }
+
+    delete[] workers;
+    workers = NULL;
+    participantCount = 0;
+}
+
+INT32 ThreadPool::FindParticipant() const
+{
+    USIZE threadId = Thread::GetCurrentId();
+    for (UINT32 i = 0; i < participantCount; i++)
+    {
+        if (workers[i].ThreadId.Load(MemoryOrder::Relaxed) == threadId)
+            return (INT32)i;
+    }
+    return -1;
+}
+
+VOID ThreadPool::RunTask(PTASK task)
+{
+    task->Invoke(task);
+    // Last access to the task: its owner may return as soon as pending drops
+    if (task->Group != NULL)
+        task->Group->pending.FetchSub(1, MemoryOrder::Release);
+}
+
+PTASK ThreadPool::FindTask(WORKER &self)
+{
+    PTASK task = self.Deque.Take();
+    if (task != NULL)
+        return task;
+
+    // Start at a random victim so thieves spread over the pool (xorshift32)
+    UINT32 x = self.Random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    self.Random = x;
+
+    UINT32 start = x % participantCount;
+    for (UINT32 i = 0; i < participantCount; i++)
+    {
+        UINT32 victim = start + i;
+        if (victim >= participantCount)
+            victim -= participantCount;
+        if (victim == self.Index)
+            continue;
+
+        task = workers[victim].Deque.Steal();
+        if (task != NULL)
+            return task;
+    }
+    return NULL;
+}
+
+BOOL ThreadPool::HasVisibleWork() const
+{
+    for (UINT32 i = 0; i < participantCount; i++)
+    {
+        if (!workers[i].Deque.IsEmpty())
+            return TRUE;
+    }
+    return FALSE;
+}
+
+VOID ThreadPool::WakeOne()
+{
+    if (sleeperCount.Load() == 0)
+        return;
+
+    for (UINT32 i = 1; i < participantCount; i++)
+    {
+        BOOL expected = TRUE;
+        if (workers[i].Sleeping.CompareExchangeStrong(expected, FALSE))
+        {
+            Thread::Unpark(workers[i].ThreadId.Load());
+            return;
+        }
+    }
+}
+
+VOID ThreadPool::Spawn(PTASK task)
+{
+    INT32 index = workers != NULL ? FindParticipant() : -1;
+    if (index < 0 || !workers[index].Deque.Push(task))
+    {
+        // Foreign thread or full deque: keep the program correct, just serial
+        RunTask(task);
+        return;
+    }
+
+    // Pairs with the fence in WorkerMain: either we see the sleeper or it sees the task
+    AtomicThreadFence(MemoryOrder::SequentiallyConsistent);
+    WakeOne();
+}
+
+BOOL ThreadPool::RunPendingTask()
+{
+    INT32 index = workers != NULL ? FindParticipant() : -1;
+    if (index < 0)
+        return FALSE;
+
+    PTASK task = FindTask(workers[index]);
+    if (task == NULL)
+        return FALSE;
+
+    RunTask(task);
+    return TRUE;
+}
+
+INT32 ThreadPool::WorkerMain(PVOID parameter)
+{
+    WORKER &self = *(WORKER *)parameter;
+    ThreadPool &pool = *self.Pool;
+
+    self.ThreadId.Store(Thread::GetCurrentId());
+
+    UINT32 idleRounds = 0;
+    while (!pool.stopping.Load(MemoryOrder::Acquire))
+    {
+        PTASK task = pool.FindTask(self);
+        if (task != NULL)
+        {
+            RunTask(task);
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < IdleSpinRounds)
+        {
+            CpuRelax();
+            continue;
+        }
+
+        // Announce sleep, then re-check so a concurrent Spawn cannot be missed
+        self.Sleeping.Store(TRUE);
+        pool.sleeperCount.FetchAdd(1);
+        AtomicThreadFence(MemoryOrder::SequentiallyConsistent);
+
+        if (pool.HasVisibleWork() || pool.stopping.Load())
+        {
+            self.Sleeping.Store(FALSE);
+        }
+        else
+        {
+            while (self.Sleeping.Load(MemoryOrder::Acquire))
+                Thread::Park(&self);
+        }
+
+        pool.sleeperCount.FetchSub(1);
+        idleRounds = 0;
+    }
+
+    return 0;
+}
+
+VOID TaskGroup::Wait(ThreadPool &pool)
+{
+    UINT32 idleRounds = 0;
+    while (pending.Load(MemoryOrder::Acquire) != 0)
+    {
+        if (pool.RunPendingTask())
+        {
+            idleRounds = 0;
+            continue;
+        }
+
+        // Remaining tasks are running elsewhere
+        if (++idleRounds < IdleSpinRounds)
+            CpuRelax();
+        else
+            Thread::Yield();
+    }
+}
@@ -3,57 +3,163 @@
  */
 
 #include "runtime.h"
+#if defined(BENCH)
+#include "benchmarks.h"
+#else
 #include "tests.h"
+#endif
 
-ENTRYPOINT INT32 _start(VOID)
+#if defined(BENCH)
+
+// BENCH builds replace the test suites with the benchmark harness
+static BOOL RunBenchmarks()
 {
-	ENVIRONMENT_DATA envData;
-	Initialize(&envData);
+	LOG_INFO("=== CPP-PIC Benchmarks ===");
+	BOOL allRan = Benchmarks::RunAll();
+	LOG_INFO("=== Benchmarks Complete ===");
+	return allRan;
+}
+
+#else
 
+static BOOL RunTests()
+{
 	BOOL allPassed = TRUE;
 
-	Logger::Info<WCHAR>(L"=== CPP-PIC Test Suite ==="_embed);
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("=== CPP-PIC Test Suite ===");
+	LOG_INFO("");
 
 	// Run all test suites
 	if (!Djb2Tests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!MemoryTests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!StringTests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!Uint64Tests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!Int64Tests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!DoubleTests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
 
 	if (!StringFormatterTests::RunAll())
 		allPassed = FALSE;
-	Logger::Info<WCHAR>(L""_embed);
+	LOG_INFO("");
+
+	if (!ThreadTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!ThreadContextTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!SynchronizationTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!ThreadPoolTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!QueueTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!CoroutineTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!AsyncIoTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!FileTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!MappedFileTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!TimerTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!Lz4Tests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!EncodingTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!ChecksumTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!ShaTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!VectorTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!HashMapTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!BasicStringTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
+
+	if (!SortTests::RunAll())
+		allPassed = FALSE;
+	LOG_INFO("");
 
 	// Final summary
-	Logger::Info<WCHAR>(L"=== Test Suite Complete ==="_embed);
+	LOG_INFO("=== Test Suite Complete ===");
 	if (allPassed)
 	{
-		Logger::Info<WCHAR>(L"ALL TESTS PASSED!"_embed);
+		LOG_INFO("ALL TESTS PASSED!");
 	}
 	else
 	{
-		Logger::Error<WCHAR>(L"SOME TESTS FAILED!"_embed);
+		LOG_ERROR("SOME TESTS FAILED!");
 	}
 
+	return allPassed;
+}
+
+#endif
+
+ENTRYPOINT INT32 _start(VOID)
+{
+	ENVIRONMENT_DATA envData;
+	Initialize(&envData);
+
+	THREAD_CONTEXT threadContext;
+	ThreadContext::Attach(&threadContext);
+
+#if defined(BENCH)
+	BOOL allPassed = RunBenchmarks();
+#else
+	BOOL allPassed = RunTests();
+#endif
+
+	ThreadContext::Detach();
 	ExitProcess(allPassed ? 0 : 1);
 }
@@ -0,0 +1,156 @@
+/**
+ * start.cc - Self-Decompressing Stub for Packed Blobs
+ *
+ * Built with -DPACK=ON as a second executable from the runtime sources
+ * (everything in src/ except src/start.cc). scripts/pack.ps1 appends the
+ * LZ4-compressed output.bin to the stub's .text:
+ *
+ *   [stub code][zero padding to 4 bytes][PACKED_BLOB_HEADER][LZ4 block]
+ *
+ * StubEnd is linked last in the stub's .text, so the stub looks for the
+ * header only in the few bytes past it and never reads beyond its own
+ * image plus the header. It then decompresses the payload into fresh
+ * pages, makes them executable and calls the payload's _start, which never
+ * returns. Like the payload it is .rdata-free and position-independent, so
+ * output.packed.bin loads exactly like output.bin.
+ *
+ * EXIT CODES (the payload never started):
+ *   PACK_EXIT_NO_HEADER - No header within PACK_STUB_TAIL_MAX of StubEnd
+ *   PACK_EXIT_NO_MEMORY - Pages for the payload could not be allocated
+ *   PACK_EXIT_CORRUPT   - The block did not decode to the recorded size
+ *
+ * BENCH builds print benchmark lines (see benchmarks/bench.h) before the
+ * payload starts: the cold decompression, the cold stub entry to payload
+ * entry time, and warm decompression throughput.
+ */
+
+#include "runtime.h"
+#include "ntdll.h"
+#if defined(BENCH)
+#include "bench.h"
+#endif
+
+// 'PCK1'
+#define PACK_MAGIC 0x314B4350
+// The header is searched for this far past StubEnd: its own body plus the padding to 4 bytes
+#define PACK_STUB_TAIL_MAX 32
+
+#define PACK_EXIT_NO_HEADER 0xE1
+#define PACK_EXIT_NO_MEMORY 0xE2
+#define PACK_EXIT_CORRUPT 0xE3
+
+// Written by scripts/pack.ps1 (little-endian)
+typedef struct _PACKED_BLOB_HEADER
+{
+	UINT32 Magic;        // PACK_MAGIC
+	UINT32 MagicCheck;   // ~PACK_MAGIC; the pair does not occur in the stub's own code
+	UINT32 PackedSize;   // Size of the LZ4 block that follows
+	UINT32 UnpackedSize; // Size of the original output.bin
+} PACKED_BLOB_HEADER, *PPACKED_BLOB_HEADER;
+
+static_assert(sizeof(PACKED_BLOB_HEADER) == 16, "The header layout is shared with scripts/pack.ps1");
+
+// lld keeps a non-COMDAT ".text$zz" section after every ".text" function, so this marks the end of the stub
+__attribute__((section(".text$zz"), used)) NOINLINE static VOID StubEnd(VOID)
+{
+}
+
+static PPACKED_BLOB_HEADER FindHeader(PVOID stubEnd)
+{
+	PUINT8 cursor = (PUINT8)(((USIZE)stubEnd + 3) & ~(USIZE)3);
+	for (USIZE scanned = 0; scanned < PACK_STUB_TAIL_MAX; scanned += 4, cursor += 4)
+	{
+		PPACKED_BLOB_HEADER header = (PPACKED_BLOB_HEADER)cursor;
+		if (header->Magic == PACK_MAGIC && (header->Magic ^ header->MagicCheck) == 0xFFFFFFFF)
+			return header;
+	}
+	return NULL;
+}
+
+#if defined(BENCH)
+
+// One cold measurement in the harness's output format
+static VOID ReportOnce(const WCHAR *name, UINT64 cycles, USIZE bytes)
+{
+	BENCH_RESULT result;
+	UINT64 picoseconds = Timer::CyclesToNanoseconds(cycles) * 1000U;
+	result.Iterations = 1;
+	result.Samples = 1;
+	result.MinimumPs = picoseconds;
+	result.MedianPs = picoseconds;
+	result.P99Ps = picoseconds;
+	result.MeanPs = picoseconds;
+	Bench::Report(name, result, bytes);
+}
+
+#endif
+
+ENTRYPOINT INT32 _start(VOID)
+{
+#if defined(BENCH)
+	UINT64 entryCycles = Timer::ReadCycles();
+#endif
+
+	ENVIRONMENT_DATA envData;
+	Initialize(&envData);
+
+	PPACKED_BLOB_HEADER header = FindHeader(PerformRelocation((PVOID)StubEnd));
+	if (header == NULL)
+		ExitProcess(PACK_EXIT_NO_HEADER);
+
+	PVOID payload = NULL;
+	USIZE regionSize = header->UnpackedSize;
+	if (!NT_SUCCESS(NTDLL::NtAllocateVirtualMemory(NTDLL::NtCurrentProcess(), &payload, 0, &regionSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+		ExitProcess(PACK_EXIT_NO_MEMORY);
+
+#if defined(BENCH)
+	UINT64 decompressStart = Timer::ReadCycles();
+#endif
+
+	SSIZE written = Lz4::Decompress(header + 1, header->PackedSize, payload, header->UnpackedSize);
+	if (written != (SSIZE)header->UnpackedSize)
+		ExitProcess(PACK_EXIT_CORRUPT);
+
+#if defined(BENCH)
+	UINT64 decompressCycles = Timer::ReadCycles() - decompressStart;
+#endif
+
+	// W^X: the pages are never writable and executable at the same time
+	UINT32 oldProtect;
+	PVOID protectBase = payload;
+	if (!NT_SUCCESS(NTDLL::NtProtectVirtualMemory(NTDLL::NtCurrentProcess(), &protectBase, &regionSize, PAGE_EXECUTE_READ, &oldProtect)))
+		ExitProcess(PACK_EXIT_NO_MEMORY);
+	NTDLL::NtFlushInstructionCache(NTDLL::NtCurrentProcess(), payload, header->UnpackedSize);
+
+#if defined(BENCH)
+	// Everything the raw blob does not pay for before its _start runs
+	UINT64 readyCycles = Timer::ReadCycles() - entryCycles;
+
+	THREAD_CONTEXT threadContext;
+	ThreadContext::Attach(&threadContext);
+
+	ReportOnce(L"pack.decompress_cold"_embed, decompressCycles, header->UnpackedSize);
+	ReportOnce(L"pack.time_to_start"_embed, readyCycles, 0);
+
+	// Warm throughput, into a scratch buffer since the payload pages are no longer writable
+	PVOID scratch = Allocator::AllocateMemory(header->UnpackedSize);
+	if (scratch != NULL)
+	{
+		auto decompress = [header, scratch](USIZE iterations)
+		{
+			for (USIZE i = 0; i < iterations; i++)
+				Lz4::Decompress(header + 1, header->PackedSize, scratch, header->UnpackedSize);
+			ClobberMemory();
+		};
+		Bench bench;
+		bench.Run(L"pack.decompress"_embed, decompress, header->UnpackedSize);
+		Allocator::ReleaseMemory(scratch, header->UnpackedSize);
+	}
+
+	ThreadContext::Detach();
+#endif
+
+	// The payload's _start is at offset 0 and exits the process itself
+	((VOID(*)(VOID))payload)();
+	__builtin_unreachable();
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "runtime.h"
+
+class AsyncIoTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running AsyncIo Tests..."_embed);
+
+		// Test 1: A batch of writes and reads at distinct offsets round-trips
+		if (!TestBatchedReadWrite())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Batched read/write"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Batched read/write"_embed);
+		}
+
+		// Test 2: The submission queue has a fixed depth and drains fully
+		if (!TestQueueDepth())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Queue depth and polling"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Queue depth and polling"_embed);
+		}
+
+		// Test 3: Flush completes and reads past the end return no data
+		if (!TestFlushAndEndOfFile())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Flush and end of file"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Flush and end of file"_embed);
+		}
+
+		// Test 4: Registered buffers are page aligned and usable for I/O
+		if (!TestRegisteredBuffers())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Registered buffers"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Registered buffers"_embed);
+		}
+
+		// Test 5: Coroutines await I/O through the executor's poll routine
+		if (!TestCoroutineIo())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Coroutine I/O"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Coroutine I/O"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All AsyncIo tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some AsyncIo tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr UINT32 BlockSize = 4096;
+	static constexpr USIZE BlockCount = 8;
+
+	static PVOID OpenScratchFile(AsyncIo &io)
+	{
+		return io.OpenFile(L"async_io_test.tmp"_embed, ASYNC_FILE_READ | ASYNC_FILE_WRITE | ASYNC_FILE_CREATE | ASYNC_FILE_TEMPORARY);
+	}
+
+	static VOID FillBlock(PUINT8 block, UINT32 length, USIZE seed)
+	{
+		for (UINT32 i = 0; i < length; i++)
+			block[i] = (UINT8)(seed * 31 + i);
+	}
+
+	// Poll until count requests finished; FALSE if any of them failed
+	static BOOL Drain(AsyncIo &io, USIZE count)
+	{
+		PASYNC_REQUEST completed[ASYNC_IO_REAP_BATCH];
+		BOOL success = TRUE;
+		while (count > 0)
+		{
+			USIZE reaped = io.Poll(completed, ASYNC_IO_REAP_BATCH, TRUE);
+			if (reaped == 0)
+				return FALSE;
+			for (USIZE i = 0; i < reaped; i++)
+				success = success && completed[i]->Status == 0;
+			count -= reaped;
+		}
+		return success;
+	}
+
+	static BOOL TestBatchedReadWrite()
+	{
+		AsyncIo io;
+		if (!io.Create())
+			return FALSE;
+		PVOID file = OpenScratchFile(io);
+		if (file == NULL)
+			return FALSE;
+
+		PUINT8 source = new UINT8[BlockSize * BlockCount];
+		PUINT8 target = new UINT8[BlockSize * BlockCount];
+		ASYNC_REQUEST *requests = new ASYNC_REQUEST[BlockCount];
+		Memory::Zero(target, BlockSize * BlockCount);
+
+		// Blocks are written in reverse order to exercise explicit offsets
+		for (USIZE i = 0; i < BlockCount; i++)
+		{
+			USIZE block = BlockCount - 1 - i;
+			FillBlock(source + block * BlockSize, BlockSize, block);
+			AsyncIo::PrepareWrite(requests[i], file, source + block * BlockSize, BlockSize, UINT64((UINT32)(block * BlockSize)), NULL);
+			io.Queue(&requests[i]);
+		}
+		BOOL result = io.GetQueuedCount() == BlockCount && io.Submit() == BlockCount && Drain(io, BlockCount);
+
+		for (USIZE i = 0; i < BlockCount; i++)
+		{
+			AsyncIo::PrepareRead(requests[i], file, target + i * BlockSize, BlockSize, UINT64((UINT32)(i * BlockSize)), (PVOID)i);
+			io.Queue(&requests[i]);
+		}
+		io.Submit();
+		result = result && Drain(io, BlockCount);
+
+		for (USIZE i = 0; i < BlockCount; i++)
+			result = result && requests[i].BytesTransferred == BlockSize && requests[i].UserData == (PVOID)i;
+		result = result && Memory::Compare(source, target, BlockSize * BlockCount) == 0;
+
+		AsyncIo::CloseFile(file);
+		delete[] requests;
+		delete[] source;
+		delete[] target;
+		return result;
+	}
+
+	static BOOL TestQueueDepth()
+	{
+		AsyncIo io;
+		if (!io.Create())
+			return FALSE;
+		PVOID file = OpenScratchFile(io);
+		if (file == NULL)
+			return FALSE;
+
+		UINT8 data[64];
+		FillBlock(data, sizeof(data), 7);
+		ASYNC_REQUEST *requests = new ASYNC_REQUEST[ASYNC_IO_QUEUE_DEPTH + 1];
+
+		BOOL result = TRUE;
+		for (USIZE i = 0; i < ASYNC_IO_QUEUE_DEPTH; i++)
+		{
+			AsyncIo::PrepareWrite(requests[i], file, data, sizeof(data), UINT64((UINT32)(i * sizeof(data))), NULL);
+			result = result && io.Queue(&requests[i]);
+		}
+		AsyncIo::PrepareWrite(requests[ASYNC_IO_QUEUE_DEPTH], file, data, sizeof(data), UINT64(), NULL);
+		result = result && !io.Queue(&requests[ASYNC_IO_QUEUE_DEPTH]);
+
+		result = result && io.Submit() == ASYNC_IO_QUEUE_DEPTH && io.GetQueuedCount() == 0;
+		result = result && Drain(io, ASYNC_IO_QUEUE_DEPTH) && io.GetInFlightCount() == 0;
+
+		// Nothing outstanding: a blocking poll returns at once
+		PASYNC_REQUEST completed[1];
+		result = result && io.Poll(completed, 1, TRUE) == 0;
+
+		AsyncIo::CloseFile(file);
+		delete[] requests;
+		return result;
+	}
+
+	static BOOL TestFlushAndEndOfFile()
+	{
+		AsyncIo io;
+		if (!io.Create())
+			return FALSE;
+		PVOID file = OpenScratchFile(io);
+		if (file == NULL)
+			return FALSE;
+
+		UINT8 data[100];
+		FillBlock(data, sizeof(data), 3);
+		ASYNC_REQUEST write;
+		ASYNC_REQUEST flush;
+		AsyncIo::PrepareWrite(write, file, data, sizeof(data), UINT64(), NULL);
+		AsyncIo::PrepareFlush(flush, file, NULL);
+		io.Queue(&write);
+		io.Submit();
+		BOOL result = Drain(io, 1);
+		io.Queue(&flush);
+		io.Submit();
+		result = result && Drain(io, 1) && flush.Status == 0;
+
+		// Short read at the tail, empty read beyond it
+		UINT8 buffer[64];
+		ASYNC_REQUEST tail;
+		ASYNC_REQUEST beyond;
+		AsyncIo::PrepareRead(tail, file, buffer, sizeof(buffer), UINT64((UINT32)60), NULL);
+		AsyncIo::PrepareRead(beyond, file, buffer, sizeof(buffer), UINT64((UINT32)4096), NULL);
+		io.Queue(&tail);
+		io.Queue(&beyond);
+		io.Submit();
+		result = result && Drain(io, 2);
+		result = result && tail.BytesTransferred == 40 && beyond.BytesTransferred == 0 && beyond.Status == 0;
+
+		AsyncIo::CloseFile(file);
+		return result;
+	}
+
+	static BOOL TestRegisteredBuffers()
+	{
+		AsyncIo io;
+		if (!io.Create() || !io.RegisterBuffers(2, 1000))
+			return FALSE;
+
+		PUINT8 first = (PUINT8)io.GetRegisteredBuffer(0);
+		PUINT8 second = (PUINT8)io.GetRegisteredBuffer(1);
+		if (first == NULL || second == NULL || io.GetRegisteredBuffer(2) != NULL ||
+			((USIZE)first & 4095) != 0 || ((USIZE)second & 4095) != 0 || io.GetRegisteredBufferSize() != 4096)
+			return FALSE;
+
+		PVOID file = OpenScratchFile(io);
+		if (file == NULL)
+			return FALSE;
+
+		FillBlock(first, BlockSize, 11);
+		Memory::Zero(second, BlockSize);
+		ASYNC_REQUEST request;
+		AsyncIo::PrepareWrite(request, file, first, BlockSize, UINT64(), NULL);
+		io.Queue(&request);
+		io.Submit();
+		BOOL result = Drain(io, 1);
+		AsyncIo::PrepareRead(request, file, second, BlockSize, UINT64(), NULL);
+		io.Queue(&request);
+		io.Submit();
+		result = result && Drain(io, 1) && Memory::Compare(first, second, BlockSize) == 0;
+
+		AsyncIo::CloseFile(file);
+		io.UnregisterBuffers();
+		return result && io.GetRegisteredBuffer(0) == NULL;
+	}
+
+	static Task<VOID> CopyBlock(AsyncIo &io, PVOID file, USIZE index, PUSIZE verified)
+	{
+		UINT8 out[256];
+		UINT8 in[256];
+		FillBlock(out, sizeof(out), index);
+		UINT64 offset((UINT32)(index * sizeof(out)));
+
+		ASYNC_RESULT written = co_await io.Write(file, out, sizeof(out), offset);
+		if (written.Status != 0 || written.BytesTransferred != sizeof(out))
+			co_return;
+		ASYNC_RESULT read = co_await io.Read(file, in, sizeof(in), offset);
+		if (read.Status == 0 && read.BytesTransferred == sizeof(in) && Memory::Compare(out, in, sizeof(in)) == 0)
+			(*verified)++;
+	}
+
+	static BOOL TestCoroutineIo()
+	{
+		AsyncIo io;
+		if (!io.Create())
+			return FALSE;
+		PVOID file = OpenScratchFile(io);
+		if (file == NULL)
+			return FALSE;
+
+		USIZE verified = 0;
+		BOOL result;
+		{
+			Executor executor;
+			executor.SetPoller(AsyncIo::PollExecutor, &io);
+			for (USIZE i = 0; i < 6; i++)
+				executor.Spawn(CopyBlock(io, file, i, &verified));
+			result = executor.Run();
+		}
+
+		AsyncIo::CloseFile(file);
+		return result && verified == 6;
+	}
+};
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "runtime.h"
+
+class BasicStringTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running BasicString Tests..."_embed);
+
+		// Test 1: Up to the inline capacity the text stays inside the object
+		if (!TestInlineStorage())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Inline storage"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Inline storage"_embed);
+		}
+
+		// Test 2: Appending past it moves to the heap and doubles
+		if (!TestGrowth())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Growth"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Growth"_embed);
+		}
+
+		// Test 3: Format appends StringFormatter output
+		if (!TestFormat())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Format"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Format"_embed);
+		}
+
+		// Test 4: Moves, assignment and relocation inside a Vector
+		if (!TestMove())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Move"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Move"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All BasicString tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some BasicString tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static BOOL TestInlineStorage()
+	{
+		NarrowString text;
+		if (!text.IsEmpty() || !text.IsInline() || text.GetData()[0] != '\0')
+			return FALSE;
+
+		// 23 units fill the inline storage exactly
+		auto full = "abcdefghijklmnopqrstuvw"_embed;
+		if (!text.Append((const CHAR *)full) || text.GetLength() != 23 || !text.IsInline())
+			return FALSE;
+		const UINT8 *self = (const UINT8 *)&text;
+		const UINT8 *data = (const UINT8 *)text.GetData();
+		if (data < self || data >= self + sizeof(text) || text.GetData()[23] != '\0')
+			return FALSE;
+		if (!text.Equals((const CHAR *)full, 23) || text[22] != 'w')
+			return FALSE;
+
+		// The same for wide text, one unit at a time
+		WideString wide;
+		for (UINT32 i = 0; i < BASIC_STRING_INLINE_CAPACITY; i++)
+		{
+			if (!wide.Append((WCHAR)(L'A' + i)))
+				return FALSE;
+		}
+		auto expected = L"ABCDEFGHIJKLMNOPQRSTUVW"_embed;
+		return wide.IsInline() && wide.Equals((const WCHAR *)expected, 23) && wide.GetData()[23] == L'\0';
+	}
+
+	static BOOL TestGrowth()
+	{
+		NarrowString text;
+		for (UINT32 i = 0; i < 24; i++)
+			text.Append((CHAR)('a' + i % 26));
+		if (text.IsInline() || text.GetCapacity() != 46 || text.GetLength() != 24 || text[23] != 'x')
+			return FALSE;
+
+		// Many appends: the length is tracked, the capacity doubles, the text stays terminated
+		for (UINT32 i = 24; i < 10000; i++)
+		{
+			if (!text.Append((CHAR)('a' + i % 26)))
+				return FALSE;
+		}
+		if (text.GetLength() != 10000 || text.GetCapacity() < 10000 || text.GetCapacity() > 20000)
+			return FALSE;
+		for (UINT32 i = 0; i < 10000; i++)
+		{
+			if (text[i] != (CHAR)('a' + i % 26))
+				return FALSE;
+		}
+		if (text.GetData()[10000] != '\0' || String::Length(text.GetData()) != 10000)
+			return FALSE;
+
+		// Truncate and Clear keep the block
+		USIZE capacity = text.GetCapacity();
+		text.Truncate(5);
+		auto head = "abcde"_embed;
+		if (!text.Equals((const CHAR *)head, 5) || text.GetCapacity() != capacity)
+			return FALSE;
+		text.Clear();
+		if (!text.IsEmpty() || text.GetData()[0] != '\0')
+			return FALSE;
+
+		// Reserve, then Assign and Append whole strings without growing
+		WideString wide;
+		if (!wide.Reserve(100) || wide.IsInline() || wide.GetCapacity() != 100)
+			return FALSE;
+		auto part = L"0123456789"_embed;
+		wide.Assign((const WCHAR *)part);
+		for (UINT32 i = 0; i < 9; i++)
+		{
+			if (!wide.Append((const WCHAR *)part, 10))
+				return FALSE;
+		}
+		return wide.GetLength() == 100 && wide.GetCapacity() == 100 && wide[99] == L'9' && wide.GetData()[100] == L'\0';
+	}
+
+	static BOOL TestFormat()
+	{
+		// Short output never leaves the object
+		NarrowString text;
+		auto format = "%d-%u-%X"_embed;
+		if (!text.Format((const CHAR *)format, -42, 7U, 0xBEEFU) || !text.IsInline())
+			return FALSE;
+		auto expected = "-42-7-BEEF"_embed;
+		if (!text.Equals((const CHAR *)expected, 10))
+			return FALSE;
+
+		// Format appends to what is already there
+		WideString path;
+		auto directory = L"C:\\Temp"_embed;
+		auto name = L"report"_embed;
+		auto suffix = L"\\%ls_%03d.log"_embed;
+		path.Append((const WCHAR *)directory);
+		if (!path.Format((const WCHAR *)suffix, (const WCHAR *)name, 7))
+			return FALSE;
+		auto expectedPath = L"C:\\Temp\\report_007.log"_embed;
+		if (!path.Equals((const WCHAR *)expectedPath, 22) || !path.IsInline())
+			return FALSE;
+
+		// Long output moves to the heap mid-format
+		NarrowString longText;
+		auto repeated = "%s%s%s%s"_embed;
+		auto piece = "0123456789abcdef"_embed;
+		const CHAR *p = (const CHAR *)piece;
+		if (!longText.Format((const CHAR *)repeated, p, p, p, p) || longText.IsInline() || longText.GetLength() != 64)
+			return FALSE;
+		return longText[63] == 'f' && longText.GetData()[64] == '\0';
+	}
+
+	static BOOL TestMove()
+	{
+		auto longPiece = "a string well past the inline capacity"_embed;
+		NarrowString source;
+		source.Append((const CHAR *)longPiece);
+		const CHAR *block = source.GetData();
+
+		// A heap block changes owner without copying
+		NarrowString target(Move(source));
+		if (target.GetData() != block || !source.IsEmpty() || !source.IsInline() || source.GetData()[0] != '\0')
+			return FALSE;
+
+		// Inline text is copied into the target
+		auto shortPiece = "short"_embed;
+		NarrowString shortText;
+		shortText.Append((const CHAR *)shortPiece);
+		target = Move(shortText);
+		if (!target.IsInline() || !target.Equals((const CHAR *)shortPiece, 5) || !shortText.IsEmpty())
+			return FALSE;
+
+		// Vectors relocate strings as plain bytes; inline text must survive that
+		Vector<WideString> names;
+		for (UINT32 i = 0; i < 50; i++)
+		{
+			WideString name;
+			auto format = L"name%u"_embed;
+			name.Format((const WCHAR *)format, i);
+			if (i % 10 == 0)
+			{
+				auto padding = L" padded out past twenty-three units"_embed;
+				name.Append((const WCHAR *)padding);
+			}
+			names.Push(Move(name));
+		}
+		auto expected = L"name49"_embed;
+		auto expectedLong = L"name40 padded out past twenty-three units"_embed;
+		return names[49].Equals((const WCHAR *)expected, 6) && names[49].IsInline() &&
+			   names[40].Equals((const WCHAR *)expectedLong, 41) && !names[40].IsInline();
+	}
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "runtime.h"
+
+class ChecksumTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Checksum Tests..."_embed);
+
+		// Test 1: CRC-32C check value and RFC 3720 vectors
+		if (!TestCrc32cVectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: CRC32C vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: CRC32C vectors"_embed);
+		}
+
+		// Test 2: Buffers long enough for the interleaved path, whole and in pieces
+		if (!TestCrc32cLarge())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: CRC32C large buffers"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: CRC32C large buffers"_embed);
+		}
+
+		// Test 3: Slicing tables generated into an arena
+		if (!TestCrc32cTable())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: CRC32C table"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: CRC32C table"_embed);
+		}
+
+		// Test 4: XXH64 against the reference implementation
+		if (!TestXxHash64Vectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: XXH64 vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: XXH64 vectors"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Checksum tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Checksum tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Spans three 2 KB interleaved blocks twice, plus a tail that is not a whole word
+	static constexpr USIZE LargeSize = 6 * 2048 * 2 + 37;
+
+	// One bit at a time, straight from the definition
+	static UINT32 ReferenceCrc32c(const UINT8 *data, USIZE size)
+	{
+		UINT32 crc = 0xFFFFFFFF;
+		for (USIZE i = 0; i < size; i++)
+		{
+			crc ^= data[i];
+			for (UINT32 bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0 - (crc & 1)));
+		}
+		return ~crc;
+	}
+
+	static BOOL TestCrc32cVectors()
+	{
+		if (Crc32c::Compute((const CHAR *)"123456789"_embed, 9) != 0xE3069283)
+			return FALSE;
+		if (Crc32c::Compute(NULL, 0) != 0)
+			return FALSE;
+
+		UINT8 data[32];
+		Memory::Zero(data, sizeof(data));
+		if (Crc32c::Compute(data, sizeof(data)) != 0x8A9136AA)
+			return FALSE;
+		Memory::Set(data, 0xFF, sizeof(data));
+		if (Crc32c::Compute(data, sizeof(data)) != 0x62A8AB43)
+			return FALSE;
+		for (UINT32 i = 0; i < 32; i++)
+			data[i] = (UINT8)i;
+		if (Crc32c::Compute(data, sizeof(data)) != 0x46DD794E)
+			return FALSE;
+		for (UINT32 i = 0; i < 32; i++)
+			data[i] = (UINT8)(31 - i);
+		return Crc32c::Compute(data, sizeof(data)) == 0x113FDB5C;
+	}
+
+	static BOOL TestCrc32cLarge()
+	{
+		PUINT8 data = new UINT8[LargeSize];
+		UINT32 state = 0x1B873593;
+		for (USIZE i = 0; i < LargeSize; i++)
+		{
+			state = state * 1664525 + 1013904223;
+			data[i] = (UINT8)(state >> 24);
+		}
+
+		BOOL passed = TRUE;
+		UINT32 expected = ReferenceCrc32c(data, LargeSize);
+		if (Crc32c::Compute(data, LargeSize) != expected)
+			passed = FALSE;
+
+		// Any split, including ones that leave the interleaved path mid-buffer, continues the same CRC
+		for (USIZE split = 0; split <= LargeSize && passed; split += 1021)
+		{
+			UINT32 crc = Crc32c::Compute(data, split);
+			if (Crc32c::Compute(data + split, LargeSize - split, crc) != expected)
+				passed = FALSE;
+		}
+
+		// The instruction choice passed in: both paths give the same CRC
+		BOOL hardware = Crc32c::IsHardwareAvailable();
+		if (Crc32c::Compute(data, LargeSize, 0, FALSE) != expected || Crc32c::Compute(data, LargeSize, 0, hardware) != expected)
+			passed = FALSE;
+
+		// Unaligned starts and every short length
+		for (USIZE offset = 1; offset < 8 && passed; offset++)
+		{
+			if (Crc32c::Compute(data + offset, LargeSize - offset) != ReferenceCrc32c(data + offset, LargeSize - offset))
+				passed = FALSE;
+		}
+		for (USIZE size = 0; size < 64 && passed; size++)
+		{
+			if (Crc32c::Compute(data + 3, size) != ReferenceCrc32c(data + 3, size))
+				passed = FALSE;
+		}
+
+		delete[] data;
+		return passed;
+	}
+
+	static BOOL TestCrc32cTable()
+	{
+		Arena arena;
+		if (!arena.InitializeHeap(CRC32C_TABLE_ENTRIES * sizeof(UINT32)))
+			return FALSE;
+
+		const UINT32 *table = Crc32c::BuildTable(arena);
+		if (table == NULL || arena.GetUsed() != CRC32C_TABLE_ENTRIES * sizeof(UINT32))
+			return FALSE;
+
+		// Byte table entries, and slice 1 of byte 1 (one zero byte further)
+		if (table[0] != 0 || table[1] != 0xF26B8303 || table[128] != 0x82F63B78 || table[255] != 0xAD7D5351)
+			return FALSE;
+		if (table[256 + 1] != ((table[1] >> 8) ^ table[table[1] & 0xFF]))
+			return FALSE;
+
+		// A full arena yields NULL
+		return Crc32c::BuildTable(arena) == NULL;
+	}
+
+	static BOOL TestXxHash64Vectors()
+	{
+		UINT8 data[100];
+		for (UINT32 i = 0; i < 100; i++)
+			data[i] = (UINT8)i;
+		auto fox = "The quick brown fox jumps over the lazy dog"_embed;
+		UINT64 seed = UINT64(0x9E3779B9U, 0x7F4A7C15U);
+
+		return XxHash64::Compute(NULL, 0) == UINT64(0xEF46DB37U, 0x51D8E999U) &&
+			   XxHash64::Compute((const CHAR *)"a"_embed, 1) == UINT64(0xD24EC4F1U, 0xA98C6E5BU) &&
+			   XxHash64::Compute((const CHAR *)"abc"_embed, 3) == UINT64(0x44BC2CF5U, 0xAD770999U) &&
+			   XxHash64::Compute((const CHAR *)fox, fox.Length) == UINT64(0x0B242D36U, 0x1FDA71BCU) &&
+			   XxHash64::Compute(data, 100) == UINT64(0x6AC1E580U, 0x32166597U) &&
+			   XxHash64::Compute(NULL, 0, seed) == UINT64(0xC4349FC9U, 0x3C010000U) &&
+			   XxHash64::Compute((const CHAR *)"abc"_embed, 3, seed) == UINT64(0x2ED0F59DU, 0x6B43AC8BU) &&
+			   XxHash64::Compute(data, 100, seed) == UINT64(0x3B97D91EU, 0xBA03E785U);
+	}
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "runtime.h"
+
+class CoroutineTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Coroutine Tests..."_embed);
+
+		// Test 1: A spawned task runs to completion and keeps its result
+		if (!TestTaskResult())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Task result"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Task result"_embed);
+		}
+
+		// Test 2: Nested and repeated awaits complete in constant stack
+		if (!TestNestedAwait())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Nested await"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Nested await"_embed);
+		}
+
+		// Test 3: AsyncEvent resumes its waiters in order
+		if (!TestAsyncEvent())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: AsyncEvent"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: AsyncEvent"_embed);
+		}
+
+		// Test 4: A poll routine delivers completions to suspended tasks
+		if (!TestPoller())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Poller completions"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Poller completions"_embed);
+		}
+
+		// Test 5: Run reports tasks that nothing can wake
+		if (!TestStallDetection())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Stall detection"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Stall detection"_embed);
+		}
+
+		// Test 6: Frames of finished tasks are reused by the frame pool
+		if (!TestFrameReuse())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Frame reuse"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Frame reuse"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Coroutine tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Coroutine tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Simulated completion-based device: reads complete one per poll
+	typedef struct _FAKE_READ
+	{
+		std::coroutine_handle<> Waiter;
+		USIZE Value;
+		struct _FAKE_READ *Next;
+	} FAKE_READ;
+
+	struct FAKE_DEVICE
+	{
+		FAKE_READ *Pending;
+		USIZE NextValue;
+		USIZE PollCount;
+	};
+
+	struct ReadAwaiter
+	{
+		FAKE_DEVICE &Device;
+		FAKE_READ Request;
+
+		bool await_ready() const noexcept { return false; }
+
+		VOID await_suspend(std::coroutine_handle<> handle) noexcept
+		{
+			Request.Waiter = handle;
+			Request.Next = Device.Pending;
+			Device.Pending = &Request;
+		}
+
+		USIZE await_resume() const noexcept { return Request.Value; }
+	};
+
+	static USIZE PollDevice(PVOID context, Executor &executor)
+	{
+		FAKE_DEVICE *device = (FAKE_DEVICE *)context;
+		device->PollCount++;
+		FAKE_READ *request = device->Pending;
+		if (request == NULL)
+			return 0;
+		device->Pending = request->Next;
+		request->Value = device->NextValue++;
+		executor.Schedule(request->Waiter);
+		return 1;
+	}
+
+	static Task<INT32> Constant(INT32 value)
+	{
+		co_return value;
+	}
+
+	static Task<INT32> AddConstants()
+	{
+		INT32 left = co_await Constant(40);
+		INT32 right = co_await Constant(2);
+		co_return left + right;
+	}
+
+	static Task<USIZE> SumDown(USIZE n)
+	{
+		if (n == 0)
+			co_return 0;
+		USIZE rest = co_await SumDown(n - 1);
+		co_return n + rest;
+	}
+
+	static Task<USIZE> SumLoop(USIZE count)
+	{
+		USIZE total = 0;
+		for (USIZE i = 1; i <= count; i++)
+			total += (USIZE)co_await Constant((INT32)i);
+		co_return total;
+	}
+
+	static Task<VOID> WaitAndRecord(AsyncEvent &event, PUINT32 order, PUINT32 next, UINT32 id)
+	{
+		co_await event;
+		order[(*next)++] = id;
+	}
+
+	static Task<VOID> ReadTwice(FAKE_DEVICE &device, PUSIZE sum)
+	{
+		USIZE first = co_await ReadAwaiter{device, {}};
+		co_await Executor::Yield();
+		USIZE second = co_await ReadAwaiter{device, {}};
+		*sum += first + second;
+	}
+
+	static Task<VOID> Noop(PUINT32 counter)
+	{
+		(*counter)++;
+		co_return;
+	}
+
+	static BOOL TestTaskResult()
+	{
+		Executor executor;
+		Task<INT32> task = AddConstants();
+		if (!task.IsValid() || task.IsDone())
+			return FALSE;
+
+		executor.Spawn(task);
+		return executor.Run() && task.IsDone() && task.GetResult() == 42 && executor.GetOutstandingCount() == 0;
+	}
+
+	static BOOL TestNestedAwait()
+	{
+		Executor executor;
+		Task<USIZE> deep = SumDown(200);
+		Task<USIZE> loop = SumLoop(5000);
+		executor.Spawn(deep);
+		executor.Spawn(loop);
+		if (!executor.Run())
+			return FALSE;
+		return deep.GetResult() == 200 * 201 / 2 && loop.GetResult() == (USIZE)5000 * 5001 / 2;
+	}
+
+	static BOOL TestAsyncEvent()
+	{
+		Executor executor;
+		AsyncEvent event;
+		UINT32 order[4] = {};
+		UINT32 next = 0;
+
+		for (UINT32 id = 1; id <= 3; id++)
+			executor.Spawn(WaitAndRecord(event, order, &next, id));
+
+		// Waiters are suspended: nothing can wake them yet
+		if (executor.Run() || next != 0 || executor.GetOutstandingCount() != 3)
+			return FALSE;
+
+		event.Set();
+		if (!executor.Run() || next != 3 || order[0] != 1 || order[1] != 2 || order[2] != 3)
+			return FALSE;
+
+		// A set event does not suspend
+		executor.Spawn(WaitAndRecord(event, order, &next, 4));
+		return executor.Run() && next == 4 && order[3] == 4;
+	}
+
+	static BOOL TestPoller()
+	{
+		Executor executor;
+		FAKE_DEVICE device = {NULL, 1, 0};
+		executor.SetPoller(PollDevice, &device);
+
+		USIZE sum = 0;
+		for (USIZE i = 0; i < 4; i++)
+			executor.Spawn(ReadTwice(device, &sum));
+
+		// Eight reads complete with values 1..8
+		return executor.Run() && sum == 36 && device.Pending == NULL && device.PollCount >= 8;
+	}
+
+	static BOOL TestStallDetection()
+	{
+		Executor executor;
+		AsyncEvent event;
+		UINT32 order[1] = {};
+		UINT32 next = 0;
+
+		executor.Spawn(WaitAndRecord(event, order, &next, 7));
+		if (executor.Run() || executor.GetOutstandingCount() != 1)
+			return FALSE;
+
+		event.Set();
+		return executor.Run() && next == 1 && order[0] == 7;
+	}
+
+	static BOOL TestFrameReuse()
+	{
+		Executor executor;
+		UINT32 counter = 0;
+
+		executor.Spawn(Noop(&counter));
+		if (!executor.Run())
+			return FALSE;
+		USIZE used = executor.GetFramePool().GetArenaUsed();
+
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			executor.Spawn(Noop(&counter));
+			if (!executor.Run())
+				return FALSE;
+		}
+
+		return counter == 1001 && used > 0 && executor.GetFramePool().GetArenaUsed() == used;
+	}
+};
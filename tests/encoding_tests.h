@@ -0,0 +1,242 @@
+#pragma once
+
+#include "runtime.h"
+
+class EncodingTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Encoding Tests..."_embed);
+
+		// Test 1: RFC 4648 Base64 test vectors
+		if (!TestBase64Vectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Base64 vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Base64 vectors"_embed);
+		}
+
+		// Test 2: Unpadded input is accepted, malformed input is rejected
+		if (!TestBase64Invalid())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Base64 invalid input"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Base64 invalid input"_embed);
+		}
+
+		// Test 3: Hex digits in both cases
+		if (!TestHexVectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Hex vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Hex vectors"_embed);
+		}
+
+		// Test 4: Every size through the word loop and the padded tail, CHAR and WCHAR
+		if (!TestRoundTrip())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Round trip"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Round trip"_embed);
+		}
+
+		// Test 5: Output buffers one element too small
+		if (!TestCapacity())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Capacity"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Capacity"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Encoding tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Encoding tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr USIZE MaxSize = 100;
+
+	template <TCHAR TChar>
+	static BOOL TextEquals(const TChar *text, const TChar *expected, USIZE length)
+	{
+		for (USIZE i = 0; i < length; i++)
+		{
+			if (text[i] != expected[i])
+				return FALSE;
+		}
+		return text[length] == 0;
+	}
+
+	// Encodes data, compares with expected and decodes expected back to data
+	template <TCHAR TChar>
+	static BOOL CheckBase64(const CHAR *data, USIZE size, const TChar *expected, USIZE length)
+	{
+		TChar text[24];
+		UINT8 bytes[16];
+		if (Base64::Encode(data, size, text, 24) != (SSIZE)length || !TextEquals(text, expected, length))
+			return FALSE;
+		return Base64::Decode(expected, length, bytes, sizeof(bytes)) == (SSIZE)size && Memory::Compare(bytes, data, size) == 0;
+	}
+
+	static BOOL TestBase64Vectors()
+	{
+		auto data = "foobar"_embed;
+		if (!CheckBase64((const CHAR *)data, 0, (const CHAR *)""_embed, 0) ||
+			!CheckBase64((const CHAR *)data, 1, (const CHAR *)"Zg=="_embed, 4) ||
+			!CheckBase64((const CHAR *)data, 2, (const CHAR *)"Zm8="_embed, 4) ||
+			!CheckBase64((const CHAR *)data, 3, (const CHAR *)"Zm9v"_embed, 4) ||
+			!CheckBase64((const CHAR *)data, 4, (const CHAR *)"Zm9vYg=="_embed, 8) ||
+			!CheckBase64((const CHAR *)data, 5, (const CHAR *)"Zm9vYmE="_embed, 8) ||
+			!CheckBase64((const CHAR *)data, 6, (const CHAR *)"Zm9vYmFy"_embed, 8))
+			return FALSE;
+
+		// Every alphabet run entered and left, as wide text
+		auto edges = "\x01\x96\xB3\xD3\xDF\xBF\xFB\xFF\x74\xCD\xA6\x40"_embed;
+		return CheckBase64((const CHAR *)edges, 12, (const WCHAR *)L"AZaz09+/+/90zaZA"_embed, 16);
+	}
+
+	static BOOL TestBase64Invalid()
+	{
+		UINT8 bytes[16];
+
+		// Padding is optional
+		if (Base64::Decode((const CHAR *)"Zm9vYg"_embed, 6, bytes, sizeof(bytes)) != 4 || Memory::Compare(bytes, (const CHAR *)"foob"_embed, 4) != 0)
+			return FALSE;
+		if (Base64::Decode((const WCHAR *)L"Zm9vYmE"_embed, 7, bytes, sizeof(bytes)) != 5 || Memory::Compare(bytes, (const CHAR *)"fooba"_embed, 5) != 0)
+			return FALSE;
+
+		// One character past a group cannot encode a byte
+		if (Base64::Decode((const CHAR *)"Zm9vY"_embed, 5, bytes, sizeof(bytes)) != -1)
+			return FALSE;
+
+		// Whitespace, URL-safe characters and misplaced padding, in the word loop and in the tail
+		if (Base64::Decode((const CHAR *)"Zm9v Ym Fy"_embed, 10, bytes, sizeof(bytes)) != -1 ||
+			Base64::Decode((const CHAR *)"Zm9vYmFyZm9vYm-y"_embed, 16, bytes, sizeof(bytes)) != -1 ||
+			Base64::Decode((const CHAR *)"Zm9vYm_y"_embed, 8, bytes, sizeof(bytes)) != -1 ||
+			Base64::Decode((const CHAR *)"Zg==Zm9v"_embed, 8, bytes, sizeof(bytes)) != -1 ||
+			Base64::Decode((const CHAR *)"Zm9"
+										 "\xC3\xA9"
+										 "mFy"_embed,
+						   8, bytes, sizeof(bytes)) != -1)
+			return FALSE;
+
+		// A wide character whose low byte is a valid letter
+		auto wide = L"Zm9vYmFyZm9vYmFy"_embed;
+		WCHAR text[16];
+		Memory::Copy(text, (const WCHAR *)wide, sizeof(text));
+		text[13] = (WCHAR)0x0141;
+		return Base64::Decode(text, 16, bytes, sizeof(bytes)) == -1;
+	}
+
+	static BOOL TestHexVectors()
+	{
+		auto data = "\x01\x23\x45\x67\x89\xAB\xCD\xEF\x00\xFF"_embed;
+		CHAR text[24];
+		WCHAR wide[24];
+		UINT8 bytes[16];
+
+		if (Hex::Encode((const CHAR *)data, 10, text, 24) != 20 || !TextEquals(text, (const CHAR *)"0123456789abcdef00ff"_embed, 20))
+			return FALSE;
+		if (Hex::Encode((const CHAR *)data, 10, wide, 24, TRUE) != 20 || !TextEquals(wide, (const WCHAR *)L"0123456789ABCDEF00FF"_embed, 20))
+			return FALSE;
+
+		// Mixed case decodes to the same bytes
+		if (Hex::Decode((const CHAR *)"0123456789AbCdeF00fF"_embed, 20, bytes, sizeof(bytes)) != 10 || Memory::Compare(bytes, (const CHAR *)data, 10) != 0)
+			return FALSE;
+		if (Hex::Decode((const WCHAR *)L"0123456789aBcDEf00Ff"_embed, 20, bytes, sizeof(bytes)) != 10 || Memory::Compare(bytes, (const CHAR *)data, 10) != 0)
+			return FALSE;
+
+		// Odd length, and characters next to the digit and letter runs
+		return Hex::Decode((const CHAR *)"abc"_embed, 3, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const CHAR *)"0123456789abcdeg"_embed, 16, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const CHAR *)"0123456789abcd/f"_embed, 16, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const CHAR *)"0:"_embed, 2, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const WCHAR *)L"@0"_embed, 2, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const WCHAR *)L"G0"_embed, 2, bytes, sizeof(bytes)) == -1 &&
+			   Hex::Decode((const CHAR *)"`0"_embed, 2, bytes, sizeof(bytes)) == -1;
+	}
+
+	template <TCHAR TChar>
+	static BOOL RoundTrip(const UINT8 *data, USIZE size)
+	{
+		TChar text[MaxSize * 2 + 1];
+		UINT8 bytes[MaxSize];
+
+		SSIZE length = Base64::Encode(data, size, text, MaxSize * 2 + 1);
+		if (length != (SSIZE)Base64::GetEncodedLength(size) || text[length] != 0)
+			return FALSE;
+		if (Base64::Decode(text, (USIZE)length, bytes, size) != (SSIZE)size || Memory::Compare(bytes, data, size) != 0)
+			return FALSE;
+
+		length = Hex::Encode(data, size, text, MaxSize * 2 + 1);
+		if (length != (SSIZE)Hex::GetEncodedLength(size) || text[length] != 0)
+			return FALSE;
+		return Hex::Decode(text, (USIZE)length, bytes, size) == (SSIZE)size && Memory::Compare(bytes, data, size) == 0;
+	}
+
+	static BOOL TestRoundTrip()
+	{
+		UINT8 data[MaxSize];
+		UINT32 state = 0x2545F491;
+		for (USIZE i = 0; i < MaxSize; i++)
+		{
+			state = state * 1103515245 + 12345;
+			data[i] = (UINT8)(state >> 16);
+		}
+
+		for (USIZE size = 0; size <= MaxSize; size++)
+		{
+			if (!RoundTrip<CHAR>(data, size) || !RoundTrip<WCHAR>(data, size))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	static BOOL TestCapacity()
+	{
+		auto data = "0123456789"_embed;
+		CHAR text[32];
+		UINT8 bytes[16];
+
+		// Encode needs room for the terminator
+		if (Base64::Encode((const CHAR *)data, 10, text, 16) != -1 || Base64::Encode((const CHAR *)data, 10, text, 17) != 16)
+			return FALSE;
+		if (Hex::Encode((const CHAR *)data, 10, text, 20) != -1 || Hex::Encode((const CHAR *)data, 10, text, 21) != 20)
+			return FALSE;
+
+		// Decode needs room for the exact size only, and leaves the byte after it alone
+		bytes[10] = 0x5A;
+		if (Base64::Decode((const CHAR *)"MDEyMzQ1Njc4OQ=="_embed, 16, bytes, 9) != -1 ||
+			Base64::Decode((const CHAR *)"MDEyMzQ1Njc4OQ=="_embed, 16, bytes, 10) != 10 ||
+			bytes[10] != 0x5A)
+			return FALSE;
+		return Hex::Decode((const CHAR *)"30313233343536373839"_embed, 20, bytes, 9) == -1 &&
+			   Hex::Decode((const CHAR *)"30313233343536373839"_embed, 20, bytes, 10) == 10 &&
+			   bytes[10] == 0x5A && Memory::Compare(bytes, (const CHAR *)data, 10) == 0;
+	}
+};
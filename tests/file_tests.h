@@ -0,0 +1,243 @@
+#pragma once
+
+#include "runtime.h"
+
+class FileTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running File Tests..."_embed);
+
+		// Test 1: Bytes written through a File read back unchanged
+		if (!TestReadWrite())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Read/write round trip"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Read/write round trip"_embed);
+		}
+
+		// Test 2: Seek moves the position and size tracks the end of file
+		if (!TestSeekAndSize())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Seek, position and size"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Seek, position and size"_embed);
+		}
+
+		// Test 3: Lines written in blocks split back into the same lines
+		if (!TestBufferedLines())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Buffered lines"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Buffered lines"_embed);
+		}
+
+		// Test 4: Custom delimiters and records longer than the buffer
+		if (!TestRecords())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Record splitting"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Record splitting"_embed);
+		}
+
+		// Test 5: Transfers larger than the buffer bypass it and stay in order
+		if (!TestLargeTransfers())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Large transfers"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Large transfers"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All File tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some File tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static BOOL OpenScratchFile(File &file)
+	{
+		return file.Open(L"file_test.tmp"_embed, FILE_MODE_READ | FILE_MODE_WRITE | FILE_MODE_CREATE | FILE_MODE_TEMPORARY);
+	}
+
+	static VOID FillBytes(PUINT8 data, USIZE length, USIZE seed)
+	{
+		for (USIZE i = 0; i < length; i++)
+			data[i] = (UINT8)(seed * 13 + i);
+	}
+
+	static BOOL Matches(PCCHAR data, USIZE length, const CHAR *expected)
+	{
+		USIZE i = 0;
+		for (; i < length; i++)
+		{
+			if (expected[i] != data[i])
+				return FALSE;
+		}
+		return expected[i] == 0;
+	}
+
+	static BOOL TestReadWrite()
+	{
+		File file;
+		if (!OpenScratchFile(file))
+			return FALSE;
+
+		UINT8 source[300];
+		UINT8 target[300];
+		FillBytes(source, sizeof(source), 1);
+		Memory::Zero(target, sizeof(target));
+
+		BOOL result = file.Write(source, sizeof(source)) == (SSIZE)sizeof(source);
+		result = result && file.Seek(UINT64());
+		result = result && file.Read(target, sizeof(target)) == (SSIZE)sizeof(target);
+		result = result && Memory::Compare(source, target, sizeof(source)) == 0;
+
+		// At the end of file a read returns no data rather than an error
+		result = result && file.Read(target, sizeof(target)) == 0;
+
+		file.Close();
+		return result && !file.IsOpen() && file.Read(target, 1) == -1;
+	}
+
+	static BOOL TestSeekAndSize()
+	{
+		File file;
+		if (!OpenScratchFile(file))
+			return FALSE;
+
+		UINT8 data[128];
+		FillBytes(data, sizeof(data), 2);
+		BOOL result = file.GetSize() == UINT64() && file.Write(data, sizeof(data)) == (SSIZE)sizeof(data);
+		result = result && file.GetSize() == UINT64((UINT32)128) && file.GetPosition() == UINT64((UINT32)128);
+
+		UINT8 byte = 0;
+		result = result && file.Seek(UINT64((UINT32)100)) && file.GetPosition() == UINT64((UINT32)100);
+		result = result && file.Read(&byte, 1) == 1 && byte == data[100];
+
+		// Writing past the end extends the file
+		result = result && file.Seek(UINT64((UINT32)200)) && file.Write(data, 10) == 10;
+		result = result && file.GetSize() == UINT64((UINT32)210);
+		result = result && file.Seek(UINT64()) && file.SeekToEnd() && file.GetPosition() == UINT64((UINT32)210);
+		result = result && file.Flush();
+
+		return result;
+	}
+
+	static BOOL TestBufferedLines()
+	{
+		File file;
+		if (!OpenScratchFile(file))
+			return FALSE;
+
+		// Small buffers force refills and flushes in the middle of lines
+		BOOL result;
+		{
+			BufferedWriter writer(file, 16);
+			result = writer.IsValid();
+			for (USIZE i = 0; i < 50; i++)
+				result = result && writer.WriteLine("line of text"_embed, 12);
+			result = result && writer.Write("windows\r\n"_embed, 9);
+			result = result && writer.WriteLine(""_embed, 0);
+			result = result && writer.Write("unterminated"_embed, 12);
+			result = result && writer.Flush();
+		}
+		result = result && file.GetSize() == UINT64((UINT32)(50 * 13 + 9 + 1 + 12));
+		result = result && file.Seek(UINT64());
+
+		BufferedReader reader(file, 16);
+		PCCHAR line;
+		USIZE length;
+		for (USIZE i = 0; i < 50; i++)
+			result = result && reader.ReadLine(line, length) && Matches(line, length, "line of text"_embed);
+		result = result && reader.ReadLine(line, length) && Matches(line, length, "windows"_embed);
+		result = result && reader.ReadLine(line, length) && length == 0;
+		result = result && reader.ReadLine(line, length) && Matches(line, length, "unterminated"_embed);
+		result = result && !reader.ReadLine(line, length);
+
+		return result;
+	}
+
+	static BOOL TestRecords()
+	{
+		File file;
+		if (!OpenScratchFile(file))
+			return FALSE;
+
+		auto text = "alpha;beta;;a-record-longer-than-the-buffer;omega;"_embed;
+		USIZE textLength = 0;
+		while (text[textLength] != 0)
+			textLength++;
+		BOOL result = file.Write(text, textLength) == (SSIZE)textLength && file.Seek(UINT64());
+
+		BufferedReader reader(file, 16);
+		PCCHAR record;
+		USIZE length;
+		result = result && reader.ReadRecord(';', record, length) && Matches(record, length, "alpha"_embed);
+		result = result && reader.ReadRecord(';', record, length) && Matches(record, length, "beta"_embed);
+		result = result && reader.ReadRecord(';', record, length) && length == 0;
+
+		// An oversized record comes back in buffer-sized pieces
+		result = result && reader.ReadRecord(';', record, length) && Matches(record, length, "a-record-longer-"_embed);
+		result = result && reader.ReadRecord(';', record, length) && Matches(record, length, "than-the-buffer"_embed);
+		result = result && reader.ReadRecord(';', record, length) && Matches(record, length, "omega"_embed);
+		result = result && !reader.ReadRecord(';', record, length);
+
+		return result;
+	}
+
+	static BOOL TestLargeTransfers()
+	{
+		File file;
+		if (!OpenScratchFile(file))
+			return FALSE;
+
+		constexpr USIZE Size = 64 * 1024;
+		PUINT8 source = new UINT8[Size];
+		PUINT8 target = new UINT8[Size];
+		FillBytes(source, Size, 5);
+		Memory::Zero(target, Size);
+
+		BOOL result;
+		{
+			BufferedWriter writer(file, 4096);
+			result = writer.Write(source, 10) && writer.Write(source + 10, Size - 20) && writer.Write(source + Size - 10, 10);
+		}
+		result = result && file.GetSize() == UINT64((UINT32)Size) && file.Seek(UINT64());
+
+		// A small read primes the buffer, the large one drains it and then reads directly
+		BufferedReader reader(file, 4096);
+		result = result && reader.Read(target, 100) == 100;
+		result = result && reader.Read(target + 100, Size - 100) == (SSIZE)(Size - 100);
+		result = result && Memory::Compare(source, target, Size) == 0;
+		result = result && reader.Read(target, 1) == 0;
+
+		delete[] source;
+		delete[] target;
+		return result;
+	}
+};
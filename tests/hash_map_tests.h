@@ -0,0 +1,278 @@
+#pragma once
+
+#include "runtime.h"
+
+class HashMapTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running HashMap Tests..."_embed);
+
+		// Test 1: Insert, find and overwrite across several growths
+		if (!TestInsertFind())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Insert and find"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Insert and find"_embed);
+		}
+
+		// Test 2: Removed keys disappear and their slots are reused
+		if (!TestRemove())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Remove"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Remove"_embed);
+		}
+
+		// Test 3: Caller-supplied hashes, including colliding ones and struct keys
+		if (!TestPrecomputedHashes())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Precomputed hashes"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Precomputed hashes"_embed);
+		}
+
+		// Test 4: Non-trivial values are constructed and destroyed exactly once
+		if (!TestLifetimes())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Value lifetimes"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Value lifetimes"_embed);
+		}
+
+		// Test 5: Iteration visits every entry once; statistics match the contents
+		if (!TestIterationAndStatistics())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Iteration and statistics"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Iteration and statistics"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All HashMap tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some HashMap tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Counts live instances through a pointer (there are no writable globals)
+	struct Tracked
+	{
+		PINT32 Live;
+		UINT32 Value;
+
+		Tracked(PINT32 live, UINT32 value) : Live(live), Value(value) { (*Live)++; }
+		Tracked(const Tracked &other) : Live(other.Live), Value(other.Value) { (*Live)++; }
+		Tracked(Tracked &&other) : Live(other.Live), Value(other.Value) { (*Live)++; }
+		Tracked &operator=(const Tracked &other)
+		{
+			Value = other.Value;
+			return *this;
+		}
+		~Tracked() { (*Live)--; }
+	};
+
+	// An API cache key: module and export name hashes
+	struct ExportKey
+	{
+		USIZE Module;
+		USIZE Function;
+
+		BOOL operator==(const ExportKey &other) const { return Module == other.Module && Function == other.Function; }
+	};
+
+	static BOOL TestInsertFind()
+	{
+		HashMap<UINT32, UINT32> map;
+		if (map.GetCapacity() != 0 || map.Find(1) != NULL)
+			return FALSE;
+
+		for (UINT32 i = 0; i < 5000; i++)
+		{
+			if (!map.Insert(i * 3, i))
+				return FALSE;
+		}
+		if (map.GetSize() != 5000)
+			return FALSE;
+		for (UINT32 i = 0; i < 5000; i++)
+		{
+			UINT32 *value = map.Find(i * 3);
+			if (value == NULL || *value != i || map.Contains(i * 3 + 1))
+				return FALSE;
+		}
+
+		// Inserting an existing key replaces its value
+		if (!map.Insert(300, 7) || map.GetSize() != 5000 || *map.Find(300) != 7)
+			return FALSE;
+
+		// Reserve up front: no growth while filling
+		HashMap<UINT32, UINT32> reserved;
+		if (!reserved.Reserve(1000))
+			return FALSE;
+		USIZE capacity = reserved.GetCapacity();
+		for (UINT32 i = 0; i < 1000; i++)
+			reserved.Insert(i, i);
+		return reserved.GetCapacity() == capacity && capacity * 7 / 8 >= 1000;
+	}
+
+	static BOOL TestRemove()
+	{
+		HashMap<UINT32, UINT32> map;
+		for (UINT32 i = 0; i < 1000; i++)
+			map.Insert(i, i + 1);
+
+		for (UINT32 i = 0; i < 1000; i += 2)
+		{
+			if (!map.Remove(i))
+				return FALSE;
+		}
+		if (map.Remove(0) || map.GetSize() != 500)
+			return FALSE;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			UINT32 *value = map.Find(i);
+			if ((i % 2 == 0) != (value == NULL) || (value != NULL && *value != i + 1))
+				return FALSE;
+		}
+
+		// Churn at a fixed size must not grow the table: tombstones are reused or rebuilt away
+		USIZE capacity = map.GetCapacity();
+		for (UINT32 round = 0; round < 20; round++)
+		{
+			for (UINT32 i = 0; i < 500; i++)
+				map.Insert(100000 + round * 1000 + i, i);
+			for (UINT32 i = 0; i < 500; i++)
+				map.Remove(100000 + round * 1000 + i);
+		}
+		if (map.GetCapacity() != capacity || map.GetSize() != 500 || *map.Find(999) != 1000)
+			return FALSE;
+
+		map.Clear();
+		return map.GetSize() == 0 && map.Find(1) == NULL && map.GetCapacity() == capacity && map.Insert(1, 2) &&
+			   *map.Find(1) == 2;
+	}
+
+	static BOOL TestPrecomputedHashes()
+	{
+		// Export addresses keyed by Djb2 name hashes: the key is its own hash
+		HashMap<USIZE, PVOID> exports;
+		USIZE loadLibrary = Djb2::HashCompileTime("LoadLibraryA");
+		USIZE getProcAddress = Djb2::HashCompileTime("GetProcAddress");
+		exports.Insert(loadLibrary, (PVOID)0x1000, loadLibrary);
+		exports.Insert(getProcAddress, (PVOID)0x2000, getProcAddress);
+		auto name = "getprocaddress"_embed;
+		USIZE lookup = Djb2::Hash((const CHAR *)name);
+		PVOID *address = exports.Find(lookup, lookup);
+		if (address == NULL || *address != (PVOID)0x2000)
+			return FALSE;
+
+		// Struct keys with every hash equal: the key comparison alone tells them apart
+		HashMap<ExportKey, UINT32> collisions;
+		for (UINT32 i = 0; i < 200; i++)
+		{
+			if (!collisions.Insert(ExportKey{i, i * 7}, i, 42))
+				return FALSE;
+		}
+		for (UINT32 i = 0; i < 200; i++)
+		{
+			UINT32 *value = collisions.Find(ExportKey{i, i * 7}, 42);
+			if (value == NULL || *value != i)
+				return FALSE;
+		}
+		if (collisions.Find(ExportKey{1, 1}, 42) != NULL || !collisions.Remove(ExportKey{100, 700}, 42) ||
+			collisions.Contains(ExportKey{100, 700}, 42) || !collisions.Contains(ExportKey{199, 1393}, 42))
+			return FALSE;
+
+		// The same key under a different hash is a different entry
+		return collisions.Find(ExportKey{5, 35}, 43) == NULL;
+	}
+
+	static BOOL TestLifetimes()
+	{
+		INT32 live = 0;
+		{
+			HashMap<UINT32, Tracked> map;
+			for (UINT32 i = 0; i < 300; i++)
+			{
+				Tracked value(&live, i);
+				map.Insert(i, value);
+			}
+			if (live != 300 || map.Find(299)->Value != 299)
+				return FALSE;
+
+			map.Insert(5, Tracked(&live, 1000));
+			map.Remove(6);
+			if (live != 299 || map.Find(5)->Value != 1000)
+				return FALSE;
+
+			map.Clear();
+			if (live != 0)
+				return FALSE;
+			map.Insert(1, Tracked(&live, 1));
+		}
+		return live == 0;
+	}
+
+	static BOOL TestIterationAndStatistics()
+	{
+		HASH_MAP_STATISTICS empty = HashMap<UINT32, UINT32>().GetStatistics();
+		if (empty.Size != 0 || empty.Capacity != 0 || empty.LoadPercent != 0)
+			return FALSE;
+
+		HashMap<UINT32, UINT32> map;
+		USIZE keySum = 0;
+		for (UINT32 i = 1; i <= 1000; i++)
+		{
+			map.Insert(i * 11, i);
+			keySum += i * 11;
+		}
+		map.Remove(11);
+		map.Remove(22);
+
+		USIZE visited = 0;
+		UINT32 entries = 0;
+		for (auto &entry : map)
+		{
+			if (entry.Value * 11 != entry.Key || entry.Hash != entry.Key)
+				return FALSE;
+			visited += entry.Key;
+			entries++;
+		}
+		if (entries != 998 || visited != keySum - 33)
+			return FALSE;
+
+		HASH_MAP_STATISTICS statistics = map.GetStatistics();
+		if (statistics.Size != 998 || statistics.Capacity != map.GetCapacity())
+			return FALSE;
+		if (statistics.LoadPercent != (UINT32)(998 * 100 / statistics.Capacity) || statistics.LoadPercent > 88)
+			return FALSE;
+
+		// Every entry is at least in its home group; sequential keys mix well enough to stay near it
+		return statistics.TotalProbeLength >= 998 && statistics.MaxProbeLength >= 1 && statistics.MaxProbeLength < 8 &&
+			   statistics.Tombstones <= 2;
+	}
+};
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "runtime.h"
+
+class Lz4Tests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Lz4 Tests..."_embed);
+
+		// Test 1: A block of literals only
+		if (!TestLiteralsOnly())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Literals only"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Literals only"_embed);
+		}
+
+		// Test 2: Matches that overlap their own output, with extended lengths
+		if (!TestOverlappingMatch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Overlapping match"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Overlapping match"_embed);
+		}
+
+		// Test 3: Corrupt, truncated and oversized blocks are rejected
+		if (!TestMalformedBlocks())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Malformed blocks"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Malformed blocks"_embed);
+		}
+
+		// Test 4: A block written by the reference lz4 tool
+		if (!TestReferenceBlock())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Reference block"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Reference block"_embed);
+		}
+
+		// Test 5: Compress then decompress restores the input
+		if (!TestRoundTrip())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Round trip"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Round trip"_embed);
+		}
+
+		// Test 6: Hash table from a caller's arena, and on the stack when it is full
+		if (!TestHashTableSources())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Hash table sources"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Hash table sources"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Lz4 tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Lz4 tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static BOOL TestLiteralsOnly()
+	{
+		UINT8 output[32];
+
+		// Token 0x50: five literals, no match
+		auto shortBlock = "\x50hello"_embed;
+		SSIZE written = Lz4::Decompress((const CHAR *)shortBlock, shortBlock.Length, output, sizeof(output));
+		if (written != 5 || Memory::Compare(output, (const CHAR *)"hello"_embed, 5) != 0)
+			return FALSE;
+
+		// Token 0xF0 and one extra length byte: 15 + 5 literals
+		auto longBlock = "\xF0\x05"
+						 "abcdefghijklmnopqrst"_embed;
+		written = Lz4::Decompress((const CHAR *)longBlock, longBlock.Length, output, sizeof(output));
+		if (written != 20 || Memory::Compare(output, (const CHAR *)"abcdefghijklmnopqrst"_embed, 20) != 0)
+			return FALSE;
+
+		// An empty block decodes to nothing
+		return Lz4::Decompress(output, 0, output, sizeof(output)) == 0;
+	}
+
+	static BOOL TestOverlappingMatch()
+	{
+		UINT8 output[64];
+
+		// One literal 'a', then a match at offset 1 of 15 + 5 + 4 bytes, then "xyz"
+		auto run = "\x1F"
+				   "a\x01\x00\x05\x30"
+				   "xyz"_embed;
+		SSIZE written = Lz4::Decompress((const CHAR *)run, run.Length, output, sizeof(output));
+		if (written != 28)
+			return FALSE;
+		for (USIZE i = 0; i < 25; i++)
+		{
+			if (output[i] != 'a')
+				return FALSE;
+		}
+		if (output[25] != 'x' || output[26] != 'y' || output[27] != 'z')
+			return FALSE;
+
+		// Offset 2 repeats a two-byte pattern: "ab" then 6 more bytes
+		auto pattern = "\x22"
+					   "ab\x02\x00\x10"
+					   "c"_embed;
+		written = Lz4::Decompress((const CHAR *)pattern, pattern.Length, output, sizeof(output));
+		return written == 9 && Memory::Compare(output, (const CHAR *)"ababababc"_embed, 9) == 0;
+	}
+
+	static BOOL TestMalformedBlocks()
+	{
+		UINT8 output[64];
+
+		// Offset 0 is never valid
+		auto zeroOffset = "\x10"
+						  "a\x00\x00"_embed;
+		if (Lz4::Decompress((const CHAR *)zeroOffset, zeroOffset.Length, output, sizeof(output)) != -1)
+			return FALSE;
+
+		// Offset reaching before the start of the output
+		auto farOffset = "\x10"
+						 "a\x02\x00"_embed;
+		if (Lz4::Decompress((const CHAR *)farOffset, farOffset.Length, output, sizeof(output)) != -1)
+			return FALSE;
+
+		// Literal count past the end of the input, and a lone offset byte
+		auto truncated = "\x50hel"_embed;
+		if (Lz4::Decompress((const CHAR *)truncated, truncated.Length, output, sizeof(output)) != -1)
+			return FALSE;
+		auto halfOffset = "\x10"
+						  "a\x01"_embed;
+		if (Lz4::Decompress((const CHAR *)halfOffset, halfOffset.Length, output, sizeof(output)) != -1)
+			return FALSE;
+
+		// Output one byte too small, for literals and for a match
+		auto literals = "\x50hello"_embed;
+		if (Lz4::Decompress((const CHAR *)literals, literals.Length, output, 4) != -1)
+			return FALSE;
+		auto run = "\x1F"
+				   "a\x01\x00\x05"_embed;
+		return Lz4::Decompress((const CHAR *)run, run.Length, output, 24) == -1;
+	}
+
+	static BOOL TestReferenceBlock()
+	{
+		UINT8 output[128];
+
+		// lz4 -12 of the text below: one long literal run, then matches at offsets 45 and 11
+		auto block = "\xFF\x1E"
+					 "The quick brown fox jumps over the lazy dog. -\x00\x18\xB9"
+					 " again, and\x0B\x00"
+					 "Pgain."_embed;
+		auto text = "The quick brown fox jumps over the lazy dog. "
+					"The quick brown fox jumps over the lazy dog again, and again, and again."_embed;
+		SSIZE written = Lz4::Decompress((const CHAR *)block, block.Length, output, sizeof(output));
+		return written == (SSIZE)text.Length && Memory::Compare(output, (const CHAR *)text, text.Length) == 0;
+	}
+
+	// Compresses size bytes of data, checks the bound and decodes the block again
+	static BOOL RoundTrip(const UINT8 *data, USIZE size, PUINT8 packed, PUINT8 unpacked, Arena *arena = NULL)
+	{
+		SSIZE packedSize = Lz4::Compress(data, size, packed, Lz4::GetCompressBound(size), arena);
+		if (packedSize <= 0 || (USIZE)packedSize > Lz4::GetCompressBound(size))
+			return FALSE;
+		if (Lz4::Decompress(packed, (USIZE)packedSize, unpacked, size) != (SSIZE)size)
+			return FALSE;
+		return Memory::Compare(unpacked, data, size) == 0;
+	}
+
+	static BOOL TestRoundTrip()
+	{
+		BOOL passed = TRUE;
+		PUINT8 data = new UINT8[Size];
+		PUINT8 packed = new UINT8[Lz4::GetCompressBound(Size)];
+		PUINT8 unpacked = new UINT8[Size];
+
+		// Every size around the 13-byte minimum for a match, from a short-period pattern
+		for (USIZE i = 0; i < Size; i++)
+			data[i] = (UINT8)('a' + i % 3);
+		for (USIZE size = 0; size <= 40 && passed; size++)
+			passed = RoundTrip(data, size, packed, unpacked);
+
+		// A long run shrinks to a few bytes
+		if (passed)
+		{
+			Memory::Zero(data, Size);
+			SSIZE packedSize = Lz4::Compress(data, Size, packed, Lz4::GetCompressBound(Size));
+			passed = packedSize > 0 && packedSize < 64 && RoundTrip(data, Size, packed, unpacked);
+		}
+
+		// Pseudo-random bytes grow, but stay within the bound
+		UINT32 state = 0x12345678;
+		for (USIZE i = 0; i < Size; i++)
+		{
+			state = state * 1664525 + 1013904223;
+			data[i] = (UINT8)(state >> 24);
+		}
+		passed = passed && RoundTrip(data, Size, packed, unpacked);
+
+		// Random words repeat at many distances
+		for (USIZE i = 0; i < Size; i++)
+		{
+			state = state * 1664525 + 1013904223;
+			if ((state >> 28) < 2)
+				data[i] = ' ';
+			else
+				data[i] = (UINT8)('a' + (state >> 16) % 4);
+		}
+		passed = passed && RoundTrip(data, Size, packed, unpacked);
+
+		// A target one byte too small fails instead of writing a partial block
+		SSIZE packedSize = Lz4::Compress(data, Size, packed, Lz4::GetCompressBound(Size));
+		if (passed && packedSize > 0)
+			passed = Lz4::Compress(data, Size, unpacked, (USIZE)packedSize - 1) == -1 &&
+					 Lz4::Compress(data, Size, unpacked, (USIZE)packedSize) == packedSize;
+
+		delete[] unpacked;
+		delete[] packed;
+		delete[] data;
+		return passed;
+	}
+
+	static BOOL TestHashTableSources()
+	{
+		BOOL passed = TRUE;
+		PUINT8 data = new UINT8[Size];
+		PUINT8 packed = new UINT8[Lz4::GetCompressBound(Size)];
+		PUINT8 unpacked = new UINT8[Size];
+		for (USIZE i = 0; i < Size; i++)
+			data[i] = (UINT8)((i * 7) ^ (i >> 5));
+
+		// The table comes from the given arena and is released again
+		Arena arena;
+		if (!arena.InitializeHeap(LZ4_HASH_ENTRIES * sizeof(UINT32) + 64))
+			passed = FALSE;
+		passed = passed && RoundTrip(data, Size, packed, unpacked, &arena) && arena.GetUsed() == 0;
+
+		// With the arena full the smaller stack table takes over
+		if (passed)
+		{
+			PVOID filler = arena.Allocate(arena.GetCapacity() - 32, 1);
+			passed = filler != NULL && RoundTrip(data, Size, packed, unpacked, &arena);
+		}
+
+		delete[] unpacked;
+		delete[] packed;
+		delete[] data;
+		return passed;
+	}
+
+	static constexpr USIZE Size = 8192;
+};
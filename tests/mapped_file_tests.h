@@ -0,0 +1,291 @@
+#pragma once
+
+#include "runtime.h"
+
+class MappedFileTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running MappedFile Tests..."_embed);
+
+		// Test 1: A read-only view exposes the file's bytes
+		if (!TestReadOnlyView())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Read-only view"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Read-only view"_embed);
+		}
+
+		// Test 2: Writes to a copy-on-write view never reach the file
+		if (!TestCopyOnWrite())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Copy-on-write view"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Copy-on-write view"_embed);
+		}
+
+		// Test 3: Number parsers run directly over the mapped bytes
+		if (!TestParseInPlace())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Parsing mapped bytes"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Parsing mapped bytes"_embed);
+		}
+
+		// Test 4: Access hints and prefetch over valid and invalid ranges
+		if (!TestHintsAndPrefetch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Access hints and prefetch"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Access hints and prefetch"_embed);
+		}
+
+		// Test 5: Empty files map to an empty view, missing files fail
+		if (!TestEmptyAndMissing())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Empty and missing files"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Empty and missing files"_embed);
+		}
+
+		// Test 6: A zero-length prefetch succeeds without touching the view
+		if (!TestZeroLengthPrefetch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Zero-length prefetch"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Zero-length prefetch"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All MappedFile tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some MappedFile tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Create the scratch file with the given contents
+	static BOOL WriteScratchFile(PCVOID data, USIZE length)
+	{
+		File file;
+		if (!file.Open(L"mapped_file_test.tmp"_embed, FILE_MODE_WRITE | FILE_MODE_CREATE))
+			return FALSE;
+		return length == 0 || file.Write(data, length) == (SSIZE)length;
+	}
+
+	// Opening with FILE_MODE_TEMPORARY deletes the file once the handle closes
+	static VOID DeleteScratchFile()
+	{
+		File file;
+		file.Open(L"mapped_file_test.tmp"_embed, FILE_MODE_READ | FILE_MODE_TEMPORARY);
+	}
+
+	static BOOL TestReadOnlyView()
+	{
+		constexpr USIZE Size = 3 * 4096 + 100;
+		PUINT8 data = new UINT8[Size];
+		for (USIZE i = 0; i < Size; i++)
+			data[i] = (UINT8)(i * 7 + 1);
+		if (!WriteScratchFile(data, Size))
+		{
+			delete[] data;
+			return FALSE;
+		}
+
+		BOOL result;
+		{
+			MappedFile mapped;
+			result = mapped.Open(L"mapped_file_test.tmp"_embed) && mapped.IsOpen();
+			result = result && mapped.GetSize() == Size && mapped.GetWritableData() == NULL;
+			result = result && mapped.GetData() != NULL && Memory::Compare(mapped.GetData(), data, Size) == 0;
+			mapped.Close();
+			result = result && !mapped.IsOpen() && mapped.GetData() == NULL;
+		}
+
+		DeleteScratchFile();
+		delete[] data;
+		return result;
+	}
+
+	static BOOL TestCopyOnWrite()
+	{
+		auto text = "original contents"_embed;
+		USIZE length = String::Length((const CHAR *)text);
+		if (!WriteScratchFile((const CHAR *)text, length))
+			return FALSE;
+
+		BOOL result;
+		{
+			MappedFile mapped;
+			result = mapped.Open(L"mapped_file_test.tmp"_embed, MappedView::CopyOnWrite);
+			PUINT8 bytes = mapped.GetWritableData();
+			result = result && bytes != NULL;
+			if (result)
+			{
+				bytes[0] = 'O';
+				bytes[9] = 'C';
+				result = mapped.GetText()[0] == 'O' && mapped.GetText()[9] == 'C';
+			}
+		}
+
+		// A fresh view still sees the bytes on disk
+		{
+			MappedFile mapped;
+			result = result && mapped.Open(L"mapped_file_test.tmp"_embed);
+			result = result && Memory::Compare(mapped.GetData(), (const CHAR *)text, length) == 0;
+		}
+
+		DeleteScratchFile();
+		return result;
+	}
+
+	static BOOL TestParseInPlace()
+	{
+		auto text = "42 -17 0x1F ff\n18446744073709551615 18446744073709551616"_embed;
+		USIZE length = String::Length((const CHAR *)text);
+		if (!WriteScratchFile((const CHAR *)text, length))
+			return FALSE;
+
+		BOOL result;
+		{
+			MappedFile mapped;
+			result = mapped.Open(L"mapped_file_test.tmp"_embed, MappedView::ReadOnly, MappedAccess::Sequential);
+
+			// Walk the view with an explicit cursor; nothing is copied or terminated
+			PCCHAR cursor = mapped.GetText();
+			PCCHAR end = cursor + mapped.GetSize();
+			UINT64 unsignedValue;
+			INT64 signedValue;
+			USIZE used;
+
+			used = String::ParseUInt64(cursor, end - cursor, unsignedValue);
+			result = result && used == 2 && unsignedValue == 42U;
+			cursor += used + 1;
+
+			used = String::ParseInt64(cursor, end - cursor, signedValue);
+			result = result && used == 3 && signedValue == INT64(-17);
+			cursor += used + 1;
+
+			used = String::ParseHex(cursor, end - cursor, unsignedValue);
+			result = result && used == 4 && unsignedValue == 0x1FU;
+			cursor += used + 1;
+
+			used = String::ParseHex(cursor, end - cursor, unsignedValue);
+			result = result && used == 2 && unsignedValue == 0xFFU;
+			cursor += used + 1;
+
+			used = String::ParseUInt64(cursor, end - cursor, unsignedValue);
+			result = result && used == 20 && unsignedValue == UINT64(0xFFFFFFFFU, 0xFFFFFFFFU);
+			cursor += used + 1;
+
+			// The last number overflows and runs into the end of the view
+			result = result && String::ParseUInt64(cursor, end - cursor, unsignedValue) == 0;
+		}
+
+		DeleteScratchFile();
+		return result;
+	}
+
+	static BOOL TestHintsAndPrefetch()
+	{
+		constexpr USIZE Size = 64 * 1024;
+		PUINT8 data = new UINT8[Size];
+		for (USIZE i = 0; i < Size; i++)
+			data[i] = (UINT8)(i >> 8);
+		if (!WriteScratchFile(data, Size))
+		{
+			delete[] data;
+			return FALSE;
+		}
+
+		BOOL result = TRUE;
+		{
+			MappedFile sequential;
+			result = result && sequential.Open(L"mapped_file_test.tmp"_embed, MappedView::ReadOnly, MappedAccess::Sequential);
+			result = result && sequential.Prefetch(0, Size);
+			result = result && sequential.Prefetch(Size - 10, 1000);
+			result = result && !sequential.Prefetch(Size, 1);
+			result = result && Memory::Compare(sequential.GetData(), data, Size) == 0;
+
+			MappedFile random;
+			result = result && random.Open(L"mapped_file_test.tmp"_embed, MappedView::ReadOnly, MappedAccess::Random);
+			result = result && random.Prefetch(4096 * 5, 4096);
+			result = result && random.GetData()[Size - 1] == data[Size - 1];
+		}
+
+		DeleteScratchFile();
+		delete[] data;
+		return result;
+	}
+
+	static BOOL TestEmptyAndMissing()
+	{
+		if (!WriteScratchFile(NULL, 0))
+			return FALSE;
+
+		BOOL result;
+		{
+			MappedFile mapped;
+			result = mapped.Open(L"mapped_file_test.tmp"_embed);
+			result = result && mapped.IsOpen() && mapped.GetSize() == 0 && mapped.GetData() == NULL;
+			result = result && !mapped.Prefetch(0, 1);
+		}
+		DeleteScratchFile();
+
+		MappedFile missing;
+		return result && !missing.Open(L"mapped_file_missing.tmp"_embed) && !missing.IsOpen();
+	}
+
+	static BOOL TestZeroLengthPrefetch()
+	{
+		constexpr USIZE Size = 4096;
+		PUINT8 data = new UINT8[Size];
+		for (USIZE i = 0; i < Size; i++)
+			data[i] = (UINT8)i;
+		if (!WriteScratchFile(data, Size))
+		{
+			delete[] data;
+			return FALSE;
+		}
+
+		BOOL result;
+		{
+			MappedFile mapped;
+			result = mapped.Open(L"mapped_file_test.tmp"_embed, MappedView::ReadOnly, MappedAccess::Random);
+			result = result && mapped.Prefetch(0, 0);
+			result = result && mapped.Prefetch(Size - 1, 0);
+			result = result && !mapped.Prefetch(Size, 0);
+			result = result && Memory::Compare(mapped.GetData(), data, Size) == 0;
+		}
+
+		DeleteScratchFile();
+		delete[] data;
+		return result;
+	}
+};
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "runtime.h"
+
+class QueueTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Queue Tests..."_embed);
+
+		// Test 1: SPSC fill, full and drain in FIFO order
+		if (!TestSpscFillAndDrain())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SPSC fill and drain"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SPSC fill and drain"_embed);
+		}
+
+		// Test 2: SPSC batch operations respect capacity and wrap around
+		if (!TestSpscBatch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SPSC batch"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SPSC batch"_embed);
+		}
+
+		// Test 3: SPSC transfer between two threads preserves order
+		if (!TestSpscConcurrent())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SPSC concurrent transfer"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SPSC concurrent transfer"_embed);
+		}
+
+		// Test 4: MPMC fill, full and drain in FIFO order
+		if (!TestMpmcFillAndDrain())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: MPMC fill and drain"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: MPMC fill and drain"_embed);
+		}
+
+		// Test 5: MPMC batch operations
+		if (!TestMpmcBatch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: MPMC batch"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: MPMC batch"_embed);
+		}
+
+		// Test 6: MPMC with several producers and consumers loses nothing
+		if (!TestMpmcConcurrent())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: MPMC concurrent transfer"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: MPMC concurrent transfer"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Queue tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Queue tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr USIZE TransferCount = 100000;
+	static constexpr USIZE ThreadsPerSide = 3;
+
+	typedef SpscQueue<USIZE, 64> SMALL_SPSC;
+	typedef MpmcQueue<USIZE, 64> SMALL_MPMC;
+
+	struct MPMC_SHARED
+	{
+		SMALL_MPMC Queue;
+		Atomic<USIZE> ConsumedCount;
+		Atomic<USIZE> ConsumedSum;
+	};
+
+	static INT32 SpscProducer(PVOID parameter)
+	{
+		SMALL_SPSC *queue = (SMALL_SPSC *)parameter;
+		USIZE batch[8];
+		USIZE next = 1;
+		while (next <= TransferCount)
+		{
+			// Alternate single and batch pushes to cover both paths
+			if (next & 1)
+			{
+				if (queue->TryPush(next))
+					next++;
+				else
+					Thread::Yield();
+				continue;
+			}
+
+			USIZE count = 0;
+			while (count < 8 && next + count <= TransferCount)
+			{
+				batch[count] = next + count;
+				count++;
+			}
+			USIZE pushed = queue->TryPushBatch(batch, count);
+			if (pushed == 0)
+				Thread::Yield();
+			next += pushed;
+		}
+		return 0;
+	}
+
+	static INT32 MpmcProducer(PVOID parameter)
+	{
+		MPMC_SHARED *shared = (MPMC_SHARED *)parameter;
+		for (USIZE i = 1; i <= TransferCount; i++)
+		{
+			while (!shared->Queue.TryPush(i))
+				Thread::Yield();
+		}
+		return 0;
+	}
+
+	static INT32 MpmcConsumer(PVOID parameter)
+	{
+		MPMC_SHARED *shared = (MPMC_SHARED *)parameter;
+		const USIZE total = TransferCount * ThreadsPerSide;
+		USIZE batch[4];
+		while (shared->ConsumedCount.Load(MemoryOrder::Relaxed) < total)
+		{
+			USIZE popped = shared->Queue.TryPopBatch(batch, 4);
+			if (popped == 0)
+			{
+				Thread::Yield();
+				continue;
+			}
+			USIZE sum = 0;
+			for (USIZE i = 0; i < popped; i++)
+				sum += batch[i];
+			shared->ConsumedSum.FetchAdd(sum, MemoryOrder::Relaxed);
+			shared->ConsumedCount.FetchAdd(popped, MemoryOrder::Relaxed);
+		}
+		return 0;
+	}
+
+	static BOOL TestSpscFillAndDrain()
+	{
+		SMALL_SPSC *queue = new SMALL_SPSC();
+		BOOL result = queue->GetSize() == 0;
+
+		for (USIZE i = 0; i < SMALL_SPSC::GetCapacity(); i++)
+			result = result && queue->TryPush(i * 3);
+		result = result && !queue->TryPush(999) && queue->GetSize() == SMALL_SPSC::GetCapacity();
+
+		USIZE value = 0;
+		for (USIZE i = 0; i < SMALL_SPSC::GetCapacity(); i++)
+			result = result && queue->TryPop(value) && value == i * 3;
+		result = result && !queue->TryPop(value) && queue->GetSize() == 0;
+
+		delete queue;
+		return result;
+	}
+
+	static BOOL TestSpscBatch()
+	{
+		SMALL_SPSC *queue = new SMALL_SPSC();
+		USIZE input[100];
+		USIZE output[100];
+		for (USIZE i = 0; i < 100; i++)
+			input[i] = i + 1;
+
+		// Only capacity items fit
+		BOOL result = queue->TryPushBatch(input, 100) == 64;
+		result = result && queue->TryPopBatch(output, 40) == 40 && output[0] == 1 && output[39] == 40;
+
+		// Next batch wraps around the end of the ring
+		result = result && queue->TryPushBatch(input + 64, 36) == 36;
+		result = result && queue->TryPopBatch(output, 100) == 60;
+		for (USIZE i = 0; i < 60; i++)
+			result = result && output[i] == i + 41;
+		result = result && queue->TryPopBatch(output, 10) == 0;
+
+		delete queue;
+		return result;
+	}
+
+	static BOOL TestSpscConcurrent()
+	{
+		SMALL_SPSC *queue = new SMALL_SPSC();
+		Thread producer;
+		if (!producer.Create(SpscProducer, queue))
+		{
+			delete queue;
+			return FALSE;
+		}
+
+		BOOL result = TRUE;
+		USIZE expected = 1;
+		USIZE batch[16];
+		while (expected <= TransferCount)
+		{
+			USIZE popped = queue->TryPopBatch(batch, 16);
+			if (popped == 0)
+			{
+				Thread::Yield();
+				continue;
+			}
+			for (USIZE i = 0; i < popped; i++)
+			{
+				if (batch[i] != expected)
+					result = FALSE;
+				expected++;
+			}
+		}
+
+		producer.Join();
+		delete queue;
+		return result;
+	}
+
+	static BOOL TestMpmcFillAndDrain()
+	{
+		SMALL_MPMC *queue = new SMALL_MPMC();
+		BOOL result = queue->GetSize() == 0;
+
+		// Two laps exercise the sequence numbers of reused cells
+		for (USIZE lap = 0; lap < 2; lap++)
+		{
+			for (USIZE i = 0; i < SMALL_MPMC::GetCapacity(); i++)
+				result = result && queue->TryPush(lap * 1000 + i);
+			result = result && !queue->TryPush(999) && queue->GetSize() == SMALL_MPMC::GetCapacity();
+
+			USIZE value = 0;
+			for (USIZE i = 0; i < SMALL_MPMC::GetCapacity(); i++)
+				result = result && queue->TryPop(value) && value == lap * 1000 + i;
+			result = result && !queue->TryPop(value) && queue->GetSize() == 0;
+		}
+
+		delete queue;
+		return result;
+	}
+
+	static BOOL TestMpmcBatch()
+	{
+		SMALL_MPMC *queue = new SMALL_MPMC();
+		USIZE input[100];
+		USIZE output[100];
+		for (USIZE i = 0; i < 100; i++)
+			input[i] = i + 1;
+
+		BOOL result = queue->TryPushBatch(input, 100) == 64;
+		result = result && queue->TryPopBatch(output, 40) == 40 && output[0] == 1 && output[39] == 40;
+		result = result && queue->TryPushBatch(input + 64, 36) == 36;
+		result = result && queue->TryPopBatch(output, 100) == 60;
+		for (USIZE i = 0; i < 60; i++)
+			result = result && output[i] == i + 41;
+		result = result && queue->TryPopBatch(output, 10) == 0;
+
+		delete queue;
+		return result;
+	}
+
+	static BOOL TestMpmcConcurrent()
+	{
+		MPMC_SHARED *shared = new MPMC_SHARED();
+		Thread producers[ThreadsPerSide];
+		Thread consumers[ThreadsPerSide];
+		BOOL started = TRUE;
+
+		for (USIZE i = 0; i < ThreadsPerSide; i++)
+		{
+			started = consumers[i].Create(MpmcConsumer, shared) && started;
+			started = producers[i].Create(MpmcProducer, shared) && started;
+		}
+
+		for (USIZE i = 0; i < ThreadsPerSide; i++)
+		{
+			if (producers[i].IsJoinable())
+				producers[i].Join();
+		}
+		// Consumers exit once everything was produced and consumed
+		for (USIZE i = 0; i < ThreadsPerSide; i++)
+		{
+			if (consumers[i].IsJoinable())
+				consumers[i].Join();
+		}
+
+		// TransferCount is even; sums may wrap on 32-bit targets, consistently on both sides
+		const USIZE expectedSum = ThreadsPerSide * ((TransferCount / 2) * (TransferCount + 1));
+		BOOL result = started &&
+					  shared->ConsumedCount.Load() == TransferCount * ThreadsPerSide &&
+					  shared->ConsumedSum.Load() == expectedSum;
+
+		delete shared;
+		return result;
+	}
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "runtime.h"
+
+class ShaTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running SHA Tests..."_embed);
+
+		// Test 1: FIPS 180-4 example messages, instruction and portable rounds
+		if (!TestSha256Vectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SHA-256 vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SHA-256 vectors"_embed);
+		}
+
+		// Test 2: One million 'a' fed in uneven pieces
+		if (!TestSha256Streaming())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SHA-256 streaming"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SHA-256 streaming"_embed);
+		}
+
+		// Test 3: Both paths agree around the padding boundaries and over many blocks
+		if (!TestSha256Paths())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SHA-256 paths agree"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SHA-256 paths agree"_embed);
+		}
+
+		// Test 4: SHA-1 example messages
+		if (!TestSha1Vectors())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SHA-1 vectors"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SHA-1 vectors"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All SHA tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some SHA tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr USIZE MillionSize = 1000000;
+
+	static BOOL MatchesHex(const UINT8 *digest, USIZE size, const CHAR *hex)
+	{
+		UINT8 expected[SHA256_DIGEST_SIZE];
+		return Hex::Decode(hex, size * 2, expected, sizeof(expected)) == (SSIZE)size && Memory::Compare(digest, expected, size) == 0;
+	}
+
+	// The default path (instructions where available) and the portable rounds
+	static BOOL CheckSha256(const CHAR *message, USIZE length, const CHAR *hex)
+	{
+		UINT8 digest[SHA256_DIGEST_SIZE];
+		Sha256::Compute(message, length, digest);
+		if (!MatchesHex(digest, SHA256_DIGEST_SIZE, hex))
+			return FALSE;
+
+		Sha256 sha;
+		sha.UsePortable();
+		sha.Update(message, length);
+		sha.Final(digest);
+		return MatchesHex(digest, SHA256_DIGEST_SIZE, hex);
+	}
+
+	static BOOL CheckSha1(const CHAR *message, USIZE length, const CHAR *hex)
+	{
+		UINT8 digest[SHA1_DIGEST_SIZE];
+		Sha1::Compute(message, length, digest);
+		return MatchesHex(digest, SHA1_DIGEST_SIZE, hex);
+	}
+
+	static BOOL TestSha256Vectors()
+	{
+		auto abc = "abc"_embed;
+		auto two = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"_embed;
+		auto fox = "The quick brown fox jumps over the lazy dog"_embed;
+
+		return CheckSha256(NULL, 0, (const CHAR *)"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_embed) &&
+			   CheckSha256((const CHAR *)abc, abc.Length, (const CHAR *)"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"_embed) &&
+			   CheckSha256((const CHAR *)two, two.Length, (const CHAR *)"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"_embed) &&
+			   CheckSha256((const CHAR *)fox, fox.Length, (const CHAR *)"d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592"_embed);
+	}
+
+	static BOOL TestSha256Streaming()
+	{
+		PUINT8 data = new UINT8[MillionSize];
+		Memory::Set(data, 'a', MillionSize);
+		auto expected = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"_embed;
+
+		BOOL passed = CheckSha256((const CHAR *)data, MillionSize, (const CHAR *)expected);
+
+		// Pieces that end inside, exactly on and just past a block
+		for (UINT32 path = 0; path < 2 && passed; path++)
+		{
+			Sha256 sha;
+			if (path == 1)
+				sha.UsePortable();
+			USIZE offset = 0;
+			for (USIZE piece = 1; offset < MillionSize; piece = piece * 3 % 1031 + 1)
+			{
+				USIZE size = piece < MillionSize - offset ? piece : MillionSize - offset;
+				sha.Update(data + offset, size);
+				offset += size;
+			}
+			UINT8 digest[SHA256_DIGEST_SIZE];
+			sha.Final(digest);
+			passed = MatchesHex(digest, SHA256_DIGEST_SIZE, (const CHAR *)expected);
+		}
+
+		delete[] data;
+		return passed;
+	}
+
+	static BOOL TestSha256Paths()
+	{
+		UINT8 data[1024];
+		UINT32 state = 0x2545F491;
+		for (USIZE i = 0; i < sizeof(data); i++)
+		{
+			state = state * 1664525 + 1013904223;
+			data[i] = (UINT8)(state >> 24);
+		}
+
+		// Lengths around 55/56/64 change how many padding blocks Final adds; the caller's choice matches both
+		BOOL hardware = Sha256::IsHardwareAvailable();
+		for (USIZE size = 0; size <= sizeof(data); size += size < 200 ? 1 : 61)
+		{
+			UINT8 fast[SHA256_DIGEST_SIZE];
+			UINT8 chosen[SHA256_DIGEST_SIZE];
+			UINT8 portable[SHA256_DIGEST_SIZE];
+			Sha256::Compute(data, size, fast);
+			Sha256::Compute(data, size, chosen, hardware);
+
+			Sha256 sha;
+			sha.UsePortable();
+			sha.Update(data, size / 3);
+			sha.Update(data + size / 3, size - size / 3);
+			sha.Final(portable);
+			if (Memory::Compare(fast, portable, SHA256_DIGEST_SIZE) != 0 || Memory::Compare(chosen, portable, SHA256_DIGEST_SIZE) != 0)
+				return FALSE;
+		}
+
+		// Init restarts the hash
+		Sha256 sha;
+		sha.Update(data, 100);
+		sha.Init();
+		UINT8 digest[SHA256_DIGEST_SIZE];
+		sha.Final(digest);
+		return MatchesHex(digest, SHA256_DIGEST_SIZE, (const CHAR *)"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_embed);
+	}
+
+	static BOOL TestSha1Vectors()
+	{
+		auto abc = "abc"_embed;
+		auto two = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"_embed;
+
+		if (!CheckSha1(NULL, 0, (const CHAR *)"da39a3ee5e6b4b0d3255bfef95601890afd80709"_embed) ||
+			!CheckSha1((const CHAR *)abc, abc.Length, (const CHAR *)"a9993e364706816aba3e25717850c26c9cd0d89d"_embed) ||
+			!CheckSha1((const CHAR *)two, two.Length, (const CHAR *)"84983e441c3bd26ebaae4aa1f95129e5e54670f1"_embed))
+			return FALSE;
+
+		PUINT8 data = new UINT8[MillionSize];
+		Memory::Set(data, 'a', MillionSize);
+		Sha1 sha;
+		for (USIZE offset = 0; offset < MillionSize; offset += 1000)
+			sha.Update(data + offset, 1000);
+		UINT8 digest[SHA1_DIGEST_SIZE];
+		sha.Final(digest);
+		delete[] data;
+		return MatchesHex(digest, SHA1_DIGEST_SIZE, (const CHAR *)"34aa973cd4c4daa4f61eeb2bdbad27316534016f"_embed);
+	}
+};
@@ -0,0 +1,375 @@
+#pragma once
+
+#include "runtime.h"
+
+class SortTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Sort Tests..."_embed);
+
+		// Test 1: Random, sorted, reversed, equal and few-valued inputs of many sizes
+		if (!TestSortPatterns())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Sort patterns"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Sort patterns"_embed);
+		}
+
+		// Test 2: An adversary that defeats any quicksort pivot stays O(n log n)
+		if (!TestSortDepthLimit())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Depth limit"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Depth limit"_embed);
+		}
+
+		// Test 3: Functor comparators and move-only elements
+		if (!TestSortComparators())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Comparators"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Comparators"_embed);
+		}
+
+		// Test 4: RadixSort on unsigned, signed and UINT64 keys, stable through a key functor
+		if (!TestRadixSort())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: RadixSort"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: RadixSort"_embed);
+		}
+
+		// Test 5: LowerBound and UpperBound agree with a linear scan
+		if (!TestBounds())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: LowerBound, UpperBound"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: LowerBound, UpperBound"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Sort tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Sort tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static UINT32 NextRandom(UINT32 &state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// Sorted, and the same multiset as before: the sum and xor of the values match
+	static BOOL IsSortedPermutation(const UINT32 *values, USIZE count, UINT32 sum, UINT32 bits)
+	{
+		for (USIZE i = 0; i < count; i++)
+		{
+			if (i > 0 && values[i] < values[i - 1])
+				return FALSE;
+			sum -= values[i];
+			bits ^= values[i];
+		}
+		return sum == 0 && bits == 0;
+	}
+
+	static BOOL TestSortPatterns()
+	{
+		const USIZE maximum = 3000;
+		UINT32 *values = new UINT32[maximum];
+		UINT32 state = 0x2545F491;
+		BOOL passed = TRUE;
+		for (USIZE count = 0; count <= maximum && passed; count = count < 40 ? count + 1 : count * 3 / 2)
+		{
+			for (UINT32 pattern = 0; pattern < 6 && passed; pattern++)
+			{
+				UINT32 sum = 0;
+				UINT32 bits = 0;
+				for (USIZE i = 0; i < count; i++)
+				{
+					UINT32 value;
+					if (pattern == 0)
+						value = NextRandom(state);
+					else if (pattern == 1)
+						value = (UINT32)i;
+					else if (pattern == 2)
+						value = (UINT32)(count - i);
+					else if (pattern == 3)
+						value = 7;
+					else if (pattern == 4)
+						value = NextRandom(state) % 4;
+					else
+						value = (UINT32)(i < count / 2 ? i : count - i); // Organ pipe
+					values[i] = value;
+					sum += value;
+					bits ^= value;
+				}
+				Sort(values, count);
+				passed = IsSortedPermutation(values, count, sum, bits);
+			}
+		}
+
+		// The fallbacks on their own
+		for (UINT32 round = 0; round < 2 && passed; round++)
+		{
+			UINT32 sum = 0;
+			UINT32 bits = 0;
+			for (USIZE i = 0; i < 500; i++)
+			{
+				values[i] = NextRandom(state) % 1000;
+				sum += values[i];
+				bits ^= values[i];
+			}
+			if (round == 0)
+				HeapSort(values, 500);
+			else
+				InsertionSort(values, 500);
+			passed = IsSortedPermutation(values, 500, sum, bits);
+		}
+		delete[] values;
+		return passed;
+	}
+
+	// McIlroy's adversary: values are fixed only when compared, always so that the pivot is near one end
+	struct Adversary
+	{
+		UINT32 *Values;
+		UINT32 Gas;
+		UINT32 Solid;
+		UINT32 Candidate;
+		USIZE Comparisons;
+	};
+
+	static BOOL TestSortDepthLimit()
+	{
+		const UINT32 count = 8192;
+		Adversary adversary;
+		adversary.Values = new UINT32[count];
+		adversary.Gas = count;
+		adversary.Solid = 0;
+		adversary.Candidate = 0;
+		adversary.Comparisons = 0;
+		UINT32 *items = new UINT32[count];
+		for (UINT32 i = 0; i < count; i++)
+		{
+			items[i] = i;
+			adversary.Values[i] = adversary.Gas;
+		}
+
+		Adversary *state = &adversary;
+		Sort(items, count, [state](UINT32 x, UINT32 y)
+		{
+			state->Comparisons++;
+			UINT32 *values = state->Values;
+			if (values[x] == state->Gas && values[y] == state->Gas)
+				values[x == state->Candidate ? x : y] = state->Solid++;
+			if (values[x] == state->Gas)
+				state->Candidate = x;
+			else if (values[y] == state->Gas)
+				state->Candidate = y;
+			return values[x] < values[y];
+		});
+
+		// A quadratic sort would need millions of comparisons here; n log2 n is about 106000
+		BOOL passed = adversary.Comparisons < 8 * 106000;
+		for (UINT32 i = 1; i < count && passed; i++)
+			passed = adversary.Values[items[i - 1]] <= adversary.Values[items[i]];
+		delete[] items;
+		delete[] adversary.Values;
+		return passed;
+	}
+
+	struct Record
+	{
+		UINT32 Key;
+		UINT32 Order;
+	};
+
+	struct ByKeyDescending
+	{
+		BOOL operator()(const Record &a, const Record &b) const { return a.Key > b.Key; }
+	};
+
+	static BOOL TestSortComparators()
+	{
+		// A functor type: descending keys
+		Record records[200];
+		UINT32 state = 0x9E3779B9;
+		for (UINT32 i = 0; i < 200; i++)
+		{
+			records[i].Key = NextRandom(state) % 50;
+			records[i].Order = i;
+		}
+		Sort(records, 200, ByKeyDescending());
+		for (UINT32 i = 1; i < 200; i++)
+		{
+			if (records[i - 1].Key < records[i].Key)
+				return FALSE;
+		}
+
+		// Move-only strings, ordered by content through a lambda
+		Vector<NarrowString> names;
+		auto format = "module_%u.dll"_embed;
+		for (UINT32 i = 0; i < 100; i++)
+		{
+			NarrowString name;
+			if (!name.Format((const CHAR*)format, (NextRandom(state) % 1000) * 1000003U) || !names.Push(Move(name)))
+				return FALSE;
+		}
+		auto byText = [](const NarrowString &a, const NarrowString &b)
+		{
+			return String::Compare(a.GetData(), a.GetLength(), b.GetData(), b.GetLength()) < 0;
+		};
+		Sort(names.GetData(), names.GetSize(), byText);
+		for (USIZE i = 1; i < names.GetSize(); i++)
+		{
+			if (byText(names[i], names[i - 1]))
+				return FALSE;
+		}
+		return names[0].GetLength() > 0 && names[99].GetLength() > 0;
+	}
+
+	static BOOL TestRadixSort()
+	{
+		const USIZE count = 5000;
+		UINT32 *values = new UINT32[count];
+		UINT32 *expected = new UINT32[count];
+		UINT32 state = 0x12345678;
+		BOOL passed = TRUE;
+
+		// Full 32-bit keys, then keys that differ in one byte only (the other passes are skipped)
+		for (UINT32 round = 0; round < 2 && passed; round++)
+		{
+			for (USIZE i = 0; i < count; i++)
+			{
+				UINT32 random = NextRandom(state);
+				values[i] = round == 0 ? random : 0xAB00CD00 | ((random & 0xFF) << 16);
+				expected[i] = values[i];
+			}
+			Sort(expected, count);
+			passed = RadixSort(values, count) && Memory::Compare(values, expected, count * sizeof(UINT32)) == 0;
+		}
+
+		// Signed keys: negatives first
+		INT32 *signedValues = new INT32[300];
+		for (INT32 i = 0; i < 300; i++)
+			signedValues[i] = (INT32)(NextRandom(state) % 2001) - 1000;
+		signedValues[0] = (INT32)0x80000000;
+		signedValues[1] = 0x7FFFFFFF;
+		if (passed && RadixSort(signedValues, 300))
+		{
+			for (UINT32 i = 1; i < 300 && passed; i++)
+				passed = signedValues[i - 1] <= signedValues[i];
+			passed = passed && signedValues[0] == (INT32)0x80000000 && signedValues[299] == 0x7FFFFFFF;
+		}
+		else
+		{
+			passed = FALSE;
+		}
+
+		// Software UINT64 keys that differ in the high word, with caller-provided scratch
+		UINT64 *wide = new UINT64[300];
+		UINT64 *wideScratch = new UINT64[300];
+		for (UINT32 i = 0; i < 300; i++)
+			wide[i] = UINT64(NextRandom(state) % 64, NextRandom(state) % 8);
+		RadixSort(wide, wideScratch, 300);
+		for (UINT32 i = 1; i < 300 && passed; i++)
+			passed = wide[i - 1] <= wide[i];
+
+		// Native 64-bit keys
+		unsigned long long *native = new unsigned long long[300];
+		for (UINT32 i = 0; i < 300; i++)
+			native[i] = ((unsigned long long)NextRandom(state) << 32) | NextRandom(state);
+		passed = passed && RadixSort(native, 300);
+		for (UINT32 i = 1; i < 300 && passed; i++)
+			passed = native[i - 1] <= native[i];
+
+		// Records by key: equal keys keep their original order
+		Record *records = new Record[1000];
+		Record *scratch = new Record[1000];
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			records[i].Key = NextRandom(state) % 300;
+			records[i].Order = i;
+		}
+		RadixSort(records, scratch, 1000, [](const Record &record) { return record.Key; });
+		for (UINT32 i = 1; i < 1000 && passed; i++)
+		{
+			passed = records[i - 1].Key < records[i].Key ||
+					 (records[i - 1].Key == records[i].Key && records[i - 1].Order < records[i].Order);
+		}
+
+		delete[] scratch;
+		delete[] records;
+		delete[] native;
+		delete[] wideScratch;
+		delete[] wide;
+		delete[] signedValues;
+		delete[] expected;
+		delete[] values;
+		return passed;
+	}
+
+	static BOOL TestBounds()
+	{
+		// 0, 0, 0, 2, 2, 2, ... with every even value three times
+		UINT32 values[300];
+		for (UINT32 i = 0; i < 300; i++)
+			values[i] = i / 3 * 2;
+
+		for (USIZE count = 0; count <= 300; count += 37)
+		{
+			for (UINT32 key = 0; key < 205; key++)
+			{
+				USIZE lower = 0;
+				while (lower < count && values[lower] < key)
+					lower++;
+				USIZE upper = lower;
+				while (upper < count && values[upper] <= key)
+					upper++;
+				if (LowerBound(values, count, key) != lower || UpperBound(values, count, key) != upper)
+					return FALSE;
+			}
+		}
+
+		// A key of another type than the elements: records searched by key alone
+		Record records[64];
+		for (UINT32 i = 0; i < 64; i++)
+		{
+			records[i].Key = i * 10;
+			records[i].Order = i;
+		}
+		auto recordBelow = [](const Record &record, UINT32 key) { return record.Key < key; };
+		auto keyBelow = [](UINT32 key, const Record &record) { return key < record.Key; };
+		return LowerBound(records, 64, 250U, recordBelow) == 25 && LowerBound(records, 64, 251U, recordBelow) == 26 &&
+			   UpperBound(records, 64, 250U, keyBelow) == 26 && UpperBound(records, 64, 1000U, keyBelow) == 64 &&
+			   LowerBound(records, 64, 0U, recordBelow) == 0;
+	}
+};
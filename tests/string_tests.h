@@ -99,6 +99,94 @@ public:
 			Logger::Info<WCHAR>(L"  PASSED: WideToUtf8 null handling"_embed);
 		}
 
+		// Test 9: Bounded decimal parsing
+		if (!TestParseDecimal())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Decimal parsing"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Decimal parsing"_embed);
+		}
+
+		// Test 10: Bounded hexadecimal parsing
+		if (!TestParseHex())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Hexadecimal parsing"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Hexadecimal parsing"_embed);
+		}
+
+		// Test 11: IndexOf on both paths agrees with a plain search
+		if (!TestIndexOf())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: IndexOf"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: IndexOf"_embed);
+		}
+
+		// Test 12: Compare, StartsWith and EndsWith
+		if (!TestCompare())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Compare, StartsWith, EndsWith"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Compare, StartsWith, EndsWith"_embed);
+		}
+
+		// Test 13: EqualsIgnoreCase folds ASCII letters only
+		if (!TestEqualsIgnoreCase())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: EqualsIgnoreCase"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: EqualsIgnoreCase"_embed);
+		}
+
+		// Test 14: UTF-16 to UTF-8 encodes every sequence length and rejects lone surrogates
+		if (!TestWideToUtf8Encoding())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: UTF-16 to UTF-8"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: UTF-16 to UTF-8"_embed);
+		}
+
+		// Test 15: UTF-8 to UTF-16 rejects every malformed sequence
+		if (!TestUtf8ToWide())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: UTF-8 to UTF-16"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: UTF-8 to UTF-16"_embed);
+		}
+
+		// Test 16: Round trips with non-ASCII text at every offset of the ASCII blocks
+		if (!TestTranscodeRoundTrip())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Transcoding round trip"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Transcoding round trip"_embed);
+		}
+
 		if (allPassed)
 		{
 			Logger::Info<WCHAR>(L"All String tests passed!"_embed);
@@ -258,4 +346,313 @@ private:
 
 		return TRUE;
 	}
+
+	static BOOL TestParseDecimal()
+	{
+		auto digits = "12345xyz"_embed;
+		auto signedText = "-9223372036854775808"_embed;
+		auto tooLarge = "9223372036854775808"_embed;
+		auto wide = L"+77"_embed;
+		UINT64 unsignedValue;
+		INT64 signedValue;
+
+		// Parsing stops at the first non-digit and honours the length limit
+		if (String::ParseUInt64((const CHAR*)digits, 8, unsignedValue) != 5 || unsignedValue != 12345U)
+			return FALSE;
+		if (String::ParseUInt64((const CHAR*)digits, 3, unsignedValue) != 3 || unsignedValue != 123U)
+			return FALSE;
+		if (String::ParseUInt64((const CHAR*)digits + 5, 3, unsignedValue) != 0)
+			return FALSE;
+
+		// INT64 range is asymmetric
+		if (String::ParseInt64((const CHAR*)signedText, 20, signedValue) != 20 || signedValue != INT64((INT32)0x80000000, 0U))
+			return FALSE;
+		if (String::ParseInt64((const CHAR*)tooLarge, 19, signedValue) != 0)
+			return FALSE;
+		if (String::ParseInt64((const CHAR*)signedText, 1, signedValue) != 0)
+			return FALSE;
+
+		if (String::ParseInt64((const WCHAR*)wide, 3, signedValue) != 3 || signedValue != INT64(77))
+			return FALSE;
+
+		return TRUE;
+	}
+
+	static BOOL TestParseHex()
+	{
+		auto prefixed = "0xDeadBeef01"_embed;
+		auto bare = "ffffffffffffffff0"_embed;
+		auto prefixOnly = "0xg"_embed;
+		UINT64 value;
+
+		if (String::ParseHex((const CHAR*)prefixed, 12, value) != 12 || value != UINT64(0xDEU, 0xADBEEF01U))
+			return FALSE;
+
+		// Sixteen digits fit, a seventeenth overflows
+		if (String::ParseHex((const CHAR*)bare, 16, value) != 16 || value != UINT64(0xFFFFFFFFU, 0xFFFFFFFFU))
+			return FALSE;
+		if (String::ParseHex((const CHAR*)bare, 17, value) != 0)
+			return FALSE;
+
+		// "0x" without digits is the number zero
+		if (String::ParseHex((const CHAR*)prefixOnly, 3, value) != 1 || value != 0U)
+			return FALSE;
+
+		return TRUE;
+	}
+
+	// First match the slow way
+	template <TCHAR TChar>
+	static SSIZE NaiveIndexOf(const TChar *text, USIZE length, const TChar *pattern, USIZE patternLength)
+	{
+		for (USIZE i = 0; i + patternLength <= length; i++)
+		{
+			USIZE j = 0;
+			while (j < patternLength && text[i + j] == pattern[j])
+				j++;
+			if (j == patternLength)
+				return (SSIZE)i;
+		}
+		return -1;
+	}
+
+	// Patterns cut from a three-letter text, plus variants that are absent, across both IndexOf paths
+	template <TCHAR TChar>
+	static BOOL CheckIndexOf()
+	{
+		TChar text[2000];
+		UINT32 state = 12345;
+		for (UINT32 i = 0; i < 2000; i++)
+		{
+			state = state * 1103515245 + 12345;
+			text[i] = (TChar)('a' + (state >> 16) % 3);
+		}
+
+		TChar pattern[40];
+		for (USIZE patternLength = 1; patternLength <= 40; patternLength++)
+		{
+			for (USIZE offset = 0; offset + patternLength <= 2000; offset += 97)
+			{
+				for (USIZE j = 0; j < patternLength; j++)
+					pattern[j] = text[offset + j];
+				if (String::IndexOf(text, 2000, pattern, patternLength) != NaiveIndexOf(text, 2000, pattern, patternLength))
+					return FALSE;
+
+				// A unit the text never holds, at the end and in the middle
+				pattern[patternLength - 1] = (TChar)'d';
+				if (String::IndexOf(text, 2000, pattern, patternLength) != -1)
+					return FALSE;
+				pattern[patternLength / 2] = (TChar)'d';
+				if (String::IndexOf(text, 2000 - offset, pattern, patternLength) != -1)
+					return FALSE;
+			}
+		}
+
+		// Matches in the last few positions go through the scalar tail
+		for (USIZE patternLength = 1; patternLength <= 20; patternLength++)
+		{
+			USIZE length = 2000 - patternLength / 3;
+			const TChar *tail = text + length - patternLength;
+			if (String::IndexOf(text, length, tail, patternLength) != NaiveIndexOf(text, length, tail, patternLength))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	static BOOL TestIndexOf()
+	{
+		if (!CheckIndexOf<CHAR>() || !CheckIndexOf<WCHAR>())
+			return FALSE;
+
+		auto text = "kernel32.dll\0ntdll.dll"_embed;
+		auto dll = ".dll"_embed;
+		auto ntdll = "ntdll"_embed;
+		if (String::IndexOf((const CHAR*)text, 22, (const CHAR*)dll, 4) != 8 || String::IndexOf((const CHAR*)text, 22, (const CHAR*)ntdll, 5) != 13)
+			return FALSE;
+
+		// Empty pattern, pattern longer than the text, and a single unit
+		if (String::IndexOf((const CHAR*)text, 22, (const CHAR*)dll, 0) != 0 || String::IndexOf((const CHAR*)dll, 4, (const CHAR*)text, 22) != -1)
+			return FALSE;
+		auto wide = L"C:\\Windows\\System32"_embed;
+		return String::IndexOf((const WCHAR*)wide, 19, (WCHAR)L'S') == 11 && String::IndexOf((const WCHAR*)wide, 19, (WCHAR)L'/') == -1;
+	}
+
+	static BOOL TestCompare()
+	{
+		auto apple = "apple pie with cream"_embed;
+		auto apricot = "apple pie with crumble"_embed;
+		auto high = "apple pie with cr\xE9me"_embed;
+		const CHAR *a = (const CHAR*)apple;
+		const CHAR *b = (const CHAR*)apricot;
+
+		if (String::Compare(a, 20, b, 22) >= 0 || String::Compare(b, 22, a, 20) <= 0 || String::Compare(a, 20, a, 20) != 0)
+			return FALSE;
+
+		// A prefix sorts first; units above 0x7F compare as unsigned
+		if (String::Compare(a, 10, a, 20) >= 0 || String::Compare((const CHAR*)high, 20, a, 20) <= 0)
+			return FALSE;
+
+		auto wideA = L"System32\\ntdll.dll"_embed;
+		auto wideB = L"System32\\ntdlm.dll"_embed;
+		if (String::Compare((const WCHAR*)wideA, 18, (const WCHAR*)wideB, 18) >= 0)
+			return FALSE;
+
+		auto prefix = "apple"_embed;
+		auto suffix = "cream"_embed;
+		if (!String::StartsWith(a, 20, (const CHAR*)prefix, 5) || String::StartsWith((const CHAR*)prefix, 5, a, 20))
+			return FALSE;
+		if (!String::EndsWith(a, 20, (const CHAR*)suffix, 5) || String::EndsWith(b, 22, (const CHAR*)suffix, 5))
+			return FALSE;
+
+		auto dll = L".dll"_embed;
+		return String::EndsWith((const WCHAR*)wideA, 18, (const WCHAR*)dll, 4) && String::StartsWith((const WCHAR*)wideA, 18, (const WCHAR*)dll, 0);
+	}
+
+	static BOOL TestEqualsIgnoreCase()
+	{
+		auto upper = "KERNEL32.DLL with a long tail [@]"_embed;
+		auto lower = "kernel32.dll WITH A LONG TAIL [@]"_embed;
+		if (!String::EqualsIgnoreCase((const CHAR*)upper, 33, (const CHAR*)lower, 33) || String::EqualsIgnoreCase((const CHAR*)upper, 33, (const CHAR*)lower, 32))
+			return FALSE;
+
+		// '@' and '[' sit next to 'A' and 'Z' and must not fold onto '`' and '{'
+		auto edges = "@[AZ"_embed;
+		auto folded = "`{az"_embed;
+		auto letters = "@[az"_embed;
+		if (String::EqualsIgnoreCase((const CHAR*)edges, 4, (const CHAR*)folded, 4) || !String::EqualsIgnoreCase((const CHAR*)edges, 4, (const CHAR*)letters, 4))
+			return FALSE;
+
+		// 0xC1 has 'A' in its low seven bits but is not a letter
+		auto highA = "\xC1\xC1\xC1\xC1\xC1\xC1\xC1\xC1"_embed;
+		auto highAFolded = "\xE1\xE1\xE1\xE1\xE1\xE1\xE1\xE1"_embed;
+		if (String::EqualsIgnoreCase((const CHAR*)highA, 8, (const CHAR*)highAFolded, 8))
+			return FALSE;
+
+		// Wide: U+0141 and U+0161 differ only in the bit a letter's case uses
+		auto wideUpper = L"NTDLL.DLL\x0141\x0141\x0141\x0141"_embed;
+		auto wideLower = L"ntdll.dll\x0141\x0141\x0141\x0141"_embed;
+		auto wideOther = L"ntdll.dll\x0161\x0141\x0141\x0141"_embed;
+		return String::EqualsIgnoreCase((const WCHAR*)wideUpper, 13, (const WCHAR*)wideLower, 13) &&
+			   !String::EqualsIgnoreCase((const WCHAR*)wideUpper, 13, (const WCHAR*)wideOther, 13);
+	}
+
+	static BOOL TestWideToUtf8Encoding()
+	{
+		// "A", U+00E9, U+20AC, U+1F600 (a surrogate pair): 1, 2, 3 and 4 bytes
+		WCHAR wide[5] = {L'A', 0x00E9, 0x20AC, 0xD83D, 0xDE00};
+		auto expected = "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"_embed;
+		CHAR utf8[16];
+		if (String::GetUtf8Length(wide, 5) != 10 || String::WideToUtf8(wide, 5, utf8, sizeof(utf8)) != 10)
+			return FALSE;
+		if (Memory::Compare(utf8, (const CHAR*)expected, 10) != 0)
+			return FALSE;
+
+		// The exact length fits; one byte less does not
+		if (String::WideToUtf8(wide, 5, utf8, 10) != 10 || String::WideToUtf8(wide, 5, utf8, 9) != -1)
+			return FALSE;
+
+		// A high surrogate at the end, one followed by a non-surrogate, and a lone low surrogate
+		if (String::GetUtf8Length(wide, 4) != -1 || String::WideToUtf8(wide, 4, utf8, sizeof(utf8)) != -1)
+			return FALSE;
+		WCHAR broken[3] = {0xD83D, L'x', 0xDE00};
+		if (String::GetUtf8Length(broken, 2) != -1 || String::GetUtf8Length(broken + 2, 1) != -1 || String::GetUtf8Length(broken + 1, 1) != 1)
+			return FALSE;
+
+		// The null-terminated form leaves an empty string rather than partial output
+		WCHAR terminated[4] = {L'a', L'b', 0xDE00, 0};
+		if (String::WideToUtf8(terminated, utf8, sizeof(utf8)) != 0 || utf8[0] != '\0')
+			return FALSE;
+		terminated[2] = L'c';
+		if (String::WideToUtf8(terminated, utf8, 3) != 0 || String::WideToUtf8(terminated, utf8, 4) != 3)
+			return FALSE;
+		return utf8[2] == 'c' && utf8[3] == '\0';
+	}
+
+	// TRUE if the UTF-8 text is rejected by both the length function and the converter
+	static BOOL IsRejected(const CHAR *utf8, USIZE length)
+	{
+		WCHAR wide[8];
+		return String::GetWideLength(utf8, length) == -1 && String::Utf8ToWide(utf8, length, wide, 8) == -1;
+	}
+
+	static BOOL TestUtf8ToWide()
+	{
+		auto text = "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"_embed;
+		WCHAR wide[8];
+		if (String::GetWideLength((const CHAR*)text, 10) != 5 || String::Utf8ToWide((const CHAR*)text, 10, wide, 8) != 5)
+			return FALSE;
+		if (wide[0] != L'A' || wide[1] != 0x00E9 || wide[2] != 0x20AC || wide[3] != 0xD83D || wide[4] != 0xDE00)
+			return FALSE;
+
+		// A pair needs room for both units
+		if (String::Utf8ToWide((const CHAR*)text, 10, wide, 4) != -1 || String::Utf8ToWide((const CHAR*)text, 6, wide, 3) != 3)
+			return FALSE;
+
+		// The extremes of each sequence length are accepted
+		auto edges = "\xC2\x80\xDF\xBF\xE0\xA0\x80\xED\x9F\xBF\xEE\x80\x80\xF0\x90\x80\x80\xF4\x8F\xBF\xBF"_embed;
+		WCHAR decoded[9];
+		if (String::Utf8ToWide((const CHAR*)edges, 21, decoded, 9) != 9 || decoded[3] != 0xD7FF || decoded[4] != 0xE000)
+			return FALSE;
+		if (decoded[5] != 0xD800 || decoded[6] != 0xDC00 || decoded[7] != 0xDBFF || decoded[8] != 0xDFFF)
+			return FALSE;
+
+		// Overlong forms of '/' and U+07FF, and of U+FFFF in four bytes
+		auto overlong = "\xC0\xAF\xC1\xBF\xE0\x9F\xBF\xF0\x8F\xBF\xBF"_embed;
+		const CHAR *o = (const CHAR*)overlong;
+		if (!IsRejected(o, 2) || !IsRejected(o + 2, 2) || !IsRejected(o + 4, 3) || !IsRejected(o + 7, 4))
+			return FALSE;
+
+		// Encoded surrogates, code points past U+10FFFF, and leads that never occur
+		auto outOfRange = "\xED\xA0\x80\xED\xBF\xBF\xF4\x90\x80\x80\xF5\x80\x80\x80\xFF"_embed;
+		const CHAR *r = (const CHAR*)outOfRange;
+		if (!IsRejected(r, 3) || !IsRejected(r + 3, 3) || !IsRejected(r + 6, 4) || !IsRejected(r + 10, 4) || !IsRejected(r + 14, 1))
+			return FALSE;
+
+		// Truncated sequences, a stray continuation byte, and a lead followed by ASCII
+		const CHAR *t = (const CHAR*)text;
+		if (!IsRejected(t + 1, 1) || !IsRejected(t + 3, 2) || !IsRejected(t + 6, 3) || !IsRejected(t + 2, 1))
+			return FALSE;
+		auto interrupted = "\xE2\x82x"_embed;
+		return IsRejected((const CHAR*)interrupted, 3);
+	}
+
+	static BOOL TestTranscodeRoundTrip()
+	{
+		// ASCII runs with one character of each length dropped in at every offset
+		const USIZE length = 100;
+		WCHAR wide[length];
+		CHAR utf8[length * 3];
+		WCHAR back[length];
+		WCHAR special[3] = {0x00E9, 0x20AC, 0xD83D};
+		for (USIZE kind = 0; kind < 3; kind++)
+		{
+			for (USIZE offset = 0; offset + 1 < length; offset++)
+			{
+				for (USIZE i = 0; i < length; i++)
+					wide[i] = (WCHAR)(L'a' + i % 26);
+				wide[offset] = special[kind];
+				if (kind == 2)
+					wide[offset + 1] = 0xDE00;
+
+				USIZE expectedLength = length + (kind == 2 ? 2 : kind + 1);
+				SSIZE written = String::WideToUtf8(wide, length, utf8, sizeof(utf8));
+				if (String::GetUtf8Length(wide, length) != (SSIZE)expectedLength || written != (SSIZE)expectedLength)
+					return FALSE;
+				if (String::GetWideLength(utf8, expectedLength) != (SSIZE)length || String::Utf8ToWide(utf8, expectedLength, back, length) != (SSIZE)length)
+					return FALSE;
+				if (Memory::Compare(back, wide, sizeof(wide)) != 0)
+					return FALSE;
+
+				// A buffer one unit short fails on either side
+				if (String::WideToUtf8(wide, length, utf8, expectedLength - 1) != -1 || String::Utf8ToWide(utf8, expectedLength, back, length - 1) != -1)
+					return FALSE;
+			}
+		}
+
+		// A stray byte in the last unit of a block is not skipped with the block
+		for (USIZE i = 0; i < length; i++)
+			utf8[i] = (CHAR)('a' + i % 26);
+		utf8[15] = (CHAR)0x80;
+		return String::GetWideLength(utf8, length) == -1 && String::Utf8ToWide(utf8, length, back, length) == -1;
+	}
 };
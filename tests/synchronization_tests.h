@@ -0,0 +1,275 @@
+#pragma once
+
+#include "runtime.h"
+
+class SynchronizationTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Synchronization Tests..."_embed);
+
+		// Test 1: Atomic operations return previous values
+		if (!TestAtomicOperations())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Atomic operations"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Atomic operations"_embed);
+		}
+
+		// Test 2: Atomic compare-exchange success and failure
+		if (!TestAtomicCompareExchange())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Atomic compare-exchange"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Atomic compare-exchange"_embed);
+		}
+
+		// Test 3: Concurrent atomic increments are not lost
+		if (!TestAtomicConcurrentIncrement())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Atomic concurrent increment"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Atomic concurrent increment"_embed);
+		}
+
+		// Test 4: SpinLock try-lock state
+		if (!TestSpinLockTryLock())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SpinLock try-lock"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SpinLock try-lock"_embed);
+		}
+
+		// Test 5: SpinLock protects a plain counter under contention
+		if (!TestSpinLockContention())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: SpinLock contention"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: SpinLock contention"_embed);
+		}
+
+		// Test 6: Mutex try-lock state
+		if (!TestMutexTryLock())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Mutex try-lock"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Mutex try-lock"_embed);
+		}
+
+		// Test 7: Mutex protects a plain counter under contention
+		if (!TestMutexContention())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Mutex contention"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Mutex contention"_embed);
+		}
+
+		// Test 8: An unpark issued before park is not lost
+		if (!TestUnparkBeforePark())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Unpark before park"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Unpark before park"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Synchronization tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Synchronization tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr USIZE WorkerCount = 4;
+	static constexpr USIZE IterationsPerWorker = 20000;
+
+	// Shared state for the contention tests
+	template <typename TLock>
+	struct SHARED_COUNTER
+	{
+		TLock Lock;
+		USIZE Value;
+		Atomic<USIZE> AtomicValue;
+	};
+
+	template <typename TLock>
+	static INT32 IncrementLocked(PVOID parameter)
+	{
+		SHARED_COUNTER<TLock> *shared = (SHARED_COUNTER<TLock> *)parameter;
+		for (USIZE i = 0; i < IterationsPerWorker; i++)
+		{
+			LockGuard<TLock> guard(shared->Lock);
+			// Split read-modify-write widens the race window if the lock is broken
+			USIZE value = shared->Value;
+			CpuRelax();
+			shared->Value = value + 1;
+		}
+		return 0;
+	}
+
+	static INT32 IncrementAtomic(PVOID parameter)
+	{
+		SHARED_COUNTER<SpinLock> *shared = (SHARED_COUNTER<SpinLock> *)parameter;
+		for (USIZE i = 0; i < IterationsPerWorker; i++)
+			shared->AtomicValue.FetchAdd(1, MemoryOrder::Relaxed);
+		return 0;
+	}
+
+	// Run routine on WorkerCount threads against the same shared state
+	static BOOL RunWorkers(THREAD_ROUTINE routine, PVOID shared)
+	{
+		Thread threads[WorkerCount];
+		BOOL started = TRUE;
+		for (USIZE i = 0; i < WorkerCount; i++)
+		{
+			if (!threads[i].Create(routine, shared))
+				started = FALSE;
+		}
+		for (USIZE i = 0; i < WorkerCount; i++)
+		{
+			if (threads[i].IsJoinable())
+				threads[i].Join();
+		}
+		return started;
+	}
+
+	static BOOL TestAtomicOperations()
+	{
+		Atomic<UINT32> value(10);
+		if (value.FetchAdd(5) != 10 || value.Load() != 15)
+			return FALSE;
+		if (value.FetchSub(3) != 15 || value.Load() != 12)
+			return FALSE;
+		if (value.FetchOr(0x100) != 12 || value.Load() != 0x10C)
+			return FALSE;
+		if (value.FetchAnd(0xFF) != 0x10C || value.Load() != 0x0C)
+			return FALSE;
+		if (value.FetchXor(0x0F) != 0x0C || value.Load() != 0x03)
+			return FALSE;
+		if (value.Exchange(99, MemoryOrder::AcquireRelease) != 0x03)
+			return FALSE;
+		value.Store(7, MemoryOrder::Release);
+		return value.Load(MemoryOrder::Acquire) == 7;
+	}
+
+	static BOOL TestAtomicCompareExchange()
+	{
+		Atomic<USIZE> value(1);
+
+		USIZE expected = 2;
+		if (value.CompareExchangeStrong(expected, 3))
+			return FALSE;
+		// Failed exchange reports the observed value
+		if (expected != 1)
+			return FALSE;
+
+		if (!value.CompareExchangeStrong(expected, 3))
+			return FALSE;
+
+		// Weak form may fail spuriously, so retry
+		expected = 3;
+		while (!value.CompareExchangeWeak(expected, 4, MemoryOrder::Acquire))
+		{
+			if (expected != 3)
+				return FALSE;
+		}
+		return value.Load() == 4;
+	}
+
+	static BOOL TestAtomicConcurrentIncrement()
+	{
+		SHARED_COUNTER<SpinLock> shared;
+		shared.Value = 0;
+		if (!RunWorkers(IncrementAtomic, &shared))
+			return FALSE;
+		return shared.AtomicValue.Load() == WorkerCount * IterationsPerWorker;
+	}
+
+	static BOOL TestSpinLockTryLock()
+	{
+		SpinLock lock;
+		if (lock.IsLocked() || !lock.TryLock())
+			return FALSE;
+		if (!lock.IsLocked() || lock.TryLock())
+			return FALSE;
+		lock.Unlock();
+		if (lock.IsLocked() || !lock.TryLock())
+			return FALSE;
+		lock.Unlock();
+		return !lock.IsLocked();
+	}
+
+	static BOOL TestSpinLockContention()
+	{
+		SHARED_COUNTER<SpinLock> shared;
+		shared.Value = 0;
+		if (!RunWorkers(IncrementLocked<SpinLock>, &shared))
+			return FALSE;
+		return shared.Value == WorkerCount * IterationsPerWorker && !shared.Lock.IsLocked();
+	}
+
+	static BOOL TestMutexTryLock()
+	{
+		Mutex lock;
+		if (lock.IsLocked() || !lock.TryLock())
+			return FALSE;
+		if (!lock.IsLocked() || lock.TryLock())
+			return FALSE;
+		lock.Unlock();
+		if (lock.IsLocked())
+			return FALSE;
+		lock.Lock();
+		BOOL locked = lock.IsLocked();
+		lock.Unlock();
+		return locked && !lock.IsLocked();
+	}
+
+	static BOOL TestMutexContention()
+	{
+		SHARED_COUNTER<Mutex> shared;
+		shared.Value = 0;
+		if (!RunWorkers(IncrementLocked<Mutex>, &shared))
+			return FALSE;
+		return shared.Value == WorkerCount * IterationsPerWorker && !shared.Lock.IsLocked();
+	}
+
+	static BOOL TestUnparkBeforePark()
+	{
+		// The pending wakeup must make Park return instead of blocking forever
+		Thread::Unpark(Thread::GetCurrentId());
+		Thread::Park(NULL);
+		return TRUE;
+	}
+};
@@ -12,6 +12,24 @@
  *   Int64Tests             - Signed 64-bit integer tests
  *   DoubleTests            - Floating-point tests
  *   StringFormatterTests   - Printf-style formatting tests
+ *   ThreadTests            - Thread create/join tests
+ *   ThreadContextTests     - Per-thread context, arena and cache tests
+ *   SynchronizationTests   - Atomic, SpinLock and Mutex tests
+ *   ThreadPoolTests        - Work-stealing pool and ParallelFor tests
+ *   QueueTests             - SPSC and MPMC queue tests
+ *   CoroutineTests         - Task, executor and AsyncEvent tests
+ *   AsyncIoTests           - Batched asynchronous file I/O tests
+ *   FileTests              - File and buffered stream tests
+ *   MappedFileTests        - Memory-mapped file view tests
+ *   TimerTests             - Clock, cycle counter, stopwatch and histogram tests
+ *   Lz4Tests               - LZ4 block compression and decompression tests
+ *   EncodingTests          - Base64 and hex encode/decode tests
+ *   ChecksumTests          - CRC32C and XXH64 tests
+ *   ShaTests               - SHA-256 and SHA-1 vector tests
+ *   VectorTests            - Vector growth, inline storage, lifetimes and allocators
+ *   HashMapTests           - HashMap lookups, removal, precomputed hashes and statistics
+ *   BasicStringTests       - BasicString inline storage, growth, formatting and moves
+ *   SortTests              - Introsort patterns and depth limit, radix sort keys, binary search bounds
  *
  * USAGE:
  *   #include "tests.h"
@@ -31,3 +49,21 @@
 #include "int64_tests.h"
 #include "double_tests.h"
 #include "string_formatter_tests.h"
+#include "thread_tests.h"
+#include "thread_context_tests.h"
+#include "synchronization_tests.h"
+#include "thread_pool_tests.h"
+#include "queue_tests.h"
+#include "coroutine_tests.h"
+#include "async_io_tests.h"
+#include "file_tests.h"
+#include "mapped_file_tests.h"
+#include "timer_tests.h"
+#include "lz4_tests.h"
+#include "encoding_tests.h"
+#include "checksum_tests.h"
+#include "sha_tests.h"
+#include "vector_tests.h"
+#include "hash_map_tests.h"
+#include "basic_string_tests.h"
+#include "sort_tests.h"
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "runtime.h"
+
+class ThreadContextTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running ThreadContext Tests..."_embed);
+
+		// Test 1: Main thread has an attached context
+		if (!TestMainThreadContext())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Main thread context"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Main thread context"_embed);
+		}
+
+		// Test 2: Each thread sees its own context
+		if (!TestContextIsPerThread())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Context is per thread"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Context is per thread"_embed);
+		}
+
+		// Test 3: Arena alignment, rewind and exhaustion
+		if (!TestArena())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Arena"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Arena"_embed);
+		}
+
+		// Test 4: Scratch arena is backed on demand and scoped
+		if (!TestScratchArena())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Scratch arena"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Scratch arena"_embed);
+		}
+
+		// Test 5: Small sized frees are recycled by the thread cache
+		if (!TestAllocatorCache())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Allocator cache"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Allocator cache"_embed);
+		}
+
+		// Test 6: Resolved API addresses are cached
+		if (!TestApiCache())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: API cache"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: API cache"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All ThreadContext tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some ThreadContext tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	typedef struct _CONTEXT_PROBE
+	{
+		PTHREAD_CONTEXT Context;
+		USIZE ContextThreadId;
+		USIZE ThreadId;
+		BOOL ScratchUsable;
+	} CONTEXT_PROBE;
+
+	static INT32 ProbeContext(PVOID parameter)
+	{
+		CONTEXT_PROBE *probe = (CONTEXT_PROBE *)parameter;
+		probe->Context = ThreadContext::Get();
+		probe->ThreadId = Thread::GetCurrentId();
+		probe->ContextThreadId = probe->Context != NULL ? probe->Context->ThreadId : 0;
+		Arena *scratch = ThreadContext::GetScratch();
+		probe->ScratchUsable = scratch != NULL && scratch->Allocate(128) != NULL;
+		return 0;
+	}
+
+	static BOOL TestMainThreadContext()
+	{
+		PTHREAD_CONTEXT context = ThreadContext::Get();
+		return context != NULL && context->ThreadId == Thread::GetCurrentId() && ThreadContext::Get() == context;
+	}
+
+	static BOOL TestContextIsPerThread()
+	{
+		CONTEXT_PROBE probe = {NULL, 0, 0, FALSE};
+		Thread thread;
+		if (!thread.Create(ProbeContext, &probe))
+			return FALSE;
+		thread.Join();
+
+		return probe.Context != NULL &&
+			   probe.Context != ThreadContext::Get() &&
+			   probe.ContextThreadId == probe.ThreadId &&
+			   probe.ScratchUsable;
+	}
+
+	static BOOL TestArena()
+	{
+		UINT8 buffer[256];
+		Arena arena;
+		arena.InitializeBuffer(buffer, sizeof(buffer));
+
+		PUINT8 first = (PUINT8)arena.Allocate(3, 1);
+		PUINT8 aligned = (PUINT8)arena.Allocate(8, 16);
+		if (first == NULL || aligned == NULL || ((USIZE)aligned & 15) != 0 || aligned <= first)
+			return FALSE;
+
+		USIZE mark = arena.Mark();
+		if (arena.Allocate(64) == NULL || arena.GetUsed() <= mark)
+			return FALSE;
+		arena.Rewind(mark);
+		if (arena.GetUsed() != mark)
+			return FALSE;
+
+		// Requests beyond the remaining space fail without moving the offset
+		if (arena.Allocate(1024) != NULL || arena.GetUsed() != mark)
+			return FALSE;
+
+		arena.Reset();
+		return arena.GetUsed() == 0 && arena.Allocate(256, 1) == buffer && arena.Allocate(1, 1) == NULL;
+	}
+
+	static BOOL TestScratchArena()
+	{
+		Arena *scratch = ThreadContext::GetScratch();
+		if (scratch == NULL || scratch->GetCapacity() < SCRATCH_ARENA_SIZE)
+			return FALSE;
+
+		USIZE before = scratch->GetUsed();
+		{
+			ArenaScope scope(*scratch);
+			PCHAR text = (PCHAR)scratch->Allocate(1000);
+			if (text == NULL)
+				return FALSE;
+			Memory::Set(text, 'x', 1000);
+		}
+		// Same arena on every call, rewound by the scope
+		return ThreadContext::GetScratch() == scratch && scratch->GetUsed() == before;
+	}
+
+	static BOOL TestAllocatorCache()
+	{
+		// Size classes round up to powers of two
+		if (ThreadContext::GetSizeClass(1) != 0 || ThreadContext::GetSizeClass(16) != 0 ||
+			ThreadContext::GetSizeClass(17) != 1 || ThreadContext::GetSizeClass(256) != 4 ||
+			ThreadContext::GetSizeClass(257) != -1)
+			return FALSE;
+
+		PVOID block = Allocator::AllocateMemory(24);
+		if (block == NULL)
+			return FALSE;
+		Allocator::ReleaseMemory(block, 24);
+
+		// A request in the same class reuses the cached block
+		PVOID again = Allocator::AllocateMemory(30);
+		BOOL reused = again == block;
+		Allocator::ReleaseMemory(again, 30);
+		return reused;
+	}
+
+	static BOOL TestApiCache()
+	{
+		USIZE moduleHash = Djb2::HashCompileTime(L"ntdll.dll");
+		USIZE functionHash = Djb2::HashCompileTime("NtClose");
+
+		PVOID first = ResolveExportAddressFromPebModule(moduleHash, functionHash);
+		PVOID second = ResolveExportAddressFromPebModule(moduleHash, functionHash);
+		if (first == NULL || first != second)
+			return FALSE;
+
+		PTHREAD_CONTEXT context = ThreadContext::Get();
+		for (USIZE i = 0; i < API_CACHE_ENTRIES; i++)
+		{
+			if (context->ApiCache[i].FunctionHash == functionHash && context->ApiCache[i].Address == first)
+				return TRUE;
+		}
+		return FALSE;
+	}
+};
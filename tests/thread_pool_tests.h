@@ -0,0 +1,218 @@
+#pragma once
+
+#include "runtime.h"
+
+class ThreadPoolTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running ThreadPool Tests..."_embed);
+
+		// Test 1: Deque owner/thief ordering
+		if (!TestDequeOrdering())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Deque ordering"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Deque ordering"_embed);
+		}
+
+		// Test 2: ParallelFor visits every index exactly once
+		if (!TestParallelForCoverage())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: ParallelFor coverage"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: ParallelFor coverage"_embed);
+		}
+
+		// Test 3: ParallelFor with empty and single-grain ranges
+		if (!TestParallelForEdgeRanges())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: ParallelFor edge ranges"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: ParallelFor edge ranges"_embed);
+		}
+
+		// Test 4: Nested fork/join through task groups
+		if (!TestNestedTaskGroups())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Nested task groups"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Nested task groups"_embed);
+		}
+
+		// Test 5: Work spreads across several threads
+		if (!TestWorkIsDistributed())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Work is distributed"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Work is distributed"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All ThreadPool tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some ThreadPool tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	static constexpr UINT32 WorkerCount = 3;
+
+	static VOID NoOp(PTASK) {}
+
+	static BOOL TestDequeOrdering()
+	{
+		TaskDeque *deque = new TaskDeque();
+		TASK tasks[3];
+		for (USIZE i = 0; i < 3; i++)
+		{
+			tasks[i].Invoke = NoOp;
+			tasks[i].Group = NULL;
+		}
+
+		BOOL result = deque->IsEmpty();
+		result = result && deque->Push(&tasks[0]) && deque->Push(&tasks[1]) && deque->Push(&tasks[2]);
+		// Owner pops LIFO, thieves steal FIFO
+		result = result && deque->Take() == &tasks[2];
+		result = result && deque->Steal() == &tasks[0];
+		result = result && deque->Take() == &tasks[1];
+		result = result && deque->Take() == NULL && deque->Steal() == NULL && deque->IsEmpty();
+
+		delete deque;
+		return result;
+	}
+
+	static BOOL TestParallelForCoverage()
+	{
+		constexpr USIZE count = 10000;
+		UINT8 *visits = new UINT8[count];
+		Memory::Zero(visits, count);
+
+		ThreadPool pool;
+		if (!pool.Start(WorkerCount))
+		{
+			delete[] visits;
+			return FALSE;
+		}
+
+		auto body = [visits](USIZE i)
+		{ __atomic_fetch_add(&visits[i], 1, __ATOMIC_RELAXED); };
+		pool.ParallelFor(0, count, 64, body);
+		pool.Stop();
+
+		BOOL result = TRUE;
+		for (USIZE i = 0; i < count; i++)
+		{
+			if (visits[i] != 1)
+				result = FALSE;
+		}
+
+		delete[] visits;
+		return result;
+	}
+
+	static BOOL TestParallelForEdgeRanges()
+	{
+		ThreadPool pool;
+		if (!pool.Start(WorkerCount))
+			return FALSE;
+
+		Atomic<USIZE> sum(0);
+		auto body = [&sum](USIZE i)
+		{ sum.FetchAdd(i + 1); };
+
+		// Empty range runs nothing
+		pool.ParallelFor(5, 5, 1, body);
+		BOOL result = sum.Load() == 0;
+
+		// Range smaller than the grain runs on the caller
+		pool.ParallelFor(0, 10, 100, body);
+		result = result && sum.Load() == 55;
+
+		// Zero grain is treated as one
+		sum.Store(0);
+		pool.ParallelFor(0, 100, 0, body);
+		result = result && sum.Load() == 5050;
+
+		pool.Stop();
+		return result;
+	}
+
+	// Recursive Fibonacci, forking the first call at every level
+	static USIZE Fibonacci(ThreadPool &pool, USIZE n)
+	{
+		if (n < 2)
+			return n;
+		if (n < 12)
+			return Fibonacci(pool, n - 1) + Fibonacci(pool, n - 2);
+
+		USIZE left = 0;
+		auto job = MakeJob([&pool, &left, n]()
+						   { left = Fibonacci(pool, n - 1); });
+		TaskGroup group;
+		group.Run(pool, job);
+		USIZE right = Fibonacci(pool, n - 2);
+		group.Wait(pool);
+		return left + right;
+	}
+
+	static BOOL TestNestedTaskGroups()
+	{
+		ThreadPool pool;
+		if (!pool.Start(WorkerCount))
+			return FALSE;
+		USIZE result = Fibonacci(pool, 24);
+		pool.Stop();
+		return result == 46368;
+	}
+
+	static BOOL TestWorkIsDistributed()
+	{
+		ThreadPool pool;
+		if (!pool.Start(WorkerCount))
+			return FALSE;
+
+		// Record which threads ran iterations; slow bodies give thieves time to steal
+		constexpr USIZE count = 256;
+		USIZE owners[count];
+		auto body = [&owners](USIZE i)
+		{
+			for (UINT32 spin = 0; spin < 2000; spin++)
+				CpuRelax();
+			owners[i] = Thread::GetCurrentId();
+		};
+		pool.ParallelFor(0, count, 1, body);
+		pool.Stop();
+
+		USIZE first = owners[0];
+		for (USIZE i = 1; i < count; i++)
+		{
+			if (owners[i] != first)
+				return TRUE;
+		}
+		return FALSE;
+	}
+};
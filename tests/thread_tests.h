@@ -0,0 +1,222 @@
+#pragma once
+
+#include "runtime.h"
+
+class ThreadTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Thread Tests..."_embed);
+
+		// Test 1: Create and join returns the routine's exit code
+		if (!TestCreateJoinExitCode())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Create and join exit code"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Create and join exit code"_embed);
+		}
+
+		// Test 2: Parameter is passed through and writes are visible after join
+		if (!TestParameterPassing())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Parameter passing"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Parameter passing"_embed);
+		}
+
+		// Test 3: Several threads run concurrently with distinct ids
+		if (!TestMultipleThreads())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Multiple threads"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Multiple threads"_embed);
+		}
+
+		// Test 4: Requested stack size is usable
+		if (!TestCustomStackSize())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Custom stack size"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Custom stack size"_embed);
+		}
+
+		// Test 5: Joinable state follows the thread lifetime
+		if (!TestJoinableState())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Joinable state"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Joinable state"_embed);
+		}
+
+		// Test 6: A thread that is never joined is joined when it goes out of scope
+		if (!TestDestructorJoins())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Destructor joins"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Destructor joins"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Thread tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Thread tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Per-thread result slot, each worker writes only its own
+	typedef struct _THREAD_SLOT
+	{
+		USIZE Input;
+		USIZE Output;
+		USIZE ThreadId;
+	} THREAD_SLOT;
+
+	static INT32 ReturnConstant(PVOID)
+	{
+		return 42;
+	}
+
+	static INT32 SquareInput(PVOID parameter)
+	{
+		THREAD_SLOT *slot = (THREAD_SLOT *)parameter;
+		slot->Output = slot->Input * slot->Input;
+		slot->ThreadId = Thread::GetCurrentId();
+		Thread::Yield();
+		return (INT32)slot->Input;
+	}
+
+	// Recurse with small frames so no single frame needs a stack probe
+	static NOINLINE USIZE ConsumeStack(USIZE depth)
+	{
+		volatile UINT8 frame[1024];
+		frame[0] = (UINT8)depth;
+		frame[sizeof(frame) - 1] = (UINT8)depth;
+		if (depth == 0)
+			return frame[0];
+		return ConsumeStack(depth - 1) + 1 + (frame[sizeof(frame) - 1] - (UINT8)depth);
+	}
+
+	static INT32 TouchLargeStack(PVOID parameter)
+	{
+		// About 512KB of frames, more than the default stack size provides
+		*(USIZE *)parameter = ConsumeStack(512);
+		return 0;
+	}
+
+	static BOOL TestCreateJoinExitCode()
+	{
+		Thread thread;
+		if (!thread.Create(ReturnConstant, NULL))
+			return FALSE;
+		return thread.Join() == 42;
+	}
+
+	static BOOL TestParameterPassing()
+	{
+		THREAD_SLOT slot = {7, 0, 0};
+		Thread thread;
+		if (!thread.Create(SquareInput, &slot))
+			return FALSE;
+		if (thread.Join() != 7)
+			return FALSE;
+		return slot.Output == 49 && slot.ThreadId != 0 && slot.ThreadId != Thread::GetCurrentId();
+	}
+
+	static BOOL TestMultipleThreads()
+	{
+		constexpr USIZE count = 4;
+		THREAD_SLOT slots[count];
+		Thread threads[count];
+
+		for (USIZE i = 0; i < count; i++)
+		{
+			slots[i].Input = i + 1;
+			slots[i].Output = 0;
+			slots[i].ThreadId = 0;
+			if (!threads[i].Create(SquareInput, &slots[i]))
+				return FALSE;
+		}
+
+		BOOL result = TRUE;
+		for (USIZE i = 0; i < count; i++)
+		{
+			if (threads[i].Join() != (INT32)(i + 1) || slots[i].Output != (i + 1) * (i + 1))
+				result = FALSE;
+		}
+
+		// Every thread must observe its own identifier
+		for (USIZE i = 0; i < count; i++)
+		{
+			for (USIZE j = i + 1; j < count; j++)
+			{
+				if (slots[i].ThreadId == slots[j].ThreadId)
+					result = FALSE;
+			}
+		}
+
+		return result;
+	}
+
+	static BOOL TestCustomStackSize()
+	{
+		USIZE observed = 0;
+		Thread thread;
+		if (!thread.Create(TouchLargeStack, &observed, 1024 * 1024))
+			return FALSE;
+		thread.Join();
+		return observed == 512;
+	}
+
+	static BOOL TestJoinableState()
+	{
+		Thread thread;
+		if (thread.IsJoinable())
+			return FALSE;
+		if (!thread.Create(ReturnConstant, NULL))
+			return FALSE;
+		if (!thread.IsJoinable())
+			return FALSE;
+		thread.Join();
+		// A second join on a released thread reports failure
+		return !thread.IsJoinable() && thread.Join() == -1;
+	}
+
+	static BOOL TestDestructorJoins()
+	{
+		THREAD_SLOT slot = {9, 0, 0};
+		{
+			Thread thread;
+			if (!thread.Create(SquareInput, &slot))
+				return FALSE;
+		}
+		// The routine has finished by the time the destructor returns
+		return slot.Output == 81 && slot.ThreadId != 0;
+	}
+};
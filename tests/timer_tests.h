@@ -0,0 +1,197 @@
+#pragma once
+
+#include "runtime.h"
+
+class TimerTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Timer Tests..."_embed);
+
+		// Test 1: The cycle counter never runs backwards and advances under load
+		if (!TestCycleCounter())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Cycle counter"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Cycle counter"_embed);
+		}
+
+		// Test 2: The nanosecond clock is monotonic and advances
+		if (!TestMonotonicClock())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Monotonic clock"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Monotonic clock"_embed);
+		}
+
+		// Test 3: Calibrated cycles agree with the clock
+		if (!TestCalibration())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Calibration"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Calibration"_embed);
+		}
+
+		// Test 4: Histogram statistics and bucket precision
+		if (!TestHistogram())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Histogram"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Histogram"_embed);
+		}
+
+		// Test 5: Stopwatches record into a histogram when they go out of scope
+		if (!TestStopwatch())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Stopwatch"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Stopwatch"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Timer tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Timer tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Busy-wait on the monotonic clock
+	static VOID SpinFor(UINT64 nanoseconds)
+	{
+		UINT64 start = Timer::GetNanoseconds();
+		while (Timer::GetNanoseconds() - start < nanoseconds)
+			CpuRelax();
+	}
+
+	static BOOL TestCycleCounter()
+	{
+		UINT64 previous = Timer::ReadCycles();
+		for (USIZE i = 0; i < 1000; i++)
+		{
+			UINT64 current = Timer::ReadCyclesOrdered();
+			if (current < previous)
+				return FALSE;
+			previous = current;
+		}
+
+		UINT64 start = Timer::ReadCycles();
+		SpinFor(UINT64(1000000U));
+		return Timer::ReadCycles() > start;
+	}
+
+	static BOOL TestMonotonicClock()
+	{
+		UINT64 previous = Timer::GetNanoseconds();
+		for (USIZE i = 0; i < 1000; i++)
+		{
+			UINT64 current = Timer::GetNanoseconds();
+			if (current < previous)
+				return FALSE;
+			previous = current;
+		}
+
+		// Spinning 2 ms must show at least that much time
+		UINT64 start = Timer::GetNanoseconds();
+		SpinFor(UINT64(2000000U));
+		return Timer::GetNanoseconds() - start >= 2000000U;
+	}
+
+	static BOOL TestCalibration()
+	{
+		UINT64 frequency = Timer::GetCycleFrequency();
+		if (frequency < 1000000U)
+			return FALSE;
+
+		// Cached per thread: the second call returns the same value
+		if (Timer::GetCycleFrequency() != frequency)
+			return FALSE;
+
+		// 20 ms measured both ways; allow a quarter for preemption and coarse clocks
+		UINT64 cycleStart = Timer::ReadCyclesOrdered();
+		UINT64 clockStart = Timer::GetNanoseconds();
+		SpinFor(UINT64(20000000U));
+		UINT64 clockElapsed = Timer::GetNanoseconds() - clockStart;
+		UINT64 cycleElapsed = Timer::CyclesToNanoseconds(Timer::ReadCyclesOrdered() - cycleStart);
+
+		UINT64 tolerance = clockElapsed / 4U;
+		return cycleElapsed + tolerance >= clockElapsed && cycleElapsed <= clockElapsed + tolerance;
+	}
+
+	static BOOL TestHistogram()
+	{
+		Histogram histogram;
+		if (histogram.GetCount() != 0 || histogram.GetPercentile(50) != 0U)
+			return FALSE;
+
+		// 1..100: small values are exact, larger ones are within a bucket
+		for (UINT32 i = 1; i <= 100; i++)
+			histogram.Record(UINT64(i));
+
+		if (histogram.GetCount() != 100U || histogram.GetMinimum() != 1U || histogram.GetMaximum() != 100U)
+			return FALSE;
+		if (histogram.GetMean() != 50U || histogram.GetPercentile(10) != 10U || histogram.GetPercentile(100) != 100U)
+			return FALSE;
+
+		UINT64 median = histogram.GetPercentile(50);
+		UINT64 p99 = histogram.GetPercentile(99);
+		if (median < 50U || median > 53U || p99 < 99U || p99 > 100U)
+			return FALSE;
+
+		// Large samples keep a relative error of at most 1/16
+		Histogram large;
+		UINT64 value(0x12U, 0x34567890U);
+		large.Record(value);
+		large.Record(value + 1000U);
+		UINT64 reported = large.GetPercentile(50);
+		if (reported < value || reported > value + value / 16U)
+			return FALSE;
+
+		// Merged histograms combine counts and extremes
+		large.Merge(histogram);
+		return large.GetCount() == 102U && large.GetMinimum() == 1U && large.GetMaximum() == value + 1000U;
+	}
+
+	static BOOL TestStopwatch()
+	{
+		Histogram latency;
+		for (USIZE i = 0; i < 10; i++)
+		{
+			Stopwatch watch(latency);
+			SpinFor(UINT64(100000U));
+		}
+
+		// Each sample spun at least 100 us
+		if (latency.GetCount() != 10U || latency.GetMinimum() < 75000U || latency.GetMaximum() < latency.GetMinimum())
+			return FALSE;
+
+		Stopwatch watch;
+		SpinFor(UINT64(1000000U));
+		UINT64 elapsed = watch.GetElapsedNanoseconds();
+		watch.Restart();
+		return elapsed >= 750000U && watch.GetElapsedNanoseconds() < elapsed;
+	}
+};
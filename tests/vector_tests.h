@@ -0,0 +1,359 @@
+#pragma once
+
+#include "runtime.h"
+
+class VectorTests
+{
+public:
+	static BOOL RunAll()
+	{
+		BOOL allPassed = TRUE;
+
+		Logger::Info<WCHAR>(L"Running Vector Tests..."_embed);
+
+		// Test 1: Growth keeps every element and capacity doubles
+		if (!TestGrowth())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Growth"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Growth"_embed);
+		}
+
+		// Test 2: Inline storage is used before the heap
+		if (!TestInlineCapacity())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Inline capacity"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Inline capacity"_embed);
+		}
+
+		// Test 3: Non-trivial elements are constructed and destroyed exactly once
+		if (!TestLifetimes())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Element lifetimes"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Element lifetimes"_embed);
+		}
+
+		// Test 4: Insert, remove, resize and pop
+		if (!TestEditing())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Editing"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Editing"_embed);
+		}
+
+		// Test 5: Move construction and assignment from heap and inline vectors
+		if (!TestMove())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Move"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Move"_embed);
+		}
+
+		// Test 6: Arena policy grows in place and reports exhaustion
+		if (!TestArena())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Arena allocator"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Arena allocator"_embed);
+		}
+
+		// Test 7: Heap policy honours alignments stricter than the heap's
+		if (!TestHeapAlignment())
+		{
+			allPassed = FALSE;
+			Logger::Error<WCHAR>(L"  FAILED: Heap alignment"_embed);
+		}
+		else
+		{
+			Logger::Info<WCHAR>(L"  PASSED: Heap alignment"_embed);
+		}
+
+		if (allPassed)
+		{
+			Logger::Info<WCHAR>(L"All Vector tests passed!"_embed);
+		}
+		else
+		{
+			Logger::Error<WCHAR>(L"Some Vector tests failed!"_embed);
+		}
+
+		return allPassed;
+	}
+
+private:
+	// Counts live instances through a pointer (there are no writable globals)
+	struct Tracked
+	{
+		PINT32 Live;
+		UINT32 Value;
+
+		Tracked(PINT32 live, UINT32 value) : Live(live), Value(value) { (*Live)++; }
+		Tracked(const Tracked &other) : Live(other.Live), Value(other.Value) { (*Live)++; }
+		Tracked(Tracked &&other) : Live(other.Live), Value(other.Value)
+		{
+			(*Live)++;
+			other.Value = 0;
+		}
+		Tracked &operator=(const Tracked &other)
+		{
+			Value = other.Value;
+			return *this;
+		}
+		Tracked &operator=(Tracked &&other)
+		{
+			Value = other.Value;
+			other.Value = 0;
+			return *this;
+		}
+		~Tracked() { (*Live)--; }
+	};
+
+	static BOOL TestGrowth()
+	{
+		Vector<UINT32> values;
+		if (!values.IsEmpty() || values.GetCapacity() != 0)
+			return FALSE;
+
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			if (!values.Push(i * 7))
+				return FALSE;
+		}
+		if (values.GetSize() != 1000 || values.GetCapacity() != 1024)
+			return FALSE;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			if (values[i] != i * 7)
+				return FALSE;
+		}
+
+		// Pushing an element of the vector itself while it reallocates
+		Vector<UINT32> small;
+		for (UINT32 i = 0; i < VECTOR_MIN_CAPACITY; i++)
+			small.Push(i + 1);
+		if (!small.Push(small[0]) || small.GetSize() != VECTOR_MIN_CAPACITY + 1 || small.Last() != 1)
+			return FALSE;
+
+		// Reserve, Append and range-for
+		Vector<UINT32> reserved;
+		if (!reserved.Reserve(100) || reserved.GetCapacity() != 100)
+			return FALSE;
+		if (!reserved.Append(values.GetData(), 100) || reserved.GetCapacity() != 100)
+			return FALSE;
+		UINT32 sum = 0;
+		for (UINT32 value : reserved)
+			sum += value;
+		return sum == 7 * (99 * 100 / 2);
+	}
+
+	static BOOL TestInlineCapacity()
+	{
+		SmallVector<UINT64, 4> values;
+		PUINT8 self = (PUINT8)&values;
+		for (UINT32 i = 0; i < 4; i++)
+			values.Push(UINT64(i));
+		PUINT8 data = (PUINT8)values.GetData();
+		if (values.GetCapacity() != 4 || data < self || data >= self + sizeof(values))
+			return FALSE;
+
+		// The fifth element moves everything to the heap
+		values.Push(UINT64(4U));
+		data = (PUINT8)values.GetData();
+		if (values.GetCapacity() != 8 || (data >= self && data < self + sizeof(values)))
+			return FALSE;
+		for (UINT32 i = 0; i < 5; i++)
+		{
+			if (values[i] != UINT64(i))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	static BOOL TestLifetimes()
+	{
+		INT32 live = 0;
+		{
+			Vector<Tracked> items;
+			for (UINT32 i = 0; i < 100; i++)
+				items.Emplace(&live, i);
+			if (live != 100)
+				return FALSE;
+			for (UINT32 i = 0; i < 100; i++)
+			{
+				if (items[i].Value != i)
+					return FALSE;
+			}
+
+			items.RemoveAt(10);
+			items.Pop();
+			if (live != 98 || items[10].Value != 11)
+				return FALSE;
+
+			Tracked extra(&live, 500);
+			items.Insert(0, extra);
+			if (live != 100 || items[0].Value != 500 || items[11].Value != 11)
+				return FALSE;
+		}
+		if (live != 0)
+			return FALSE;
+
+		// Small vectors move non-trivial elements out of inline storage one by one
+		{
+			SmallVector<Tracked, 2> items;
+			for (UINT32 i = 0; i < 5; i++)
+				items.Emplace(&live, i);
+			if (live != 5 || items[4].Value != 4 || items[0].Value != 0)
+				return FALSE;
+			items.Clear();
+			if (live != 0 || items.GetCapacity() != 8)
+				return FALSE;
+		}
+
+		// Vectors of vectors: each inner vector relocates as plain bytes
+		{
+			Vector<Vector<Tracked>> outer;
+			for (UINT32 i = 0; i < 10; i++)
+			{
+				Vector<Tracked> inner;
+				for (UINT32 j = 0; j <= i; j++)
+					inner.Emplace(&live, j);
+				outer.Push(Move(inner));
+			}
+			if (live != 55 || outer[9].GetSize() != 10 || outer[9][9].Value != 9)
+				return FALSE;
+		}
+		return live == 0;
+	}
+
+	static BOOL TestEditing()
+	{
+		Vector<UINT32> values;
+		for (UINT32 i = 0; i < 10; i++)
+			values.Push(i);
+
+		values.Insert(5, 100);
+		values.Insert(0, 200);
+		values.Insert(values.GetSize(), 300);
+		if (values.GetSize() != 13 || values[0] != 200 || values[6] != 100 || values[7] != 5 || values.Last() != 300)
+			return FALSE;
+
+		values.RemoveAt(0);
+		values.RemoveSwap(0);
+		if (values.GetSize() != 11 || values[0] != 300 || values.Last() != 9)
+			return FALSE;
+
+		if (!values.Resize(20) || values.GetSize() != 20 || values[19] != 0)
+			return FALSE;
+		if (!values.Resize(3) || values.GetSize() != 3 || values[2] != 2)
+			return FALSE;
+		values.Pop();
+		return values.GetSize() == 2 && values.First() == 300;
+	}
+
+	static BOOL TestMove()
+	{
+		Vector<UINT32> source;
+		for (UINT32 i = 0; i < 50; i++)
+			source.Push(i);
+		const UINT32 *block = source.GetData();
+
+		// A heap block changes owner without copying
+		Vector<UINT32> target(Move(source));
+		if (target.GetData() != block || target.GetSize() != 50 || source.GetSize() != 0 || source.GetCapacity() != 0)
+			return FALSE;
+
+		Vector<UINT32> assigned;
+		assigned.Push(1);
+		assigned = Move(target);
+		if (assigned.GetData() != block || assigned[49] != 49 || target.GetSize() != 0)
+			return FALSE;
+
+		// Inline elements are moved into the target's own storage
+		SmallVector<UINT32, 8> inlineSource;
+		inlineSource.Push(7);
+		inlineSource.Push(8);
+		SmallVector<UINT32, 8> inlineTarget(Move(inlineSource));
+		return inlineTarget.GetSize() == 2 && inlineTarget[1] == 8 && inlineTarget.GetData() != inlineSource.GetData() &&
+			   inlineSource.IsEmpty();
+	}
+
+	static BOOL TestArena()
+	{
+		Arena arena;
+		if (!arena.InitializeHeap(1024))
+			return FALSE;
+
+		{
+			// The only block in the arena keeps growing where it is
+			Vector<UINT32, ArenaAllocator> values{ArenaAllocator(arena)};
+			values.Push(0);
+			const UINT32 *block = values.GetData();
+			for (UINT32 i = 1; i < 200; i++)
+			{
+				if (!values.Push(i))
+					return FALSE;
+			}
+			if (values.GetData() != block || arena.GetUsed() != values.GetCapacity() * sizeof(UINT32))
+				return FALSE;
+
+			// 256 elements fill the arena; the next push fails and changes nothing
+			for (UINT32 i = 200; i < 256; i++)
+				values.Push(i);
+			if (values.Push(256) || values.GetSize() != 256 || values[255] != 255)
+				return FALSE;
+		}
+
+		// Releasing the last block hands its bytes back
+		return arena.GetUsed() == 0;
+	}
+
+	static BOOL TestHeapAlignment()
+	{
+		HeapAllocator heap;
+		for (USIZE alignment = 1; alignment <= 256; alignment *= 2)
+		{
+			// Sizes inside and past the thread cache's classes
+			for (USIZE size = 8; size <= 1024; size *= 4)
+			{
+				PUINT8 block = (PUINT8)heap.Allocate(size, alignment);
+				if (block == NULL || ((USIZE)block & (alignment - 1)) != 0)
+					return FALSE;
+				Memory::Set(block, 0xA5, size);
+				heap.Release(block, size, alignment);
+			}
+		}
+
+		// A vector of over-aligned elements gets aligned storage on every growth
+		struct alignas(64) Line
+		{
+			UINT8 Bytes[64];
+		};
+		Vector<Line> lines;
+		for (UINT32 i = 0; i < 20; i++)
+		{
+			if (!lines.Push(Line()) || ((USIZE)lines.GetData() & 63) != 0)
+				return FALSE;
+		}
+		return TRUE;
+	}
+};